@@ -18,6 +18,9 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <qautils/HistAccumulator.h>
+#include <qautils/QAHistManagerDef.h>
+
 #include <TF1.h>
 #include <TFile.h>
 #include <TGraphErrors.h>
@@ -30,6 +33,8 @@
 #include <TSystem.h>
 #include <TTree.h>
 
+#include <omp.h>
+
 #include <CLHEP/Vector/ThreeVector.h>  // for Hep3Vector
 
 #include <algorithm>  // for max, max_element
@@ -496,9 +501,22 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
   t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
   t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
 
-  // pre-loop to save all the clusters LorentzVector
+  if (!eta_hist.at(0) || !pt1_ptpi0_alpha || !pairInvMassTotal || !mass_eta || !mass_eta_phi)
+  {
+    std::cout << PHWHERE << " histograms are not booked, call InitRun first" << std::endl;
+    return;
+  }
 
-  TLorentzVector *savClusLV[10000];
+  // the pair loop runs in m_nthreads threads, each fills its own accumulators
+  // which are added to the histograms at the end
+  std::vector<HistAccumulator<float>> eta_acc(m_nthreads, HistAccumulator<float>(eta_hist.size(), eta_hist.at(0)));
+  std::vector<HistAccumulator<float>> pt1_ptpi0_alpha_acc(m_nthreads, HistAccumulator<float>(1, pt1_ptpi0_alpha));
+  std::vector<HistAccumulator<float>> pairInvMassTotal_acc(m_nthreads, HistAccumulator<float>(1, pairInvMassTotal));
+  std::vector<HistAccumulator<float>> mass_eta_acc(m_nthreads, HistAccumulator<float>(1, mass_eta));
+  std::vector<HistAccumulator<float>> mass_eta_phi_acc(m_nthreads, HistAccumulator<float>(1, mass_eta_phi));
+
+  // pre-loop to save all the clusters LorentzVector
+  std::vector<TLorentzVector> savClusLV;
 
   //  int nEntries = (int) t1->GetEntriesFast();
   int nEntries = (int) t1->GetEntries();
@@ -533,9 +551,7 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       continue;
     }
 
-    float pt1cut = 0;
-    float pt2cut = 0;
-
+    savClusLV.resize(nClusters);
     for (int j = 0; j < nClusters; j++)
     {
       // float px, py, pz;
@@ -567,16 +583,15 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       pt *= aggcv;
       E *= aggcv;
 
-      savClusLV[j] = new TLorentzVector();
-      savClusLV[j]->SetPtEtaPhiE(pt, eta, phi, E);
+      savClusLV[j].SetPtEtaPhiE(pt, eta, phi, E);
     }
 
-    TLorentzVector *pho1;
-    TLorentzVector *pho2;
     int iCs = nClusters;
+#pragma omp parallel for schedule(dynamic) num_threads(m_nthreads)
     for (int jCs = 0; jCs < iCs; jCs++)
     {
-      pho1 = savClusLV[jCs];
+      const int ithread = omp_get_thread_num();
+      const TLorentzVector &pho1 = savClusLV[jCs];
       /////////////////////////////////////////////////////////////////
       //////////////////////////////////////////////////////
       // *********************************
@@ -596,6 +611,8 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       // stable calibration period (typically a daq run-length) is small
 
       float modCutFactor = 1.0;
+      float pt1cut = 0;
+      float pt2cut = 0;
 
       if (iCs < 30)
       {
@@ -629,7 +646,7 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       ///////////////////////////////////////
       /////////////////////////////////////
 
-      if (std::abs(pho1->Pt()) < pt1cut)
+      if (std::abs(pho1.Pt()) < pt1cut)
       {
         continue;
       }
@@ -642,28 +659,28 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
           continue;
         }
 
-        pho2 = savClusLV[kCs];
+        const TLorentzVector &pho2 = savClusLV[kCs];
 
-        if (std::abs(pho2->Pt()) < pt2cut)
+        if (std::abs(pho2.Pt()) < pt2cut)
         {
           continue;
         }
 
-        alphaCut = std::abs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
+        float alpha = std::abs((pho1.E() - pho2.E()) / (pho1.E() + pho2.E()));
 
-        if (alphaCut > alphacutval)
+        if (alpha > alphacutval)
         {
           continue;
         }
 
         TLorentzVector pi0lv;
 
-        if (pho1->DeltaR(*pho2) > deltaRconecut)
+        if (pho1.DeltaR(pho2) > deltaRconecut)
         {
           continue;
         }
 
-        pi0lv = *pho1 + *pho2;
+        pi0lv = pho1 + pho2;
         if (std::abs(pi0lv.Pt()) > pi0ptcut)
         {
           float pairInvMass = pi0lv.M();
@@ -671,15 +688,48 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
           // fill the tower by tower histograms with invariant mass
           // cemc_hist_eta_phi[_maxTowerEtas[jCs]][_maxTowerPhis[jCs]]->Fill(pairInvMass);
           // not useful in summer 23 data
-          eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
-          pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
-          pairInvMassTotal->Fill(pairInvMass);
-          mass_eta->Fill(pairInvMass, _clusterEtas[jCs]);
-          mass_eta_phi->Fill(pairInvMass, _clusterEtas[jCs], _clusterPhis[jCs]);
+          eta_acc[ithread].Fill(_maxTowerEtas[jCs], pairInvMass);
+          pt1_ptpi0_alpha_acc[ithread].Fill3D(0, pho1.Pt(), pi0lv.Pt(), alpha);
+          pairInvMassTotal_acc[ithread].Fill(0, pairInvMass);
+          mass_eta_acc[ithread].Fill2D(0, pairInvMass, _clusterEtas[jCs]);
+          mass_eta_phi_acc[ithread].Fill3D(0, pairInvMass, _clusterEtas[jCs], _clusterPhis[jCs]);
         }
       }
     }
   }
+
+  for (int ithread = 1; ithread < m_nthreads; ithread++)
+  {
+    eta_acc[0].Add(eta_acc[ithread]);
+    pt1_ptpi0_alpha_acc[0].Add(pt1_ptpi0_alpha_acc[ithread]);
+    pairInvMassTotal_acc[0].Add(pairInvMassTotal_acc[ithread]);
+    mass_eta_acc[0].Add(mass_eta_acc[ithread]);
+    mass_eta_phi_acc[0].Add(mass_eta_phi_acc[ithread]);
+  }
+  for (unsigned int i = 0; i < eta_hist.size(); i++)
+  {
+    eta_acc[0].AddTo(i, eta_hist.at(i));
+  }
+  pt1_ptpi0_alpha_acc[0].AddTo(0, pt1_ptpi0_alpha);
+  pairInvMassTotal_acc[0].AddTo(0, pairInvMassTotal);
+  mass_eta_acc[0].AddTo(0, mass_eta);
+  mass_eta_phi_acc[0].AddTo(0, mass_eta_phi);
+  if (eta_acc[0].Rejected() > 0)
+  {
+    std::cout << PHWHERE << " " << eta_acc[0].Rejected() << " pairs with max tower eta out of range were not filled" << std::endl;
+  }
+
+  // the histograms are owned by the output file, the histogram manager gets copies
+  Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager(Name());
+  for (const TH1 *h : eta_hist)
+  {
+    QAHistManagerDef::registerHistoCopy(hm, h);
+  }
+  QAHistManagerDef::registerHistoCopy(hm, pt1_ptpi0_alpha);
+  QAHistManagerDef::registerHistoCopy(hm, pairInvMassTotal);
+  QAHistManagerDef::registerHistoCopy(hm, mass_eta);
+  QAHistManagerDef::registerHistoCopy(hm, mass_eta_phi);
+
   std::cout << "total number of events: " << nEntries << std::endl;
   std::cout << "total number of events discarded: " << discarded_clusters << std::endl;
 }
@@ -758,9 +808,19 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
   t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
   t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
 
-  // pre-loop to save all the clusters LorentzVector
+  if (!cemc_hist_eta_phi.at(0).at(0) || !eta_hist.at(0))
+  {
+    std::cout << PHWHERE << " tower histograms are not loaded, call Get_Histos first" << std::endl;
+    return;
+  }
 
-  std::array<TLorentzVector *, 10000> savClusLV{};
+  // the pair loop runs in m_nthreads threads, each fills its own accumulators
+  // which are added to the histograms at the end
+  std::vector<HistAccumulator<float>> tower_acc(m_nthreads, HistAccumulator<float>(96 * 256, cemc_hist_eta_phi.at(0).at(0)));
+  std::vector<HistAccumulator<float>> eta_acc(m_nthreads, HistAccumulator<float>(eta_hist.size(), eta_hist.at(0)));
+
+  // pre-loop to save all the clusters LorentzVector
+  std::vector<TLorentzVector> savClusLV;
 
   //  int nEntries = (int) t1->GetEntriesFast();
   int nEntries = (int) t1->GetEntries();
@@ -789,6 +849,7 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
       continue;
     }
 
+    savClusLV.resize(nClusters);
     for (int j = 0; j < nClusters; j++)
     {
       // float px, py, pz;
@@ -806,18 +867,17 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
       pt *= aggcv;
       E *= aggcv;
 
-      savClusLV.at(j) = new TLorentzVector();
-      savClusLV.at(j)->SetPtEtaPhiE(pt, eta, phi, E);
+      savClusLV.at(j).SetPtEtaPhiE(pt, eta, phi, E);
     }
 
-    TLorentzVector *pho1;
-    TLorentzVector *pho2;
     int iCs = nClusters;
+#pragma omp parallel for schedule(dynamic) num_threads(m_nthreads)
     for (int jCs = 0; jCs < iCs; jCs++)
     {
-      pho1 = savClusLV.at(jCs);
+      const int ithread = omp_get_thread_num();
+      const TLorentzVector &pho1 = savClusLV.at(jCs);
 
-      if (std::abs(pho1->Pt()) < 1.0)
+      if (std::abs(pho1.Pt()) < 1.0)
       {
         continue;
       }
@@ -830,19 +890,19 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
           continue;
         }
 
-        pho2 = savClusLV.at(kCs);
+        const TLorentzVector &pho2 = savClusLV.at(kCs);
 
-        if (std::abs(pho2->Pt()) < 0.6)
+        if (std::abs(pho2.Pt()) < 0.6)
         {
           continue;
         }
 
         TLorentzVector pi0lv;
-        if (pho1->DeltaR(*pho2) > 0.45)
+        if (pho1.DeltaR(pho2) > 0.45)
         {
           continue;
         }
-        pi0lv = *pho1 + *pho2;
+        pi0lv = pho1 + pho2;
         float pairInvMass = pi0lv.M();
         if (pi0lv.Pt() < 1.0)
         {
@@ -857,8 +917,8 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
         }
         */
 
-        alphaCut = std::abs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
-        if (alphaCut > 0.50)
+        float alpha = std::abs((pho1.E() - pho2.E()) / (pho1.E() + pho2.E()));
+        if (alpha > 0.50)
         {
           continue;  // 0.50 to begin with
         }
@@ -874,12 +934,40 @@ void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filenam
         // fill the tower by tower histograms with invariant mass
         // we don't need to fill tower-by-tower level when we do for eta slices
         // although filling here just so we don't have to change codes in other places
-        cemc_hist_eta_phi.at(_maxTowerEtas[jCs]).at(_maxTowerPhis[jCs])->Fill(pairInvMass);
-        eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
+        // an out of range tower index is rejected by the accumulator
+        const bool tower_ok = _maxTowerEtas[jCs] >= 0 && _maxTowerEtas[jCs] < 96 && _maxTowerPhis[jCs] >= 0 && _maxTowerPhis[jCs] < 256;
+        tower_acc[ithread].Fill(tower_ok ? _maxTowerEtas[jCs] * 256 + _maxTowerPhis[jCs] : tower_acc[ithread].NHist(), pairInvMass);
+        eta_acc[ithread].Fill(_maxTowerEtas[jCs], pairInvMass);
         // pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
       }
     }
   }
+
+  for (int ithread = 1; ithread < m_nthreads; ithread++)
+  {
+    tower_acc[0].Add(tower_acc[ithread]);
+    eta_acc[0].Add(eta_acc[ithread]);
+  }
+  for (int ieta = 0; ieta < 96; ieta++)
+  {
+    for (int iphi = 0; iphi < 256; iphi++)
+    {
+      tower_acc[0].AddTo(ieta * 256 + iphi, cemc_hist_eta_phi.at(ieta).at(iphi));
+    }
+    eta_acc[0].AddTo(ieta, eta_hist.at(ieta));
+  }
+  if (tower_acc[0].Rejected() > 0 || eta_acc[0].Rejected() > 0)
+  {
+    std::cout << PHWHERE << " " << tower_acc[0].Rejected() << " pairs with max tower out of range were not filled" << std::endl;
+  }
+
+  // the histograms are owned by the output file, the histogram manager gets copies.
+  // The tower by tower spectra are only in the output file
+  Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager(Name());
+  for (const TH1 *h : eta_hist)
+  {
+    QAHistManagerDef::registerHistoCopy(hm, h);
+  }
 }
 
 // _______________________________________________________________..
@@ -5,6 +5,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <algorithm>
 #include <array>
 #include <string>
 
@@ -47,6 +48,9 @@ class CaloCalibEmc_Pi0 : public SubsysReco
 
   void set_centrality_nclusters_cut(int n) { m_cent_nclus_cut = n; }
 
+  //! number of threads for the pair loops of Loop and Loop_for_eta_slices
+  void set_num_threads(int n) { m_nthreads = std::max(1, n); }
+
   void Add_32();
   void Add_96();
 
@@ -85,6 +89,7 @@ class CaloCalibEmc_Pi0 : public SubsysReco
   std::string _inputtownodename;
 
   int m_cent_nclus_cut{0};
+  int m_nthreads{1};
 
   // histos lists
   //  std::arrays have their indices backward, this is the old TH1 *cemc_hist_eta_phi[96][258];
@@ -11,6 +11,8 @@
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>
 
+#include <qautils/QAHistManagerDef.h>
+
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -66,6 +68,7 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
   {
     std::cout << Name() << ": No Calo Type set" << std::endl;
     gSystem->Exit(1);
+    return Fun4AllReturnCodes::ABORTRUN;
   }
 
   _ievent = 0;
@@ -109,6 +112,12 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
         hcalin_eta[i]->SetXTitle("Energy [GeV]");
       }
     }
+
+    m_nphi = 64;
+    m_neta = 24;
+    m_eta_hists = hcalin_eta;
+    m_energy_eta = hcalin_energy_eta;
+    m_e_eta_phi = hcalin_e_eta_phi;
   }
 
   else if (calotype == LiteCaloEval::HCALOUT)
@@ -143,6 +152,12 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
         hcalout_eta[i]->SetXTitle("Energy [GeV]");
       }
     }
+
+    m_nphi = 64;
+    m_neta = 24;
+    m_eta_hists = hcalout_eta;
+    m_energy_eta = hcalout_energy_eta;
+    m_e_eta_phi = hcalout_e_eta_phi;
   }
 
   else if (calotype == LiteCaloEval::CEMC)
@@ -173,6 +188,12 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
 
     // make 3d histo
     e_eta_phi = new TH3F("e_eta_phi", "e v eta v phi", 100, 0, 10, 96, -0.5, 95.5, 256, -0.5, 255.5);
+
+    m_nphi = 256;
+    m_neta = 96;
+    m_eta_hists = eta_hist;
+    m_energy_eta = energy_eta_hist;
+    m_e_eta_phi = e_eta_phi;
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -181,6 +202,12 @@ int LiteCaloEval::InitRun(PHCompositeNode * /*topNode*/)
 //____________________________________________________________________________..
 int LiteCaloEval::process_event(PHCompositeNode *topNode)
 {
+  // no histograms are booked without a calorimeter type
+  if (calotype == LiteCaloEval::NONE)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   if (_ievent % 100 == 0)
   {
     std::cout << "LiteCaloEval::process_event(PHCompositeNode *topNode) Processing Event " << _ievent << std::endl;
@@ -335,16 +362,6 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
 
         e *= 0.88 + llet * 0.04 - 0.01 + 0.01 * ppkket;
       }
-
-      cemc_hist_eta_phi[ieta][iphi]->Fill(e);
-
-      eta_hist[96]->Fill(e);
-
-      eta_hist[ieta]->Fill(e);
-
-      energy_eta_hist->Fill(e, ieta);
-
-      e_eta_phi->Fill(e, ieta, iphi);
     }
 
     else if (calotype == LiteCaloEval::HCALOUT)
@@ -361,16 +378,6 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
           e *= 1.03;
         }
       }
-
-      hcal_out_eta_phi[ieta][iphi]->Fill(e);
-
-      hcalout_eta[24]->Fill(e);
-
-      hcalout_eta[ieta]->Fill(e);
-
-      hcalout_energy_eta->Fill(e, ieta);
-
-      hcalout_e_eta_phi->Fill(e, ieta, iphi);
     }
 
     else if (calotype == LiteCaloEval::HCALIN)
@@ -387,18 +394,10 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
           e *= 1.03;
         }
       }
-
-      hcal_in_eta_phi[ieta][iphi]->Fill(e);
-
-      hcalin_eta[24]->Fill(e);
-
-      hcalin_eta[ieta]->Fill(e);
-
-      hcalin_energy_eta->Fill(e, ieta);
-
-      hcalin_e_eta_phi->Fill(e, ieta, iphi);
     }
 
+    FillTower(ieta, iphi, e);
+
     if (!m_UseTowerInfo)
     {
       ++rtiter;
@@ -414,6 +413,23 @@ int LiteCaloEval::process_event(PHCompositeNode *topNode)
 //____________________________________________________________________________..
 int LiteCaloEval::End(PHCompositeNode * /*topNode*/)
 {
+  if (m_rejected_towers > 0)
+  {
+    std::cout << PHWHERE << " " << m_rejected_towers << " towers outside of " << _caloname << " were not filled" << std::endl;
+  }
+
+  // the histograms belong to the output file, the histogram manager gets copies.
+  // The tower by tower and 3D spectra are only in the output file
+  if (m_eta_hists)
+  {
+    Fun4AllHistoManager *hm = QAHistManagerDef::getHistoManager(Name());
+    for (unsigned int i = 0; i <= m_neta; i++)
+    {
+      QAHistManagerDef::registerHistoCopy(hm, m_eta_hists[i]);
+    }
+    QAHistManagerDef::registerHistoCopy(hm, m_energy_eta);
+  }
+
   cal_output->cd();
 
   std::cout << " writing lite calo file" << std::endl;
@@ -423,6 +439,35 @@ int LiteCaloEval::End(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void LiteCaloEval::FillTower(unsigned int ieta, unsigned int iphi, float e)
+{
+  // a tower outside this calorimeter must not land in the spectrum of another one
+  if (ieta >= m_neta || iphi >= m_nphi)
+  {
+    ++m_rejected_towers;
+    return;
+  }
+
+  TH1 *tower_hist = hcal_in_eta_phi[ieta][iphi];
+  if (calotype == LiteCaloEval::CEMC)
+  {
+    tower_hist = cemc_hist_eta_phi[ieta][iphi];
+  }
+  else if (calotype == LiteCaloEval::HCALOUT)
+  {
+    tower_hist = hcal_out_eta_phi[ieta][iphi];
+  }
+  tower_hist->Fill(e);
+
+  m_eta_hists[m_neta]->Fill(e);
+
+  m_eta_hists[ieta]->Fill(e);
+
+  m_energy_eta->Fill(e, ieta);
+
+  m_e_eta_phi->Fill(e, ieta, iphi);
+}
+
 /// infile histos, outfile is output file name
 void LiteCaloEval::Get_Histos(const std::string &infile, const std::string &outfile)
 {
@@ -127,6 +127,17 @@ class LiteCaloEval : public SubsysReco
 
   TH1 *h_event{nullptr};
 
+  // fills the spectra of one tower of the selected calorimeter
+  void FillTower(unsigned int ieta, unsigned int iphi, float e);
+  unsigned int m_nphi{0};
+  unsigned int m_neta{0};
+  unsigned long m_rejected_towers{0};
+
+  // histograms of the selected calorimeter
+  TH1 **m_eta_hists{nullptr};  // m_neta rings and all towers
+  TH2 *m_energy_eta{nullptr};
+  TH3 *m_e_eta_phi{nullptr};
+
   Calo calotype{NONE};
   int _ievent{0};
 
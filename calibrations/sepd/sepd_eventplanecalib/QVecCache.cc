@@ -0,0 +1,124 @@
+#include "QVecCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+void QVecCache::add(double cent, int cent_bin, double charge, const QVecs& q)
+{
+  m_cent.push_back(cent);
+  m_charge.push_back(charge);
+  m_cent_bin.push_back(cent_bin);
+  for (size_t h_idx = 0; h_idx < NHARMONICS; ++h_idx)
+  {
+    for (size_t arm = 0; arm < 2; ++arm)
+    {
+      m_q[h_idx][arm][0].push_back(q[h_idx][arm].x);
+      m_q[h_idx][arm][1].push_back(q[h_idx][arm].y);
+    }
+  }
+}
+
+bool QVecCache::write(const std::string& file) const
+{
+  std::ofstream out(file, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "QVecCache::write - Error! Cannot open: " << file << std::endl;
+    return false;
+  }
+
+  const size_t nevents = size();
+  Header header;
+  header.nevents = nevents;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  auto write_column = [&](const auto* data, size_t bytes)
+  {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(nevents * bytes));
+  };
+
+  write_column(cent(), sizeof(double));
+  write_column(charge(), sizeof(double));
+  for (size_t h_idx = 0; h_idx < NHARMONICS; ++h_idx)
+  {
+    for (size_t arm = 0; arm < 2; ++arm)
+    {
+      write_column(qx(h_idx, arm), sizeof(double));
+      write_column(qy(h_idx, arm), sizeof(double));
+    }
+  }
+  write_column(cent_bin(), sizeof(std::int32_t));
+
+  if (!out)
+  {
+    std::cout << "QVecCache::write - Error! Failed writing: " << file << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool QVecCache::map(const std::string& file)
+{
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "QVecCache::map - Error! Cannot open: " << file << std::endl;
+    return false;
+  }
+
+  struct stat st{};
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header))
+  {
+    close(fd);
+    std::cout << "QVecCache::map - Error! Not a Q-vector cache: " << file << std::endl;
+    return false;
+  }
+
+  void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // the mapping stays valid
+  if (base == MAP_FAILED)
+  {
+    std::cout << "QVecCache::map - Error! Cannot map: " << file << std::endl;
+    return false;
+  }
+
+  Header header;
+  const Header expected;
+  std::memcpy(&header, base, sizeof(header));
+  const size_t nevents = header.nevents;
+  if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+      header.version != expected.version || header.nharmonics != NHARMONICS ||
+      static_cast<size_t>(st.st_size) != offset(COL_CENT_BIN, nevents) + nevents * sizeof(std::int32_t))
+  {
+    munmap(base, st.st_size);
+    std::cout << "QVecCache::map - Error! Inconsistent Q-vector cache: " << file << std::endl;
+    return false;
+  }
+
+  unmap();
+  m_cent = {};
+  m_charge = {};
+  m_cent_bin = {};
+  m_q = {};
+  m_mapped = static_cast<const char*>(base);
+  m_mapped_size = st.st_size;
+  m_nmapped = nevents;
+  return true;
+}
+
+void QVecCache::unmap()
+{
+  if (m_mapped)
+  {
+    munmap(const_cast<char*>(m_mapped), m_mapped_size);
+  }
+  m_mapped = nullptr;
+  m_mapped_size = 0;
+  m_nmapped = 0;
+}
@@ -0,0 +1,105 @@
+#ifndef SEPDEVENTPLANECALIB_QVECCACHE_H
+#define SEPDEVENTPLANECALIB_QVECCACHE_H
+
+#include "QVecDefs.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class QVecCache
+ * @brief Columnar per-event store of the normalized sEPD Q-vectors.
+ *
+ * Filled once while the first calibration pass reads the DSTs, so the later
+ * passes can loop over plain arrays instead of replaying the input. Each
+ * quantity is a contiguous column. The file written by write() has the same
+ * layout and map() serves the columns straight from the mapped file.
+ */
+class QVecCache
+{
+ public:
+  static constexpr size_t NHARMONICS = QVecShared::HARMONICS.size();
+  using QVecs = std::array<std::array<QVecShared::QVec, 2>, NHARMONICS>;
+
+  QVecCache() = default;
+  ~QVecCache() { unmap(); }
+
+  QVecCache(const QVecCache&) = delete;
+  QVecCache& operator=(const QVecCache&) = delete;
+
+  /**
+   * @brief Appends one accepted event.
+   * @param cent The event centrality.
+   * @param cent_bin The 0-based centrality bin.
+   * @param charge The sEPD total charge.
+   * @param q The normalized Q-vectors, [Harmonic][South/North].
+   */
+  void add(double cent, int cent_bin, double charge, const QVecs& q);
+
+  /// Writes the columns to a file, false on error.
+  bool write(const std::string& file) const;
+
+  /// Replaces the in-memory columns by a view on a file written by write(), false on error.
+  bool map(const std::string& file);
+
+  void unmap();
+
+  size_t size() const { return m_mapped ? m_nmapped : m_cent.size(); }
+
+  const double* cent() const { return column<double>(COL_CENT, m_cent); }
+  const double* charge() const { return column<double>(COL_CHARGE, m_charge); }
+  const std::int32_t* cent_bin() const { return column<std::int32_t>(COL_CENT_BIN, m_cent_bin); }
+  const double* qx(size_t h_idx, size_t arm) const { return column<double>(COL_Q + 4 * h_idx + 2 * arm, m_q[h_idx][arm][0]); }
+  const double* qy(size_t h_idx, size_t arm) const { return column<double>(COL_Q + 4 * h_idx + 2 * arm + 1, m_q[h_idx][arm][1]); }
+
+ private:
+  // the int column goes last to keep the double columns aligned in the file
+  enum Column : size_t
+  {
+    COL_CENT = 0,
+    COL_CHARGE = 1,
+    COL_Q = 2,
+    COL_CENT_BIN = COL_Q + 4 * NHARMONICS,
+    COL_COUNT
+  };
+
+  struct Header
+  {
+    char magic[8]{'Q', 'V', 'E', 'C', 'A', 'C', 'H', 'E'};
+    std::uint32_t version{1};
+    std::uint32_t nharmonics{NHARMONICS};
+    std::uint64_t nevents{0};
+    std::uint64_t reserved{0};
+  };
+
+  /// byte offset of a column in the file
+  static size_t offset(size_t col, size_t nevents)
+  {
+    return sizeof(Header) + col * nevents * sizeof(double);
+  }
+
+  template <typename T>
+  const T* column(size_t col, const std::vector<T>& data) const
+  {
+    if (m_mapped)
+    {
+      return reinterpret_cast<const T*>(m_mapped + offset(col, m_nmapped));
+    }
+    return data.data();
+  }
+
+  std::vector<double> m_cent;
+  std::vector<double> m_charge;
+  std::vector<std::int32_t> m_cent_bin;
+  // [Harmonic][South/North][x/y]
+  std::array<std::array<std::array<std::vector<double>, 2>, 2>, NHARMONICS> m_q;
+
+  const char* m_mapped{nullptr};
+  size_t m_mapped_size{0};
+  size_t m_nmapped{0};
+};
+
+#endif  // SEPDEVENTPLANECALIB_QVECCACHE_H
@@ -32,9 +32,11 @@
 // ====================================================================
 // Standard C++ Includes
 // ====================================================================
+#include <atomic>
 #include <format>
 #include <numbers>
 #include <filesystem>
+#include <thread>
 
 //____________________________________________________________________________..
 QVecCalib::QVecCalib(const std::string &name):
@@ -46,6 +48,8 @@ QVecCalib::QVecCalib(const std::string &name):
 //____________________________________________________________________________..
 int QVecCalib::Init([[maybe_unused]] PHCompositeNode *topNode)
 {
+  m_start_time = std::chrono::steady_clock::now();
+
   if (Verbosity() > 1)
   {
     std::cout << "QVecCalib::Init(PHCompositeNode *topNode) Initializing" << std::endl;
@@ -73,6 +77,12 @@ int QVecCalib::Init([[maybe_unused]] PHCompositeNode *topNode)
 
   prepare_hists();
 
+  if (m_use_cache && m_pass != Pass::ComputeRecentering)
+  {
+    std::cout << PHWHERE << "Warning: the Q-vector cache is filled in the first pass only, ignored." << std::endl;
+    m_use_cache = false;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -939,6 +949,11 @@ int QVecCalib::process_event(PHCompositeNode *topNode)
 
   hCentrality->Fill(cent);
 
+  if (m_use_cache)
+  {
+    m_cache.add(cent, hCentrality->FindBin(cent) - 1, m_evtdata->get_sepd_totalcharge(), m_q_vectors);
+  }
+
   for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
   {
     const auto& q_S = m_q_vectors[h_idx][0];  // 0 for South
@@ -1048,6 +1063,32 @@ void QVecCalib::compute_recentering(size_t cent_bin, int h_idx)
   double Q_NS_yy_avg = m_profiles[NS_yy_avg_name]->GetBinContent(bin);
   double Q_NS_xy_avg = m_profiles[NS_xy_avg_name]->GetBinContent(bin);
 
+  finish_recentering(cent_bin, h_idx,
+                     {Q_S_x_corr_avg, Q_S_y_corr_avg, Q_N_x_corr_avg, Q_N_y_corr_avg,
+                      Q_S_xx_avg, Q_S_yy_avg, Q_S_xy_avg, Q_N_xx_avg, Q_N_yy_avg, Q_N_xy_avg,
+                      Q_NS_xx_avg, Q_NS_yy_avg, Q_NS_xy_avg});
+}
+
+void QVecCalib::finish_recentering(size_t cent_bin, int h_idx, const std::array<double, RECENTER_MOMENTS>& m)
+{
+  int n = m_harmonics[h_idx];
+
+  double Q_S_x_corr_avg = m[S_X_CORR];
+  double Q_S_y_corr_avg = m[S_Y_CORR];
+  double Q_N_x_corr_avg = m[N_X_CORR];
+  double Q_N_y_corr_avg = m[N_Y_CORR];
+
+  double Q_S_xx_avg = m[S_XX];
+  double Q_S_yy_avg = m[S_YY];
+  double Q_S_xy_avg = m[S_XY];
+  double Q_N_xx_avg = m[N_XX];
+  double Q_N_yy_avg = m[N_YY];
+  double Q_N_xy_avg = m[N_XY];
+
+  double Q_NS_xx_avg = m[NS_XX];
+  double Q_NS_yy_avg = m[NS_YY];
+  double Q_NS_xy_avg = m[NS_XY];
+
   m_correction_data[cent_bin][h_idx][static_cast<size_t>(QVecShared::Subdetector::NS)].X_matrix = calculate_flattening_matrix(Q_NS_xx_avg, Q_NS_yy_avg, Q_NS_xy_avg, n, cent_bin, "NS");
 
   for (size_t det_idx = 0; det_idx < 2; ++det_idx)
@@ -1061,6 +1102,15 @@ void QVecCalib::compute_recentering(size_t cent_bin, int h_idx)
     m_correction_data[cent_bin][h_idx][det_idx].X_matrix = calculate_flattening_matrix(xx, yy, xy, n, cent_bin, label);
   }
 
+  // the flattening pass loads these from the second pass output, the cached passes write them from here
+  for (size_t d = 0; d < static_cast<size_t>(QVecShared::Subdetector::Count); ++d)
+  {
+    auto& data = m_correction_data[cent_bin][h_idx][d];
+    data.avg_Q_xx = m[S_XX + 3 * d];
+    data.avg_Q_yy = m[S_YY + 3 * d];
+    data.avg_Q_xy = m[S_XY + 3 * d];
+  }
+
   std::cout << std::format(
       "Centrality Bin: {}, "
       "Harmonic: {}, "
@@ -1124,6 +1174,33 @@ void QVecCalib::print_flattening(size_t cent_bin, int n) const
   double Q_NS_yy_corr_avg = m_profiles.at(NS_yy_corr_avg_name)->GetBinContent(bin);
   double Q_NS_xy_corr_avg = m_profiles.at(NS_xy_corr_avg_name)->GetBinContent(bin);
 
+  double EP_res = m_profiles.at(std::format("hEP_res_{}", n))->GetBinContent(bin);
+
+  print_flattening_moments(cent_bin, n,
+                           {Q_S_x_corr2_avg, Q_S_y_corr2_avg, Q_N_x_corr2_avg, Q_N_y_corr2_avg,
+                            Q_S_xx_corr_avg, Q_S_yy_corr_avg, Q_S_xy_corr_avg,
+                            Q_N_xx_corr_avg, Q_N_yy_corr_avg, Q_N_xy_corr_avg,
+                            Q_NS_xx_corr_avg, Q_NS_yy_corr_avg, Q_NS_xy_corr_avg, EP_res});
+}
+
+void QVecCalib::print_flattening_moments(size_t cent_bin, int n, const std::array<double, FLATTENING_MOMENTS>& m)
+{
+  double Q_S_x_corr2_avg = m[S_X_CORR2];
+  double Q_S_y_corr2_avg = m[S_Y_CORR2];
+  double Q_N_x_corr2_avg = m[N_X_CORR2];
+  double Q_N_y_corr2_avg = m[N_Y_CORR2];
+
+  double Q_S_xx_corr_avg = m[S_XX_CORR];
+  double Q_S_yy_corr_avg = m[S_YY_CORR];
+  double Q_S_xy_corr_avg = m[S_XY_CORR];
+  double Q_N_xx_corr_avg = m[N_XX_CORR];
+  double Q_N_yy_corr_avg = m[N_YY_CORR];
+  double Q_N_xy_corr_avg = m[N_XY_CORR];
+
+  double Q_NS_xx_corr_avg = m[NS_XX_CORR];
+  double Q_NS_yy_corr_avg = m[NS_YY_CORR];
+  double Q_NS_xy_corr_avg = m[NS_XY_CORR];
+
   std::cout << std::format(
       "Centrality Bin: {}, "
       "Harmonic: {}, "
@@ -1136,7 +1213,8 @@ void QVecCalib::print_flattening(size_t cent_bin, int n) const
       "Q_NS_xx_corr_avg / Q_NS_yy_corr_avg: {:13.10f}, "
       "Q_S_xy_corr_avg: {:13.10f}, "
       "Q_N_xy_corr_avg: {:13.10f}, "
-      "Q_NS_xy_corr_avg: {:13.10f}",
+      "Q_NS_xy_corr_avg: {:13.10f}, "
+      "EP_res: {:13.10f}",
       cent_bin,
       n,
       Q_S_x_corr2_avg,
@@ -1148,7 +1226,8 @@ void QVecCalib::print_flattening(size_t cent_bin, int n) const
       Q_NS_xx_corr_avg / Q_NS_yy_corr_avg,
       Q_S_xy_corr_avg,
       Q_N_xy_corr_avg,
-      Q_NS_xy_corr_avg) << std::endl;
+      Q_NS_xy_corr_avg,
+      m[EP_RES]) << std::endl;
 }
 
 void QVecCalib::write_cdb()
@@ -1238,6 +1317,278 @@ void QVecCalib::write_cdb_EventPlane()
   cdbttree.WriteCDBTTree();
 }
 
+template <typename Kernel>
+void QVecCalib::accumulate_cached(size_t nmoments, Kernel kernel, CachedMoments& moments) const
+{
+  const size_t nevents = m_cache.size();
+  const size_t stride = m_harmonics.size() * nmoments;
+  const size_t nchunks = (nevents + CACHE_CHUNK - 1) / CACHE_CHUNK;
+  const std::int32_t* cent_bins = m_cache.cent_bin();
+
+  // [Chunk][Cent][Harmonic][Moment] sums and sums of squares, [Chunk][Cent] event counts
+  std::vector<double> sums(nchunks * m_cent_bins * stride, 0);
+  std::vector<double> sums2(nchunks * m_cent_bins * stride, 0);
+  std::vector<double> counts(nchunks * m_cent_bins, 0);
+
+  std::atomic<size_t> next_chunk{0};
+  auto worker = [&]()
+  {
+    std::vector<double> values(stride);
+    for (size_t chunk = next_chunk++; chunk < nchunks; chunk = next_chunk++)
+    {
+      double* chunk_sums = &sums[chunk * m_cent_bins * stride];
+      double* chunk_sums2 = &sums2[chunk * m_cent_bins * stride];
+      double* chunk_counts = &counts[chunk * m_cent_bins];
+      const size_t end = std::min(nevents, (chunk + 1) * CACHE_CHUNK);
+      for (size_t i = chunk * CACHE_CHUNK; i < end; ++i)
+      {
+        const std::int32_t cent_bin = cent_bins[i];
+        // the profile passes have no corrections for these either
+        if (cent_bin < 0 || cent_bin >= static_cast<std::int32_t>(m_cent_bins))
+        {
+          continue;
+        }
+        ++chunk_counts[cent_bin];
+        kernel(i, static_cast<size_t>(cent_bin), values.data());
+        double* s = chunk_sums + cent_bin * stride;
+        double* s2 = chunk_sums2 + cent_bin * stride;
+        for (size_t k = 0; k < stride; ++k)
+        {
+          s[k] += values[k];
+          s2[k] += values[k] * values[k];
+        }
+      }
+    }
+  };
+
+  const size_t nthreads = std::min<size_t>(m_nthreads, std::max<size_t>(nchunks, 1));
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nthreads; ++t)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // add up the chunks in order
+  moments.stride = stride;
+  moments.sum.assign(m_cent_bins * stride, 0);
+  moments.sum2.assign(m_cent_bins * stride, 0);
+  moments.entries.assign(m_cent_bins, 0);
+  for (size_t chunk = 0; chunk < nchunks; ++chunk)
+  {
+    for (size_t k = 0; k < m_cent_bins * stride; ++k)
+    {
+      moments.sum[k] += sums[chunk * m_cent_bins * stride + k];
+      moments.sum2[k] += sums2[chunk * m_cent_bins * stride + k];
+    }
+    for (size_t cent_bin = 0; cent_bin < m_cent_bins; ++cent_bin)
+    {
+      moments.entries[cent_bin] += counts[chunk * m_cent_bins + cent_bin];
+    }
+  }
+}
+
+template <size_t NMOMENTS>
+void QVecCalib::fill_cached_profiles(const CachedMoments& moments, const std::array<MomentName, NMOMENTS>& names)
+{
+  Fun4AllServer *se = Fun4AllServer::instance();
+
+  for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
+  {
+    int n = m_harmonics[h_idx];
+    for (size_t k = 0; k < NMOMENTS; ++k)
+    {
+      const auto& [det, var, suffix] = names[k];
+      std::string name;
+      std::string title;
+      if (det.empty())
+      {
+        name = std::format("hEP_res_{}", n);
+        title = std::format("; Centrality [%]; #LTRe(Q^{{S}}_{{{0}}} Q^{{N*}}_{{{0}}}) / (|Q^{{S}}_{{{0}}}||Q^{{N}}_{{{0}}}|)#GT", n);
+      }
+      else
+      {
+        name = QVecShared::get_hist_name(std::string(det), std::string(var), n, std::string(suffix));
+        title = std::format("sEPD {}; Centrality [%]; <Q_{{{},{}}}>", det, n, var);
+      }
+
+      // a TProfile keeps sum(y) as bin content and sum(y^2) in its Sumw2 array
+      auto* prof = new TProfile(name.c_str(), title.c_str(), m_cent_bins, m_cent_low, m_cent_high);
+      double entries = 0;
+      for (size_t cent_bin = 0; cent_bin < m_cent_bins; ++cent_bin)
+      {
+        const size_t index = (cent_bin * m_harmonics.size() + h_idx) * NMOMENTS + k;
+        const int bin = static_cast<int>(cent_bin) + 1;
+        prof->SetBinEntries(bin, moments.entries[cent_bin]);
+        prof->SetBinContent(bin, moments.sum[index]);
+        prof->GetSumw2()->fArray[bin] = moments.sum2[index];
+        entries += moments.entries[cent_bin];
+      }
+      prof->SetEntries(entries);
+
+      m_profiles[name] = prof;
+      se->registerHisto(prof);
+    }
+  }
+}
+
+void QVecCalib::run_cached_passes()
+{
+  auto start = std::chrono::steady_clock::now();
+
+  if (!m_cache_file.empty())
+  {
+    if (!m_cache.write(m_cache_file) || !m_cache.map(m_cache_file))
+    {
+      std::cout << PHWHERE << "Warning: running the cached passes from memory" << std::endl;
+    }
+  }
+
+  std::cout << "QVecCalib::run_cached_passes - " << m_cache.size() << " cached events, " << m_nthreads << " threads" << std::endl;
+
+  constexpr size_t S_idx = static_cast<size_t>(QVecShared::Subdetector::S);
+  constexpr size_t N_idx = static_cast<size_t>(QVecShared::Subdetector::N);
+  constexpr size_t NS_idx = static_cast<size_t>(QVecShared::Subdetector::NS);
+
+  std::array<const double*, m_harmonics.size()> S_x{};
+  std::array<const double*, m_harmonics.size()> S_y{};
+  std::array<const double*, m_harmonics.size()> N_x{};
+  std::array<const double*, m_harmonics.size()> N_y{};
+  for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
+  {
+    S_x[h_idx] = m_cache.qx(h_idx, 0);
+    S_y[h_idx] = m_cache.qy(h_idx, 0);
+    N_x[h_idx] = m_cache.qx(h_idx, 1);
+    N_y[h_idx] = m_cache.qy(h_idx, 1);
+  }
+
+  // --- Second Pass: Apply 1st Order, Derive 2nd Order (same as process_recentering) ---
+  CachedMoments moments;
+  accumulate_cached(RECENTER_MOMENTS, [&](size_t i, size_t cent_bin, double* values)
+  {
+    for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
+    {
+      const auto& S = m_correction_data[cent_bin][h_idx][S_idx];
+      const auto& N = m_correction_data[cent_bin][h_idx][N_idx];
+
+      QVecShared::QVec q_S_corr = {S_x[h_idx][i] - S.avg_Q.x, S_y[h_idx][i] - S.avg_Q.y};
+      QVecShared::QVec q_N_corr = {N_x[h_idx][i] - N.avg_Q.x, N_y[h_idx][i] - N.avg_Q.y};
+      QVecShared::QVec q_NS_corr = {q_S_corr.x + q_N_corr.x, q_S_corr.y + q_N_corr.y};
+
+      double* m = values + h_idx * RECENTER_MOMENTS;
+      m[S_X_CORR] = q_S_corr.x;
+      m[S_Y_CORR] = q_S_corr.y;
+      m[N_X_CORR] = q_N_corr.x;
+      m[N_Y_CORR] = q_N_corr.y;
+
+      m[S_XX] = q_S_corr.x * q_S_corr.x;
+      m[S_YY] = q_S_corr.y * q_S_corr.y;
+      m[S_XY] = q_S_corr.x * q_S_corr.y;
+      m[N_XX] = q_N_corr.x * q_N_corr.x;
+      m[N_YY] = q_N_corr.y * q_N_corr.y;
+      m[N_XY] = q_N_corr.x * q_N_corr.y;
+
+      m[NS_XX] = q_NS_corr.x * q_NS_corr.x;
+      m[NS_YY] = q_NS_corr.y * q_NS_corr.y;
+      m[NS_XY] = q_NS_corr.x * q_NS_corr.y;
+    }
+  }, moments);
+
+  for (size_t cent_bin = 0; cent_bin < m_cent_bins; ++cent_bin)
+  {
+    for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
+    {
+      std::array<double, RECENTER_MOMENTS> m{};
+      for (size_t k = 0; k < RECENTER_MOMENTS; ++k)
+      {
+        m[k] = moments.mean(cent_bin, h_idx * RECENTER_MOMENTS + k);
+      }
+      finish_recentering(cent_bin, h_idx, m);
+    }
+  }
+
+  // same profiles as prepare_recenter_hists, in RecenterMoment order
+  fill_cached_profiles<RECENTER_MOMENTS>(moments, {{{"S", "x", "_corr"}, {"S", "y", "_corr"}, {"N", "x", "_corr"}, {"N", "y", "_corr"},
+                                                    {"S", "xx", ""}, {"S", "yy", ""}, {"S", "xy", ""},
+                                                    {"N", "xx", ""}, {"N", "yy", ""}, {"N", "xy", ""},
+                                                    {"NS", "xx", ""}, {"NS", "yy", ""}, {"NS", "xy", ""}}});
+
+  // --- Third Pass: Apply 2nd Order, Validate (same as process_flattening) ---
+  accumulate_cached(FLATTENING_MOMENTS, [&](size_t i, size_t cent_bin, double* values)
+  {
+    for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
+    {
+      const auto& S = m_correction_data[cent_bin][h_idx][S_idx];
+      const auto& N = m_correction_data[cent_bin][h_idx][N_idx];
+      const auto& NS = m_correction_data[cent_bin][h_idx][NS_idx];
+
+      QVecShared::QVec q_S_corr = {S_x[h_idx][i] - S.avg_Q.x, S_y[h_idx][i] - S.avg_Q.y};
+      QVecShared::QVec q_N_corr = {N_x[h_idx][i] - N.avg_Q.x, N_y[h_idx][i] - N.avg_Q.y};
+      QVecShared::QVec q_NS_corr = {q_S_corr.x + q_N_corr.x, q_S_corr.y + q_N_corr.y};
+
+      const auto& X_S = S.X_matrix;
+      const auto& X_N = N.X_matrix;
+      const auto& X_NS = NS.X_matrix;
+
+      QVecShared::QVec q_S_corr2 = {X_S[0][0] * q_S_corr.x + X_S[0][1] * q_S_corr.y, X_S[1][0] * q_S_corr.x + X_S[1][1] * q_S_corr.y};
+      QVecShared::QVec q_N_corr2 = {X_N[0][0] * q_N_corr.x + X_N[0][1] * q_N_corr.y, X_N[1][0] * q_N_corr.x + X_N[1][1] * q_N_corr.y};
+      QVecShared::QVec q_NS_corr2 = {X_NS[0][0] * q_NS_corr.x + X_NS[0][1] * q_NS_corr.y, X_NS[1][0] * q_NS_corr.x + X_NS[1][1] * q_NS_corr.y};
+
+      double SP_QS_QN = q_S_corr2.x * q_N_corr2.x + q_S_corr2.y * q_N_corr2.y;
+      double norm_S = std::sqrt(q_S_corr2.x * q_S_corr2.x + q_S_corr2.y * q_S_corr2.y);
+      double norm_N = std::sqrt(q_N_corr2.x * q_N_corr2.x + q_N_corr2.y * q_N_corr2.y);
+
+      double* m = values + h_idx * FLATTENING_MOMENTS;
+      m[S_X_CORR2] = q_S_corr2.x;
+      m[S_Y_CORR2] = q_S_corr2.y;
+      m[N_X_CORR2] = q_N_corr2.x;
+      m[N_Y_CORR2] = q_N_corr2.y;
+
+      m[S_XX_CORR] = q_S_corr2.x * q_S_corr2.x;
+      m[S_YY_CORR] = q_S_corr2.y * q_S_corr2.y;
+      m[S_XY_CORR] = q_S_corr2.x * q_S_corr2.y;
+      m[N_XX_CORR] = q_N_corr2.x * q_N_corr2.x;
+      m[N_YY_CORR] = q_N_corr2.y * q_N_corr2.y;
+      m[N_XY_CORR] = q_N_corr2.x * q_N_corr2.y;
+
+      m[NS_XX_CORR] = q_NS_corr2.x * q_NS_corr2.x;
+      m[NS_YY_CORR] = q_NS_corr2.y * q_NS_corr2.y;
+      m[NS_XY_CORR] = q_NS_corr2.x * q_NS_corr2.y;
+
+      m[EP_RES] = (norm_S && norm_N) ? SP_QS_QN / (norm_S * norm_N) : 0;
+    }
+  }, moments);
+
+  for (size_t cent_bin = 0; cent_bin < m_cent_bins; ++cent_bin)
+  {
+    for (size_t h_idx = 0; h_idx < m_harmonics.size(); ++h_idx)
+    {
+      std::array<double, FLATTENING_MOMENTS> m{};
+      for (size_t k = 0; k < FLATTENING_MOMENTS; ++k)
+      {
+        m[k] = moments.mean(cent_bin, h_idx * FLATTENING_MOMENTS + k);
+      }
+      print_flattening_moments(cent_bin, m_harmonics[h_idx], m);
+    }
+  }
+
+  // same profiles as prepare_flattening_hists, in FlatteningMoment order
+  fill_cached_profiles<FLATTENING_MOMENTS>(moments, {{{"S", "x", "_corr2"}, {"S", "y", "_corr2"}, {"N", "x", "_corr2"}, {"N", "y", "_corr2"},
+                                                      {"S", "xx", "_corr"}, {"S", "yy", "_corr"}, {"S", "xy", "_corr"},
+                                                      {"N", "xx", "_corr"}, {"N", "yy", "_corr"}, {"N", "xy", "_corr"},
+                                                      {"NS", "xx", "_corr"}, {"NS", "yy", "_corr"}, {"NS", "xy", "_corr"},
+                                                      {"", "", ""}}});
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << std::format("QVecCalib::run_cached_passes - second and third pass: {:.3f} s", elapsed.count()) << std::endl;
+
+  write_cdb();
+}
+
 //____________________________________________________________________________..
 int QVecCalib::End(PHCompositeNode * /*topNode*/)
 {
@@ -1277,5 +1628,13 @@ int QVecCalib::End(PHCompositeNode * /*topNode*/)
     write_cdb();
   }
 
+  if (m_use_cache)
+  {
+    run_cached_passes();
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start_time;
+  std::cout << std::format("QVecCalib::End - wall time since Init: {:.3f} s", elapsed.count()) << std::endl;
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -1,12 +1,14 @@
 #ifndef SEPDEVENTPLANECALIB_QVECCALIB_H
 #define SEPDEVENTPLANECALIB_QVECCALIB_H
 
+#include "QVecCache.h"
 #include "QVecDefs.h"
 
 #include <fun4all/SubsysReco.h>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <map>
 #include <stdexcept>
 #include <string>
@@ -107,6 +109,26 @@ class QVecCalib : public SubsysReco
     m_sEPD_noise_threshold = threshold;
   }
 
+  /**
+   * @brief Runs the full calibration from a single read of the input.
+   * * Only used in the first pass: the accepted events are kept in a columnar
+   * Q-vector cache, and End() runs the re-centering and flattening passes over
+   * it and writes the CDB payload. If a file name is given the cache is also
+   * written there and the later passes read it back memory mapped.
+   * @param file Optional output file for the cache.
+   */
+  void set_qvec_cache(std::string_view file = "")
+  {
+    m_use_cache = true;
+    m_cache_file = file;
+  }
+
+  /// Number of threads for the passes over the Q-vector cache.
+  void set_num_threads(int n)
+  {
+    m_nthreads = std::max(1, n);
+  }
+
  private:
   static Pass validate_pass(int pass)
   {
@@ -164,6 +186,74 @@ class QVecCalib : public SubsysReco
 
   std::array<std::array<QVecShared::QVec, 2>, m_harmonics.size()> m_q_vectors{};
 
+  // Single-read mode
+  bool m_use_cache{false};
+  std::string m_cache_file;
+  int m_nthreads{1};
+  QVecCache m_cache;
+
+  std::chrono::steady_clock::time_point m_start_time;
+
+  // events per block of the cached passes, the blocks are summed in order so
+  // the results do not depend on the number of threads
+  static constexpr size_t CACHE_CHUNK = 1U << 16U;
+
+  // Moments of the second pass, per centrality bin and harmonic
+  enum RecenterMoment : size_t
+  {
+    S_X_CORR,
+    S_Y_CORR,
+    N_X_CORR,
+    N_Y_CORR,
+    S_XX,
+    S_YY,
+    S_XY,
+    N_XX,
+    N_YY,
+    N_XY,
+    NS_XX,
+    NS_YY,
+    NS_XY,
+    RECENTER_MOMENTS
+  };
+
+  // Moments of the third pass, per centrality bin and harmonic
+  enum FlatteningMoment : size_t
+  {
+    S_X_CORR2,
+    S_Y_CORR2,
+    N_X_CORR2,
+    N_Y_CORR2,
+    S_XX_CORR,
+    S_YY_CORR,
+    S_XY_CORR,
+    N_XX_CORR,
+    N_YY_CORR,
+    N_XY_CORR,
+    NS_XX_CORR,
+    NS_YY_CORR,
+    NS_XY_CORR,
+    EP_RES,
+    FLATTENING_MOMENTS
+  };
+
+  // Per-event moments summed over the cache, [Cent][Harmonic][Moment]
+  struct CachedMoments
+  {
+    size_t stride{0};
+    std::vector<double> sum;
+    std::vector<double> sum2;
+    std::vector<double> entries;  // [Cent]
+
+    double mean(size_t cent_bin, size_t k) const
+    {
+      return entries[cent_bin] ? sum[cent_bin * stride + k] / entries[cent_bin] : 0;
+    }
+  };
+
+  // Profile of a moment, {detector, variable, suffix} as in QVecShared::get_hist_name
+  using MomentName = std::array<std::string_view, 3>;
+
   static constexpr int PROGRESS_REPORT_INTERVAL = 10000;
 
   // Holds all correction data
@@ -367,6 +457,14 @@ class QVecCalib : public SubsysReco
    */
   void compute_recentering(size_t cent_bin, int h_idx);
 
+  /**
+   * @brief Solves the flattening matrices from the re-centered moments and logs them.
+   * @param cent_bin The centrality bin index.
+   * @param h_idx The harmonic index.
+   * @param m The second pass moments, indexed by RecenterMoment.
+   */
+  void finish_recentering(size_t cent_bin, int h_idx, const std::array<double, RECENTER_MOMENTS>& m);
+
   /**
    * @brief Logs the final corrected moments to verify successful flattening.
    * @param cent_bin The centrality bin index.
@@ -374,6 +472,42 @@ class QVecCalib : public SubsysReco
    */
   void print_flattening(size_t cent_bin, int n) const;
 
+  /**
+   * @brief Logs the third pass moments, indexed by FlatteningMoment.
+   */
+  static void print_flattening_moments(size_t cent_bin, int n, const std::array<double, FLATTENING_MOMENTS>& m);
+
+  /**
+   * @brief Runs the re-centering and flattening passes over the Q-vector cache.
+   * * Called from End() of the first pass once the averages are known, fills the
+   * correction data and writes the CDB payload. The moment profiles of the two
+   * passes are registered under the names the separate passes use. The
+   * h2_sEPD_Psi_*_corr and _corr2 event plane distributions are not produced.
+   */
+  void run_cached_passes();
+
+  /**
+   * @brief Sums per-event moments over the Q-vector cache.
+   * * The kernel writes the [Harmonic][Moment] values of event i, which are added
+   * to the sums of its centrality bin. The blocks of CACHE_CHUNK events run on
+   * m_nthreads threads.
+   * @param nmoments Moments per harmonic.
+   * @param kernel Callable (size_t i, size_t cent_bin, double* values).
+   * @param moments Output sums, sums of squares and entries.
+   */
+  template <typename Kernel>
+  void accumulate_cached(size_t nmoments, Kernel kernel, CachedMoments& moments) const;
+
+  /**
+   * @brief Creates and registers the profiles of cached moments.
+   * * The bins hold the same entries, sums and sums of squares as the profiles
+   * filled event by event in the separate passes.
+   * @param moments The sums from accumulate_cached.
+   * @param names Profile name of each moment, an empty detector for hEP_res.
+   */
+  template <size_t NMOMENTS>
+  void fill_cached_profiles(const CachedMoments& moments, const std::array<MomentName, NMOMENTS>& names);
+
   void prepare_hists();
 
   /**
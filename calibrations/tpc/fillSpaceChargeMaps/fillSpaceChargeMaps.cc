@@ -13,6 +13,7 @@
 #include <phool/getClass.h>
 #include <phool/sphenix_constants.h>
 
+#include <TArrayD.h>
 #include <TAxis.h>  // for TAxis
 #include <TFile.h>
 #include <TH1.h>
@@ -22,6 +23,7 @@
 #include <TVector3.h>
 
 #include <algorithm>  // for max
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <format>
@@ -33,6 +35,15 @@
 #include <utility>  // for pair
 #include <vector>
 
+namespace
+{
+  // same bin as TAxis::FindFixBin for variable bins, 0 and n+1 are under- and overflow
+  int findDenseBin(const std::vector<double> &edges, double x)
+  {
+    return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+  }
+}  // namespace
+
 //____________________________________________________________________________..
 fillSpaceChargeMaps::fillSpaceChargeMaps(const std::string &name, const std::string &filename)
   : SubsysReco(name)
@@ -216,6 +227,7 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
   // double tpc_frame_r1_outer = 402.49*mm;  //402.6;//mm inner edge of larger-r frame of r3
   // double tpc_frame_r1_inner = 217.83*mm;  //221.0;//mm outer edge of smaller-r frame of r3
 
+  const auto t_start = std::chrono::steady_clock::now();
   double z_bias_avg = 0;
   int bemxingsInFile = _keys.size();
   int key = -1;
@@ -243,6 +255,10 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
   int n_hits = 0;
   if (hits)
   {
+    if (_fDense == 1)
+    {
+      setDenseFrames(z_bias_avg);
+    }
     PHG4HitContainer::ConstRange hit_range = hits->getHits();
     for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; hit_iter++)
     {
@@ -339,6 +355,14 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
       {
         _rawHits->Fill();
       }
+      if (_fDense == 1)
+      {
+        if (addDenseHit(new_r, new_phi, dr_bin, dphi_bin, N_electrons))
+        {
+          n_hits++;
+        }
+        continue;
+      }
       double z_prim[30] = {-1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
                            -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
                            -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10};
@@ -453,6 +477,10 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
         _h_R->Fill(_hit_r);
       }
     }
+    if (_fDense == 1)
+    {
+      fillDenseFrames();
+    }
   }
   else
   {
@@ -463,6 +491,9 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
   }
   _h_hits->Fill(n_hits);
 
+  _processTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+  _nEvents++;
+  _nHitsTotal += n_hits;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -470,6 +501,25 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
 int fillSpaceChargeMaps::End(PHCompositeNode * /*topNode*/)
 {
   std::cout << "fillSpaceChargeMaps::End" << std::endl;
+  if (_processTime > 0)
+  {
+    std::cout << "fillSpaceChargeMaps::End - " << _nEvents << " events, " << _nHitsTotal << " hits in "
+              << _processTime << " s: " << _nEvents / _processTime << " events/s, "
+              << _nHitsTotal / _processTime << " hits/s"
+              << (_fDense == 1 ? std::format(" (dense accumulation, {} threads)", _nDenseThreads) : std::string())
+              << std::endl;
+  }
+  if (_fDense == 1)
+  {
+    // the bins were filled directly, bring statistics and entries up to date
+    for (int iz = 0; iz < nFrames; iz++)
+    {
+      _h_SC_prim[iz]->ResetStats();
+      _h_SC_prim[iz]->SetEntries(_dense_entries[2 * iz]);
+      _h_SC_ibf[iz]->ResetStats();
+      _h_SC_ibf[iz]->SetEntries(_dense_entries[2 * iz + 1]);
+    }
+  }
   if (_fSliming == 1)
   {
     outfile->cd();
@@ -562,6 +612,203 @@ void fillSpaceChargeMaps::UseFieldMaps(int shiftElectrons)
   std::cout << "Use Field-Maps is set to: " << s_shiftElectrons[_shiftElectrons] << std::endl;
 }
 
+void fillSpaceChargeMaps::UseDenseAccumulation(int fDense, int nThreads)
+{
+  _fDense = fDense;
+  _nDenseThreads = std::max(1, nThreads);
+  static const std::string s_dense[2] = {"OFF", "ON"};
+  std::cout << "Dense accumulation is set to: " << s_dense[_fDense] << " with " << _nDenseThreads << " threads" << std::endl;
+}
+
+void fillSpaceChargeMaps::setDenseFrames(double z_bias_avg)
+{
+  if (_dense_zedges.empty())
+  {
+    const TArrayD *edges = _h_SC_prim[0]->GetZaxis()->GetXbins();
+    _dense_zedges.assign(edges->GetArray(), edges->GetArray() + edges->GetSize());
+  }
+  // the shift of a frame is the same for all hits of the event, the ibf
+  // charge of a frame sits at the same z for every hit of a side
+  _dense_first_ibf = nFrames;
+  for (int iz = 0; iz < nFrames; iz++)
+  {
+    double bX = _beamxing[iz];
+    _dense_active[iz] = (_event_bunchXing <= bX);
+    _dense_ibf[iz] = false;
+    if (!_dense_active[iz])
+    {
+      continue;
+    }
+    if (_fAvg == 1)
+    {
+      _dense_shift[iz] = z_bias_avg;
+    }
+    else
+    {
+      _dense_shift[iz] = (bX - _event_bunchXing) * sphenix_constants::time_between_crossings * vIon * ns;
+    }
+    double z_ibf = 1.055 * m - _dense_shift[iz];
+    _dense_ibf[iz] = (z_ibf > 0 && z_ibf < 1.055 * m);
+    _dense_ibf_zbin[0][iz] = findDenseBin(_dense_zedges, z_ibf);
+    _dense_ibf_zbin[1][iz] = findDenseBin(_dense_zedges, -z_ibf);
+    if (_dense_ibf[iz] && _dense_first_ibf == nFrames)
+    {
+      _dense_first_ibf = iz;
+    }
+  }
+}
+
+bool fillSpaceChargeMaps::addDenseHit(double new_r, double new_phi, double dr_bin, double dphi_bin, float N_electrons)
+{
+  float sign = 0;
+  if (_hit_z >= 5 * mm && _hit_z < 1.055 * m)
+  {
+    sign = 1;
+  }
+  else if (_hit_z < -5 * mm && _hit_z > -1.055 * m)
+  {
+    sign = -1;
+  }
+  else
+  {
+    return false;
+  }
+  _h_DC_E->Fill(_ibf_vol, _hit_eion * 1e6);
+
+  const TH3 *h = _h_SC_prim[0];
+  const int nx = h->GetNbinsX() + 2;
+  auto xyBin = [h, nx](double phi, double r)
+  { return h->GetXaxis()->FindFixBin(phi) + nx * h->GetYaxis()->FindFixBin(r); };
+
+  const bool fill_first = _dense_active[0] && _dense_ibf[0];
+  int prim_bin = xyBin(_hit_phi, _hit_r);
+  int prim_bin_moved = prim_bin;
+  int ibf_bin = 0;
+  float w_ibf = _ibf_vol;
+  float r_first = _hit_r;
+  if (!_isOnPlane)
+  {
+    // Redistribute charges, from the first ibf frame on the primary charge
+    // of the later frames is filled at the moved position as well
+    std::vector<double> newWeights = getNewWeights(_h_SC_ibf[0], _h_modules_anode, _h_modules_measuredibf, new_r, new_phi, dr_bin, dphi_bin, _fUseIBFMap);
+    float r_moved = newWeights[2];
+    float phi_moved = newWeights[3];
+    w_ibf = N_electrons * newWeights[1] * _ampGain * newWeights[0] * _ampIBFfrac;
+    ibf_bin = xyBin(phi_moved, r_moved);
+    prim_bin_moved = ibf_bin;
+    r_first = r_moved;
+    if (fill_first)
+    {
+      _h_SC_XY->Fill(r_moved * std::cos(phi_moved), r_moved * std::sin(phi_moved));
+    }
+  }
+  else
+  {
+    ibf_bin = xyBin(new_phi, new_r);
+    if (fill_first)
+    {
+      _h_SC_XY->Fill(new_r * cos(new_phi), new_r * sin(new_phi));
+    }
+  }
+  if (fill_first)
+  {
+    _h_R->Fill(r_first);
+  }
+
+  _dense_z.push_back(_hit_z);
+  _dense_sign.push_back(sign);
+  _dense_w_prim.push_back(_hit_eion * Tpc_ElectronsPerGeV);
+  _dense_w_ibf.push_back(w_ibf);
+  _dense_prim_bin.push_back(prim_bin);
+  _dense_prim_bin_moved.push_back(prim_bin_moved);
+  _dense_ibf_bin.push_back(ibf_bin);
+  return true;
+}
+
+void fillSpaceChargeMaps::fillDenseFrames()
+{
+  const size_t n = _dense_z.size();
+  if (n > 0)
+  {
+    const int nxy = (_h_SC_prim[0]->GetNbinsX() + 2) * (_h_SC_prim[0]->GetNbinsY() + 2);
+    const double z_max = 1.055 * m;
+    for (int iz = 0; iz < nFrames; iz++)
+    {
+      // TH3::Fill books the errors with the first weighted entry
+      if (!_h_SC_prim[iz]->GetSumw2N())
+      {
+        _h_SC_prim[iz]->Sumw2();
+      }
+      if (!_h_SC_ibf[iz]->GetSumw2N())
+      {
+        _h_SC_ibf[iz]->Sumw2();
+      }
+    }
+
+    // every task owns one map, the hits go in in the same order as with TH3::Fill
+#pragma omp parallel for schedule(dynamic) num_threads(_nDenseThreads)
+    for (int task = 0; task < 2 * nFrames; task++)
+    {
+      const int iz = task / 2;
+      if (!_dense_active[iz])
+      {
+        continue;
+      }
+      long long entries = 0;
+      if (task % 2 == 0)
+      {
+        TH3 *h = _h_SC_prim[iz];
+        double *sumw2 = h->GetSumw2()->GetArray();
+        const double shift = _dense_shift[iz];
+        const std::vector<int> &bins = (iz > _dense_first_ibf) ? _dense_prim_bin_moved : _dense_prim_bin;
+
+        // z replication of the frame, branch free so the compiler can vectorize it
+        std::vector<double> z(n);
+        for (size_t i = 0; i < n; i++)
+        {
+          z[i] = _dense_z[i] - _dense_sign[i] * shift;
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+          const double z_side = _dense_sign[i] * z[i];
+          if (z_side > 0 && z_side < z_max)
+          {
+            const int bin = bins[i] + nxy * findDenseBin(_dense_zedges, z[i]);
+            const double w = _dense_w_prim[i];
+            h->AddBinContent(bin, w);
+            sumw2[bin] += w * w;
+            entries++;
+          }
+        }
+      }
+      else if (_dense_ibf[iz])
+      {
+        TH3 *h = _h_SC_ibf[iz];
+        double *sumw2 = h->GetSumw2()->GetArray();
+        const int zbin_pos = nxy * _dense_ibf_zbin[0][iz];
+        const int zbin_neg = nxy * _dense_ibf_zbin[1][iz];
+        for (size_t i = 0; i < n; i++)
+        {
+          const int bin = _dense_ibf_bin[i] + (_dense_sign[i] > 0 ? zbin_pos : zbin_neg);
+          const double w = _dense_w_ibf[i];
+          h->AddBinContent(bin, w);
+          sumw2[bin] += w * w;
+        }
+        entries = n;
+      }
+      _dense_entries[task] += entries;
+    }
+  }
+
+  _dense_z.clear();
+  _dense_sign.clear();
+  _dense_w_prim.clear();
+  _dense_w_ibf.clear();
+  _dense_prim_bin.clear();
+  _dense_prim_bin_moved.clear();
+  _dense_ibf_bin.clear();
+}
+
 std::vector<double> fillSpaceChargeMaps::getNewWeights(TH3 *h_SC_ibf, TH2 *h_modules_anode, TH2 *h_modules_measuredibf, double hit_r, double hit_phi, double dr_bin, double dphi_bin, bool fUseIBFMap)
 {
   double w_ibf_tmp = 1.0;
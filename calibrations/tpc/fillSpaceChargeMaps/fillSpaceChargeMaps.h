@@ -59,11 +59,17 @@ class fillSpaceChargeMaps : public SubsysReco
   void SetAvg(int fAvg = 0);
   void UseSliming(int fSliming = 0);
   void UseFieldMaps(int shiftElectrons = 0);
+  // Fill the z-shifted copies of an event straight into the bin arrays of the
+  // maps, one frame per thread. The bin contents are the same as with TH3::Fill.
+  void UseDenseAccumulation(int fDense = 1, int nThreads = 1);
 
  private:
   std::vector<double> getNewWeights(TH3 *_h_SC_ibf, TH2 *_h_modules_anode, TH2 *_h_modules_measuredibf, double _hit_r, double _hit_phi, double dr_bin, double dphi_bin, bool _fUseIBFMap);
   bool IsOverFrame(double r, double phi);
   std::vector<double> putOnPlane(double r, double phi);
+  void setDenseFrames(double z_bias_avg);
+  bool addDenseHit(double new_r, double new_phi, double dr_bin, double dphi_bin, float N_electrons);
+  void fillDenseFrames();
 
   Fun4AllHistoManager *hm = nullptr;
   std::string _filename;
@@ -106,6 +112,30 @@ class fillSpaceChargeMaps : public SubsysReco
   TH3 *_h_SC_prim[nFrames] = {nullptr};
   TH3 *_h_SC_ibf[nFrames] = {nullptr};
 
+  // dense accumulation: hits of the current event which are inside the z ranges
+  int _fDense = 0;
+  int _nDenseThreads = 1;
+  std::vector<float> _dense_z;
+  std::vector<float> _dense_sign;
+  std::vector<double> _dense_w_prim;
+  std::vector<float> _dense_w_ibf;
+  std::vector<int> _dense_prim_bin;        // phi-r bin of the primary charge
+  std::vector<int> _dense_prim_bin_moved;  // same after the charge over a frame has been moved
+  std::vector<int> _dense_ibf_bin;
+  // frame parameters of the current event
+  bool _dense_active[nFrames] = {false};
+  bool _dense_ibf[nFrames] = {false};
+  double _dense_shift[nFrames] = {0};
+  int _dense_ibf_zbin[2][nFrames] = {{0}};
+  int _dense_first_ibf = nFrames;
+  std::vector<double> _dense_zedges;
+  long long _dense_entries[2 * nFrames] = {0};
+
+  // throughput
+  double _processTime = 0;
+  long long _nEvents = 0;
+  long long _nHitsTotal = 0;
+
   // PHG4TpcPadPlaneReadout *padplane = nullptr;
   // PHG4TpcCylinderGeomContainer *seggeo = nullptr;
 
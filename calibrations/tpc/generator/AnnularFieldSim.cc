@@ -2,6 +2,7 @@
 
 #include "AnalyticFieldModel.h"
 #include "ChargeMapReader.h"
+#include "CompactFieldArray.h"
 #include "MultiArray.h"  //for TH3 alternative
 #include "Rossegger.h"
 
@@ -17,12 +18,20 @@
 #include <TVector3.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>  // for assert
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <format>
 #include <iostream>
+#include <memory>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define ALMOST_ZERO 0.00001
 
@@ -1582,6 +1591,13 @@ void AnnularFieldSim::populate_fieldmap()
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements * nr * nphi * nz) << std::endl;
 
+  // the per-cell debug printout counts calls, which does not survive threading
+  if (lookupCase == PhiSlice && debug_printActionEveryN <= 0)
+  {
+    populate_phislice_fieldmap(percent);
+    return;
+  }
+
   int el = 0;
 
   TVector3 localF;  // holder for the summed field at the current position.
@@ -1993,63 +2009,267 @@ void AnnularFieldSim::populate_phislice_lookup()
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  if (green != nullptr)
   {
-    for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+    // calc_unit_field only asks the Green's functions for cell centers, so their radial and z parts can be tabulated once:
+    std::vector<double> radii;
+    std::vector<double> zs;
+    for (int ir = 0; ir < nr; ir++)
+    {
+      radii.push_back(GetCellCenter(ir, 0, 0).Perp());
+    }
+    for (int iz = 0; iz < nz; iz++)
+    {
+      zs.push_back(GetCellCenter(0, 0, iz).Z() + green_shift);
+    }
+    green->TabulateGrid(radii, zs);
+    if (!green->CheckTabulation())
     {
-      at = GetCellCenter(ifr, 0, ifz);
-      for (int ior = 0; ior < nr; ior++)
+      std::cout << "populate_phislice_lookup: tabulated Green's functions disagree with the series.  Using the series." << std::endl;
+      green->ClearTabulation();
+    }
+  }
+
+  // each (ifr,ifz) target slice is independent, so the slices are spread over threads.
+  int nthreads = nThreads;
+#ifdef _OPENMP
+  if (nthreads <= 0)
+  {
+    nthreads = omp_get_max_threads();
+  }
+#endif
+  const int nslices = nr_roi * nz_roi;
+  const unsigned long long slice_elements = static_cast<unsigned long long>(nr) * nphi * nz;
+  std::atomic<unsigned long long> el{0};
+  auto t0 = std::chrono::steady_clock::now();
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int islice = 0; islice < nslices; islice++)
+  {
+    const int ifr = rmin_roi + islice / nz_roi;
+    const int ifz = zmin_roi + islice % nz_roi;
+    TVector3 at = GetCellCenter(ifr, 0, ifz);
+    for (int ior = 0; ior < nr; ior++)
+    {
+      for (int iophi = 0; iophi < nphi; iophi++)
       {
-        for (int iophi = 0; iophi < nphi; iophi++)
+        for (int ioz = 0; ioz < nz; ioz++)
         {
-          for (int ioz = 0; ioz < nz; ioz++)
+          if (ifr == ior && 0 == iophi && ifz == ioz)
           {
-            el++;
-            from = GetCellCenter(ior, iophi, ioz);
-            //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-            // print_need_cout("calc_unit_field...\n");
-            if (ifr == ior && 0 == iophi && ifz == ioz)
-            {
-              if (!(el % percent))
-              {
-                std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
+            set_phislice_entry(ifr, ifz, ior, iophi, ioz, zero);
+          }
+          else
+          {
+            set_phislice_entry(ifr, ifz, ior, iophi, ioz, calc_unit_field(at, GetCellCenter(ior, iophi, ioz)));  // the origin phi is relative to zero anyway.
+          }
+        }
+      }
+    }
+    // report once per slice that crosses a debug_npercent boundary:
+    unsigned long long done = (el += slice_elements);
+    if (percent > 0 && (done / percent) != ((done - slice_elements) / percent))
+    {
+      TVector3 unitf = get_phislice_entry(ifr, ifz, 0, 0, 0);
+#pragma omp critical(phislice_progress)
+      std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * done / percent)
+                << std::format("calc_unit_field (ir=0, iphi=0, iz=0) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
+                               ifr, ifz, unitf.X(), unitf.Y(), unitf.Z())
+                << std::endl;
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+  std::cout << std::format("populate_phislice_lookup: built {} slices in {:.1f} s with {} thread(s)",
+                           nslices, elapsed.count(), nthreads)
+            << std::endl;
+  return;
+}
 
-                std::cout << std::format("self-to-self is zero (ir={}, iphi={}, iz={}) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
-                                         ior, iophi, ioz, ifr, ifz, zero.X(), zero.Y(), zero.Z())
-                          << std::endl;
-              }
-              Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, zero);
-            }
-            else
-            {
-              TVector3 unitf = calc_unit_field(at, from);
-              if (true)
-              {
-                if (!(el % percent))
-                {
-                  std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
+void AnnularFieldSim::populate_phislice_fieldmap(unsigned long long percent)
+{
+  // parallel form of the populate_fieldmap loop for the phislice lookup.  Each roi cell is summed independently.
+  // With the compact lookup the charge is copied into a flat float array once, so that the sum over z for a given (r,phi) source column
+  // is a dot product of contiguous arrays, and the rotation into the target phi is applied once to the total rather than to every term.
+  int nthreads = nThreads;
+#ifdef _OPENMP
+  if (nthreads <= 0)
+  {
+    nthreads = omp_get_max_threads();
+  }
+#endif
+  std::vector<float> charge;
+  if (compactLookup)
+  {
+    charge.resize(static_cast<std::size_t>(nr) * nphi * nz);
+    for (int ir = 0; ir < nr; ir++)
+    {
+      for (int iphi = 0; iphi < nphi; iphi++)
+      {
+        for (int iz = 0; iz < nz; iz++)
+        {
+          charge[(static_cast<std::size_t>(ir) * nphi + iphi) * nz + iz] = q->GetChargeInBin(ir, iphi, iz);
+        }
+      }
+    }
+  }
 
-                  std::cout << std::format("calc_unit_field (ir={}, iphi={}, iz={}) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
-                                           ior, iophi, ioz, ifr, ifz, unitf.X(), unitf.Y(), unitf.Z())
-                            << std::endl;
-                }
-              }
+  const int ncells = nr_roi * nphi_roi * nz_roi;
+  std::atomic<unsigned long long> el{0};
+  auto t0 = std::chrono::steady_clock::now();
 
-              Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, unitf);  // the origin phi is relative to zero anyway.
-            }
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nthreads)
+  for (int icell = 0; icell < ncells; icell++)
+  {
+    const int r = rmin_roi + icell / (nphi_roi * nz_roi);
+    const int phi = phimin_roi + (icell / nz_roi) % nphi_roi;
+    const int z = zmin_roi + icell % nz_roi;
+    TVector3 localF;
+    if (compactLookup)
+    {
+      const float *ex = Epartial_phislice_compact->X();
+      const float *ey = Epartial_phislice_compact->Y();
+      const float *ez = Epartial_phislice_compact->Z();
+      const long int slice = Epartial_phislice_compact->Index(r - rmin_roi, 0, z - zmin_roi, 0, 0, 0);
+      double sx = 0;
+      double sy = 0;
+      double sz = 0;
+      for (int ir = 0; ir < nr; ir++)
+      {
+        for (int iphi = 0; iphi < nphi; iphi++)
+        {
+          const long int row = slice + (static_cast<long int>(ir) * nphi + FilterPhiIndex(iphi - phi)) * nz;
+          const float *qrow = &charge[(static_cast<std::size_t>(ir) * nphi + iphi) * nz];
+#pragma omp simd reduction(+ : sx, sy, sz)
+          for (int iz = 0; iz < nz; iz++)
+          {
+            sx += ex[row + iz] * qrow[iz];
+            sy += ey[row + iz] * qrow[iz];
+            sz += ez[row + iz] * qrow[iz];
           }
         }
       }
+      // dont' count the self-to-self field (stored as zero, but removed explicitly in case a loaded table disagrees):
+      const long int self = slice + static_cast<long int>(r) * nphi * nz + z;
+      const float qself = charge[(static_cast<std::size_t>(r) * nphi + phi) * nz + z];
+      localF.SetXYZ(sx - ex[self] * qself, sy - ey[self] * qself, sz - ez[self] * qself);
+      TVector3 pos = GetRoiCellCenter(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
+      TVector3 slicepos = GetRoiCellCenter(r - rmin_roi, 0, z - zmin_roi);
+      localF.RotateZ(pos.Phi() - slicepos.Phi());
+    }
+    else
+    {
+      localF = sum_phislice_field_at(r, phi, z);
+    }
+    localF += Eexternal->Get(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
+    Efield->Set(r - rmin_roi, phi - phimin_roi, z - zmin_roi, localF);  // sets in roi coordinates.
+
+    unsigned long long done = el++;
+    if (percent > 0 && !(done % percent))
+    {
+#pragma omp critical(fieldmap_progress)
+      std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * done / percent)
+                << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", r, phi, z, localF.X(), localF.Y(), localF.Z())
+                << std::endl;
     }
   }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+  std::cout << std::format("populate_fieldmap: summed {} cells in {:.1f} s with {} thread(s){}",
+                           ncells, elapsed.count(), nthreads, compactLookup ? " (compact lookup)" : "")
+            << std::endl;
   return;
 }
 
+TVector3 AnnularFieldSim::get_phislice_entry(int ifr, int ifz, int ior, int iophi, int ioz)
+{
+  if (compactLookup)
+  {
+    return Epartial_phislice_compact->Get(Epartial_phislice_compact->Index(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz));
+  }
+  return Epartial_phislice->Get(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz);
+}
+
+void AnnularFieldSim::set_phislice_entry(int ifr, int ifz, int ior, int iophi, int ioz, const TVector3 &val)
+{
+  if (compactLookup)
+  {
+    Epartial_phislice_compact->Set(Epartial_phislice_compact->Index(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz), val);
+    return;
+  }
+  Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, val);
+  return;
+}
+
+void AnnularFieldSim::set_compact_lookup(bool compact)
+{
+  if (lookupCase != PhiSlice)
+  {
+    std::cout << "AnnularFieldSim::set_compact_lookup: only the PhiSlice lookup has a compact form.  Ignoring." << std::endl;
+    return;
+  }
+  if (compact == compactLookup)
+  {
+    return;
+  }
+  // the previous table is dropped, so this needs to happen before the lookup is populated or loaded.
+  delete Epartial_phislice;
+  if (compact)
+  {
+    Epartial_phislice = new MultiArray<TVector3>(1);
+    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice_compact = std::make_shared<CompactFieldArray>(nr_roi, 1, nz_roi, nr, nphi, nz);
+    std::cout << std::format("AnnularFieldSim::set_compact_lookup: phislice lookup uses {:.1f} MB instead of {:.1f} MB",
+                             Epartial_phislice_compact->Bytes() / 1e6, Epartial_phislice_compact->Length() * sizeof(TVector3) / 1e6)
+              << std::endl;
+  }
+  else
+  {
+    Epartial_phislice_compact.reset();
+    Epartial_phislice = new MultiArray<TVector3>(nr_roi, 1, nz_roi, nr, nphi, nz);
+    for (int i = 0; i < Epartial_phislice->Length(); i++)
+    {
+      Epartial_phislice->GetFlat(i)->SetXYZ(0, 0, 0);
+    }
+  }
+  compactLookup = compact;
+  return;
+}
+
+std::vector<double> AnnularFieldSim::phislice_binary_params()
+{
+  // same quantities the ROOT lookup file checks in its info tree
+  return {rmin, rmax, zmin, zmax,
+          static_cast<double>(rmin_roi), static_cast<double>(rmax_roi),
+          static_cast<double>(zmin_roi), static_cast<double>(zmax_roi),
+          static_cast<double>(nr), static_cast<double>(nphi), static_cast<double>(nz)};
+}
+
+bool AnnularFieldSim::load_phislice_lookup_binary(const std::string &sourcefile)
+{
+  // the binary file holds the table in internal units, exactly as it is kept in memory.
+  std::cout << std::format("loading binary phislice lookup for ({}x{}x{})x({}x{}x{}) grid from {}",
+                           nr_roi, 1, nz_roi, nr, nphi, nz, sourcefile)
+            << std::endl;
+  set_compact_lookup(true);
+  if (!compactLookup)
+  {
+    return false;
+  }
+  return Epartial_phislice_compact->Load(sourcefile, phislice_binary_params());
+}
+
+bool AnnularFieldSim::save_phislice_lookup_binary(const std::string &destfile)
+{
+  if (!compactLookup)
+  {
+    std::cout << "AnnularFieldSim::save_phislice_lookup_binary: the binary format needs set_compact_lookup(true).  Not saving." << std::endl;
+    return false;
+  }
+  std::cout << std::format("saving binary phislice lookup for ({}x{}x{})x({}x{}x{}) grid to {}", nr_roi, 1, nz_roi, nr, nphi, nz, destfile) << std::endl;
+  return Epartial_phislice_compact->Save(destfile, phislice_binary_params());
+}
+
 void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
 {
   std::cout << std::format("loading phislice lookup for ({}x{}x{})x({}x{}x{}) grid from {}",
@@ -2141,7 +2361,7 @@ void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
     el++;
     tLookup->GetEntry(i);
     // print_need_cout("loading i=%d\n",i);
-    Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, (*unitf) * (-1.0) * (V / (cm * C)));  // load assuming field has units V/(C*cm), which is how we save it.
+    set_phislice_entry(ifr, ifz, ior, iophi, ioz, (*unitf) * (-1.0) * (V / (cm * C)));  // load assuming field has units V/(C*cm), which is how we save it.
     // note that we save the gradient terms, not the field, hence we need to multiply by (-1.0)
     if (!(el % percent))
     {
@@ -2216,7 +2436,7 @@ void AnnularFieldSim::save_phislice_lookup(const std::string &destfile)
           for (ioz = 0; ioz < nz; ioz++)
           {
             el++;
-            unitf = Epartial_phislice->Get(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz) * (-1 / (V / (C * cm)));  // save in units of V/(C*cm) note that we introduce a -1 here for legcy reasons.
+            unitf = get_phislice_entry(ifr, ifz, ior, iophi, ioz) * (-1 / (V / (C * cm)));  // save in units of V/(C*cm) note that we introduce a -1 here for legcy reasons.
             if (true)
             {
               if (!(el % percent))
@@ -2711,7 +2931,7 @@ TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
           continue;  // dont' compute self-to-self field.
         }
         phirel = FilterPhiIndex(iphi - phi);
-        unitField = Epartial_phislice->Get(r - rmin_roi, 0, z - zmin_roi, ir, phirel, iz);
+        unitField = get_phislice_entry(r, z, ir, phirel, iz);
         unitField.RotateZ(rotphi);  // previously was rotate by the step.Phi()*phi.    //annoying that I can't rename this to 'rotated field' here without unnecessary overhead.
 
         sum += unitField * q->GetChargeInBin(ir, iphi, iz);
@@ -4,10 +4,13 @@
 
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 class AnalyticFieldModel;
 class ChargeMapReader;
+class CompactFieldArray;
 class TH2;
 class TH3;
 class TTree;
@@ -166,6 +169,8 @@ class AnnularFieldSim
   void borrow_epartial_from(AnnularFieldSim *sim, float zshift)
   {
     Epartial_phislice = sim->Epartial_phislice;
+    Epartial_phislice_compact = sim->Epartial_phislice_compact;
+    compactLookup = sim->compactLookup;
     green_shift = zshift;
     printf("AnnularFieldSim::borrow_epartial_from:  borrowed Epartial_phislice table with zshift %f\n", zshift);
     return;
@@ -202,6 +207,14 @@ class AnnularFieldSim
   void load_phislice_lookup(const std::string &sourcefile);
   void save_phislice_lookup(const std::string &destfile);
 
+  // store the phislice lookup as float32 x/y/z arrays instead of a MultiArray<TVector3>.  Call before populating or loading the lookup.
+  void set_compact_lookup(bool compact);
+  // number of OpenMP threads used to build the phislice lookup and to sum the fieldmap.  0 keeps the OpenMP default.
+  void set_num_threads(int n) { nThreads = n; };
+  // flat binary form of the compact lookup.  The load maps the file read-only, so jobs on one node share a single copy.
+  bool load_phislice_lookup_binary(const std::string &sourcefile);
+  bool save_phislice_lookup_binary(const std::string &destfile);
+
   Rossegger *green;   // stand-alone class to compute greens functions.
   float green_shift;  // how far to offset our position in z when querying our green's functions.
   AnnularFieldSim *twin = nullptr;
@@ -226,6 +239,12 @@ class AnnularFieldSim
   int GetPhiIndex(float pos);
   int GetZindex(float pos);
 
+  // access to the phislice lookup in global f-coordinates, whichever storage is in use
+  TVector3 get_phislice_entry(int ifr, int ifz, int ior, int iophi, int ioz);
+  void set_phislice_entry(int ifr, int ifz, int ior, int iophi, int ioz, const TVector3 &val);
+  std::vector<double> phislice_binary_params();
+  void populate_phislice_fieldmap(unsigned long long percent);
+
   void UpdateOmegaTau()
   {
     omegatau_nominal = -Bnominal * vdrift / std::abs(Enominal);
@@ -341,6 +360,9 @@ class AnnularFieldSim
   MultiArray<TVector3> *Epartial_lowres;    // electric field in each l-bin in the roi from charge in a given l-bin anywhere in the volume.
   MultiArray<TVector3> *Epartial;           // electric field for the old brute-force model.
   MultiArray<TVector3> *Epartial_phislice;  // electric field in a 2D phi-slice from the full 3D region.
+  std::shared_ptr<CompactFieldArray> Epartial_phislice_compact;  // float32 replacement for Epartial_phislice when compactLookup is set.  Shared with borrowers, so it outlives a lender that drops it.
+  bool compactLookup{false};
+  int nThreads{0};
   MultiArray<TVector3> *Eexternal;          // externally applied electric field in each f-bin in the roi
   MultiArray<TVector3> *Bfield;             // magnetic field in each f-bin in the roi
 
@@ -0,0 +1,212 @@
+#ifndef COMPACTFIELDARRAY_H
+#define COMPACTFIELDARRAY_H
+
+#include <TVector3.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class CompactFieldArray
+{
+  // float32 structure-of-arrays replacement for MultiArray<TVector3>, indexed the same way (up to six dimensions, unused ones flattened).
+  // the x, y and z components are kept in three contiguous arrays, so a loop over the innermost index streams through memory and vectorizes,
+  // and each element costs 12 bytes instead of a full TVector3.
+  // The table can be written to a flat binary file and mapped back read-only, so that several jobs share one copy in the page cache.
+ public:
+  static const int MAX_DIM = 6;
+  int dim{0};
+  int n[MAX_DIM]{0};
+  long int length{0};
+
+  CompactFieldArray(int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0)
+  {
+    const int n_[MAX_DIM] = {a, b, c, d, e, f};
+    SetDimensions(n_);
+    storage.assign(3 * length, 0);
+    px = storage.data();
+    py = px + length;
+    pz = py + length;
+  }
+  //! delete copy ctor and assignment opertor (cppcheck)
+  explicit CompactFieldArray(const CompactFieldArray &) = delete;
+  CompactFieldArray &operator=(const CompactFieldArray &) = delete;
+
+  ~CompactFieldArray()
+  {
+    Unmap();
+  }
+
+  long int Index(int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0) const
+  {
+    const int n_[MAX_DIM] = {a, b, c, d, e, f};
+    long int index = n_[0];
+    for (int i = 1; i < dim; i++)
+    {
+      index = (index * n[i]) + n_[i];
+    }
+    return index;
+  }
+
+  TVector3 Get(long int index) const
+  {
+    return TVector3(px[index], py[index], pz[index]);
+  }
+
+  void Set(long int index, const TVector3 &in)
+  {
+    assert(!mapped);  // mapped tables are read-only
+    storage[index] = in.X();
+    storage[length + index] = in.Y();
+    storage[2 * length + index] = in.Z();
+  }
+
+  const float *X() const { return px; }
+  const float *Y() const { return py; }
+  const float *Z() const { return pz; }
+
+  long int Length() const { return length; }
+  std::size_t Bytes() const { return 3 * length * sizeof(float); }
+  bool IsMapped() const { return mapped != nullptr; }
+
+  // file layout: Header, the caller's parameters (doubles, used to check that the table matches its grid), then x, y and z arrays.
+  bool Save(const std::string &filename, const std::vector<double> &params) const
+  {
+    Header header;
+    std::memcpy(header.magic, file_magic, sizeof(header.magic));
+    header.version = file_version;
+    header.nparams = params.size();
+    for (int i = 0; i < MAX_DIM; i++)
+    {
+      header.n[i] = n[i];
+    }
+    header.length = length;
+    std::ofstream out(filename, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(params.data()), params.size() * sizeof(double));
+    const long int padding = DataOffset(params.size()) - sizeof(header) - params.size() * sizeof(double);
+    const char zeros[data_alignment] = {0};
+    out.write(zeros, padding);
+    out.write(reinterpret_cast<const char *>(px), length * sizeof(float));
+    out.write(reinterpret_cast<const char *>(py), length * sizeof(float));
+    out.write(reinterpret_cast<const char *>(pz), length * sizeof(float));
+    return out.good();
+  }
+
+  // maps the file read-only.  Fails if the file is not a table of this version, its dimensions differ or its parameters differ from params.
+  bool Load(const std::string &filename, const std::vector<double> &params)
+  {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      std::cout << std::format("CompactFieldArray::Load: cannot open {}", filename) << std::endl;
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+      close(fd);
+      return false;
+    }
+    void *base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping stays valid
+    if (base == MAP_FAILED)
+    {
+      std::cout << std::format("CompactFieldArray::Load: cannot map {}", filename) << std::endl;
+      return false;
+    }
+    const Header *header = static_cast<const Header *>(base);
+    const double *fileparams = reinterpret_cast<const double *>(header + 1);
+    bool ok = std::memcmp(header->magic, file_magic, sizeof(header->magic)) == 0 && header->version == file_version && header->length == length && header->nparams == static_cast<int64_t>(params.size()) && st.st_size == static_cast<off_t>(DataOffset(params.size()) + 3 * length * sizeof(float));
+    for (int i = 0; ok && i < MAX_DIM; i++)
+    {
+      ok = (header->n[i] == n[i]);
+    }
+    for (std::size_t i = 0; ok && i < params.size(); i++)
+    {
+      ok = (fileparams[i] == params[i]);
+    }
+    if (!ok)
+    {
+      std::cout << std::format("CompactFieldArray::Load: {} does not match the requested table", filename) << std::endl;
+      munmap(base, st.st_size);
+      return false;
+    }
+    Unmap();
+    std::vector<float>().swap(storage);
+    mapped = base;
+    mapped_size = st.st_size;
+    px = reinterpret_cast<const float *>(static_cast<const char *>(base) + DataOffset(params.size()));
+    py = px + length;
+    pz = py + length;
+    return true;
+  }
+
+ private:
+  struct Header
+  {
+    char magic[8];
+    int64_t version;
+    int64_t nparams;
+    int64_t length;
+    int64_t n[MAX_DIM];
+  };
+  static constexpr char file_magic[8] = {'A', 'F', 'S', 'C', 'F', 'A', '\0', '\0'};
+  static constexpr int64_t file_version = 1;
+  static constexpr long int data_alignment = 64;
+
+  static long int DataOffset(std::size_t nparams)
+  {
+    const long int end = sizeof(Header) + nparams * sizeof(double);
+    return (end + data_alignment - 1) / data_alignment * data_alignment;
+  }
+
+  void SetDimensions(const int *n_)
+  {
+    length = 1;
+    dim = MAX_DIM;
+    for (int i = 0; i < MAX_DIM; i++)
+    {
+      n[i] = 0;
+    }
+    for (int i = 0; i < MAX_DIM; i++)
+    {
+      if (n_[i] < 1)
+      {
+        dim = i;
+        break;
+      }
+      n[i] = n_[i];
+      length *= n[i];
+    }
+  }
+
+  void Unmap()
+  {
+    if (mapped)
+    {
+      munmap(mapped, mapped_size);
+      mapped = nullptr;
+      mapped_size = 0;
+    }
+  }
+
+  std::vector<float> storage;  // owned components, empty when mapped
+  void *mapped{nullptr};
+  std::size_t mapped_size{0};
+  // x, y, z component arrays, pointing into storage or into the mapping
+  const float *px{nullptr};
+  const float *py{nullptr};
+  const float *pz{nullptr};
+};
+#endif  // COMPACTFIELDARRAY_H
@@ -7,13 +7,16 @@
 #include <boost/math/special_functions.hpp>  //covers all the special functions.
 
 #include <algorithm>  // for max
+#include <chrono>
 #include <cmath>
 #include <cstdlib>  // for exit, abs
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // the limu and kimu terms, that i need to think about a little while longer...
 extern "C"
@@ -21,6 +24,11 @@ extern "C"
   void dkia_(int *IFAC, double *X, double *A, double *DKI, double *DKID, int *IERRO);
   void dlia_(int *IFAC, double *X, double *A, double *DLI, double *DLID, int *IERRO);
 }
+// the fortran routines keep SAVEd state, so calls into them are serialized:
+namespace
+{
+  std::mutex fortran_mutex;
+}
 //
 
 // Bessel Function J_n(x):
@@ -350,6 +358,7 @@ double Rossegger::Limu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  std::lock_guard<std::mutex> lock(fortran_mutex);
   dlia_(&IFAC, &X, &A, &DLI, &DERR, &IERRO);
   return DLI;
 }
@@ -362,6 +371,7 @@ double Rossegger::Kimu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  std::lock_guard<std::mutex> lock(fortran_mutex);
   dkia_(&IFAC, &X, &A, &DKI, &DERR, &IERRO);
   return DKI;
 }
@@ -800,6 +810,17 @@ double Rossegger::Ez(double r, double phi, double z, double r1, double phi1, dou
     ;
     return 0;
   }
+  if (useTabulation && !tabR.empty())
+  {
+    int ir = FindTabulated(tabR, r);
+    int ir1 = FindTabulated(tabR, r1);
+    int iz = FindTabulated(tabZ, z);
+    int iz1 = FindTabulated(tabZ, z1);
+    if (ir >= 0 && ir1 >= 0 && iz >= 0 && iz1 >= 0)
+    {
+      return Ez_tab(ir, phi, iz, ir1, phi1, iz1);
+    }
+  }
   // Rossegger Equation 5.64
   double G = 0;
   for (int m = 0; m < NumberOfOrders; m++)
@@ -1006,6 +1027,18 @@ double Rossegger::Er(double r, double phi, double z, double r1, double phi1, dou
     return 0;
   }
 
+  if (useTabulation && !tabR.empty())
+  {
+    int ir = FindTabulated(tabR, r);
+    int ir1 = FindTabulated(tabR, r1);
+    int iz = FindTabulated(tabZ, z);
+    int iz1 = FindTabulated(tabZ, z1);
+    if (ir >= 0 && ir1 >= 0 && iz >= 0 && iz1 >= 0)
+    {
+      return Er_tab(ir, r, phi, iz, ir1, r1, phi1, iz1);
+    }
+  }
+
   double part = 0;
   double G = 0;
   for (int m = 0; m < NumberOfOrders; m++)
@@ -1170,6 +1203,18 @@ double Rossegger::Ephi(double r, double phi, double z, double r1, double phi1, d
     return 0;
   }
 
+  if (useTabulation && !tabR.empty())
+  {
+    int ir = FindTabulated(tabR, r);
+    int ir1 = FindTabulated(tabR, r1);
+    int iz = FindTabulated(tabZ, z);
+    int iz1 = FindTabulated(tabZ, z1);
+    if (ir >= 0 && ir1 >= 0 && iz >= 0 && iz1 >= 0)
+    {
+      return Ephi_tab(ir, r, phi, iz, ir1, phi1, iz1);
+    }
+  }
+
   double G = 0;
   // Rossegger Eqn. 5.66:
   for (int k = 0; k < NumberOfOrders; k++)
@@ -1319,6 +1364,265 @@ double Rossegger::Ephi_(double r, double phi, double z, double r1, double phi1,
   return G;
 }
 
+void Rossegger::TabulateGrid(const std::vector<double> &radii, const std::vector<double> &zs)
+{
+  // precompute every r- and z-dependent factor of Rossegger 5.64-5.66 at the requested points, so that evaluating a Green's function
+  // between two tabulated points is a sum of products of table entries, with no Bessel function calls.
+  ClearTabulation();
+  for (double r : radii)
+  {
+    if (r >= a && r <= b && FindTabulated(tabR, r) < 0)
+    {
+      tabR.insert(std::upper_bound(tabR.begin(), tabR.end(), r), r);
+    }
+  }
+  for (double z : zs)
+  {
+    if (z >= 0 && z <= L && FindTabulated(tabZ, z) < 0)
+    {
+      tabZ.insert(std::upper_bound(tabZ.begin(), tabZ.end(), z), z);
+    }
+  }
+  auto t0 = std::chrono::steady_clock::now();
+  const int NO = NumberOfOrders;
+  const std::size_t nr = tabR.size();
+  const std::size_t nz = tabZ.size();
+  tabRmn.resize(nr * NO * NO);
+  tabRmn1.resize(nr * NO * NO);
+  tabRmn2.resize(nr * NO * NO);
+  tabRPrimeA.resize(nr * NO * NO);
+  tabRPrimeB.resize(nr * NO * NO);
+  tabRnk.resize(nr * NO * NO);
+  for (std::size_t i = 0; i < nr; i++)
+  {
+    for (int m = 0; m < NO; m++)
+    {
+      for (int n = 0; n < NO; n++)
+      {
+        const std::size_t idx = (i * NO + m) * NO + n;
+        tabRmn[idx] = Rmn(m, n, tabR[i]);
+        tabRmn1[idx] = Rmn1(m, n, tabR[i]);
+        tabRmn2[idx] = Rmn2(m, n, tabR[i]);
+        tabRPrimeA[idx] = RPrime(m, n, a, tabR[i]);
+        tabRPrimeB[idx] = RPrime(m, n, b, tabR[i]);
+        tabRnk[idx] = Rnk(m, n, tabR[i]);  // here m plays the role of n and n the role of k
+      }
+    }
+  }
+  tabSinBetaNz.resize(nz * NO);
+  tabCoshBetamnz.resize(nz * NO * NO);
+  tabCoshBetamnLz.resize(nz * NO * NO);
+  tabSinhBetamnz.resize(nz * NO * NO);
+  tabSinhBetamnLz.resize(nz * NO * NO);
+  for (std::size_t i = 0; i < nz; i++)
+  {
+    for (int n = 0; n < NO; n++)
+    {
+      tabSinBetaNz[i * NO + n] = sin(BetaN[n] * tabZ[i]);
+    }
+    for (int m = 0; m < NO; m++)
+    {
+      for (int n = 0; n < NO; n++)
+      {
+        const std::size_t idx = (i * NO + m) * NO + n;
+        tabCoshBetamnz[idx] = cosh(Betamn[m][n] * tabZ[i]);
+        tabCoshBetamnLz[idx] = cosh(Betamn[m][n] * (L - tabZ[i]));
+        tabSinhBetamnz[idx] = sinh(Betamn[m][n] * tabZ[i]);
+        tabSinhBetamnLz[idx] = sinh(Betamn[m][n] * (L - tabZ[i]));
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+  std::cout << std::format("Rossegger::TabulateGrid: tabulated {} radii and {} z positions in {:.2f} s", nr, nz, elapsed.count()) << std::endl;
+  return;
+}
+
+void Rossegger::ClearTabulation()
+{
+  tabR.clear();
+  tabZ.clear();
+  tabRmn.clear();
+  tabRmn1.clear();
+  tabRmn2.clear();
+  tabRPrimeA.clear();
+  tabRPrimeB.clear();
+  tabRnk.clear();
+  tabSinBetaNz.clear();
+  tabCoshBetamnz.clear();
+  tabCoshBetamnLz.clear();
+  tabSinhBetamnz.clear();
+  tabSinhBetamnLz.clear();
+  return;
+}
+
+bool Rossegger::CheckTabulation(int nsamples, double tolerance)
+{
+  // evaluate Ez, Er and Ephi between pseudo-randomly chosen pairs of tabulated points, once from the tables and once from the series,
+  // and require relative agreement to within tolerance.
+  if (tabR.empty() || tabZ.empty())
+  {
+    return true;
+  }
+  std::vector<double> tabulated;
+  std::vector<double> series;
+  tabulated.reserve(3 * nsamples);
+  series.reserve(3 * nsamples);
+  unsigned int seed = 12345;
+  auto next = [&seed](std::size_t range)
+  {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % range;
+  };
+  std::vector<double> points;
+  for (int i = 0; i < nsamples; i++)
+  {
+    points.push_back(tabR[next(tabR.size())]);
+    points.push_back(2 * pi * next(1000) / 1000.);
+    points.push_back(tabZ[next(tabZ.size())]);
+    points.push_back(tabR[next(tabR.size())]);
+    points.push_back(2 * pi * next(1000) / 1000.);
+    points.push_back(tabZ[next(tabZ.size())]);
+  }
+  double elapsed[2] = {0, 0};
+  for (int pass = 0; pass < 2; pass++)
+  {
+    useTabulation = (pass == 0);
+    std::vector<double> &out = (pass == 0) ? tabulated : series;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < nsamples; i++)
+    {
+      const double *p = &points[6 * i];
+      out.push_back(Ez(p[0], p[1], p[2], p[3], p[4], p[5]));
+      out.push_back(Er(p[0], p[1], p[2], p[3], p[4], p[5]));
+      out.push_back(Ephi(p[0], p[1], p[2], p[3], p[4], p[5]));
+    }
+    elapsed[pass] = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  }
+  useTabulation = true;
+
+  int nbad = 0;
+  for (std::size_t i = 0; i < series.size(); i++)
+  {
+    double diff = std::abs(tabulated[i] - series[i]);
+    if (diff > tolerance * std::max(std::abs(series[i]), 1E-12))
+    {
+      if (verbosity || nbad < 5)
+      {
+        std::cout << std::format("Rossegger::CheckTabulation: sample {} component {}: tabulated {:E} vs series {:E}", i / 3, i % 3, tabulated[i], series[i]) << std::endl;
+      }
+      nbad++;
+    }
+  }
+  std::cout << std::format("Rossegger::CheckTabulation: {} samples, {} mismatches.  tabulated {:.3f} ms, series {:.3f} ms (x{:.1f})",
+                           nsamples, nbad, elapsed[0] * 1e3, elapsed[1] * 1e3, elapsed[0] > 0 ? elapsed[1] / elapsed[0] : 0.)
+            << std::endl;
+  return nbad == 0;
+}
+
+int Rossegger::FindTabulated(const std::vector<double> &table, double x)
+{
+  // index of the tabulated value equal to x (to rounding), or -1
+  auto it = std::lower_bound(table.begin(), table.end(), x);
+  const double tol = 1E-9 * std::max(std::abs(x), 1.0);
+  if (it != table.end() && *it - x <= tol)
+  {
+    return it - table.begin();
+  }
+  if (it != table.begin() && x - *(it - 1) <= tol)
+  {
+    return it - table.begin() - 1;
+  }
+  return -1;
+}
+
+double Rossegger::Ez_tab(int ir, double phi, int iz, int ir1, double phi1, int iz1) const
+{
+  // Rossegger Equation 5.64 from the tables.
+  const int NO = NumberOfOrders;
+  const double *R = &tabRmn[ir * NO * NO];
+  const double *R1 = &tabRmn[ir1 * NO * NO];
+  const bool below = (iz < iz1);  // tabZ is sorted, so this is z < z1
+  const double *zf = below ? &tabCoshBetamnz[iz * NO * NO] : &tabCoshBetamnLz[iz * NO * NO];
+  const double *zf1 = below ? &tabSinhBetamnLz[iz1 * NO * NO] : &tabSinhBetamnz[iz1 * NO * NO];
+  double G = 0;
+  for (int m = 0; m < NO; m++)
+  {
+    double sum = 0;
+    for (int n = 0; n < NO; n++)
+    {
+      const int idx = m * NO + n;
+      sum += R[idx] * R1[idx] / N2mn[m][n] * zf[idx] * zf1[idx] / sinh_Betamn_L[m][n];
+    }
+    G += (2 - ((m == 0) ? 1 : 0)) * cos(m * (phi - phi1)) * sum;
+  }
+  G = (below ? G : -G) / (2.0 * pi);
+  if (verbosity)
+  {
+    std::cout << "Ez = " << G << std::endl;
+  }
+  return G;
+}
+
+double Rossegger::Er_tab(int ir, double r, double phi, int iz, int ir1, double r1, double phi1, int iz1) const
+{
+  // Rossegger Equation 5.65 from the tables.
+  const int NO = NumberOfOrders;
+  const bool inside = (r < r1);
+  const double *RA = inside ? &tabRPrimeA[ir * NO * NO] : &tabRmn1[ir1 * NO * NO];
+  const double *RB = inside ? &tabRmn2[ir1 * NO * NO] : &tabRPrimeB[ir * NO * NO];
+  const double *sz = &tabSinBetaNz[iz * NO];
+  const double *sz1 = &tabSinBetaNz[iz1 * NO];
+  double G = 0;
+  for (int m = 0; m < NO; m++)
+  {
+    double sum = 0;
+    for (int n = 0; n < NO; n++)
+    {
+      const int idx = m * NO + n;
+      sum += sz[n] * sz1[n] * RA[idx] * RB[idx] / bessel_denominator[m][n];
+    }
+    G += (2 - ((m == 0) ? 1 : 0)) * cos(m * (phi - phi1)) * sum;
+  }
+  G = G / (L * pi);
+  if (verbosity)
+  {
+    std::cout << "Er = " << G << std::endl;
+  }
+  return G;
+}
+
+double Rossegger::Ephi_tab(int ir, double r, double phi, int iz, int ir1, double phi1, int iz1) const
+{
+  // Rossegger Equation 5.66 from the tables.  The phi dependence still needs one sinh per term.
+  const int NO = NumberOfOrders;
+  const double *R = &tabRnk[ir * NO * NO];
+  const double *R1 = &tabRnk[ir1 * NO * NO];
+  const double *sz = &tabSinBetaNz[iz * NO];
+  const double *sz1 = &tabSinBetaNz[iz1 * NO];
+  const double dphi = pi - std::abs(phi - phi1);
+  double G = 0;
+  for (int n = 0; n < NO; n++)
+  {
+    double sum = 0;
+    for (int k = 0; k < NO; k++)
+    {
+      const int idx = n * NO + k;
+      sum += R[idx] * R1[idx] / N2nk[n][k] * sinh(Munk[n][k] * dphi) / sinh_pi_Munk[n][k];
+    }
+    G += sz[n] * sz1[n] * sum;
+  }
+  if (phi > phi1)
+  {
+    G = -G;  // the derivative of cosh(munk(pi-|phi-phi1|)
+  }
+  G = G / (L * r);
+  if (verbosity)
+  {
+    std::cout << "Ephi = " << G << std::endl;
+  }
+  return G;
+}
+
 void Rossegger::SaveZeroes(const std::string &destfile)
 {
   TFile *output = TFile::Open(destfile.c_str(), "RECREATE");
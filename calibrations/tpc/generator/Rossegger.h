@@ -23,6 +23,7 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <vector>
 
 class TH2;
 class TH3;
@@ -58,6 +59,13 @@ class Rossegger
   double Er(double r, double phi, double z, double r1, double phi1, double z1);
   double Ephi(double r, double phi, double z, double r1, double phi1, double z1);
 
+  // tabulate the radial and z basis functions at a fixed set of radii and z positions (eg. the cell centers of a field grid).
+  // Ez, Er and Ephi use the tables whenever both points are on tabulated values, and fall back to the series otherwise.
+  // Evaluation is safe from several threads, but tabulating or clearing is not -- do it before the threads start.
+  void TabulateGrid(const std::vector<double> &radii, const std::vector<double> &zs);
+  void ClearTabulation();
+  bool CheckTabulation(int nsamples = 200, double tolerance = 1E-9);  // compare tabulated and series evaluation at nsamples grid points, and time both.
+
   // alternate versions that don't use precalc constants.
   double Rmn_(int m, int n, double r);  // Rmn function from Rossegger
   // Rmn_for_zeroes doesn't have a way to speed it up with precalcs.
@@ -117,6 +125,27 @@ class Rossegger
   double sinh_Betamn_L[NumberOfOrders][NumberOfOrders]{};   // sinh(Betamn[m][n]*L)  as in Rossegger 5.64
   double sinh_pi_Munk[NumberOfOrders][NumberOfOrders]{};    // sinh(pi*Munk[n][k]) as in Rossegger 5.66
 
+  // tabulated basis functions, indexed [(i*NumberOfOrders+m)*NumberOfOrders+n] for the i-th tabulated radius or z, so that the sum over
+  // the last order for a given pair of points runs over contiguous memory.
+  bool useTabulation {true};            // switched off by CheckTabulation to get the series values.
+  std::vector<double> tabR;             // sorted tabulated radii
+  std::vector<double> tabZ;             // sorted tabulated z positions
+  std::vector<double> tabRmn;
+  std::vector<double> tabRmn1;
+  std::vector<double> tabRmn2;
+  std::vector<double> tabRPrimeA;       // RPrime(m,n,a,r)
+  std::vector<double> tabRPrimeB;       // RPrime(m,n,b,r)
+  std::vector<double> tabRnk;           // indexed [(i*NumberOfOrders+n)*NumberOfOrders+k]
+  std::vector<double> tabSinBetaNz;     // sin(BetaN*z), indexed [i*NumberOfOrders+n]
+  std::vector<double> tabCoshBetamnz;   // cosh(Betamn*z)
+  std::vector<double> tabCoshBetamnLz;  // cosh(Betamn*(L-z))
+  std::vector<double> tabSinhBetamnz;   // sinh(Betamn*z)
+  std::vector<double> tabSinhBetamnLz;  // sinh(Betamn*(L-z))
+  static int FindTabulated(const std::vector<double> &table, double x);
+  double Ez_tab(int ir, double phi, int iz, int ir1, double phi1, int iz1) const;
+  double Er_tab(int ir, double r, double phi, int iz, int ir1, double r1, double phi1, int iz1) const;
+  double Ephi_tab(int ir, double r, double phi, int iz, int ir1, double phi1, int iz1) const;
+
   TH2 *Tags {nullptr};
   std::map<std::string, TH3 *> Grid;
 };
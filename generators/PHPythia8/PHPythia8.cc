@@ -27,11 +27,14 @@
 #include <Pythia8/Pythia.h>
 #include <Pythia8Plugins/HepMC2.h>
 
+#include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <format>
 #include <fstream>
 #include <iostream>  // for operator<<, endl
+#include <random>    // for seed_seq
 
 /**
  * @brief Construct a PHPythia8 generator instance and configure HepMC conversion.
@@ -57,22 +60,62 @@ PHPythia8::PHPythia8(const std::string &name)
     return;
   }
 
-  std::string thePath(charPath);
-  thePath += "/xmldoc/";
+  m_XmlPath = charPath;
+  m_XmlPath += "/xmldoc/";
   // the pythia8 ctor messes with the formatting, so we save the cout state here
   // and restore it later
   std::ios old_state(nullptr);
   old_state.copyfmt(std::cout);
-  m_Pythia8.reset(new Pythia8::Pythia(thePath));
+  m_Pythia8.reset(new Pythia8::Pythia(m_XmlPath));
   std::cout.copyfmt(old_state);
-  m_Pythia8ToHepMC.reset(new HepMC::Pythia8ToHepMC());
-  m_Pythia8ToHepMC->set_store_proc(true);
-  m_Pythia8ToHepMC->set_store_pdf(true);
-  m_Pythia8ToHepMC->set_store_xsec(true);
+  m_Pythia8ToHepMC = new_tohepmc();
 
   PHHepMCGenHelper::set_embedding_id(1);  // default embedding ID to 1
 }
 
+PHPythia8::~PHPythia8()
+{
+  stop_workers();
+}
+
+Pythia8::Pythia *PHPythia8::new_pythia() const
+{
+  std::ios old_state(nullptr);
+  old_state.copyfmt(std::cout);
+  // one banner is enough
+  Pythia8::Pythia *pythia = new Pythia8::Pythia(m_XmlPath, false);
+  std::cout.copyfmt(old_state);
+  return pythia;
+}
+
+std::unique_ptr<HepMC::Pythia8ToHepMC> PHPythia8::new_tohepmc() const
+{
+  auto tohepmc = std::make_unique<HepMC::Pythia8ToHepMC>();
+  tohepmc->set_store_proc(true);
+  tohepmc->set_store_pdf(true);
+  tohepmc->set_store_xsec(true);
+  return tohepmc;
+}
+
+//! the settings of the main instance (read by read_config and Init) for a worker
+void PHPythia8::configure(Pythia8::Pythia *pythia)
+{
+  if (!m_ConfigFileName.empty())
+  {
+    pythia->readFile(m_ConfigFileName);
+  }
+  for (auto &m_Command : m_Commands)
+  {
+    pythia->readString(m_Command);
+  }
+}
+
+void PHPythia8::set_seed(Pythia8::Pythia *pythia, const unsigned int seed) const
+{
+  pythia->readString("Random:setSeed = on");
+  pythia->readString(std::format("Random:seed = {}", seed));
+}
+
 /**
  * @brief Initialize the Pythia8 generator, configure nodes, and seed the RNG.
  *
@@ -111,8 +154,7 @@ int PHPythia8::Init(PHCompositeNode *topNode)
 
   if ((seed > 0) && (seed <= 900000000))
   {
-    m_Pythia8->readString("Random:setSeed = on");
-    m_Pythia8->readString(std::format("Random:seed = {}", seed));
+    set_seed(m_Pythia8.get(), seed);
   }
   else
   {
@@ -122,6 +164,13 @@ int PHPythia8::Init(PHCompositeNode *topNode)
   // print out seed so we can make this is reproducible
   std::cout << "PHPythia8 random seed: " << seed << std::endl;
 
+  if (m_NumWorkers > 0)
+  {
+    // the workers generate, the main instance only holds the settings
+    start_workers(seed);
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
 
 // pythia again messes with the cout formatting
   std::ios old_state(nullptr);
@@ -141,10 +190,27 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
     std::cout << "PHPythia8::End - I'm here!" << std::endl;
   }
 
+  stop_workers();
+
   if (Verbosity() >= VERBOSITY_SOME)
   {
     //-* dump out closing info (cross-sections, etc)
-    m_Pythia8->stat();
+    long nAccepted = 0;
+    if (m_Workers.empty())
+    {
+      m_Pythia8->stat();
+      nAccepted = m_Pythia8->info.nAccepted();
+    }
+    else
+    {
+      for (auto &worker : m_Workers)
+      {
+        worker->pythia->stat();
+      }
+      double weightSum = 0;
+      double sigmaGen = 0;
+      worker_statistics(nAccepted, weightSum, sigmaGen);
+    }
 
     // match pythia printout
     std::cout << " |                                                                "
@@ -152,8 +218,8 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
     std::cout << "                         PHPythia8::End - " << m_EventCount
               << " events passed trigger" << std::endl;
     std::cout << "                         Fraction passed: " << m_EventCount
-              << "/" << m_Pythia8->info.nAccepted()
-              << " = " << m_EventCount / float(m_Pythia8->info.nAccepted()) << std::endl;
+              << "/" << nAccepted
+              << " = " << m_EventCount / float(nAccepted) << std::endl;
     std::cout << " *-------  End PYTHIA Trigger Statistics  ------------------------"
               << "-------------------------------------------------* " << std::endl;
 
@@ -166,6 +232,22 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
     }
   }
 
+  if (m_EventCount > 0 && (Verbosity() >= VERBOSITY_SOME || !m_Workers.empty()))
+  {
+    std::cout << Name() << ": " << m_EventCount << " triggered events, " << m_GenerationTime
+              << " s spent waiting for the generator";
+    if (m_GenerationTime > 0)
+    {
+      std::cout << " (" << m_EventCount / m_GenerationTime << " accepted events/s";
+      if (!m_Workers.empty())
+      {
+        std::cout << " with " << m_Workers.size() << " workers";
+      }
+      std::cout << ")";
+    }
+    std::cout << std::endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -211,74 +293,54 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
   std::ios old_state(nullptr);
   old_state.copyfmt(std::cout); // save current state
 
-  while (!passedTrigger)
+  const auto start = std::chrono::steady_clock::now();
+  HepMC::GenEvent *genevent = nullptr;
+  if (m_Workers.empty())
   {
-    //    ++genCounter;
-
-    // generate another pythia event
-    while (!passedGen)
-    {
-      passedGen = m_Pythia8->next();
-    }
-
-    // test trigger logic
-    bool andScoreKeeper = true;
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    while (!passedTrigger)
     {
-      std::cout << "PHPythia8::process_event - triggersize: " << m_RegisteredTriggers.size() << std::endl;
-    }
+      //    ++genCounter;
 
-    for (auto &m_RegisteredTrigger : m_RegisteredTriggers)
-    {
-      bool trigResult = m_RegisteredTrigger->Apply(m_Pythia8.get());
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      // generate another pythia event
+      while (!passedGen)
       {
-        std::cout << "PHPythia8::process_event trigger: "
-                  << m_RegisteredTrigger->GetName() << "  " << trigResult << std::endl;
+        passedGen = m_Pythia8->next();
       }
 
-      if (m_TriggersOR && trigResult)
-      {
-        passedTrigger = true;
-        break;
-      }
-      if (m_TriggersAND)
-      {
-        andScoreKeeper &= trigResult;
-      }
+      // test trigger logic
+      passedTrigger = passes_triggers(m_Pythia8.get());
 
-      if (Verbosity() >= VERBOSITY_EVEN_MORE && !passedTrigger && !andScoreKeeper)
-      {
-        std::cout << "PHPythia8::process_event - failed trigger: "
-                  << m_RegisteredTrigger->GetName() << std::endl;
-      }
+      passedGen = false;
     }
 
-    if ((andScoreKeeper && m_TriggersAND) || (m_RegisteredTriggers.empty()))
+    // print
+    if (Verbosity())
     {
-      passedTrigger = true;
-      //      genCounter = 0;
+      m_Pythia8->event.list();
     }
 
-    passedGen = false;
+    // fill HepMC object with event & pass to
+    genevent = fill_genevent(m_Pythia8.get(), m_Pythia8ToHepMC.get(), m_EventCount);
   }
-
-  // print
-  if (Verbosity())
-  {
-    m_Pythia8->event.list();
-  }
-
-  // fill HepMC object with event & pass to
-
-  auto *genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
-  m_Pythia8ToHepMC->fill_next_event(*m_Pythia8, genevent, m_EventCount);
-  // Enable continuous reweighting by storing additional reweighting factor
-  if (m_SaveEventWeightFlag)
+  else
   {
-    genevent->weights().push_back(m_Pythia8->info.weight());
+    // the workers are used in turn, independent of which one is ahead
+    Worker &worker = *m_Workers[m_NextWorker];
+    m_NextWorker = (m_NextWorker + 1) % m_Workers.size();
+    {
+      std::unique_lock<std::mutex> lock(m_WorkerMutex);
+      m_WorkerReady.wait(lock, [&worker]
+                         { return !worker.queue.empty(); });
+      worker.last = worker.queue.front();
+      worker.queue.pop_front();
+    }
+    m_WorkerFree.notify_all();
+    genevent = worker.last.genevent;
+    worker.last.genevent = nullptr;
+    genevent->set_event_number(m_EventCount);
   }
+  const std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+  m_GenerationTime += waited.count();
 
   /* pass HepMC to PHNode*/
   auto *success = PHHepMCGenHelper::insert_event(genevent);
@@ -295,11 +357,12 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
   {
     std::cout << "PHPythia8::process_event - FINISHED WHOLE EVENT" << std::endl;
   }
-  if (m_EventCount < 2 && Verbosity() >= VERBOSITY_SOME)
+  // with workers the pythia record of this event is gone already
+  if (m_EventCount < 2 && Verbosity() >= VERBOSITY_SOME && m_Workers.empty())
   {
     m_Pythia8->event.list();
   }
-  if (m_EventCount >= 2 && Verbosity() >= VERBOSITY_A_LOT)
+  if (m_EventCount >= 2 && Verbosity() >= VERBOSITY_A_LOT && m_Workers.empty())
   {
     m_Pythia8->event.list();
   }
@@ -311,10 +374,17 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
   // save statistics
   if (m_IntegralNode)
   {
-    m_IntegralNode->set_N_Generator_Accepted_Event(m_Pythia8->info.nAccepted());
+    long nAccepted = m_Pythia8->info.nAccepted();
+    double weightSum = m_Pythia8->info.weightSum();
+    double sigmaGen = m_Pythia8->info.sigmaGen();
+    if (!m_Workers.empty())
+    {
+      worker_statistics(nAccepted, weightSum, sigmaGen);
+    }
+    m_IntegralNode->set_N_Generator_Accepted_Event(nAccepted);
     m_IntegralNode->set_N_Processed_Event(m_EventCount);
-    m_IntegralNode->set_Sum_Of_Weight(m_Pythia8->info.weightSum());
-    m_IntegralNode->set_Integrated_Lumi(m_Pythia8->info.nAccepted() / (m_Pythia8->info.sigmaGen() * 1e9));
+    m_IntegralNode->set_Sum_Of_Weight(weightSum);
+    m_IntegralNode->set_Integrated_Lumi(nAccepted / (sigmaGen * 1e9));
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -365,3 +435,165 @@ void PHPythia8::register_trigger(PHPy8GenTrigger *theTrigger)
   }
   m_RegisteredTriggers.push_back(theTrigger);
 }
+
+bool PHPythia8::passes_triggers(Pythia8::Pythia *pythia)
+{
+  bool passedTrigger = false;
+  bool andScoreKeeper = true;
+  if (Verbosity() >= VERBOSITY_EVEN_MORE)
+  {
+    std::cout << "PHPythia8::process_event - triggersize: " << m_RegisteredTriggers.size() << std::endl;
+  }
+
+  for (auto &m_RegisteredTrigger : m_RegisteredTriggers)
+  {
+    bool trigResult = m_RegisteredTrigger->Apply(pythia);
+
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "PHPythia8::process_event trigger: "
+                << m_RegisteredTrigger->GetName() << "  " << trigResult << std::endl;
+    }
+
+    if (m_TriggersOR && trigResult)
+    {
+      passedTrigger = true;
+      break;
+    }
+    if (m_TriggersAND)
+    {
+      andScoreKeeper &= trigResult;
+    }
+
+    if (Verbosity() >= VERBOSITY_EVEN_MORE && !passedTrigger && !andScoreKeeper)
+    {
+      std::cout << "PHPythia8::process_event - failed trigger: "
+                << m_RegisteredTrigger->GetName() << std::endl;
+    }
+  }
+
+  if ((andScoreKeeper && m_TriggersAND) || (m_RegisteredTriggers.empty()))
+  {
+    passedTrigger = true;
+  }
+  return passedTrigger;
+}
+
+HepMC::GenEvent *PHPythia8::fill_genevent(Pythia8::Pythia *pythia, HepMC::Pythia8ToHepMC *tohepmc, const int eventnumber) const
+{
+  auto *genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
+  tohepmc->fill_next_event(*pythia, genevent, eventnumber);
+  // Enable continuous reweighting by storing additional reweighting factor
+  if (m_SaveEventWeightFlag)
+  {
+    genevent->weights().push_back(pythia->info.weight());
+  }
+  return genevent;
+}
+
+void PHPythia8::start_workers(const unsigned int seed)
+{
+  m_StopWorkers = false;
+  for (unsigned int i = 0; i < m_NumWorkers; ++i)
+  {
+    auto worker = std::make_unique<Worker>();
+    worker->pythia.reset(new_pythia());
+    configure(worker->pythia.get());
+    // worker 0 gets the seed of the job, the others seeds derived from it and their index
+    unsigned int workerseed = seed;
+    if (i > 0)
+    {
+      std::seed_seq seq{seed, i};
+      std::array<unsigned int, 1> derived{};
+      seq.generate(derived.begin(), derived.end());
+      workerseed = derived[0] % 900000000 + 1;
+    }
+    set_seed(worker->pythia.get(), workerseed);
+    std::cout << "PHPythia8 worker " << i << " random seed: " << workerseed << std::endl;
+
+    std::ios old_state(nullptr);
+    old_state.copyfmt(std::cout);
+    worker->pythia->init();
+    std::cout.copyfmt(old_state);
+
+    worker->tohepmc = new_tohepmc();
+    m_Workers.push_back(std::move(worker));
+  }
+  for (auto &worker : m_Workers)
+  {
+    worker->thread = std::thread(&PHPythia8::worker_loop, this, std::ref(*worker));
+  }
+}
+
+void PHPythia8::stop_workers()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_WorkerMutex);
+    m_StopWorkers = true;
+  }
+  m_WorkerFree.notify_all();
+  for (auto &worker : m_Workers)
+  {
+    if (worker->thread.joinable())
+    {
+      worker->thread.join();
+    }
+    // triggered but never used
+    for (auto &next : worker->queue)
+    {
+      delete next.genevent;
+    }
+    worker->queue.clear();
+  }
+}
+
+void PHPythia8::worker_loop(Worker &worker)
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_WorkerMutex);
+      m_WorkerFree.wait(lock, [this, &worker]
+                        { return m_StopWorkers || worker.queue.size() < m_WorkerQueueDepth; });
+      if (m_StopWorkers)
+      {
+        return;
+      }
+    }
+    // rare triggers can take a while, look at the stop flag after every event
+    bool passedTrigger = false;
+    while (!passedTrigger && !m_StopWorkers)
+    {
+      passedTrigger = worker.pythia->next() && passes_triggers(worker.pythia.get());
+    }
+    if (!passedTrigger)
+    {
+      return;
+    }
+    WorkerEvent next;
+    next.genevent = fill_genevent(worker.pythia.get(), worker.tohepmc.get(), 0);
+    next.nAccepted = worker.pythia->info.nAccepted();
+    next.weightSum = worker.pythia->info.weightSum();
+    next.sigmaGen = worker.pythia->info.sigmaGen();
+    {
+      std::lock_guard<std::mutex> lock(m_WorkerMutex);
+      worker.queue.push_back(next);
+    }
+    m_WorkerReady.notify_all();
+  }
+}
+
+void PHPythia8::worker_statistics(long &nAccepted, double &weightSum, double &sigmaGen) const
+{
+  // each worker estimates the cross section from its own events, combine them by their weight
+  nAccepted = 0;
+  weightSum = 0;
+  double sigmaSum = 0;
+  for (const auto &worker : m_Workers)
+  {
+    nAccepted += worker->last.nAccepted;
+    weightSum += worker->last.weightSum;
+    sigmaSum += worker->last.sigmaGen * worker->last.nAccepted;
+  }
+  sigmaGen = (nAccepted > 0) ? sigmaSum / nAccepted : 0;
+}
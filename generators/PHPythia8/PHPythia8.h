@@ -5,9 +5,15 @@
 
 #include <phhepmc/PHHepMCGenHelper.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class PHCompositeNode;
@@ -16,6 +22,7 @@ class PHPy8GenTrigger;
 
 namespace HepMC
 {
+  class GenEvent;
   class Pythia8ToHepMC;
 }  // namespace HepMC
 
@@ -31,7 +38,7 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
   explicit PHPythia8(const std::string &name = "PHPythia8");
 
   //! destructor
-  ~PHPythia8() override = default;
+  ~PHPythia8() override;
 
   int Init(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -73,7 +80,46 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
   void save_event_weight(const bool b) { m_SaveEventWeightFlag = b; }
   void save_integrated_luminosity(const bool b) { m_SaveIntegratedLuminosityFlag = b; }
 
+  /// generate on n worker threads, each with its own PYTHIA instance and seed (0 = on the main thread).
+  /// Every worker keeps up to depth triggered events ready, process_event takes them from the
+  /// workers in turn so the event sequence only depends on the seed and n
+  void set_num_workers(const unsigned int n, const unsigned int depth = 4)
+  {
+    m_NumWorkers = n;
+    m_WorkerQueueDepth = std::max(depth, 1U);
+  }
+
  private:
+  //! triggered event of a worker with the generator statistics up to it
+  struct WorkerEvent
+  {
+    HepMC::GenEvent *genevent{nullptr};
+    long nAccepted{0};
+    double weightSum{0};
+    double sigmaGen{0};
+  };
+
+  struct Worker
+  {
+    std::unique_ptr<Pythia8::Pythia> pythia;
+    std::unique_ptr<HepMC::Pythia8ToHepMC> tohepmc;
+    std::deque<WorkerEvent> queue;
+    WorkerEvent last;  //!< statistics of the last event taken from this worker
+    std::thread thread;
+  };
+
+  Pythia8::Pythia *new_pythia() const;
+  std::unique_ptr<HepMC::Pythia8ToHepMC> new_tohepmc() const;
+  void configure(Pythia8::Pythia *pythia);
+  void set_seed(Pythia8::Pythia *pythia, const unsigned int seed) const;
+  bool passes_triggers(Pythia8::Pythia *pythia);
+  HepMC::GenEvent *fill_genevent(Pythia8::Pythia *pythia, HepMC::Pythia8ToHepMC *tohepmc, const int eventnumber) const;
+  void start_workers(const unsigned int seed);
+  void stop_workers();
+  void worker_loop(Worker &worker);
+  //! generator statistics of the events taken from the workers so far
+  void worker_statistics(long &nAccepted, double &weightSum, double &sigmaGen) const;
+
   int read_config(const std::string &cfg_file);
   int create_node_tree(PHCompositeNode *topNode) final;
   double percent_diff(const double a, const double b) { return std::fabs((a - b) / a); }
@@ -101,6 +147,21 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
 
   //! pointer to data node saving the integrated luminosity
   PHGenIntegral *m_IntegralNode{};
+
+  std::string m_XmlPath;
+
+  // worker threads
+  unsigned int m_NumWorkers{0};
+  unsigned int m_WorkerQueueDepth{4};
+  unsigned int m_NextWorker{0};
+  std::vector<std::unique_ptr<Worker>> m_Workers;
+  std::mutex m_WorkerMutex;
+  std::condition_variable m_WorkerFree;
+  std::condition_variable m_WorkerReady;
+  std::atomic<bool> m_StopWorkers{false};
+
+  //! time process_event spent on getting triggered events, for the accepted events/s
+  double m_GenerationTime{0};
 };
 
 #endif /* PHPYTHIA8_PHPYTHIA8_H */
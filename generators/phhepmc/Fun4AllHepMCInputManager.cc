@@ -1,5 +1,6 @@
 #include "Fun4AllHepMCInputManager.h"
 
+#include "HepMCEventIndex.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 
@@ -28,9 +29,12 @@
 #include <TPRegexp.h>
 #include <TString.h>
 
+#include <boost/iostreams/device/file.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
@@ -66,6 +70,7 @@ Fun4AllHepMCInputManager::Fun4AllHepMCInputManager(const std::string &name, cons
 Fun4AllHepMCInputManager::~Fun4AllHepMCInputManager()
 {
   fileclose();
+  StopReadAhead();
   if (!m_HepMCTmpFile.empty())
   {
     // okay if the file does not exist
@@ -101,6 +106,10 @@ int Fun4AllHepMCInputManager::fileopen(const std::string &filenam)
   {
     theOscarFile.open(fname);
   }
+  else if (m_ReadAheadDepth > 0)
+  {
+    StartReadAhead(fname);
+  }
   else
   {
     TString tstr(fname);
@@ -186,13 +195,13 @@ int Fun4AllHepMCInputManager::run(const int /*nevents*/)
       }
       else
       {
-        evt = ascii_in->read_next_event();
+        evt = ReadNextEvent();
       }
     }
 
     if (!evt)
     {
-      if (Verbosity() > 1)
+      if (Verbosity() > 1 && ascii_in)
       {
         std::cout << "Fun4AllHepMCInputManager::run::" << Name()
                   << ": error type: " << ascii_in->error_type()
@@ -252,9 +261,14 @@ int Fun4AllHepMCInputManager::fileclose()
   }
   else
   {
+    StopReadAhead();
     delete ascii_in;
     ascii_in = nullptr;
   }
+  if (Verbosity() > 0 || m_ReadAheadDepth > 0)
+  {
+    PrintThroughput();
+  }
   IsOpen(0);
   // if we have a file list, move next entry to top of the list
   // or repeat the same entry again
@@ -267,6 +281,12 @@ void Fun4AllHepMCInputManager::Print(const std::string &what) const
   Fun4AllInputManager::Print(what);
   std::cout << Name() << " Vertex Settings: " << std::endl;
   PHHepMCGenHelper::Print(what);
+  if (m_ReadAheadDepth > 0)
+  {
+    std::cout << Name() << ": reading " << m_ReadAheadDepth << " events ahead, "
+              << m_NumParsers << " parser threads" << std::endl;
+  }
+  PrintThroughput();
   return;
 }
 
@@ -318,12 +338,15 @@ int Fun4AllHepMCInputManager::PushBackEvents(const int i)
   int errorflag = 0;
   while (nevents > 0 && !errorflag)
   {
-    evt = ascii_in->read_next_event();
+    evt = ReadNextEvent();
     if (!evt)
     {
       std::cout << "Error after skipping " << i - nevents << std::endl;
-      std::cout << "error type: " << ascii_in->error_type()
-                << ", rdstate: " << ascii_in->rdstate() << std::endl;
+      if (ascii_in)
+      {
+        std::cout << "error type: " << ascii_in->error_type()
+                  << ", rdstate: " << ascii_in->rdstate() << std::endl;
+      }
       errorflag = -1;
       fileclose();
     }
@@ -433,3 +456,209 @@ int Fun4AllHepMCInputManager::MyCurrentEvent(const unsigned int index) const
   }
   return m_MyEvent.at(index);
 }
+
+void Fun4AllHepMCInputManager::SetReadAhead(const unsigned int nevents, const unsigned int nparsers)
+{
+  if (IsOpen())
+  {
+    std::cout << PHWHERE << Name() << ": read ahead has to be set before the first file is opened" << std::endl;
+    return;
+  }
+  if (m_ReadOscarFlag && nevents > 0)
+  {
+    std::cout << PHWHERE << Name() << ": no read ahead for Oscar input" << std::endl;
+    return;
+  }
+  m_ReadAheadDepth = nevents;
+  m_NumParsers = std::max(nparsers, 1U);
+}
+
+HepMC::GenEvent *Fun4AllHepMCInputManager::ReadNextEvent()
+{
+  const auto start = std::chrono::steady_clock::now();
+  HepMC::GenEvent *next = nullptr;
+  if (!m_ReaderThread.joinable())
+  {
+    next = ascii_in ? ascii_in->read_next_event() : nullptr;
+  }
+  else
+  {
+    std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+    m_SlotParsed.wait(lock, [this]
+                      { return !m_ReadAhead.empty() && m_ReadAhead.front().parsed; });
+    // the end marker stays in the queue, the file gets closed after it
+    if (!m_ReadAhead.front().last)
+    {
+      next = m_ReadAhead.front().evt;
+      m_ReadAhead.pop_front();
+      lock.unlock();
+      m_SlotFree.notify_one();
+    }
+  }
+  if (next)
+  {
+    const std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+    CountEvents(1, waited.count());
+  }
+  return next;
+}
+
+void Fun4AllHepMCInputManager::PrintThroughput() const
+{
+  if (m_EventsDelivered == 0)
+  {
+    return;
+  }
+  const std::chrono::duration<double> elapsed = m_LastDelivery - m_FirstDelivery;
+  std::cout << Name() << ": " << m_EventsDelivered << " events consumed in " << elapsed.count() << " s";
+  if (elapsed.count() > 0)
+  {
+    std::cout << " (" << m_EventsDelivered / elapsed.count() << " events/s)";
+  }
+  std::cout << ", run() waited " << m_WaitTime << " s for them" << std::endl;
+}
+
+void Fun4AllHepMCInputManager::StartReadAhead(const std::string &fname)
+{
+  m_ReadAheadStream.reset();
+  TString tstr(fname);
+  if (tstr.Contains(TPRegexp(".bz2$")))
+  {
+    m_ReadAheadStream.push(boost::iostreams::bzip2_decompressor());
+  }
+  else if (tstr.Contains(TPRegexp(".gz$")))
+  {
+    m_ReadAheadStream.push(boost::iostreams::gzip_decompressor());
+  }
+  m_ReadAheadStream.push(boost::iostreams::file_source(fname, std::ios::in | std::ios::binary));
+  m_ReadAheadHeader.clear();
+  m_StopReadAhead = false;
+  m_ReaderThread = std::thread(&Fun4AllHepMCInputManager::ReadAheadLoop, this);
+  for (unsigned int i = 0; i < m_NumParsers; ++i)
+  {
+    m_ParserThreads.emplace_back(&Fun4AllHepMCInputManager::ParseLoop, this);
+  }
+}
+
+void Fun4AllHepMCInputManager::StopReadAhead()
+{
+  if (!m_ReaderThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+    m_StopReadAhead = true;
+  }
+  m_SlotFree.notify_all();
+  m_SlotRead.notify_all();
+  m_ReaderThread.join();
+  for (auto &parser : m_ParserThreads)
+  {
+    parser.join();
+  }
+  m_ParserThreads.clear();
+  // events which were read but not used
+  for (auto &slot : m_ReadAhead)
+  {
+    delete slot.evt;
+  }
+  m_ReadAhead.clear();
+  m_ReadAheadStream.reset();
+}
+
+bool Fun4AllHepMCInputManager::PushSlot(ReadAheadSlot &&slot)
+{
+  const bool last = slot.last;
+  {
+    std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+    m_SlotFree.wait(lock, [this]
+                    { return m_StopReadAhead || m_ReadAhead.size() < m_ReadAheadDepth; });
+    if (m_StopReadAhead)
+    {
+      return false;
+    }
+    m_ReadAhead.push_back(std::move(slot));
+  }
+  if (last)
+  {
+    m_SlotParsed.notify_one();
+  }
+  else
+  {
+    m_SlotRead.notify_one();
+  }
+  return true;
+}
+
+void Fun4AllHepMCInputManager::ReadAheadLoop()
+{
+  // everything before the first event line is the header every parser needs,
+  // an event runs from its E line to the next one
+  std::string header;
+  std::string line;
+  ReadAheadSlot slot;
+  bool in_events = false;
+  while (std::getline(m_ReadAheadStream, line))
+  {
+    if (HepMCEventIndex::IsEventLine(line))
+    {
+      if (!in_events)
+      {
+        std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+        m_ReadAheadHeader = header;
+        in_events = true;
+      }
+      else if (!PushSlot(std::move(slot)))
+      {
+        return;
+      }
+      slot = ReadAheadSlot();
+    }
+    else if (HepMCEventIndex::IsEndLine(line))
+    {
+      break;
+    }
+    std::string &text = in_events ? slot.text : header;
+    text += line;
+    text += '\n';
+  }
+  if (in_events && !PushSlot(std::move(slot)))
+  {
+    return;
+  }
+  // the end of the file is handed on like the events, run() closes the file when it gets there
+  ReadAheadSlot end;
+  end.claimed = true;
+  end.parsed = true;
+  end.last = true;
+  PushSlot(std::move(end));
+}
+
+void Fun4AllHepMCInputManager::ParseLoop()
+{
+  std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+  while (true)
+  {
+    auto slot = m_ReadAhead.end();
+    m_SlotRead.wait(lock, [this, &slot]
+                    {
+                      slot = std::find_if(m_ReadAhead.begin(), m_ReadAhead.end(), [](const ReadAheadSlot &entry)
+                                          { return !entry.claimed; });
+                      return m_StopReadAhead || slot != m_ReadAhead.end(); });
+    if (m_StopReadAhead)
+    {
+      return;
+    }
+    slot->claimed = true;
+    // elements of a deque stay in place when others are added or removed at the ends
+    ReadAheadSlot &entry = *slot;
+    const std::string text = std::move(entry.text);
+    lock.unlock();
+    HepMC::GenEvent *parsed = HepMCEventIndex::Parse(m_ReadAheadHeader, text);
+    lock.lock();
+    entry.evt = parsed;
+    entry.parsed = true;
+    m_SlotParsed.notify_all();
+  }
+}
@@ -6,10 +6,16 @@
 #include <fun4all/Fun4AllInputManager.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class PHCompositeNode;
@@ -47,7 +53,28 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
   int SkipForThisManager(const int nevents) override { return PushBackEvents(-nevents); }
   int MyCurrentEvent(const unsigned int index = 0) const;
 
+  //! split the (decompressed) file into events on an I/O thread, up to nevents ahead, and
+  //! parse them on nparsers threads. Needs to be set before the first file is opened, 0 switches it off
+  void SetReadAhead(const unsigned int nevents, const unsigned int nparsers = 1);
+
  protected:
+  //! next event of the open file, from the read ahead queue if it is enabled
+  HepMC::GenEvent *ReadNextEvent();
+  //! events delivered to run() and the time run() waited for them. The rate is taken
+  //! from the wall time between the start of the first and the end of the last delivery
+  void CountEvents(const unsigned long nevents, const double waited)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_EventsDelivered == 0)
+    {
+      m_FirstDelivery = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(waited));
+    }
+    m_LastDelivery = now;
+    m_EventsDelivered += nevents;
+    m_WaitTime += waited;
+  }
+  void PrintThroughput() const;
+
   HepMC::GenEvent *evt = nullptr;
 
   int events_total = 0;
@@ -75,6 +102,42 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
 
   std::string filename;
   std::string topNodeName;
+
+  struct ReadAheadSlot
+  {
+    std::string text;
+    HepMC::GenEvent *evt{nullptr};
+    bool claimed{false};
+    bool parsed{false};
+    bool last{false};
+  };
+
+  void StartReadAhead(const std::string &fname);
+  void StopReadAhead();
+  void ReadAheadLoop();
+  void ParseLoop();
+  bool PushSlot(ReadAheadSlot &&slot);
+
+  unsigned long m_EventsDelivered = 0;
+  double m_WaitTime = 0;
+  std::chrono::steady_clock::time_point m_FirstDelivery;
+  std::chrono::steady_clock::time_point m_LastDelivery;
+
+  unsigned int m_ReadAheadDepth = 0;
+  unsigned int m_NumParsers = 1;
+
+  // the I/O thread splits the stream into events in file order, the parsers work on
+  // any unclaimed slot, ReadNextEvent() takes the front slot once it is parsed
+  boost::iostreams::filtering_istream m_ReadAheadStream;
+  std::string m_ReadAheadHeader;
+  std::deque<ReadAheadSlot> m_ReadAhead;
+  std::mutex m_ReadAheadMutex;
+  std::condition_variable m_SlotFree;
+  std::condition_variable m_SlotRead;
+  std::condition_variable m_SlotParsed;
+  bool m_StopReadAhead = false;
+  std::thread m_ReaderThread;
+  std::vector<std::thread> m_ParserThreads;
 };
 
 #endif /* PHHEPMC_FUN4ALLHEPMCINPUTMANAGER_H */
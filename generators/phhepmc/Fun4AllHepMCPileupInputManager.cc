@@ -1,14 +1,17 @@
 #include "Fun4AllHepMCPileupInputManager.h"
 
+#include "HepMCEventIndex.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 #include "PHHepMCGenHelper.h"  // for PHHepMCGenHelper, PHHepMCGen...
 
+#include <fun4all/DBInterface.h>
 #include <fun4all/Fun4AllBase.h>  // for Fun4AllBase::VERBOSITY_SOME
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/InputFileHandlerReturnCodes.h>
 
 #include <phool/PHRandomSeed.h>
+#include <phool/phool.h>  // for PHWHERE
 
 #include <HepMC/GenEvent.h>
 #include <HepMC/IO_GenEvent.h>
@@ -16,9 +19,14 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>  // for assert
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <unordered_set>
 
 Fun4AllHepMCPileupInputManager::Fun4AllHepMCPileupInputManager(
     const std::string &name, const std::string &nodename, const std::string &topnodename)
@@ -39,9 +47,62 @@ Fun4AllHepMCPileupInputManager::Fun4AllHepMCPileupInputManager(
 
 Fun4AllHepMCPileupInputManager::~Fun4AllHepMCPileupInputManager()
 {
+  delete m_EventIndex;
   gsl_rng_free(RandomGenerator);
 }
 
+void Fun4AllHepMCPileupInputManager::SetRandomAccess(const bool flag, const unsigned int nthreads)
+{
+  if (IsOpen())
+  {
+    std::cout << PHWHERE << Name() << ": random access has to be set before the first file is opened" << std::endl;
+    return;
+  }
+  m_RandomAccess = flag;
+  m_ParseThreads = std::max(nthreads, 1U);
+}
+
+int Fun4AllHepMCPileupInputManager::fileopen(const std::string &filenam)
+{
+  int iret = Fun4AllHepMCInputManager::fileopen(filenam);
+  if (iret || !m_RandomAccess || ReadOscar())
+  {
+    return iret;
+  }
+  std::string fname = DBInterface::instance()->location(filenam);
+  if (fname.ends_with(".gz") || fname.ends_with(".bz2"))
+  {
+    std::cout << Name() << ": " << fname << " is compressed, reading its events in sequence" << std::endl;
+    return iret;
+  }
+  if (!m_EventIndex)
+  {
+    m_EventIndex = new HepMCEventIndex();
+  }
+  if (!m_EventIndex->Open(fname))
+  {
+    std::cout << Name() << ": could not index " << fname << ", reading its events in sequence" << std::endl;
+  }
+  else
+  {
+    m_IndexedFile = fname;
+  }
+  if (Verbosity() > 0 && m_EventIndex->size() > 0)
+  {
+    std::cout << Name() << ": indexed " << m_EventIndex->size() << " events of " << fname << std::endl;
+  }
+  return iret;
+}
+
+int Fun4AllHepMCPileupInputManager::fileclose()
+{
+  if (m_EventIndex)
+  {
+    m_EventIndex->Close();
+  }
+  return Fun4AllHepMCInputManager::fileclose();
+}
+
 int Fun4AllHepMCPileupInputManager::SkipForThisManager(const int nevents)
 {
   for (int i = 0; i < nevents; ++i)
@@ -107,6 +168,18 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
     remove(m_HepMCTmpFile.c_str());
     return 0;
   }
+  if (m_RandomAccess && !IsOpen() && !FileListEmpty())
+  {
+    if (OpenNextFile() == InputFileHandlerReturnCodes::FAILURE)
+    {
+      std::cout << Name() << ": No Input file from filelist opened" << std::endl;
+      return -1;
+    }
+  }
+  if (m_EventIndex && m_EventIndex->size() > 0)
+  {
+    return RunRandomAccess(skip);
+  }
   // toss multiple crossings all the way back
   for (int icrossing = _min_crossing; icrossing <= _max_crossing; ++icrossing)
   {
@@ -150,18 +223,18 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
           }
           else
           {
-            evt = ascii_in->read_next_event();
+            evt = ReadNextEvent();
             if (evt && m_SignalEventNumber == evt->event_number())
             {
               delete evt;
-              evt = ascii_in->read_next_event();
+              evt = ReadNextEvent();
             }
           }
         }
 
         if (!evt)
         {
-          if (Verbosity() > 1)
+          if (Verbosity() > 1 && ascii_in)
           {
             std::cout << "error type: " << ascii_in->error_type()
                       << ", rdstate: " << ascii_in->rdstate() << std::endl;
@@ -210,6 +283,109 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
   return 0;
 }
 
+int Fun4AllHepMCPileupInputManager::RunRandomAccess(const bool skip)
+{
+  // draw all collisions of this event first, the same number of random numbers
+  // is used whether the event is skipped or not.
+  // The collisions are drawn without replacement, the same pileup event twice in one
+  // event would be a duplicate event number, which the crossing bookkeeping cannot hold
+  std::vector<std::pair<size_t, double>> sampled;
+  std::unordered_set<size_t> drawn;
+  const unsigned long nindexed = m_EventIndex->size();
+  for (int icrossing = _min_crossing; icrossing <= _max_crossing; ++icrossing)
+  {
+    double crossing_time = _time_between_crossings * icrossing;
+    int ncollisions = gsl_ran_poisson(RandomGenerator, _ave_coll_per_crossing);
+    for (int icollision = 0; icollision < ncollisions; ++icollision)
+    {
+      // same as for sequential reading: do not pile the signal event on top of itself
+      if (drawn.size() + 2 > nindexed)
+      {
+        if (!m_IndexExhausted)
+        {
+          std::cout << PHWHERE << Name() << ": " << m_IndexedFile << " holds only " << nindexed
+                    << " events, not enough to draw the pileup of an event without repeating one. Dropping collisions" << std::endl;
+          m_IndexExhausted = true;
+        }
+        continue;
+      }
+      size_t index = gsl_rng_uniform_int(RandomGenerator, nindexed);
+      while (drawn.contains(index) || m_EventIndex->EventNumber(index) == m_SignalEventNumber)
+      {
+        index = gsl_rng_uniform_int(RandomGenerator, nindexed);
+      }
+      drawn.insert(index);
+      sampled.emplace_back(index, crossing_time);
+    }
+  }
+  if (skip)
+  {
+    events_total += sampled.size();
+    return 0;
+  }
+
+  std::vector<HepMC::GenEvent *> parsed(sampled.size(), nullptr);
+  const auto start = std::chrono::steady_clock::now();
+  ParseSampled(sampled, parsed);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  CountEvents(sampled.size(), elapsed.count());
+
+  for (size_t i = 0; i < sampled.size(); ++i)
+  {
+    evt = parsed[i];
+    if (!evt)
+    {
+      std::cout << PHWHERE << Name() << ": could not parse event " << sampled[i].first << " of " << m_IndexedFile << std::endl;
+      continue;
+    }
+    if (Verbosity() > 0)
+    {
+      std::cout << "Fun4AllHepMCPileupInputManager::run::" << Name()
+                << " hepmc evt no: " << evt->event_number() << std::endl;
+    }
+    events_total++;
+    events_thisfile++;
+    // check if the local SubsysReco discards this event
+    if (RejectEvent() != Fun4AllReturnCodes::EVENT_OK)
+    {
+      delete evt;
+      evt = nullptr;
+      ResetEvent();
+      continue;
+    }
+    m_EventNumberMap.insert(std::make_pair(evt->event_number(), sampled[i].second));
+    InsertEvent(evt, sampled[i].second);
+  }
+  evt = nullptr;
+  return 0;
+}
+
+void Fun4AllHepMCPileupInputManager::ParseSampled(const std::vector<std::pair<size_t, double>> &sampled, std::vector<HepMC::GenEvent *> &parsed) const
+{
+  const std::string_view header = m_EventIndex->Header();
+  const unsigned int njobs = sampled.size();
+  // workers pick the next unparsed collision until all are done
+  std::atomic<unsigned int> next_job{0};
+  auto worker = [this, &sampled, &parsed, &next_job, header, njobs]()
+  {
+    for (unsigned int i = next_job++; i < njobs; i = next_job++)
+    {
+      parsed[i] = HepMCEventIndex::Parse(header, m_EventIndex->Event(sampled[i].first));
+    }
+  };
+  const unsigned int nthreads = std::min(m_ParseThreads, njobs);
+  std::vector<std::future<void>> workers;
+  for (unsigned int i = 1; i < nthreads; ++i)
+  {
+    workers.push_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto &w : workers)
+  {
+    w.get();
+  }
+}
+
 int Fun4AllHepMCPileupInputManager::ResetEvent()
 {
   m_EventNumberMap.clear();
@@ -9,6 +9,10 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
+
+class HepMCEventIndex;
 
 //! Generate pile up collisions based on beam parameter
 //! If set_embedding_id(i) with a negative number or 0, the pile up event will be inserted with increasing positive embedding_id. This is the default operation mode.
@@ -25,6 +29,8 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
 
   int run(const int nevents, const bool skip);
   int ResetEvent() override;
+  int fileopen(const std::string &filenam) override;
+  int fileclose() override;
   /// past times are negative, future times are positive
   void set_time_window(double past_nsec, double future_nsec)
   {
@@ -41,8 +47,15 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
   void SignalInputManager(Fun4AllHepMCInputManager *in) { m_SignalInputManager = in; }
   int PushBackEvents(const int i) override;
 
+  //! draw the pile up events at random from an index of the (uncompressed) input file instead of
+  //! reading it in sequence and parse the collisions of an event on nthreads threads.
+  //! Compressed files are read in sequence as before
+  void SetRandomAccess(const bool flag, const unsigned int nthreads = 1);
+
  private:
   int InsertEvent(HepMC::GenEvent *evt, const double crossing_time);
+  int RunRandomAccess(const bool skip);
+  void ParseSampled(const std::vector<std::pair<size_t, double>> &sampled, std::vector<HepMC::GenEvent *> &parsed) const;
 
   Fun4AllHepMCInputManager *m_SignalInputManager = nullptr;
   gsl_rng *RandomGenerator = nullptr;
@@ -66,6 +79,12 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
 
   bool _first_run = true;
 
+  bool m_RandomAccess = false;
+  unsigned int m_ParseThreads = 1;
+  HepMCEventIndex *m_EventIndex = nullptr;
+  std::string m_IndexedFile;
+  bool m_IndexExhausted = false;
+
   std::map<int, double> m_EventNumberMap;
 };
 
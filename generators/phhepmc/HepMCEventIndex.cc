@@ -0,0 +1,112 @@
+#include "HepMCEventIndex.h"
+
+#include <HepMC/GenEvent.h>
+#include <HepMC/IO_GenEvent.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+bool HepMCEventIndex::Open(const std::string &filename)
+{
+  Close();
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "HepMCEventIndex::Open: cannot open " << filename << std::endl;
+    return false;
+  }
+  struct stat st
+  {
+  };
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+  void *base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // the mapping stays valid
+  if (base == MAP_FAILED)
+  {
+    std::cout << "HepMCEventIndex::Open: cannot map " << filename << std::endl;
+    return false;
+  }
+  m_Mapped = static_cast<const char *>(base);
+  m_MappedSize = st.st_size;
+  m_End = m_MappedSize;
+
+  const std::string_view text(m_Mapped, m_MappedSize);
+  size_t pos = 0;
+  while (pos < text.size())
+  {
+    size_t eol = text.find('\n', pos);
+    if (eol == std::string_view::npos)
+    {
+      eol = text.size();
+    }
+    const std::string_view line = text.substr(pos, eol - pos);
+    if (IsEventLine(line))
+    {
+      m_Offsets.push_back(pos);
+      m_EventNumbers.push_back(std::atoi(line.data() + 2));
+    }
+    else if (IsEndLine(line))
+    {
+      m_End = pos;
+      break;
+    }
+    pos = eol + 1;
+  }
+  if (m_Offsets.empty())
+  {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void HepMCEventIndex::Close()
+{
+  if (m_Mapped)
+  {
+    munmap(const_cast<char *>(m_Mapped), m_MappedSize);
+  }
+  m_Mapped = nullptr;
+  m_MappedSize = 0;
+  m_End = 0;
+  m_Offsets.clear();
+  m_EventNumbers.clear();
+}
+
+std::string_view HepMCEventIndex::Event(const size_t i) const
+{
+  const size_t begin = m_Offsets.at(i);
+  const size_t end = (i + 1 < m_Offsets.size()) ? m_Offsets[i + 1] : m_End;
+  return {m_Mapped + begin, end - begin};
+}
+
+std::string_view HepMCEventIndex::Header() const
+{
+  if (m_Offsets.empty())
+  {
+    return {};
+  }
+  return {m_Mapped, m_Offsets.front()};
+}
+
+HepMC::GenEvent *HepMCEventIndex::Parse(std::string_view header, std::string_view event)
+{
+  std::string text;
+  text.reserve(header.size() + event.size() + 40);
+  text.append(header);
+  text.append(event);
+  text.append("HepMC::IO_GenEvent-END_EVENT_LISTING\n");
+  std::istringstream stream(text);
+  HepMC::IO_GenEvent ascii_in(stream);
+  return ascii_in.read_next_event();
+}
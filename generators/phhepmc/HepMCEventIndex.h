@@ -0,0 +1,58 @@
+#ifndef PHHEPMC_HEPMCEVENTINDEX_H
+#define PHHEPMC_HEPMCEVENTINDEX_H
+
+// Byte offsets of the events in an uncompressed HepMC2 ASCII file.
+// The file is memory mapped and scanned once for the event lines, after
+// that the text of any event can be handed to Parse() in any order and
+// from any thread. Parse() also takes event text which was split off a
+// (compressed) stream.
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HepMC
+{
+  class GenEvent;
+}
+
+class HepMCEventIndex
+{
+ public:
+  HepMCEventIndex() = default;
+  ~HepMCEventIndex() { Close(); }
+
+  HepMCEventIndex(const HepMCEventIndex &) = delete;
+  HepMCEventIndex &operator=(const HepMCEventIndex &) = delete;
+
+  //! map the file and index its events, false if it cannot be mapped or has no events
+  bool Open(const std::string &filename);
+  void Close();
+
+  size_t size() const { return m_Offsets.size(); }
+  //! text of event i (from its E line up to the next event)
+  std::string_view Event(const size_t i) const;
+  //! hepmc event number of event i, read off its E line
+  int EventNumber(const size_t i) const { return m_EventNumbers.at(i); }
+  //! everything before the first event (version and start of listing)
+  std::string_view Header() const;
+
+  //! parse the text of one event, the header supplies the listing start; nullptr on error
+  static HepMC::GenEvent *Parse(std::string_view header, std::string_view event);
+
+  //! true if this line starts a new event
+  static bool IsEventLine(std::string_view line) { return line.size() > 1 && line[0] == 'E' && line[1] == ' '; }
+  //! true if this line ends the listing
+  static bool IsEndLine(std::string_view line) { return line.starts_with("HepMC::IO_GenEvent-END_EVENT_LISTING"); }
+
+ private:
+  const char *m_Mapped{nullptr};
+  size_t m_MappedSize{0};
+  //! end of the event listing, the footer is not part of the last event
+  size_t m_End{0};
+  std::vector<size_t> m_Offsets;
+  std::vector<int> m_EventNumbers;
+};
+
+#endif /* PHHEPMC_HEPMCEVENTINDEX_H */
@@ -12,6 +12,7 @@
 #include <TSystem.h>
 #include <TTree.h>
 
+#include <chrono>
 #include <climits>
 #include <cmath>    // for NAN, isfinite
 #include <cstdint>  // for uint64_t
@@ -48,6 +49,7 @@ void CDBTTree::SetFloatValue(int channel, const std::string &name, float value)
     gSystem->Exit(1);
   }
   m_FloatEntryMap[channel].insert(std::make_pair(fieldname, value));
+  m_ColumnsBuilt = false;
 }
 
 void CDBTTree::SetDoubleValue(int channel, const std::string &name, double value)
@@ -65,6 +67,7 @@ void CDBTTree::SetDoubleValue(int channel, const std::string &name, double value
     gSystem->Exit(1);
   }
   m_DoubleEntryMap[channel].insert(std::make_pair(fieldname, value));
+  m_ColumnsBuilt = false;
 }
 
 void CDBTTree::SetIntValue(int channel, const std::string &name, int value)
@@ -82,6 +85,7 @@ void CDBTTree::SetIntValue(int channel, const std::string &name, int value)
     gSystem->Exit(1);
   }
   m_IntEntryMap[channel].insert(std::make_pair(fieldname, value));
+  m_ColumnsBuilt = false;
 }
 
 void CDBTTree::SetUInt64Value(int channel, const std::string &name, uint64_t value)
@@ -99,6 +103,7 @@ void CDBTTree::SetUInt64Value(int channel, const std::string &name, uint64_t val
     gSystem->Exit(1);
   }
   m_UInt64EntryMap[channel].insert(std::make_pair(fieldname, value));
+  m_ColumnsBuilt = false;
 }
 
 void CDBTTree::Commit()
@@ -658,6 +663,7 @@ void CDBTTree::LoadCalibrations()
   }
   f->Close();
   gROOT->cd(currdir.c_str());  // restore previous directory
+  m_ColumnsBuilt = false;
 }
 
 float CDBTTree::GetSingleFloatValue(const std::string &name, int verbose)
@@ -883,3 +889,204 @@ uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verb
   }
   return calibiter->second;
 }
+
+int CDBTTree::GetChannelRow(int channel)
+{
+  BuildColumns();
+  return ChannelRow(channel);
+}
+
+int CDBTTree::ChannelRow(int channel) const
+{
+  if (m_ChannelsContiguous)
+  {
+    if (m_Channels.empty() || channel < m_Channels.front() || channel > m_Channels.back())
+    {
+      return -1;
+    }
+    return channel - m_Channels.front();
+  }
+  auto iter = m_ChannelRows.find(channel);
+  if (iter == m_ChannelRows.end())
+  {
+    return -1;
+  }
+  return iter->second;
+}
+
+const std::vector<int> &CDBTTree::GetChannels()
+{
+  BuildColumns();
+  return m_Channels;
+}
+
+int CDBTTree::GetFloatColumnHandle(const std::string &name)
+{
+  BuildColumns();
+  return FindColumn(m_FloatColumns, "F" + name);
+}
+
+int CDBTTree::GetDoubleColumnHandle(const std::string &name)
+{
+  BuildColumns();
+  return FindColumn(m_DoubleColumns, "D" + name);
+}
+
+int CDBTTree::GetIntColumnHandle(const std::string &name)
+{
+  BuildColumns();
+  return FindColumn(m_IntColumns, "I" + name);
+}
+
+int CDBTTree::GetUInt64ColumnHandle(const std::string &name)
+{
+  BuildColumns();
+  return FindColumn(m_UInt64Columns, "g" + name);
+}
+
+std::span<const float> CDBTTree::GetFloatColumn(int handle)
+{
+  BuildColumns();
+  if (handle < 0 || handle >= static_cast<int>(m_FloatColumns.size()))
+  {
+    return {};
+  }
+  return m_FloatColumns[handle].values;
+}
+
+std::span<const double> CDBTTree::GetDoubleColumn(int handle)
+{
+  BuildColumns();
+  if (handle < 0 || handle >= static_cast<int>(m_DoubleColumns.size()))
+  {
+    return {};
+  }
+  return m_DoubleColumns[handle].values;
+}
+
+std::span<const int> CDBTTree::GetIntColumn(int handle)
+{
+  BuildColumns();
+  if (handle < 0 || handle >= static_cast<int>(m_IntColumns.size()))
+  {
+    return {};
+  }
+  return m_IntColumns[handle].values;
+}
+
+std::span<const uint64_t> CDBTTree::GetUInt64Column(int handle)
+{
+  BuildColumns();
+  if (handle < 0 || handle >= static_cast<int>(m_UInt64Columns.size()))
+  {
+    return {};
+  }
+  return m_UInt64Columns[handle].values;
+}
+
+CDBTTree::ColumnView<float> CDBTTree::GetFloatColumnView(const std::string &name)
+{
+  return {this, GetFloatColumn(GetFloatColumnHandle(name)), std::numeric_limits<float>::quiet_NaN()};
+}
+
+CDBTTree::ColumnView<double> CDBTTree::GetDoubleColumnView(const std::string &name)
+{
+  return {this, GetDoubleColumn(GetDoubleColumnHandle(name)), std::numeric_limits<double>::quiet_NaN()};
+}
+
+CDBTTree::ColumnView<int> CDBTTree::GetIntColumnView(const std::string &name)
+{
+  return {this, GetIntColumn(GetIntColumnHandle(name)), std::numeric_limits<int>::min()};
+}
+
+CDBTTree::ColumnView<uint64_t> CDBTTree::GetUInt64ColumnView(const std::string &name)
+{
+  return {this, GetUInt64Column(GetUInt64ColumnHandle(name)), std::numeric_limits<uint64_t>::max()};
+}
+
+void CDBTTree::BuildColumns()
+{
+  // transpose the per-channel maps into one array per field, rows ordered by channel
+  if (m_ColumnsBuilt)
+  {
+    return;
+  }
+  if (m_FloatEntryMap.empty() && m_DoubleEntryMap.empty() && m_IntEntryMap.empty() && m_UInt64EntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  auto starttime = std::chrono::steady_clock::now();
+  std::set<int> channels;
+  for (const auto &iter : m_FloatEntryMap)
+  {
+    channels.insert(iter.first);
+  }
+  for (const auto &iter : m_DoubleEntryMap)
+  {
+    channels.insert(iter.first);
+  }
+  for (const auto &iter : m_IntEntryMap)
+  {
+    channels.insert(iter.first);
+  }
+  for (const auto &iter : m_UInt64EntryMap)
+  {
+    channels.insert(iter.first);
+  }
+  m_Channels.assign(channels.begin(), channels.end());
+  m_ChannelsContiguous = m_Channels.empty() || (m_Channels.back() - m_Channels.front() + 1 == static_cast<int>(m_Channels.size()));
+  m_ChannelRows.clear();
+  if (!m_ChannelsContiguous)
+  {
+    for (size_t row = 0; row < m_Channels.size(); row++)
+    {
+      m_ChannelRows[m_Channels[row]] = row;
+    }
+  }
+
+  FillColumns(m_FloatEntryMap, m_FloatColumns, std::numeric_limits<float>::quiet_NaN());
+  FillColumns(m_DoubleEntryMap, m_DoubleColumns, std::numeric_limits<double>::quiet_NaN());
+  FillColumns(m_IntEntryMap, m_IntColumns, std::numeric_limits<int>::min());
+  FillColumns(m_UInt64EntryMap, m_UInt64Columns, std::numeric_limits<uint64_t>::max());
+  m_ColumnsBuilt = true;
+  if (verbosity > 0)
+  {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - starttime;
+    std::cout << "CDBTTree: built " << (m_FloatColumns.size() + m_DoubleColumns.size() + m_IntColumns.size() + m_UInt64Columns.size())
+              << " columns for " << m_Channels.size() << " channels in " << elapsed.count() << " ms" << std::endl;
+  }
+}
+
+template <class T>
+void CDBTTree::FillColumns(const std::map<int, std::map<std::string, T>> &entrymap, std::vector<Column<T>> &columns, T missing)
+{
+  columns.clear();
+  std::map<std::string, int> handles;
+  for (const auto &channeliter : entrymap)
+  {
+    const int row = ChannelRow(channeliter.first);
+    for (const auto &fielditer : channeliter.second)
+    {
+      auto handleiter = handles.find(fielditer.first);
+      if (handleiter == handles.end())
+      {
+        handleiter = handles.insert(std::make_pair(fielditer.first, static_cast<int>(columns.size()))).first;
+        columns.push_back({fielditer.first, std::vector<T>(m_Channels.size(), missing)});
+      }
+      columns[handleiter->second].values[row] = fielditer.second;
+    }
+  }
+}
+
+template <class T>
+int CDBTTree::FindColumn(const std::vector<Column<T>> &columns, const std::string &fieldname)
+{
+  for (size_t i = 0; i < columns.size(); i++)
+  {
+    if (columns[i].name == fieldname)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
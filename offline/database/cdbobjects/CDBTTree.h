@@ -3,7 +3,10 @@
 
 #include <cstdint>
 #include <map>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class TTree;
 
@@ -52,6 +55,51 @@ class CDBTTree
   const auto &GetIntEntryMap() const { return m_IntEntryMap; }
   const auto &GetUInt64EntryMap() const { return m_UInt64EntryMap; }
 
+  // column access to the multiple-entry payload: one dense array per field with one row per channel.
+  // Resolve the field name to a handle once (-1 if no channel has it), then read the whole column.
+  // Channels without the field read as NaN (float, double), INT_MIN (int) or UINT64_MAX (uint64), like the Get...Value() methods.
+  // Handles and spans stay valid until the payload is reloaded or modified.
+  int GetChannelRow(int channel);  // row of this channel in every column, -1 if the channel is not in the payload
+  const std::vector<int> &GetChannels();
+  int GetFloatColumnHandle(const std::string &name);
+  int GetDoubleColumnHandle(const std::string &name);
+  int GetIntColumnHandle(const std::string &name);
+  int GetUInt64ColumnHandle(const std::string &name);
+  std::span<const float> GetFloatColumn(int handle);
+  std::span<const double> GetDoubleColumn(int handle);
+  std::span<const int> GetIntColumn(int handle);
+  std::span<const uint64_t> GetUInt64Column(int handle);
+
+  // a resolved column read by channel: view(channel) gives the same value as Get...Value(channel, name)
+  template <class T>
+  class ColumnView
+  {
+   public:
+    ColumnView() = default;
+    ColumnView(CDBTTree *tree, std::span<const T> column, T missing)
+      : m_Tree(tree)
+      , m_Values(column)
+      , m_Missing(missing)
+    {
+    }
+    T operator()(int channel) const
+    {
+      int row = (m_Tree && !m_Values.empty()) ? m_Tree->GetChannelRow(channel) : -1;
+      return (row < 0) ? m_Missing : m_Values[row];
+    }
+    std::span<const T> values() const { return m_Values; }
+    bool valid() const { return !m_Values.empty(); }
+
+   private:
+    CDBTTree *m_Tree{nullptr};
+    std::span<const T> m_Values;
+    T m_Missing{};
+  };
+  ColumnView<float> GetFloatColumnView(const std::string &name);
+  ColumnView<double> GetDoubleColumnView(const std::string &name);
+  ColumnView<int> GetIntColumnView(const std::string &name);
+  ColumnView<uint64_t> GetUInt64ColumnView(const std::string &name);
+
   const auto &GetSingleFloatEntryMap() const { return m_SingleFloatEntryMap; }
   const auto &GetSingleDoubleEntryMap() const { return m_SingleDoubleEntryMap; }
   const auto &GetSingleIntEntryMap() const { return m_SingleIntEntryMap; }
@@ -77,6 +125,28 @@ class CDBTTree
   std::map<std::string, int> m_SingleIntEntryMap;
   std::map<int, std::map<std::string, uint64_t>> m_UInt64EntryMap;
   std::map<std::string, uint64_t> m_SingleUInt64EntryMap;
+
+  template <class T>
+  struct Column
+  {
+    std::string name;
+    std::vector<T> values;
+  };
+  void BuildColumns();
+  int ChannelRow(int channel) const;
+  template <class T>
+  void FillColumns(const std::map<int, std::map<std::string, T>> &entrymap, std::vector<Column<T>> &columns, T missing);
+  template <class T>
+  static int FindColumn(const std::vector<Column<T>> &columns, const std::string &fieldname);
+
+  bool m_ColumnsBuilt{false};
+  bool m_ChannelsContiguous{false};  // channels are m_Channels[0], m_Channels[0]+1, ... so the row is an offset
+  std::vector<int> m_Channels;       // sorted channels of the multiple-entry payload
+  std::unordered_map<int, int> m_ChannelRows;  // channel -> row when the channels are not contiguous
+  std::vector<Column<float>> m_FloatColumns;
+  std::vector<Column<double>> m_DoubleColumns;
+  std::vector<Column<int>> m_IntColumns;
+  std::vector<Column<uint64_t>> m_UInt64Columns;
 };
 
 #endif
@@ -19,19 +19,48 @@ nlohmann::json SphenixClient::getPayloadIOVs(long long iov)
   return nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
 }
 
-nlohmann::json SphenixClient::getUrl(const std::string& pl_type, long long iov)
+int SphenixClient::prefetch(long long iov)
 {
+  if (m_PayloadIOVCache.contains(iov))
+  {
+    return 0;
+  }
   nlohmann::json resp = getPayloadIOVs(iov);
   if (resp["code"] != 0)
   {
-    return resp;
+    if (m_Verbosity > 0)
+    {
+      std::cout << resp << std::endl;
+    }
+    return resp["code"];
+  }
+  m_PayloadIOVCache[iov] = resp["msg"];
+  return 0;
+}
+
+nlohmann::json SphenixClient::getUrl(const std::string& pl_type, long long iov)
+{
+  nlohmann::json resp;
+  const nlohmann::json *payload_iovs = nullptr;
+  auto cacheiter = m_PayloadIOVCache.find(iov);
+  if (cacheiter != m_PayloadIOVCache.end())
+  {
+    payload_iovs = &cacheiter->second;
+  }
+  else
+  {
+    resp = getPayloadIOVs(iov);
+    if (resp["code"] != 0)
+    {
+      return resp;
+    }
+    payload_iovs = &resp["msg"];
   }
-  nlohmann::json payload_iovs = resp["msg"];
-  if (!payload_iovs.contains(pl_type))
+  if (!payload_iovs->contains(pl_type))
   {
     return nopayloadclient::DataBaseException("No valid payload with type " + pl_type).jsonify();
   }
-  nlohmann::json payload_iov = payload_iovs[pl_type];
+  const nlohmann::json &payload_iov = payload_iovs->at(pl_type);
   if (m_Verbosity > 0)
   {
     std::cout << "pl_type: " << pl_type
@@ -78,11 +107,13 @@ nlohmann::json SphenixClient::getUrlDict(long long iov)
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start, long long iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start, 0, iov_end);
 }
 
@@ -123,12 +154,14 @@ nlohmann::json SphenixClient::lockGlobalTag(const std::string& gt_name)
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start, long long iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start, 0, iov_end);
 }
 
@@ -143,6 +176,7 @@ nlohmann::json SphenixClient::setGlobalTag(const std::string& gt_name)
   if (existGlobalTag(gt_name))
   {
     m_CachedGlobalTag = gt_name;
+    m_PayloadIOVCache.clear();
     return nopayloadclient::NoPayloadClient::setGlobalTag(gt_name);
   }
 
@@ -158,6 +192,7 @@ int SphenixClient::cache_set_GlobalTag(const std::string& tagname)
     return iret;
   }
   m_CachedGlobalTag = tagname;
+  m_PayloadIOVCache.clear();
   nopayloadclient::NoPayloadClient::setGlobalTag(tagname);
   bool found_gt = false;
   nlohmann::json resp = nopayloadclient::NoPayloadClient::getGlobalTags();
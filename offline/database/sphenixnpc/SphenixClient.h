@@ -5,6 +5,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <map>
 #include <set>
 #include <string>
 
@@ -37,6 +38,10 @@ class SphenixClient : public nopayloadclient::NoPayloadClient
   int createDomain(const std::string& domain);
   int cache_set_GlobalTag(const std::string& name);
   bool isGlobalTagSet();
+  // fetch all payload urls of the global tag for this iov in one request,
+  // subsequent getUrl/getCalibration calls for this iov are served from memory
+  int prefetch(long long iov);
+  void clearPayloadIOVCache() { m_PayloadIOVCache.clear(); }
   void Verbosity(int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
@@ -45,6 +50,8 @@ class SphenixClient : public nopayloadclient::NoPayloadClient
   std::string m_CachedGlobalTag;
   std::set<std::string> m_DomainCache;
   std::set<std::string> m_GlobalTagCache;
+  // iov -> payload iovs of all domains (the "msg" of getPayloadIOVs)
+  std::map<long long, nlohmann::json> m_PayloadIOVCache;
 };
 
 #endif  // SPHENIXNPC_SPHENIXCLIENT_H
@@ -20,11 +20,54 @@
 
 #include <TSystem.h>
 
-#include <cstdint>   // for uint64_t
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>  // for kill
+#include <cstdlib>  // for atoi
+#include <cstdint>  // for uint64_t
+#include <filesystem>
+#include <fstream>
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <sstream>
+#include <unistd.h>  // for getpid, gethostname
 #include <utility>   // for pair
 #include <vector>    // for vector
 
+namespace
+{
+  // 64 bit FNV-1a, used to name files in the local payload cache
+  constexpr uint64_t fnv_offset = 14695981039346656037ULL;
+  constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+  uint64_t fnv1a(const char *data, std::size_t size, uint64_t hash = fnv_offset)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= fnv_prime;
+    }
+    return hash;
+  }
+
+  std::string to_hex(uint64_t value)
+  {
+    std::ostringstream os;
+    os << std::hex << value;
+    return os.str();
+  }
+
+  std::string hostname()
+  {
+    std::array<char, 256> name{};
+    if (gethostname(name.data(), name.size() - 1) != 0)
+    {
+      return "localhost";
+    }
+    return name.data();
+  }
+}  // namespace
+
 CDBInterface *CDBInterface::__instance{nullptr};
 
 CDBInterface *CDBInterface::instance()
@@ -50,6 +93,12 @@ CDBInterface::CDBInterface(const std::string &name)
 CDBInterface::~CDBInterface()
 {
   delete cdbclient;
+  // release the objects this job used, open files stay readable
+  if (!m_LocalCacheInUseDir.empty())
+  {
+    std::error_code ec;
+    std::filesystem::remove_all(m_LocalCacheInUseDir, ec);
+  }
 }
 
 //____________________________________________________________________________..
@@ -140,11 +189,15 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
     std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
     gSystem->Exit(1);
   }
-  if (cdbclient == nullptr)
+  getClient();
+  uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
+  // the server returns the payloads of all domains for a given timestamp anyway,
+  // keep them so that every following lookup is served from memory.
+  // A failed prefetch is not repeated, the lookups then go to the server one by one
+  if (m_PrefetchedTimestamps.insert(timestamp).second)
   {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+    cdbclient->prefetch(timestamp);
   }
-  uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
   if (Verbosity() > 0)
   {
     std::cout << "Global Tag: " << rc->get_StringFlag("CDB_GLOBALTAG")
@@ -194,5 +247,252 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
 		<< ", time stamp: " << timestamp << std::endl;
     }
   }
+  // the run node keeps the original url, only the returned file is local
+  if (!m_LocalCacheDir.empty() && !return_url.empty())
+  {
+    return_url = cacheLocally(return_url);
+  }
   return return_url;
 }
+
+SphenixClient *CDBInterface::getClient()
+{
+  if (cdbclient == nullptr)
+  {
+    recoConsts *rc = recoConsts::instance();
+    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+  }
+  return cdbclient;
+}
+
+int CDBInterface::prefetch()
+{
+  if (disable)
+  {
+    return 0;
+  }
+  recoConsts *rc = recoConsts::instance();
+  if (!rc->FlagExist("CDB_GLOBALTAG") || !rc->FlagExist("TIMESTAMP"))
+  {
+    std::cout << PHWHERE << "CDB_GLOBALTAG and TIMESTAMP flags need to be set before prefetching" << std::endl;
+    return -1;
+  }
+  const uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
+  m_PrefetchedTimestamps.insert(timestamp);
+  return getClient()->prefetch(timestamp);
+}
+
+std::string CDBInterface::cacheLocally(const std::string &url)
+{
+  auto mapiter = m_LocalCacheMap.find(url);
+  if (mapiter != m_LocalCacheMap.end())
+  {
+    return mapiter->second;
+  }
+  // only plain files can be copied, anything else (e.g. xrootd urls) is used as is
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(url, ec))
+  {
+    return url;
+  }
+  const uint64_t size = std::filesystem::file_size(url, ec);
+  const auto mtime = std::filesystem::last_write_time(url, ec).time_since_epoch().count();
+  if (ec)
+  {
+    return url;
+  }
+
+  // the index maps url, size and modification time to the content hash,
+  // so known payloads are found without reading them again
+  const std::filesystem::path cachedir(m_LocalCacheDir);
+  const std::filesystem::path objectdir = cachedir / "objects";
+  const std::filesystem::path indexdir = cachedir / "index";
+  const std::filesystem::path incomingdir = cachedir / "incoming";
+  const std::string extension = std::filesystem::path(url).extension().string();
+  std::ostringstream urlkey;
+  urlkey << url << ":" << size << ":" << mtime;
+  const std::string keystring = urlkey.str();
+  const std::filesystem::path indexfile = indexdir / to_hex(fnv1a(keystring.data(), keystring.size()));
+  const std::string tmpsuffix = ".tmp" + std::to_string(getpid());
+
+  std::string objectname;
+  {
+    std::ifstream index(indexfile);
+    index >> objectname;
+  }
+  std::filesystem::path object = objectdir / objectname;
+  bool copied = false;
+  if (!objectname.empty() && std::filesystem::exists(object, ec))
+  {
+    // mark as recently used for the size bound
+    std::filesystem::last_write_time(object, std::filesystem::file_time_type::clock::now(), ec);
+  }
+  else
+  {
+    // copy while hashing the content, identical payloads stored under
+    // different urls end up as one object
+    std::filesystem::create_directories(objectdir, ec);
+    std::filesystem::create_directories(indexdir, ec);
+    std::filesystem::create_directories(incomingdir, ec);
+    const std::filesystem::path tmpobject = incomingdir / (to_hex(fnv1a(keystring.data(), keystring.size())) + tmpsuffix);
+    uint64_t hash = fnv_offset;
+    {
+      std::ifstream in(url, std::ios::binary);
+      std::ofstream out(tmpobject, std::ios::binary);
+      std::vector<char> buffer(1U << 20U);
+      while (in && out)
+      {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const std::streamsize nread = in.gcount();
+        hash = fnv1a(buffer.data(), nread, hash);
+        out.write(buffer.data(), nread);
+      }
+      if (!out || in.bad())
+      {
+        std::cout << PHWHERE << " could not copy " << url << " to local cache, using original" << std::endl;
+        out.close();
+        std::filesystem::remove(tmpobject, ec);
+        m_LocalCacheMap[url] = url;
+        return url;
+      }
+    }
+    objectname = to_hex(hash) + extension;
+    object = objectdir / objectname;
+    // rename is atomic, concurrent jobs never see a partial copy
+    std::filesystem::rename(tmpobject, object, ec);
+    if (ec)
+    {
+      std::filesystem::remove(tmpobject, ec);
+      m_LocalCacheMap[url] = url;
+      return url;
+    }
+    const std::filesystem::path tmpindex = indexfile.string() + tmpsuffix;
+    {
+      std::ofstream index(tmpindex);
+      index << objectname << std::endl;
+    }
+    std::filesystem::rename(tmpindex, indexfile, ec);
+    if (Verbosity() > 0)
+    {
+      std::cout << "CDBInterface: cached " << url << " as " << object << std::endl;
+    }
+    copied = true;
+  }
+
+  // this job works with its own hard link of the object. trimLocalCache()
+  // leaves objects with more than one link alone, and if another job removes
+  // the object in between the data stays reachable through the link
+  if (m_LocalCacheInUseDir.empty())
+  {
+    m_LocalCacheInUseDir = (cachedir / "inuse" / (hostname() + "." + std::to_string(getpid()))).string();
+  }
+  std::filesystem::create_directories(m_LocalCacheInUseDir, ec);
+  const std::filesystem::path inuse = std::filesystem::path(m_LocalCacheInUseDir) / objectname;
+  if (!std::filesystem::exists(inuse, ec))
+  {
+    std::filesystem::create_hard_link(object, inuse, ec);
+    if (ec)
+    {
+      // the object was removed since the index lookup or the file system
+      // has no hard links, use the original
+      if (Verbosity() > 0)
+      {
+        std::cout << "CDBInterface: could not link " << object << " (" << ec.message() << "), using " << url << std::endl;
+      }
+      m_LocalCacheMap[url] = url;
+      return url;
+    }
+  }
+  m_LocalCacheMap[url] = inuse.string();
+  if (copied)
+  {
+    trimLocalCache();
+  }
+  return inuse.string();
+}
+
+void CDBInterface::trimLocalCache()
+{
+  // least recently used objects are removed first, other jobs might do the
+  // same concurrently so every filesystem error here is ignored.
+  // Objects in use by a job have a hard link in inuse/<host>.<pid> and are
+  // never removed, the links of jobs which died on this host are cleaned up
+  const std::filesystem::path cachedir(m_LocalCacheDir);
+  const std::filesystem::path objectdir = cachedir / "objects";
+  const std::string thishost = hostname();
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(cachedir / "inuse", ec))
+  {
+    const std::string jobname = entry.path().filename().string();
+    const auto dot = jobname.rfind('.');
+    if (dot == std::string::npos || jobname.substr(0, dot) != thishost)
+    {
+      continue;
+    }
+    const pid_t pid = std::atoi(jobname.substr(dot + 1).c_str());
+    if (pid > 0 && kill(pid, 0) != 0 && errno == ESRCH)
+    {
+      std::filesystem::remove_all(entry.path(), ec);
+    }
+  }
+
+  std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> objects;
+  uint64_t total = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(objectdir, ec))
+  {
+    if (!entry.is_regular_file(ec))
+    {
+      continue;
+    }
+    total += entry.file_size(ec);
+    if (entry.hard_link_count(ec) == 1)
+    {
+      objects.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+  }
+  if (total <= m_LocalCacheMaxBytes)
+  {
+    return;
+  }
+  std::sort(objects.begin(), objects.end());
+  bool removed = false;
+  for (const auto &object : objects)
+  {
+    if (total <= m_LocalCacheMaxBytes)
+    {
+      break;
+    }
+    const uint64_t size = std::filesystem::file_size(object.second, ec);
+    // a job may have linked it since the directory scan
+    if (std::filesystem::hard_link_count(object.second, ec) != 1)
+    {
+      continue;
+    }
+    if (std::filesystem::remove(object.second, ec))
+    {
+      total -= size;
+      removed = true;
+    }
+  }
+  if (!removed)
+  {
+    return;
+  }
+  // index entries of removed objects go with them
+  for (const auto &entry : std::filesystem::directory_iterator(cachedir / "index", ec))
+  {
+    if (entry.path().filename().string().find(".tmp") != std::string::npos)
+    {
+      continue;
+    }
+    std::string objectname;
+    {
+      std::ifstream index(entry.path());
+      index >> objectname;
+    }
+    if (objectname.empty() || !std::filesystem::exists(objectdir / objectname, ec))
+    {
+      std::filesystem::remove(entry.path(), ec);
+    }
+  }
+}
@@ -6,6 +6,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <cstdint>  // for uint64_t
+#include <map>
 #include <set>
 #include <string>
 #include <tuple>  // for tuple
@@ -34,14 +35,40 @@ class CDBInterface : public SubsysReco
 
   std::string getUrl(const std::string &domain, const std::string &filename = "");
 
+  // resolve the urls of all domains for the current timestamp in one request
+  // (getUrl does this on its first call, an explicit call front-loads it)
+  int prefetch();
+
+  // copy payloads into a local, content addressed cache which is shared
+  // by all jobs using the same directory. The least recently used payloads
+  // are removed once the cache exceeds max_bytes, payloads in use by a job
+  // are kept
+  void setLocalCache(const std::string &dir, const uint64_t max_bytes = 10'000'000'000ULL)
+  {
+    m_LocalCacheDir = dir;
+    m_LocalCacheMaxBytes = max_bytes;
+  }
+
  private:
   CDBInterface(const std::string &name = "CDBInterface");
 
+  SphenixClient *getClient();
+  std::string cacheLocally(const std::string &url);
+  void trimLocalCache();
+
   static CDBInterface *__instance;
   SphenixClient *cdbclient{nullptr};
   bool disable{false};
   bool disable_default{false};
   std::set<std::tuple<std::string, std::string, uint64_t>> m_UrlVector;
+  std::string m_LocalCacheDir;
+  uint64_t m_LocalCacheMaxBytes{0};
+  // payload url -> local copy, every payload is copied once per job
+  std::map<std::string, std::string> m_LocalCacheMap;
+  // hard links of the objects used by this job, removed at the end
+  std::string m_LocalCacheInUseDir;
+  // timestamps the payloads were already prefetched (or tried) for
+  std::set<uint64_t> m_PrefetchedTimestamps;
 };
 
 #endif  // FFAMODULES_CDBINTERFACE_H
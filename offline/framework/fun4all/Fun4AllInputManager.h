@@ -31,6 +31,8 @@ class Fun4AllInputManager : public Fun4AllBase, public InputFileHandler
   virtual int setBranches() { return -1; }  // publich bc needed by the sync manager
   virtual int SkipForThisManager(const int /*nevents*/) { return 0; }
   virtual int HasSyncObject() const { return 0; }
+  //! streaming inputs cannot skip events, they are not supported by the multi-process mode
+  virtual bool IsStreaming() const { return false; }
   virtual std::string GetString(const std::string &) const { return ""; }
   virtual int PushBackEvents(const int /*nevt*/) { return -1; }
   virtual int RejectEvent();
@@ -23,23 +23,158 @@
 #include <phool/phool.h>
 #include <phool/recoConsts.h>
 
+#include <sphenixodbc/ODBCInterface.h>
+
 #include <Rtypes.h>  // for kMAXSIGNALS
 #include <TDirectory.h>
+#include <TFile.h>
+#include <TFileMerger.h>
 #include <TH1.h>
+#include <TKey.h>
+#include <TObjArray.h>
 #include <TROOT.h>
 #include <TSysEvtHandler.h>  // for ESignals
 
 #include <TSystem.h>
+#include <TTree.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
 #include <sstream>
 
 // #define FFAMEMTRACKER
 
+namespace
+{
+  // what a worker sends back to the parent through its pipe
+  struct WorkerReport
+  {
+    int worker{-1};
+    int nevents{0};
+    double seconds{0};
+    long rss{0};  // kB
+    long pss{0};  // kB, pages shared copy-on-write are divided among the processes using them
+    unsigned int nblockwords{0};  // size of the block record which follows the report
+  };
+
+  // pipes may return or take fewer bytes than requested
+  bool write_all(int fd, const void *buffer, size_t size)
+  {
+    const char *p = static_cast<const char *>(buffer);
+    while (size > 0)
+    {
+      ssize_t n = write(fd, p, size);
+      if (n < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      if (n <= 0)
+      {
+        return false;
+      }
+      p += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  bool read_all(int fd, void *buffer, size_t size)
+  {
+    char *p = static_cast<char *>(buffer);
+    while (size > 0)
+    {
+      ssize_t n = read(fd, p, size);
+      if (n < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      if (n <= 0)
+      {
+        return false;
+      }
+      p += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  void get_memory(long &rss, long &pss)
+  {
+    rss = 0;
+    pss = 0;
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string line;
+    while (std::getline(smaps, line))
+    {
+      std::istringstream in(line);
+      std::string key;
+      long value = 0;
+      in >> key >> value;
+      if (key == "Rss:")
+      {
+        rss = value;
+      }
+      else if (key == "Pss:")
+      {
+        pss = value;
+      }
+    }
+  }
+
+  double wall_seconds()
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // threads of this process, fork() copies only the calling one. -1 if it cannot be determined
+  int running_threads()
+  {
+    std::error_code ec;
+    int nthreads = 0;
+    for (std::filesystem::directory_iterator it("/proc/self/task", ec), end; !ec && it != end; it.increment(ec))
+    {
+      nthreads++;
+    }
+    return ec ? -1 : nthreads;
+  }
+
+  // the objects of a file with their path relative to the top directory, as the histogram managers name them
+  void collect_objects(TDirectory *dir, const std::string &path, std::vector<std::pair<std::string, TObject *>> &objects)
+  {
+    for (TObject *key : *dir->GetListOfKeys())
+    {
+      // only the highest cycle of an object
+      if (dir->GetKey(key->GetName()) != key)
+      {
+        continue;
+      }
+      TObject *obj = dir->Get(key->GetName());
+      const std::string name = path.empty() ? std::string(key->GetName()) : path + "/" + key->GetName();
+      if (auto *subdir = dynamic_cast<TDirectory *>(obj))
+      {
+        collect_objects(subdir, name, objects);
+      }
+      else if (obj)
+      {
+        objects.emplace_back(name, obj);
+      }
+    }
+  }
+}  // namespace
+
 Fun4AllServer *Fun4AllServer::__instance = nullptr;
 
 Fun4AllServer *Fun4AllServer::instance()
@@ -216,6 +351,14 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
   }
   PHCompositeNode *subsystopNode = se->topNode(topnodename);
   std::pair<SubsysReco *, PHCompositeNode *> newsubsyspair(subsystem, subsystopNode);
+  if (!m_Workers.empty())
+  {
+    // the modules run in the workers, the parent keeps them only to delete them
+    gROOT->cd(currdir.c_str());
+    Subsystems.push_back(newsubsyspair);
+    RetCodes.push_back(0);
+    return 0;
+  }
   int iret = 0;
   try
   {
@@ -383,6 +526,15 @@ int Fun4AllServer::registerOutputManager(Fun4AllOutputManager *manager)
   {
     std::cout << "Registering OutputManager " << manager->Name() << std::endl;
   }
+  if (m_WorkerId >= 0)
+  {
+    if (dynamic_cast<Fun4AllDstOutputManager *>(manager) && !manager->ApplyFileRule())
+    {
+      // the script runs on the merged file
+      manager->SetClosingScript("");
+    }
+    manager->OutFileName(WorkerFileName(manager->OutFileName(), m_WorkerId));
+  }
   UpdateEventSelector(manager);
   OutputManager.push_back(manager);
   return 0;
@@ -811,6 +963,7 @@ int Fun4AllServer::ResetNodeTree()
 {
   PHNodeReset reset;
   reset.Verbosity(Verbosity() > 2 ? Verbosity() - 2 : 0);  // one lower verbosity level than Fun4AllServer
+  reset.Recycle(m_RecycleObjects);
   std::map<std::string, PHCompositeNode *>::const_iterator iter;
   for (iter = topnodemap.begin(); iter != topnodemap.end(); ++iter)
   {
@@ -1104,74 +1257,91 @@ int Fun4AllServer::EndRun(const int runno)
 
 int Fun4AllServer::End()
 {
-  recoConsts *rc = recoConsts::instance();
-  EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
+  int nfailed = 0;
   int i = 0;
-  std::vector<std::pair<SubsysReco *, PHCompositeNode *>>::iterator iter;
-  gROOT->cd(default_Tdirectory.c_str());
-  std::string currdir = gDirectory->GetPath();
-  for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
+  if (!m_Workers.empty())
+  {
+    // the parent neither initialized nor ran the modules, it only merges what the workers wrote
+    nfailed = CollectWorkers() + MergeWorkerOutputs() + (m_WorkerInputError ? 1 : 0);
+  }
+  else
   {
-    if (Verbosity() >= VERBOSITY_SOME)
+    if (m_WorkerId >= 0 && m_WorkerBlockOpen)
     {
-      std::cout << "Fun4AllServer::End: End for " << (*iter).first->Name() << std::endl;
+      RecordWorkerBlock();
     }
-    std::string newdirname = (*iter).second->getName() + "/" + (*iter).first->Name();
-    if (!gROOT->cd(newdirname.c_str()))
+    recoConsts *rc = recoConsts::instance();
+    EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
+    std::vector<std::pair<SubsysReco *, PHCompositeNode *>>::iterator iter;
+    gROOT->cd(default_Tdirectory.c_str());
+    std::string currdir = gDirectory->GetPath();
+    for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
     {
-      std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
-                << (*iter).second->getName()
-                << " - send e-mail to off-l with your macro" << std::endl;
-      exit(1);
-    }
-    else
-    {
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      if (Verbosity() >= VERBOSITY_SOME)
       {
-        std::cout << "End: cded to " << newdirname << std::endl;
+        std::cout << "Fun4AllServer::End: End for " << (*iter).first->Name() << std::endl;
       }
+      std::string newdirname = (*iter).second->getName() + "/" + (*iter).first->Name();
+      if (!gROOT->cd(newdirname.c_str()))
+      {
+        std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+                  << (*iter).second->getName()
+                  << " - send e-mail to off-l with your macro" << std::endl;
+        exit(1);
+      }
+      else
+      {
+        if (Verbosity() >= VERBOSITY_EVEN_MORE)
+        {
+          std::cout << "End: cded to " << newdirname << std::endl;
+        }
+      }
+      try
+      {
+        i += (*iter).first->End((*iter).second);
+      }
+      catch (const std::exception &e)
+      {
+        std::cout << PHWHERE << " caught exception thrown during SusbsysReco::End() from "
+                  << (*iter).first->Name() << std::endl;
+        std::cout << "error: " << e.what() << std::endl;
+        exit(1);
+      }
+      catch (...)
+      {
+        std::cout << PHWHERE << " caught unknown type exception thrown during SubsysReco::End() from "
+                  << (*iter).first->Name() << std::endl;
+        exit(1);
+      }
+      std::cout.copyfmt(m_saved_cout_state); // restore cout to default formatting
     }
-    try
-    {
-      i += (*iter).first->End((*iter).second);
-    }
-    catch (const std::exception &e)
-    {
-      std::cout << PHWHERE << " caught exception thrown during SusbsysReco::End() from "
-                << (*iter).first->Name() << std::endl;
-      std::cout << "error: " << e.what() << std::endl;
-      exit(1);
-    }
-    catch (...)
+    gROOT->cd(currdir.c_str());
+    PHNodeIterator nodeiter(TopNode);
+    PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
+    if (!runNode)
     {
-      std::cout << PHWHERE << " caught unknown type exception thrown during SubsysReco::End() from "
-                << (*iter).first->Name() << std::endl;
-      exit(1);
+      std::cout << "No Run Node, not writing Runwise info" << std::endl;
     }
-    std::cout.copyfmt(m_saved_cout_state); // restore cout to default formatting
-  }
-  gROOT->cd(currdir.c_str());
-  PHNodeIterator nodeiter(TopNode);
-  PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
-  if (!runNode)
-  {
-    std::cout << "No Run Node, not writing Runwise info" << std::endl;
-  }
-  else
-  {
-    if (!OutputManager.empty())  // there are registered IO managers
+    else
     {
-      MakeNodesTransient(runNode);  // make all nodes transient by default
-      std::vector<Fun4AllOutputManager *>::iterator IOiter;
-      for (IOiter = OutputManager.begin(); IOiter != OutputManager.end(); ++IOiter)
+      if (!OutputManager.empty())  // there are registered IO managers
       {
-        (*IOiter)->WriteNode(runNode);
+        MakeNodesTransient(runNode);  // make all nodes transient by default
+        std::vector<Fun4AllOutputManager *>::iterator IOiter;
+        for (IOiter = OutputManager.begin(); IOiter != OutputManager.end(); ++IOiter)
+        {
+          (*IOiter)->WriteNode(runNode);
+        }
       }
     }
   }
   // close output files (check for existing output managers is
   // done inside outfileclose())
   outfileclose();
+  if (m_WorkerId >= 0)
+  {
+    FinishWorker();  // does not return
+  }
   for (auto &histit : HistoManager)
   {
     if (histit->ApplyFileRule())
@@ -1207,7 +1377,7 @@ int Fun4AllServer::End()
     std::cout << "*******************************************************************************" << std::endl;
   }
 
-  return i;
+  return i + nfailed;
 }
 
 void Fun4AllServer::Print(const std::string &what) const
@@ -1396,6 +1566,18 @@ int Fun4AllServer::registerInputManager(Fun4AllInputManager *InManager)
     std::cout << "Registering Input Manager " << InManager->Name()
 	      << std::endl;
   }
+  if (m_NumWorkers > 1 && InManager->IsStreaming())
+  {
+    // workers skip the events of the other workers, which streaming inputs cannot do
+    std::cout << PHWHERE << " streaming input " << InManager->Name() << " cannot be processed by workers" << std::endl;
+    if (m_WorkerId >= 0)
+    {
+      std::cout.flush();
+      _exit(1);  // reported as a failed worker by the parent
+    }
+    m_WorkerInputError = true;
+    return -1;
+  }
   int iret = defaultSyncManager->registerInputManager(InManager);
   return iret;
 }
@@ -1436,6 +1618,15 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
     runnumber = rc->get_IntFlag("RUNNUMBER");
     std::cout << "Fun4AllServer: Runnumber forced to " << runnumber << " by RUNNUMBER IntFlag" << std::endl;
   }
+  if (!m_Workers.empty())
+  {
+    // the events are processed by the workers, End() collects them
+    if (Verbosity() > 0)
+    {
+      std::cout << "Fun4AllServer: events are processed by the " << m_NumWorkers << " workers" << std::endl;
+    }
+    return 0;
+  }
   int iret = 0;
   int icnt = 0;
   int icnt_good = 0;
@@ -1523,6 +1714,28 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
       setRun(runnumber);
       BeginRun(runnumber);
       ifirst = 0;
+      if (m_WorkerId >= 0)
+      {
+        // a worker has read the first event of the input, it moves on to the first event of its blocks
+        m_WorkerNRequired = nevnts / m_NumWorkers + ((m_WorkerId < nevnts % m_NumWorkers) ? 1 : 0);
+        m_WorkerEvent = NextWorkerEvent(0);
+        if (require_nevents ? (nevnts > 0 && m_WorkerNRequired == 0) : (nevnts > 0 && m_WorkerEvent >= nevnts))
+        {
+          break;
+        }
+        if (m_WorkerEvent > 0)
+        {
+          if (m_WorkerEvent > 1)
+          {
+            iret = skip(m_WorkerEvent - 1);
+            if (iret)
+            {
+              break;
+            }
+          }
+          continue;
+        }
+      }
     }
     else if (!run_number_forced)
     {
@@ -1558,6 +1771,42 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
 
     ++icnt;  // completed one event processing
 
+    if (m_WorkerId >= 0)
+    {
+      m_WorkerNEvents++;
+      m_WorkerBlockOpen = true;
+      if (std::find(RetCodes.begin(),
+                    RetCodes.end(),
+                    static_cast<int>(Fun4AllReturnCodes::ABORTEVENT)) == RetCodes.end())
+      {
+        m_WorkerNGood++;
+      }
+      if (iret || (require_nevents && nevnts > 0 && m_WorkerNGood >= m_WorkerNRequired))
+      {
+        break;
+      }
+      // move on to the next event of this worker's blocks
+      int nextevent = NextWorkerEvent(m_WorkerEvent + 1);
+      if (nextevent / m_WorkerBlockSize != m_WorkerEvent / m_WorkerBlockSize)
+      {
+        RecordWorkerBlock();
+      }
+      if (!require_nevents && nevnts > 0 && nextevent >= nevnts)
+      {
+        break;
+      }
+      if (nextevent > m_WorkerEvent + 1)
+      {
+        iret = skip(nextevent - m_WorkerEvent - 1);
+        if (iret)
+        {
+          break;
+        }
+      }
+      m_WorkerEvent = nextevent;
+      continue;
+    }
+
     if (require_nevents)
     {
       if (std::find(RetCodes.begin(),
@@ -1826,3 +2075,431 @@ int Fun4AllServer::UpdateRunNode()
   }
   return iret;
 }
+
+void Fun4AllServer::setNumWorkers(const int nworkers, const int blocksize)
+{
+  if (!m_Workers.empty() || m_WorkerId >= 0)
+  {
+    std::cout << PHWHERE << " workers are already running, ignored" << std::endl;
+    return;
+  }
+  if (nworkers <= 1)
+  {
+    return;
+  }
+  // the modules are initialized in the workers, so files and connections they open are their own
+  bool registered = !Subsystems.empty() || !OutputManager.empty();
+  for (auto *syncman : SyncManagers)
+  {
+    registered = registered || !syncman->GetInputManagers().empty();
+  }
+  if (registered)
+  {
+    std::cout << PHWHERE << " has to be called before any module, input or output manager is registered, "
+              << "running in a single process" << std::endl;
+    return;
+  }
+  int nthreads = running_threads();
+  if (nthreads != 1)
+  {
+    std::cout << PHWHERE << " " << ((nthreads < 0) ? std::string("unknown number of") : std::to_string(nthreads))
+              << " threads are running, the workers would only get the calling one, running in a single process" << std::endl;
+    return;
+  }
+  m_NumWorkers = nworkers;
+  m_WorkerBlockSize = std::max(1, blocksize);
+  ForkWorkers();
+}
+
+std::string Fun4AllServer::WorkerFileName(const std::string &filename, const int worker)
+{
+  if (filename.empty())
+  {
+    return filename;
+  }
+  std::filesystem::path p = filename;
+  p.replace_filename(std::format("{}_worker{}{}", p.stem().string(), worker, p.extension().string()));
+  return p.string();
+}
+
+int Fun4AllServer::NextWorkerEvent(const int ievent) const
+{
+  int block = ievent / m_WorkerBlockSize;
+  int ahead = (m_WorkerId - (block % m_NumWorkers) + m_NumWorkers) % m_NumWorkers;
+  if (ahead == 0)
+  {
+    return ievent;
+  }
+  return (block + ahead) * m_WorkerBlockSize;
+}
+
+
+// returns 0 in the parent, 1 in a worker
+int Fun4AllServer::ForkWorkers()
+{
+  std::cout << "Fun4AllServer: forking " << m_NumWorkers << " workers" << std::endl;
+  // a connection used by several processes mixes their requests, the workers connect again when they need to
+  ODBCInterface::instance()->Disconnect();
+  // anything still buffered would be written once per worker
+  std::cout.flush();
+  fflush(stdout);
+  fflush(stderr);
+  m_ForkTime = wall_seconds();
+  for (int iworker = 0; iworker < m_NumWorkers; iworker++)
+  {
+    int fd[2];
+    if (pipe(fd) != 0)
+    {
+      std::cout << PHWHERE << " cannot create pipe: " << std::strerror(errno) << std::endl;
+      exit(1);
+    }
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      std::cout << PHWHERE << " fork failed: " << std::strerror(errno) << std::endl;
+      exit(1);
+    }
+    if (pid == 0)
+    {
+      close(fd[0]);
+      for (auto &worker : m_Workers)
+      {
+        close(worker.second);
+      }
+      m_Workers.clear();
+      m_WorkerId = iworker;
+      m_WorkerPipe = fd[1];
+      return 1;
+    }
+    close(fd[1]);
+    m_Workers.emplace_back(pid, fd[0]);
+  }
+  return 0;
+}
+
+// the number of events each output manager has written at the end of the current block,
+// the parent uses them to restore the input order when merging the DSTs
+void Fun4AllServer::RecordWorkerBlock()
+{
+  if (m_WorkerBlocks.empty())
+  {
+    m_WorkerBlocks.resize(1);
+  }
+  auto &blocks = m_WorkerBlocks.front();
+  blocks.push_back(m_WorkerEvent / m_WorkerBlockSize);
+  for (auto *outman : OutputManager)
+  {
+    blocks.push_back(outman->EventsWritten());
+  }
+  m_WorkerBlockOpen = false;
+}
+
+// a worker writes its histograms and reports to the parent after End()
+void Fun4AllServer::FinishWorker()
+{
+  for (auto &histit : HistoManager)
+  {
+    if (histit->isEmpty())
+    {
+      continue;
+    }
+    std::string filename = histit->OutFileName().empty() ? histit->Name() + ".root" : histit->OutFileName();
+    histit->UseFileRule(false);
+    histit->SetClosingScript("");
+    histit->dumpHistos(WorkerFileName(filename, m_WorkerId));
+  }
+  static const std::vector<unsigned int> noblocks;
+  const std::vector<unsigned int> &blocks = m_WorkerBlocks.empty() ? noblocks : m_WorkerBlocks.front();
+  WorkerReport report;
+  report.worker = m_WorkerId;
+  report.nevents = m_WorkerNEvents;
+  report.seconds = wall_seconds() - m_ForkTime;
+  report.nblockwords = blocks.size();
+  get_memory(report.rss, report.pss);
+  if (!write_all(m_WorkerPipe, &report, sizeof(report)) ||
+      !write_all(m_WorkerPipe, blocks.data(), blocks.size() * sizeof(unsigned int)))
+  {
+    std::cout << PHWHERE << " worker " << m_WorkerId << " could not send its report" << std::endl;
+  }
+  close(m_WorkerPipe);
+  std::cout.flush();
+  fflush(stdout);
+  // skip the rest of the macro, the static destructors and the atexit handlers (ROOT's among them)
+  _exit(0);
+}
+
+// waits for the workers and adds their histograms to the registered ones, returns the number of failed workers
+int Fun4AllServer::CollectWorkers()
+{
+  m_WorkerBlocks.assign(m_NumWorkers, {});
+  m_WorkerNFailed = 0;
+  m_WorkersNEvents = 0;
+  m_WorkersPss = 0;
+  m_WorkersSeconds = 0;
+  int iworker = 0;
+  for (auto &worker : m_Workers)
+  {
+    // the report is read before waiting, a worker blocks on a full pipe until the parent reads
+    WorkerReport report;
+    bool ok = read_all(worker.second, &report, sizeof(report));
+    if (ok)
+    {
+      m_WorkerBlocks[iworker].resize(report.nblockwords);
+      ok = read_all(worker.second, m_WorkerBlocks[iworker].data(), report.nblockwords * sizeof(unsigned int));
+    }
+    int status = 0;
+    waitpid(worker.first, &status, 0);
+    if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      std::cout << PHWHERE << " worker with pid " << worker.first << " did not finish properly, status " << status << std::endl;
+      m_WorkerBlocks[iworker].clear();
+      m_WorkerNFailed++;
+    }
+    else
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << "Fun4AllServer: worker " << report.worker << " processed " << report.nevents << " events in "
+                  << std::format("{:.1f} s, RSS {:.1f} MB, PSS {:.1f} MB", report.seconds, report.rss / 1024., report.pss / 1024.) << std::endl;
+      }
+      m_WorkersNEvents += report.nevents;
+      m_WorkersPss += report.pss;
+      m_WorkersSeconds += report.seconds;
+    }
+    close(worker.second);
+    iworker++;
+  }
+
+  // add up the worker histograms, the parent did not initialize the modules and registers them from the first worker file
+  for (auto &histit : HistoManager)
+  {
+    std::string filename = histit->OutFileName().empty() ? histit->Name() + ".root" : histit->OutFileName();
+    for (iworker = 0; iworker < m_NumWorkers; iworker++)
+    {
+      std::string workerfile = WorkerFileName(filename, iworker);
+      if (!std::filesystem::exists(workerfile))  // empty histogram managers are not written
+      {
+        continue;
+      }
+      TFile *f = TFile::Open(workerfile.c_str());
+      if (!f || f->IsZombie())
+      {
+        std::cout << PHWHERE << " cannot read " << workerfile << ", its histograms are lost" << std::endl;
+        delete f;
+        continue;
+      }
+      std::vector<std::pair<std::string, TObject *>> objects;
+      collect_objects(f, "", objects);
+      for (auto &[name, obj] : objects)
+      {
+        TH1 *hworker = dynamic_cast<TH1 *>(obj);
+        if (!hworker)
+        {
+          std::cout << "Fun4AllServer: " << name << " is not a histogram, it stays in the worker files" << std::endl;
+          continue;
+        }
+        TH1 *h = dynamic_cast<TH1 *>(histit->getHisto(name));
+        if (h)
+        {
+          h->Add(hworker);
+        }
+        else if (!histit->isHistoRegistered(name))
+        {
+          hworker->SetDirectory(nullptr);
+          histit->registerHisto(name, hworker);
+        }
+      }
+      delete f;
+      if (!m_KeepWorkerFiles)
+      {
+        std::filesystem::remove(workerfile);
+      }
+    }
+  }
+  return m_WorkerNFailed;
+}
+
+// merges the worker DSTs and prints the summary, after End() of the modules
+int Fun4AllServer::MergeWorkerOutputs()
+{
+  int iret = 0;
+  // files which follow a file rule keep their per worker segments
+  for (unsigned int index = 0; index < OutputManager.size(); index++)
+  {
+    Fun4AllOutputManager *outman = OutputManager[index];
+    if (!dynamic_cast<Fun4AllDstOutputManager *>(outman) || outman->ApplyFileRule())
+    {
+      std::cout << "Fun4AllServer: output of " << outman->Name() << " is in the per worker files "
+                << WorkerFileName(outman->OutFileName(), 0) << " ..." << std::endl;
+      continue;
+    }
+    iret += MergeWorkerDst(outman, index);
+  }
+
+  double seconds = wall_seconds() - m_ForkTime;
+  long rss = 0;
+  long pss = 0;
+  get_memory(rss, pss);
+  std::cout << "Fun4AllServer: " << m_NumWorkers << " workers processed " << m_WorkersNEvents << " events in "
+            << std::format("{:.1f} s, {:.2f} events/s", seconds, (seconds > 0) ? m_WorkersNEvents / seconds : 0.) << std::endl;
+  if (m_WorkersSeconds > 0)
+  {
+    std::cout << "Fun4AllServer: single worker rate "
+              << std::format("{:.2f} events/s", m_WorkersNEvents / m_WorkersSeconds) << std::endl;
+  }
+  std::cout << "Fun4AllServer: memory "
+            << std::format("{:.1f} MB PSS per worker, {:.1f} MB for all workers and the parent",
+                           m_WorkersPss / 1024. / std::max(1, m_NumWorkers - m_WorkerNFailed), (m_WorkersPss + pss) / 1024.)
+            << std::endl;
+  m_Workers.clear();
+  m_WorkerBlocks.clear();
+  return iret;
+}
+
+// the worker DSTs hold the blocks of events in the order the workers processed them. The event
+// tree is copied entry by entry in the order of the blocks in the input, the other trees (run tree)
+// are merged as hadd would
+int Fun4AllServer::MergeWorkerDst(Fun4AllOutputManager *outman, const unsigned int index)
+{
+  const std::string eventtree = "T";
+  std::vector<std::string> workerfiles;
+  std::vector<int> workers;
+  for (int iworker = 0; iworker < m_NumWorkers; iworker++)
+  {
+    std::string workerfile = WorkerFileName(outman->OutFileName(), iworker);
+    if (std::filesystem::exists(workerfile))
+    {
+      workerfiles.push_back(workerfile);
+      workers.push_back(iworker);
+    }
+  }
+  if (workerfiles.empty())
+  {
+    return 0;
+  }
+  TFileMerger merger(false);
+  merger.OutputFile(outman->OutFileName().c_str(), "RECREATE");
+  for (const auto &workerfile : workerfiles)
+  {
+    merger.AddFile(workerfile.c_str(), false);
+  }
+  merger.AddObjectNames(eventtree.c_str());
+  if (!merger.PartialMerge(TFileMerger::kAll | TFileMerger::kRegular | TFileMerger::kSkipListed))
+  {
+    std::cout << PHWHERE << " merging into " << outman->OutFileName() << " failed, the worker files are kept" << std::endl;
+    return -1;
+  }
+
+  // entry ranges in the worker files, ordered by the block in the input
+  struct EntryRange
+  {
+    unsigned int block;
+    unsigned int file;
+    Long64_t first;
+    Long64_t last;
+  };
+  std::vector<EntryRange> ranges;
+  std::vector<Long64_t> recorded(workerfiles.size(), 0);
+  const unsigned int recordsize = OutputManager.size() + 1;
+  for (unsigned int ifile = 0; ifile < workerfiles.size(); ifile++)
+  {
+    const auto &blocks = m_WorkerBlocks[workers[ifile]];
+    for (unsigned int i = 0; i + recordsize <= blocks.size(); i += recordsize)
+    {
+      Long64_t written = blocks[i + 1 + index];
+      if (written > recorded[ifile])
+      {
+        ranges.push_back({blocks[i], ifile, recorded[ifile], written});
+        recorded[ifile] = written;
+      }
+    }
+  }
+  std::stable_sort(ranges.begin(), ranges.end(), [](const EntryRange &a, const EntryRange &b)
+                   { return a.block < b.block; });
+
+  std::vector<TFile *> infiles;
+  std::vector<TTree *> intrees;
+  std::vector<std::vector<void *>> objects(workerfiles.size());
+  bool ok = true;
+  for (unsigned int ifile = 0; ifile < workerfiles.size(); ifile++)
+  {
+    TFile *f = TFile::Open(workerfiles[ifile].c_str());
+    TTree *tree = nullptr;
+    if (f && !f->IsZombie())
+    {
+      f->GetObject(eventtree.c_str(), tree);
+    }
+    infiles.push_back(f);
+    intrees.push_back(tree);
+    if (!tree)
+    {
+      continue;
+    }
+    if (tree->GetEntries() != recorded[ifile])
+    {
+      std::cout << PHWHERE << " " << workerfiles[ifile] << " has " << tree->GetEntries() << " events, "
+                << recorded[ifile] << " were recorded, the events are not merged" << std::endl;
+      ok = false;
+    }
+    // a null object pointer makes ROOT create the objects when the entries are read
+    TObjArray *branches = tree->GetListOfBranches();
+    objects[ifile].assign(branches->GetEntries(), nullptr);
+    for (int ibranch = 0; ibranch < branches->GetEntries(); ibranch++)
+    {
+      tree->SetBranchAddress(branches->At(ibranch)->GetName(), static_cast<void *>(&objects[ifile][ibranch]));
+    }
+  }
+
+  TFile *fout = ok ? TFile::Open(outman->OutFileName().c_str(), "UPDATE") : nullptr;
+  const auto firsttree = std::find_if(intrees.begin(), intrees.end(), [](const TTree *t)
+                                      { return t != nullptr; });
+  if (fout && !fout->IsZombie() && firsttree != intrees.end())
+  {
+    fout->cd();
+    TTree *out = (*firsttree)->CloneTree(0);
+    out->SetDirectory(fout);
+    int current = -1;
+    for (const auto &range : ranges)
+    {
+      TTree *in = intrees[range.file];
+      if (!in)
+      {
+        continue;
+      }
+      if (static_cast<int>(range.file) != current)
+      {
+        in->CopyAddresses(out);
+        current = range.file;
+      }
+      for (Long64_t entry = range.first; entry < range.last; entry++)
+      {
+        in->GetEntry(entry);
+        out->Fill();
+      }
+    }
+    out->Write();
+  }
+  else if (ok)
+  {
+    std::cout << PHWHERE << " cannot add the events to " << outman->OutFileName() << std::endl;
+    ok = false;
+  }
+  delete fout;
+  for (auto *f : infiles)
+  {
+    delete f;
+  }
+  if (!ok)
+  {
+    std::cout << PHWHERE << " merging the events into " << outman->OutFileName() << " failed, the worker files are kept" << std::endl;
+    return -1;
+  }
+  if (!m_KeepWorkerFiles)
+  {
+    for (const auto &workerfile : workerfiles)
+    {
+      std::filesystem::remove(workerfile);
+    }
+  }
+  return 0;
+}
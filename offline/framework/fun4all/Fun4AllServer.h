@@ -118,6 +118,37 @@ class Fun4AllServer : public Fun4AllBase
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
   int UpdateRunNode();
   void AddResetNodeName(const std::string &name) {ResetNodeList.emplace_back(name);}
+  //! containers in the reset nodes keep their objects for the next event instead of deleting them
+  void RecycleObjects(const bool b = true) { m_RecycleObjects = b; }
+
+  /*!
+    \brief multi-process mode.
+    setNumWorkers() forks nworkers processes right away. It has to be called at the top of
+    the macro, before any module, input or output manager is registered, and is refused
+    (the job runs in a single process) if modules are registered already or if other threads
+    are running, since fork() copies only the calling thread.
+    Every worker then runs the rest of the macro on its own: the modules are initialized in
+    the worker, WorkerId() is valid in their Init() and InitRun() and files they open there
+    belong to the worker alone, inputs are opened by the worker.
+    Worker i processes the event blocks i, i + nworkers, ... of blocksize events
+    each, the other events are skipped. Streaming inputs cannot skip events and end the workers.
+    The number of events given to run() is the total over all workers, with
+    require_nevents every worker processes its share of the good events.
+    Workers write their DSTs and histograms to files with a _workerN suffix (see WorkerFileName).
+    The parent does not initialize or run the modules, run() returns right away. End() in the
+    parent waits for the workers, adds up their histograms in the registered histogram managers,
+    merges the DSTs into the requested output files in the input event order and
+    prints the memory and event rate summary. Module End() only runs in the workers.
+    Modules which write their own files need unique file names per worker (use WorkerId()).
+  */
+  void setNumWorkers(const int nworkers, const int blocksize = 100);
+  int NumWorkers() const { return m_NumWorkers; }
+  //! -1 in the parent or in single process mode, 0 .. nworkers-1 in a worker
+  int WorkerId() const { return m_WorkerId; }
+  //! keep the per worker files after merging them
+  void KeepWorkerFiles(const bool b = true) { m_KeepWorkerFiles = b; }
+  //! name of the file worker writes instead of filename (dir/stem_workerN.ext)
+  static std::string WorkerFileName(const std::string &filename, const int worker);
 
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
@@ -127,6 +158,13 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runno);
+  int ForkWorkers();
+  int CollectWorkers();
+  int MergeWorkerOutputs();
+  int MergeWorkerDst(Fun4AllOutputManager *outman, const unsigned int index);
+  void RecordWorkerBlock();
+  void FinishWorker();
+  int NextWorkerEvent(const int ievent) const;
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars{nullptr};
   Fun4AllMemoryTracker *ffamemtracker{nullptr};
@@ -143,6 +181,28 @@ class Fun4AllServer : public Fun4AllBase
   int eventnumber{0};
   int eventcounter{0};
   int keep_db_connected{0};
+  bool m_RecycleObjects{false};
+  // multi-process mode
+  int m_NumWorkers{1};
+  int m_WorkerBlockSize{100};
+  int m_WorkerId{-1};
+  int m_WorkerPipe{-1};
+  int m_WorkerEvent{0};  // index of the current event in the input, in a worker
+  int m_WorkerNEvents{0};
+  int m_WorkerNGood{0};
+  int m_WorkerNRequired{0};  // share of the good events with require_nevents
+  bool m_WorkerBlockOpen{false};
+  bool m_KeepWorkerFiles{false};
+  bool m_WorkerInputError{false};
+  double m_ForkTime{0};
+  std::vector<std::pair<int, int>> m_Workers;  // pid, read end of the report pipe
+  // for each worker the blocks it processed: block index, then the events written by each output manager at its end
+  std::vector<std::vector<unsigned int>> m_WorkerBlocks;
+  // summary of the collected workers
+  int m_WorkerNFailed{0};
+  int m_WorkersNEvents{0};
+  long m_WorkersPss{0};
+  double m_WorkersSeconds{0};
   
   std::ios m_saved_cout_state{nullptr};
   std::vector<std::string> ComplaintList;
@@ -1,5 +1,7 @@
 #include "Fun4AllPrdfInputManager.h"
 
+#include "PrdfPacketCache.h"
+
 #include <fun4all/DBInterface.h>
 #include <fun4all/Fun4AllInputManager.h>  // for Fun4AllInputManager
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -22,7 +24,9 @@
 #include <Event/EventTypes.h>
 #include <Event/Eventiterator.h>  // for Eventiterator
 #include <Event/fileEventiterator.h>
+#include <Event/packet.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>  // for operator<<, basic_ostream, endl
@@ -32,6 +36,8 @@ Fun4AllPrdfInputManager::Fun4AllPrdfInputManager(const std::string &name, const
   : Fun4AllInputManager(name, prdfnodename, topnodename)
   , m_SyncObject(new SyncObjectv1())
   , m_PrdfNodeName(prdfnodename)
+  , m_PacketDecoder([](Packet *packet)
+                    { packet->iValue(0); })
 {
   Fun4AllServer *se = Fun4AllServer::instance();
   m_topNode = se->topNode(TopNodeName());
@@ -83,6 +89,10 @@ int Fun4AllPrdfInputManager::fileopen(const std::string &filenam)
   m_Segment = runseg.second;
   IsOpen(1);
   AddToFileOpened(fname);  // add file to the list of files which were opened
+  if (m_ReadAheadDepth > 0)
+  {
+    StartReadAhead();
+  }
   return 0;
 }
 
@@ -114,16 +124,19 @@ readagain:
   //  std::cout << "running event " << nevents << std::endl;
   PHNodeIterator iter(m_topNode);
   PHDataNode<Event> *PrdfNode = dynamic_cast<PHDataNode<Event> *>(iter.findFirst("PHDataNode", m_PrdfNodeName));
+  PHDataNode<PrdfPacketCache> *PacketNode = dynamic_cast<PHDataNode<PrdfPacketCache> *>(iter.findFirst("PHDataNode", m_PrdfNodeName + "PACKETS"));
   if (m_SaveEvent)  // if an event was pushed back, copy saved pointer and reset m_SaveEvent pointer
   {
     m_Event = m_SaveEvent;
+    m_Packets = m_SavePackets;
     m_SaveEvent = nullptr;
+    m_SavePackets = nullptr;
     m_EventsThisFile--;
     m_EventsTotal--;
   }
   else
   {
-    m_Event = m_EventIterator->getNextEvent();
+    m_Event = NextEvent(m_Packets);
   }
   if (!m_Event || m_Event->getEvtType() == ENDRUNEVENT)
   {
@@ -133,6 +146,10 @@ readagain:
     goto readagain;
   }
   PrdfNode->setData(m_Event);
+  if (PacketNode)
+  {
+    PacketNode->setData(m_Packets);
+  }
   if (Verbosity() > 1)
   {
     std::cout << Name() << " PRDF run " << m_Event->getRunNumber() << ", evt no: " << m_Event->getEvtSequence() << std::endl;
@@ -164,6 +181,7 @@ int Fun4AllPrdfInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  StopReadAhead();
   delete m_EventIterator;
   m_EventIterator = nullptr;
   IsOpen(0);
@@ -176,6 +194,11 @@ int Fun4AllPrdfInputManager::fileclose()
 void Fun4AllPrdfInputManager::Print(const std::string &what) const
 {
   Fun4AllInputManager::Print(what);
+  if (m_ReadAheadDepth > 0 && (what == "ALL" || what == "READAHEAD"))
+  {
+    std::cout << Name() << ": reading " << m_ReadAheadDepth << " events ahead, "
+              << m_NumDecoders << " decoder threads" << std::endl;
+  }
   return;
 }
 
@@ -184,6 +207,14 @@ int Fun4AllPrdfInputManager::ResetEvent()
   PHNodeIterator iter(m_topNode);
   PHDataNode<Event> *PrdfNode = dynamic_cast<PHDataNode<Event> *>(iter.findFirst("PHDataNode", m_PrdfNodeName));
   PrdfNode->setData(nullptr);  // set pointer in Node to nullptr before deleting it
+  PHDataNode<PrdfPacketCache> *PacketNode = dynamic_cast<PHDataNode<PrdfPacketCache> *>(iter.findFirst("PHDataNode", m_PrdfNodeName + "PACKETS"));
+  if (PacketNode)
+  {
+    PacketNode->setData(nullptr);
+  }
+  // the packets point into the event, they go first
+  delete m_Packets;
+  m_Packets = nullptr;
   delete m_Event;
   m_Event = nullptr;
   m_SyncObject->Reset();
@@ -202,6 +233,7 @@ int Fun4AllPrdfInputManager::PushBackEvents(const int i)
     if (i == 1 && m_Event)  // check on m_Event pointer makes sure it is not done from the cmd line
     {
       m_SaveEvent = m_Event;
+      m_SavePackets = m_Packets;
       return 0;
     }
     std::cout << PHWHERE << Name()
@@ -222,7 +254,9 @@ int Fun4AllPrdfInputManager::PushBackEvents(const int i)
   int errorflag = 0;
   while (nevents > 0 && !errorflag)
   {
-    m_Event = m_EventIterator->getNextEvent();
+    PrdfPacketCache *packets = nullptr;
+    m_Event = NextEvent(packets);
+    delete packets;
     if (!m_Event)
     {
       std::cout << "Error after skipping " << i - nevents
@@ -294,3 +328,178 @@ std::string Fun4AllPrdfInputManager::GetString(const std::string &what) const
   }
   return "";
 }
+
+void Fun4AllPrdfInputManager::SetReadAhead(const unsigned int nevents, const unsigned int ndecoders)
+{
+  if (IsOpen())
+  {
+    std::cout << PHWHERE << Name() << ": read ahead has to be set before the first file is opened" << std::endl;
+    return;
+  }
+  m_ReadAheadDepth = nevents;
+  m_NumDecoders = std::max(ndecoders, 1U);
+  if (m_ReadAheadDepth == 0)
+  {
+    return;
+  }
+  PHNodeIterator iter(m_topNode);
+  if (!iter.findFirst("PHDataNode", m_PrdfNodeName + "PACKETS"))
+  {
+    PHDataNode<PrdfPacketCache> *newNode = new PHDataNode<PrdfPacketCache>(nullptr, m_PrdfNodeName + "PACKETS", "PrdfPacketCache");
+    m_topNode->addNode(newNode);
+  }
+}
+
+Event *Fun4AllPrdfInputManager::NextEvent(PrdfPacketCache *&packets)
+{
+  packets = nullptr;
+  if (!m_ReaderThread.joinable())
+  {
+    return m_EventIterator->getNextEvent();
+  }
+  std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+  m_SlotDecoded.wait(lock, [this]
+                     { return !m_ReadAhead.empty() && m_ReadAhead.front().decoded; });
+  ReadAheadSlot slot = m_ReadAhead.front();
+  m_ReadAhead.pop_front();
+  lock.unlock();
+  m_SlotFree.notify_one();
+  packets = slot.packets;
+  return slot.event;
+}
+
+void Fun4AllPrdfInputManager::StartReadAhead()
+{
+  m_StopReadAhead = false;
+  m_ReaderThread = std::thread(&Fun4AllPrdfInputManager::ReadAheadLoop, this);
+  for (unsigned int i = 0; i < m_NumDecoders; ++i)
+  {
+    m_DecoderThreads.emplace_back(&Fun4AllPrdfInputManager::DecodeLoop, this);
+  }
+}
+
+void Fun4AllPrdfInputManager::StopReadAhead()
+{
+  if (!m_ReaderThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+    m_StopReadAhead = true;
+  }
+  m_SlotFree.notify_all();
+  m_SlotRead.notify_all();
+  m_ReaderThread.join();
+  for (auto &decoder : m_DecoderThreads)
+  {
+    decoder.join();
+  }
+  m_DecoderThreads.clear();
+  // events which were read but not used
+  for (auto &slot : m_ReadAhead)
+  {
+    delete slot.packets;
+    delete slot.event;
+  }
+  m_ReadAhead.clear();
+}
+
+void Fun4AllPrdfInputManager::ReadAheadLoop()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+      m_SlotFree.wait(lock, [this]
+                      { return m_StopReadAhead || m_ReadAhead.size() < m_ReadAheadDepth; });
+      if (m_StopReadAhead)
+      {
+        return;
+      }
+    }
+    ReadAheadSlot slot;
+    slot.event = m_EventIterator->getNextEvent();
+    // the end of the file is handed on like the events, run() closes the file when it gets there
+    const bool last = !slot.event || slot.event->getEvtType() == ENDRUNEVENT;
+    if (last)
+    {
+      slot.claimed = true;
+      slot.decoded = true;
+    }
+    else
+    {
+      // the iterator reuses its buffer for the next events, the event needs its own copy
+      slot.event->convert();
+      slot.packets = new PrdfPacketCache();
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+      m_ReadAhead.push_back(slot);
+    }
+    if (last)
+    {
+      m_SlotDecoded.notify_one();
+      return;
+    }
+    m_SlotRead.notify_one();
+  }
+}
+
+void Fun4AllPrdfInputManager::DecodeLoop()
+{
+  std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+  while (true)
+  {
+    auto slot = m_ReadAhead.end();
+    m_SlotRead.wait(lock, [this, &slot]
+                    {
+                      slot = std::find_if(m_ReadAhead.begin(), m_ReadAhead.end(), [](const ReadAheadSlot &entry)
+                                          { return !entry.claimed; });
+                      return m_StopReadAhead || slot != m_ReadAhead.end(); });
+    if (m_StopReadAhead)
+    {
+      return;
+    }
+    slot->claimed = true;
+    // elements of a deque stay in place when others are added or removed at the ends
+    Event *evt = slot->event;
+    PrdfPacketCache *packets = slot->packets;
+    ReadAheadSlot &entry = *slot;
+    lock.unlock();
+    DecodeEvent(evt, packets);
+    lock.lock();
+    entry.decoded = true;
+    m_SlotDecoded.notify_one();
+  }
+}
+
+void Fun4AllPrdfInputManager::DecodeEvent(Event *evt, PrdfPacketCache *packets) const
+{
+  std::vector<Packet *> plist(1000);
+  int npackets = 0;
+  while ((npackets = evt->getPacketList(plist.data(), plist.size())) >= static_cast<int>(plist.size()))
+  {
+    for (int i = 0; i < npackets; i++)
+    {
+      delete plist[i];
+    }
+    plist.resize(2 * plist.size());
+  }
+  for (int i = 0; i < npackets; i++)
+  {
+    const int id = plist[i]->getIdentifier();
+    if (!m_CachedPacketRanges.empty() &&
+        std::none_of(m_CachedPacketRanges.begin(), m_CachedPacketRanges.end(), [id](const std::pair<int, int> &range)
+                     { return id >= range.first && id <= range.second; }))
+    {
+      delete plist[i];
+      continue;
+    }
+    if (m_PacketDecoder)
+    {
+      m_PacketDecoder(plist[i]);
+    }
+    packets->addPacket(plist[i]);
+  }
+}
@@ -5,11 +5,20 @@
 
 #include <fun4all/Fun4AllInputManager.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 class Event;
 class Eventiterator;
+class Packet;
 class PHCompositeNode;
+class PrdfPacketCache;
 class SyncObject;
 
 class Fun4AllPrdfInputManager : public Fun4AllInputManager
@@ -31,7 +40,33 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   int HasSyncObject() const override { return 1; }
   std::string GetString(const std::string &what) const override;
 
+  //! read up to nevents ahead on an I/O thread and extract their packets on ndecoders threads,
+  //! the packets of the current event are published in a PrdfPacketCache node (<prdfnodename>PACKETS).
+  //! Needs to be called before the first file is opened, 0 switches it off
+  void SetReadAhead(const unsigned int nevents, const unsigned int ndecoders = 1);
+  //! only cache packets with ids in [low, high], without a range all packets are cached
+  void AddCachedPacketRange(const int low, const int high) { m_CachedPacketRanges.emplace_back(low, high); }
+  //! called for every cached packet on the decoder threads. The default accesses the packet data,
+  //! which runs the lazy decoding of the packet there instead of in the module which reads it
+  void SetPacketDecoder(std::function<void(Packet *)> decoder) { m_PacketDecoder = std::move(decoder); }
+
  private:
+  struct ReadAheadSlot
+  {
+    Event *event{nullptr};
+    PrdfPacketCache *packets{nullptr};
+    bool claimed{false};
+    bool decoded{false};
+  };
+
+  //! next event of the open file, from the read ahead queue if it is enabled
+  Event *NextEvent(PrdfPacketCache *&packets);
+  void StartReadAhead();
+  void StopReadAhead();
+  void ReadAheadLoop();
+  void DecodeLoop();
+  void DecodeEvent(Event *evt, PrdfPacketCache *packets) const;
+
   int m_Segment = -999;
   int m_EventsTotal = 0;
   int m_EventsThisFile = 0;
@@ -40,7 +75,25 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   Event *m_SaveEvent = nullptr;
   Eventiterator *m_EventIterator = nullptr;
   SyncObject *m_SyncObject = nullptr;
+  PrdfPacketCache *m_Packets = nullptr;
+  PrdfPacketCache *m_SavePackets = nullptr;
   std::string m_PrdfNodeName;
+
+  unsigned int m_ReadAheadDepth = 0;
+  unsigned int m_NumDecoders = 1;
+  std::vector<std::pair<int, int>> m_CachedPacketRanges;
+  std::function<void(Packet *)> m_PacketDecoder;
+
+  // the I/O thread fills the queue in file order, the decoders work on any read slot,
+  // run() takes the front slot once it is decoded
+  std::deque<ReadAheadSlot> m_ReadAhead;
+  std::mutex m_ReadAheadMutex;
+  std::condition_variable m_SlotFree;
+  std::condition_variable m_SlotRead;
+  std::condition_variable m_SlotDecoded;
+  bool m_StopReadAhead = false;
+  std::thread m_ReaderThread;
+  std::vector<std::thread> m_DecoderThreads;
 };
 
 #endif /* FUN4ALL_FUN4ALLPRDFINPUTMANAGER_H */
@@ -40,13 +40,40 @@
 #include <TSystem.h>
 
 #include <algorithm>  // for max
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdint>  // for uint64_t, uint16_t
 #include <cstdlib>
 #include <format>
+#include <future>
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
 
+namespace
+{
+  // throughput counters of the input whose pool is filled by this thread,
+  // used to attribute the raw hits added through the Add...RawHit methods
+  thread_local uint64_t *t_current_input_hits = nullptr;
+
+  void count_input_hit()
+  {
+    if (t_current_input_hits)
+    {
+      ++(*t_current_input_hits);
+    }
+  }
+
+  // the ranges only grow, inputs of the same subsystem may set them concurrently
+  void raise_to(std::atomic<unsigned int> &value, const unsigned int i)
+  {
+    unsigned int current = value.load();
+    while (current < i && !value.compare_exchange_weak(current, i))
+    {
+    }
+  }
+}  // namespace
+
 Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &name, const std::string &dstnodename, const std::string &topnodename)
   : Fun4AllInputManager(name, dstnodename, topnodename)
   , m_SyncObject(new SyncObjectv1())
@@ -151,6 +178,10 @@ int Fun4AllStreamingInputManager::run(const int /*nevents*/)
   {
     iret += FillGl1();
   }
+  if (m_ParallelInputs && m_RefBCO > 0)
+  {
+    PrefillPools();
+  }
   if (m_intt_registered_flag)
   {
     iret += FillIntt();
@@ -269,6 +300,33 @@ void Fun4AllStreamingInputManager::Print(const std::string &what) const
       }
     }
   }
+  if (what == "ALL" || what == "THROUGHPUT")
+  {
+    std::cout << "-----------------------------" << std::endl;
+    std::cout << "Input throughput, parallel inputs: " << (m_ParallelInputs ? "on" : "off")
+              << ", threads: " << m_InputThreads << std::endl;
+    const std::vector<SingleStreamingInput *> *inputvectors[] = {&m_Gl1InputVector, &m_MvtxInputVector, &m_InttInputVector, &m_TpcInputVector, &m_MicromegasInputVector};
+    for (const auto *inputvector : inputvectors)
+    {
+      for (const auto *input : *inputvector)
+      {
+        auto iter = m_InputThroughput.find(input);
+        if (iter == m_InputThroughput.end())
+        {
+          continue;
+        }
+        const InputThroughput &counters = iter->second;
+        std::cout << input->Name() << ": FillPool calls: " << counters.FillPoolCalls
+                  << ", raw hits: " << counters.RawHits
+                  << ", time: " << counters.FillPoolTime << " s";
+        if (counters.FillPoolTime > 0)
+        {
+          std::cout << ", " << counters.RawHits / counters.FillPoolTime << " hits/s";
+        }
+        std::cout << std::endl;
+      }
+    }
+  }
   if (what == "ALL" || what == "INPUTFILES")
   {
     std::cout << "-----------------------------" << std::endl;
@@ -445,6 +503,7 @@ void Fun4AllStreamingInputManager::registerStreamingInput(SingleStreamingInput *
     evtin->CreateDSTNode(m_topNode);
   }
   evtin->ConfigureStreamingInputManager();
+  m_InputThroughput[evtin] = InputThroughput();
   switch (system)
   {
   case InputManagerType::MVTX:
@@ -489,6 +548,8 @@ void Fun4AllStreamingInputManager::AddGl1RawHit(uint64_t bclk, Gl1Packet *hit)
     std::cout << "Adding gl1 hit to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
+  count_input_hit();
+  std::lock_guard<std::mutex> const lock(m_Gl1Mutex);
   m_Gl1RawHitMap[bclk].Gl1RawHitVector.push_back(hit);
 }
 
@@ -499,6 +560,8 @@ void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
     std::cout << "Adding mvtx hit to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
+  count_input_hit();
+  std::lock_guard<std::mutex> const lock(m_MvtxMutex);
   m_MvtxRawHitMap[bclk].MvtxRawHitVector.push_back(hit);
 }
 
@@ -513,6 +576,7 @@ void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feei
   feeidInfo->set_bco(bclk);
   feeidInfo->set_feeId(feeid);
   feeidInfo->set_detField(detField);
+  std::lock_guard<std::mutex> const lock(m_MvtxMutex);
   m_MvtxRawHitMap[bclk].MvtxFeeIdInfoVector.push_back(feeidInfo);
 }
 
@@ -523,6 +587,7 @@ void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bc
     std::cout << "Adding mvtx L1Trg to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
+  std::lock_guard<std::mutex> const lock(m_MvtxMutex);
   m_MvtxRawHitMap[bclk].MvtxL1TrgBco.insert(lv1Bco);
 }
 
@@ -533,6 +598,8 @@ void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
     std::cout << "Adding intt hit to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
+  count_input_hit();
+  std::lock_guard<std::mutex> const lock(m_InttMutex);
   m_InttRawHitMap[bclk].InttRawHitVector.push_back(hit);
   m_InttPacketFeeBcoMap[hit->get_packetid()][hit->get_fee()] = bclk;
 }
@@ -544,6 +611,8 @@ void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, Micromegas
     std::cout << "Adding micromegas hit to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
+  count_input_hit();
+  std::lock_guard<std::mutex> const lock(m_MicromegasMutex);
   m_MicromegasRawHitMap[bclk].MicromegasRawHitVector.push_back(hit);
 }
 
@@ -554,6 +623,8 @@ void Fun4AllStreamingInputManager::AddTpcRawHit(uint64_t bclk, TpcRawHit *hit)
     std::cout << "Adding tpc hit to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
+  count_input_hit();
+  std::lock_guard<std::mutex> const lock(m_TpcMutex);
   m_TpcRawHitMap[bclk].TpcRawHitVector.push_back(hit);
 }
 
@@ -566,7 +637,7 @@ int Fun4AllStreamingInputManager::FillGl1()
     {
       std::cout << "Fun4AllStreamingInputManager::FillGl1 - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool();
+    FillInputPool({iter, 0, false});
     if (m_RunNumber == 0)
     {
       m_RunNumber = iter->RunNumber();
@@ -623,6 +694,7 @@ int Fun4AllStreamingInputManager::FillGl1()
   {
     for (auto *iter : m_Gl1InputVector)
     {
+      m_InputThroughput.erase(iter);
       delete iter;
     }
     m_gl1_registered_flag = false;
@@ -829,7 +901,7 @@ int Fun4AllStreamingInputManager::FillMvtx()
     }
   }
   // std::cout << "before filling m_MvtxRawHitMap size: " <<  m_MvtxRawHitMap.size() << std::endl;
-  uint64_t select_crossings = m_mvtx_is_triggered ? 0 : m_mvtx_bco_range;
+  uint64_t select_crossings = m_mvtx_is_triggered ? 0 : m_mvtx_bco_range.load();
   if (m_RefBCO == 0)
   {
     m_RefBCO = m_MvtxRawHitMap.begin()->first;
@@ -1200,51 +1272,53 @@ int Fun4AllStreamingInputManager::FillTpc()
 
 void Fun4AllStreamingInputManager::SetInttBcoRange(const unsigned int i)
 {
-  m_intt_bco_range = std::max(i, m_intt_bco_range);
+  raise_to(m_intt_bco_range, i);
 }
 
 void Fun4AllStreamingInputManager::SetInttNegativeBco(const unsigned int i)
 {
-  m_intt_negative_bco = std::max(i, m_intt_negative_bco);
+  raise_to(m_intt_negative_bco, i);
 }
 
 void Fun4AllStreamingInputManager::SetMicromegasBcoRange(const unsigned int i)
 {
-  m_micromegas_bco_range = std::max(i, m_micromegas_bco_range);
+  raise_to(m_micromegas_bco_range, i);
 }
 
 void Fun4AllStreamingInputManager::SetMicromegasNegativeBco(const unsigned int i)
 {
-  m_micromegas_negative_bco = std::max(i, m_micromegas_negative_bco);
+  raise_to(m_micromegas_negative_bco, i);
 }
 
 void Fun4AllStreamingInputManager::SetMvtxNegativeBco(const unsigned int i)
 {
-  m_mvtx_negative_bco = std::max(i, m_mvtx_negative_bco);
+  raise_to(m_mvtx_negative_bco, i);
 }
 
 void Fun4AllStreamingInputManager::SetTpcBcoRange(const unsigned int i)
 {
-  m_tpc_bco_range = std::max(i, m_tpc_bco_range);
+  raise_to(m_tpc_bco_range, i);
 }
 
 void Fun4AllStreamingInputManager::SetTpcNegativeBco(const unsigned int i)
 {
-  m_tpc_negative_bco = std::max(i, m_tpc_negative_bco);
+  raise_to(m_tpc_negative_bco, i);
 }
 
 void Fun4AllStreamingInputManager::SetMvtxBcoRange(const unsigned int i)
 {
-  m_mvtx_bco_range = std::max(i, m_mvtx_bco_range);
+  raise_to(m_mvtx_bco_range, i);
+}
+
+void Fun4AllStreamingInputManager::runMvtxTriggered(const bool b)
+{
+  m_mvtx_is_triggered.store(b);
 }
 
 int Fun4AllStreamingInputManager::FillInttPool()
 {
-  uint64_t ref_bco_minus_range = 0;
-  if (m_RefBCO > m_intt_negative_bco)
-  {
-    ref_bco_minus_range = m_RefBCO - m_intt_negative_bco;
-  }
+  std::vector<PoolFillJob> jobs;
+  const uint64_t ref_bco_minus_range = InttPoolTarget();
   for (auto *iter : m_InttInputVector)
   {
     if (!m_gl1_registered_flag)
@@ -1255,26 +1329,12 @@ int Fun4AllStreamingInputManager::FillInttPool()
     {
       std::cout << "Fun4AllStreamingInputManager::FillInttPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
-    // iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    jobs.push_back({iter, ref_bco_minus_range, true});
+  }
+  FillPools(jobs);
+  for (auto *iter : m_InttInputVector)
+  {
+    CheckRunNumber(iter);
   }
   if (m_InttRawHitMap.empty())
   {
@@ -1286,42 +1346,25 @@ int Fun4AllStreamingInputManager::FillInttPool()
 
 int Fun4AllStreamingInputManager::FillTpcPool()
 {
-  uint64_t ref_bco_minus_range = 0;
-  if (m_RefBCO > m_tpc_negative_bco)
-  {
-    ref_bco_minus_range = m_RefBCO - m_tpc_negative_bco;
-  }
-
+  std::vector<PoolFillJob> jobs;
+  const uint64_t ref_bco_minus_range = TpcPoolTarget();
   for (auto *iter : m_TpcInputVector)
   {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillTpcPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    jobs.push_back({iter, ref_bco_minus_range, true});
+  }
+  FillPools(jobs);
+  for (auto *iter : m_TpcInputVector)
+  {
     const int fill_pool_status = iter->FillPoolStatus();
     if (fill_pool_status < 0)
     {
       return fill_pool_status;
     }
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   // if (m_TpcRawHitMap.empty())
   // {
@@ -1333,31 +1376,19 @@ int Fun4AllStreamingInputManager::FillTpcPool()
 
 int Fun4AllStreamingInputManager::FillMicromegasPool()
 {
+  std::vector<PoolFillJob> jobs;
   for (auto *iter : m_MicromegasInputVector)
   {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillMicromegasPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    jobs.push_back({iter, 0, false});
+  }
+  FillPools(jobs);
+  for (auto *iter : m_MicromegasInputVector)
+  {
+    CheckRunNumber(iter);
   }
   if (m_MicromegasRawHitMap.empty())
   {
@@ -1369,32 +1400,20 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
 
 int Fun4AllStreamingInputManager::FillMvtxPool()
 {
-  uint64_t ref_bco_minus_range = m_RefBCO < m_mvtx_negative_bco ? m_mvtx_negative_bco : m_RefBCO - m_mvtx_negative_bco;
+  std::vector<PoolFillJob> jobs;
+  const uint64_t ref_bco_minus_range = MvtxPoolTarget();
   for (auto *iter : m_MvtxInputVector)
   {
     if (Verbosity() > 3)
     {
       std::cout << "Fun4AllStreamingInputManager::FillMvtxPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    jobs.push_back({iter, ref_bco_minus_range, true});
+  }
+  FillPools(jobs);
+  for (auto *iter : m_MvtxInputVector)
+  {
+    CheckRunNumber(iter);
   }
   if (m_MvtxRawHitMap.empty())
   {
@@ -1403,6 +1422,142 @@ int Fun4AllStreamingInputManager::FillMvtxPool()
   }
   return 0;
 }
+
+void Fun4AllStreamingInputManager::PrefillPools()
+{
+  // the targets are the same ones the FillXXXPool() methods use, so their own
+  // FillPool calls only have to top up what is missing
+  std::vector<PoolFillJob> jobs;
+  if (m_intt_registered_flag)
+  {
+    const uint64_t target = InttPoolTarget();
+    for (auto *iter : m_InttInputVector)
+    {
+      jobs.push_back({iter, target, true});
+    }
+  }
+  if (m_mvtx_registered_flag)
+  {
+    const uint64_t target = MvtxPoolTarget();
+    for (auto *iter : m_MvtxInputVector)
+    {
+      jobs.push_back({iter, target, true});
+    }
+  }
+  if (m_tpc_registered_flag)
+  {
+    const uint64_t target = TpcPoolTarget();
+    for (auto *iter : m_TpcInputVector)
+    {
+      jobs.push_back({iter, target, true});
+    }
+  }
+  if (m_micromegas_registered_flag)
+  {
+    for (auto *iter : m_MicromegasInputVector)
+    {
+      jobs.push_back({iter, 0, false});
+    }
+  }
+  FillPools(jobs);
+}
+
+void Fun4AllStreamingInputManager::FillPools(const std::vector<PoolFillJob> &jobs)
+{
+  const unsigned int njobs = jobs.size();
+  unsigned int nthreads = m_ParallelInputs ? njobs : 1;
+  if (m_InputThreads > 0)
+  {
+    nthreads = std::min(nthreads, m_InputThreads);
+  }
+  if (nthreads < 2)
+  {
+    for (const auto &job : jobs)
+    {
+      FillInputPool(job);
+    }
+    return;
+  }
+
+  // workers pick the next unprocessed input until all are done
+  std::atomic<unsigned int> next_job{0};
+  auto worker = [this, &jobs, &next_job, njobs]()
+  {
+    for (unsigned int i = next_job++; i < njobs; i = next_job++)
+    {
+      FillInputPool(jobs[i]);
+    }
+  };
+  std::vector<std::future<void>> workers;
+  workers.reserve(nthreads - 1);
+  for (unsigned int i = 1; i < nthreads; ++i)
+  {
+    workers.push_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto &w : workers)
+  {
+    w.get();
+  }
+}
+
+void Fun4AllStreamingInputManager::FillInputPool(const PoolFillJob &job)
+{
+  // the entry exists since registration, the map is not modified while jobs run
+  InputThroughput &counters = m_InputThroughput.at(job.Input);
+  t_current_input_hits = &counters.RawHits;
+  const auto start = std::chrono::steady_clock::now();
+  if (job.UseMinBCO)
+  {
+    job.Input->FillPool(job.MinBCO);
+  }
+  else
+  {
+    job.Input->FillPool();
+  }
+  counters.FillPoolTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  ++counters.FillPoolCalls;
+  t_current_input_hits = nullptr;
+}
+
+void Fun4AllStreamingInputManager::CheckRunNumber(const SingleStreamingInput *input)
+{
+  if (m_RunNumber == 0)
+  {
+    m_RunNumber = input->RunNumber();
+    SetRunNumber(m_RunNumber);
+  }
+  else
+  {
+    if (m_RunNumber != input->RunNumber())
+    {
+      std::cout << PHWHERE << " Run Number mismatch, run is "
+                << m_RunNumber << ", " << input->Name() << " reads "
+                << input->RunNumber() << std::endl;
+      std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
+      Print("INPUTFILES");
+      gSystem->Exit(1);
+      exit(1);
+    }
+  }
+}
+
+uint64_t Fun4AllStreamingInputManager::InttPoolTarget() const
+{
+  return (m_RefBCO > m_intt_negative_bco) ? m_RefBCO - m_intt_negative_bco : 0;
+}
+
+uint64_t Fun4AllStreamingInputManager::MvtxPoolTarget() const
+{
+  const uint64_t negative_bco = m_mvtx_negative_bco;
+  return m_RefBCO < negative_bco ? negative_bco : m_RefBCO - negative_bco;
+}
+
+uint64_t Fun4AllStreamingInputManager::TpcPoolTarget() const
+{
+  return (m_RefBCO > m_tpc_negative_bco) ? m_RefBCO - m_tpc_negative_bco : 0;
+}
+
 void Fun4AllStreamingInputManager::createQAHistos()
 {
   auto *hm = QAHistManagerDef::getHistoManager();
@@ -7,9 +7,12 @@
 
 #include <fun4all/Fun4AllInputManager.h>
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 class SingleStreamingInput;
 class Gl1Packet;
@@ -39,6 +42,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int GetSyncObject(SyncObject **mastersync) override;
   int SyncIt(const SyncObject *mastersync) override;
   int HasSyncObject() const override { return 1; }
+  bool IsStreaming() const override { return true; }
   std::string GetString(const std::string &what) const override;
   void registerStreamingInput(SingleStreamingInput *evtin, InputManagerType::enu_subsystem);
   int FillGl1();
@@ -67,7 +71,18 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int FillTpcPool();
   void Streaming(bool b = true) { m_StreamingFlag = b; }
 
-  void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
+  //! fill the pools of the registered inputs concurrently (default off)
+  /**
+   * after the GL1 reference BCO is known, the pools of all subsystems are filled
+   * in one parallel pass, and each FillXXXPool() fills its own inputs in parallel.
+   * The BCO alignment of the maps stays serial, the assembled events are unchanged
+   */
+  void SetParallelInputs(const bool b = true) { m_ParallelInputs = b; }
+
+  //! maximum number of concurrently filled inputs, 0 means one thread per input
+  void SetInputThreads(const unsigned int i) { m_InputThreads = i; }
+
+  void runMvtxTriggered(const bool b = true);
 
  private:
   struct MvtxRawHitInfo
@@ -102,22 +117,53 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
     unsigned int EventFoundCounter{0};
   };
 
+  //! one FillPool call of a single input
+  struct PoolFillJob
+  {
+    SingleStreamingInput *Input{nullptr};
+    uint64_t MinBCO{0};
+    //! false for inputs which are filled without target BCO (micromegas)
+    bool UseMinBCO{true};
+  };
+
+  //! per input throughput counters
+  struct InputThroughput
+  {
+    uint64_t FillPoolCalls{0};
+    uint64_t RawHits{0};
+    double FillPoolTime{0};  // seconds
+  };
+
   void createQAHistos();
 
+  //! run FillPool for all jobs, in parallel if enabled
+  void FillPools(const std::vector<PoolFillJob> &jobs);
+  void FillInputPool(const PoolFillJob &job);
+
+  //! fill the pools of all non GL1 inputs in one parallel pass
+  void PrefillPools();
+
+  void CheckRunNumber(const SingleStreamingInput *input);
+  uint64_t InttPoolTarget() const;
+  uint64_t MvtxPoolTarget() const;
+  uint64_t TpcPoolTarget() const;
+
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
 
   uint64_t m_RefBCO{0};
 
   int m_RunNumber{0};
-  unsigned int m_intt_bco_range{0};
-  unsigned int m_intt_negative_bco{0};
-  unsigned int m_micromegas_bco_range{0};
-  unsigned int m_micromegas_negative_bco{0};
-  unsigned int m_mvtx_bco_range{0};
-  unsigned int m_mvtx_negative_bco{0};
-  unsigned int m_tpc_bco_range{0};
-  unsigned int m_tpc_negative_bco{0};
+  // the inputs set the BCO ranges and the MVTX triggered flag from their
+  // FillPool(), which may run while other pools are filled
+  std::atomic<unsigned int> m_intt_bco_range{0};
+  std::atomic<unsigned int> m_intt_negative_bco{0};
+  std::atomic<unsigned int> m_micromegas_bco_range{0};
+  std::atomic<unsigned int> m_micromegas_negative_bco{0};
+  std::atomic<unsigned int> m_mvtx_bco_range{0};
+  std::atomic<unsigned int> m_mvtx_negative_bco{0};
+  std::atomic<unsigned int> m_tpc_bco_range{0};
+  std::atomic<unsigned int> m_tpc_negative_bco{0};
 
   bool m_gl1_registered_flag{false};
   bool m_intt_registered_flag{false};
@@ -125,7 +171,9 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   bool m_mvtx_registered_flag{false};
   bool m_StreamingFlag{false};
   bool m_tpc_registered_flag{false};
-  bool m_mvtx_is_triggered{false};
+  std::atomic<bool> m_mvtx_is_triggered{false};
+  bool m_ParallelInputs{false};
+  unsigned int m_InputThreads{0};
 
   std::vector<SingleStreamingInput *> m_Gl1InputVector;
   std::vector<SingleStreamingInput *> m_InttInputVector;
@@ -139,6 +187,16 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   std::map<uint64_t, TpcRawHitInfo> m_TpcRawHitMap;
   std::map<int, std::map<int, uint64_t>> m_InttPacketFeeBcoMap;
 
+  // inputs of one subsystem add their hits to the same map
+  std::mutex m_Gl1Mutex;
+  std::mutex m_InttMutex;
+  std::mutex m_MicromegasMutex;
+  std::mutex m_MvtxMutex;
+  std::mutex m_TpcMutex;
+
+  // entries are created at registration, a job only updates the entry of its input
+  std::map<const SingleStreamingInput *, InputThroughput> m_InputThroughput;
+
   // QA histos
   TH1 *h_refbco_mvtx[12]{nullptr};
   TH1 *h_taggedAllFelixes_mvtx{nullptr};
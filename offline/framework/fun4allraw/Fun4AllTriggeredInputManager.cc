@@ -24,11 +24,15 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <Event/packet.h>
+
 #include <TSystem.h>
 
 #include <algorithm>  // for std::search
 #include <cassert>
+#include <chrono>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
@@ -47,6 +51,10 @@ Fun4AllTriggeredInputManager::~Fun4AllTriggeredInputManager()
   {
     fileclose();
   }
+  if (HasSelection())
+  {
+    PrintSelection();
+  }
   delete m_SyncObject;
   for (auto *iter : m_TriggeredInputVector)
   {
@@ -60,6 +68,7 @@ Fun4AllTriggeredInputManager::~Fun4AllTriggeredInputManager()
 
 int Fun4AllTriggeredInputManager::run(const int /*nevents*/)
 {
+readagain:
   m_Gl1TriggeredInput->FillPool();
   for (auto *iter : m_TriggeredInputVector)
   {
@@ -70,6 +79,32 @@ int Fun4AllTriggeredInputManager::run(const int /*nevents*/)
       return -1;
     }
   }
+  if (HasSelection())
+  {
+    auto start = std::chrono::steady_clock::now();
+    bool keep = SelectEvent();
+    if (!keep)
+    {
+      m_Gl1TriggeredInput->SkipEvent();
+      for (auto *iter : m_TriggeredInputVector)
+      {
+        iter->SkipEvent();
+      }
+    }
+    m_SelectTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!keep)
+    {
+      m_EventsRejected++;
+      if (m_Gl1TriggeredInput->AllDone())
+      {
+        return -1;
+      }
+      // NOLINTNEXTLINE(hicpp-avoid-goto)
+      goto readagain;
+    }
+    m_EventsAccepted++;
+  }
+  auto start = std::chrono::steady_clock::now();
   m_Gl1TriggeredInput->ReadEvent();
   for (auto *iter : m_TriggeredInputVector)
   {
@@ -81,6 +116,8 @@ int Fun4AllTriggeredInputManager::run(const int /*nevents*/)
     }
   }
 
+  m_DecodeTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
   if (m_RunNumber == 0)
   {
     m_RunNumber = m_Gl1TriggeredInput->RunNumber();
@@ -118,9 +155,103 @@ void Fun4AllTriggeredInputManager::Print(const std::string &what) const
       std::cout << "prdf input: " << iter->Name() << std::endl;
     }
   }
+  if (HasSelection() && (what == "ALL" || what == "SELECTION"))
+  {
+    PrintSelection();
+  }
   return;
 }
 
+bool Fun4AllTriggeredInputManager::SelectEvent()
+{
+  // every packet is peeked at most once, they are deleted after the decision
+  std::map<int, Packet *> packets;
+  auto getpacket = [this, &packets](const int pid) -> Packet *
+  {
+    auto iter = packets.find(pid);
+    if (iter != packets.end())
+    {
+      return iter->second;
+    }
+    Packet *packet = m_Gl1TriggeredInput->PeekPacket(pid);
+    for (auto *input : m_TriggeredInputVector)
+    {
+      if (packet)
+      {
+        break;
+      }
+      packet = input->PeekPacket(pid);
+    }
+    packets[pid] = packet;
+    return packet;
+  };
+
+  bool keep = true;
+  if (!m_TriggerSelection.empty())
+  {
+    keep = false;
+    Packet *gl1packet = getpacket(14001);
+    if (gl1packet)
+    {
+      uint64_t scaledtriggervec = gl1packet->lValue(0, "ScaledVector");
+      for (int bit : m_TriggerSelection)
+      {
+        if (bit >= 0 && bit < 64 && ((scaledtriggervec >> bit) & 0x1U) == 0x1U)
+        {
+          keep = true;
+          break;
+        }
+      }
+    }
+  }
+  for (const auto &range : m_RequiredPacketRanges)
+  {
+    for (int pid = range.low; pid <= range.high && keep; pid++)
+    {
+      Packet *packet = getpacket(pid);
+      if (!packet || packet->getDataLength() < range.min_words)
+      {
+        if (Verbosity() > 1)
+        {
+          std::cout << Name() << ": rejecting event, packet " << pid << (packet ? " empty" : " missing") << std::endl;
+        }
+        keep = false;
+      }
+    }
+  }
+  if (keep && m_EventSelector)
+  {
+    keep = m_EventSelector(getpacket);
+  }
+  for (auto &iter : packets)
+  {
+    delete iter.second;
+  }
+  return keep;
+}
+
+void Fun4AllTriggeredInputManager::PrintSelection() const
+{
+  long nevents = m_EventsAccepted + m_EventsRejected;
+  std::cout << Name() << ": raw event selection accepted " << m_EventsAccepted
+            << " of " << nevents << " events" << std::endl;
+  if (nevents == 0 || m_EventsAccepted == 0)
+  {
+    return;
+  }
+  // without the selection every event would have been decoded
+  double decode_per_event = m_DecodeTime / m_EventsAccepted;
+  double with_selection = m_SelectTime + m_DecodeTime;
+  double without_selection = decode_per_event * nevents;
+  std::cout << Name() << ": selection " << 1e6 * m_SelectTime / nevents << " us/event, decoding "
+            << 1e6 * decode_per_event << " us/accepted event" << std::endl;
+  if (with_selection > 0)
+  {
+    std::cout << Name() << ": estimated input speed-up from skipping the decode of rejected events: "
+              << without_selection / with_selection << std::endl;
+  }
+}
+
 int Fun4AllTriggeredInputManager::ResetEvent()
 {
   return 0;
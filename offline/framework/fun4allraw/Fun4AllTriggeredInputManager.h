@@ -7,6 +7,7 @@
 
 #include <Event/phenixTypes.h>
 
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -22,6 +23,7 @@ class PHCompositeNode;
 class SingleTriggeredInput;
 class SyncObject;
 class OfflinePacket;
+class Packet;
 
 class Fun4AllTriggeredInputManager : public Fun4AllInputManager
 {
@@ -46,9 +48,39 @@ class Fun4AllTriggeredInputManager : public Fun4AllInputManager
   void EventNumber(const int i) { m_EventNumber = i; }
   int EventNumber() const { return m_EventNumber; }
 
+  // Event selection on the raw packets, before anything is decoded into the
+  // node tree. Rejected events are dropped by the inputs without decoding.
+  //! keep events where any of these scaled GL1 trigger bits fired
+  void AddTriggerSelection(const int bit) { m_TriggerSelection.push_back(bit); }
+  //! keep events which have all packets in [low, high] with at least min_words of data
+  //! (from the packet header, 0 only requires the packet)
+  void AddRequiredPacketRange(const int low, const int high, const int min_words = 0) { m_RequiredPacketRanges.push_back({low, high, min_words}); }
+  //! custom selection, getpacket(id) returns the undecoded raw packet or nullptr,
+  //! the packets are owned by the input manager and only valid during the call
+  void SetEventSelector(std::function<bool(const std::function<Packet *(int)> &getpacket)> selector) { m_EventSelector = std::move(selector); }
+
  private:
+  struct PacketRange
+  {
+    int low;
+    int high;
+    int min_words;
+  };
+
+  bool HasSelection() const { return !m_TriggerSelection.empty() || !m_RequiredPacketRanges.empty() || m_EventSelector; }
+  bool SelectEvent();
+  void PrintSelection() const;
+
   int m_RunNumber{0};
   int m_EventNumber{0};
+  std::vector<int> m_TriggerSelection;
+  std::vector<PacketRange> m_RequiredPacketRanges;
+  std::function<bool(const std::function<Packet *(int)> &)> m_EventSelector;
+  // selection statistics, the decode time of the accepted events gives the estimate of the time saved
+  long m_EventsAccepted{0};
+  long m_EventsRejected{0};
+  double m_SelectTime{0};
+  double m_DecodeTime{0};
   std::set<int> m_Gl1DroppedEvent;
   SingleTriggeredInput *m_Gl1TriggeredInput{nullptr};
   std::vector<SingleTriggeredInput *> m_TriggeredInputVector;
@@ -0,0 +1,64 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_PRDFPACKETCACHE_H
+#define FUN4ALLRAW_PRDFPACKETCACHE_H
+
+//  Packets of the current PRDF event which the Fun4AllPrdfInputManager
+//  read ahead mode already extracted and decoded on its worker threads.
+//  Modules ask the cache first and only call Event::getPacket if it does not
+//  have the packet. The cache owns its packets, do not delete them.
+
+#include <Event/packet.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+class PrdfPacketCache
+{
+ public:
+  PrdfPacketCache() = default;
+  ~PrdfPacketCache() { clear(); }
+
+  PrdfPacketCache(const PrdfPacketCache &) = delete;
+  PrdfPacketCache &operator=(const PrdfPacketCache &) = delete;
+
+  //! takes ownership
+  void addPacket(Packet *packet)
+  {
+    const int id = packet->getIdentifier();
+    auto iter = std::upper_bound(m_Packets.begin(), m_Packets.end(), id,
+                                 [](const int value, const std::pair<int, Packet *> &entry)
+                                 { return value < entry.first; });
+    m_Packets.emplace(iter, id, packet);
+  }
+
+  //! nullptr if the packet is not cached
+  Packet *getPacket(const int id) const
+  {
+    auto iter = std::lower_bound(m_Packets.begin(), m_Packets.end(), id,
+                                 [](const std::pair<int, Packet *> &entry, const int value)
+                                 { return entry.first < value; });
+    if (iter == m_Packets.end() || iter->first != id)
+    {
+      return nullptr;
+    }
+    return iter->second;
+  }
+
+  unsigned int size() const { return m_Packets.size(); }
+
+  void clear()
+  {
+    for (auto &entry : m_Packets)
+    {
+      delete entry.second;
+    }
+    m_Packets.clear();
+  }
+
+ private:
+  std::vector<std::pair<int, Packet *>> m_Packets;
+};
+
+#endif /* FUN4ALLRAW_PRDFPACKETCACHE_H */
@@ -174,3 +174,18 @@ int SingleGl1TriggeredInput::ReadEvent()
   delete gl1evt;
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+int SingleGl1TriggeredInput::SkipEvent()
+{
+  int gl1pid = 14001;
+  if (m_PacketEventDeque[gl1pid].empty())
+  {
+    std::cout << Name() << ": GL1 deque is empty — all events done" << std::endl;
+    AllDone(1);
+    return -1;
+  }
+  Event* gl1evt = m_PacketEventDeque[gl1pid].front();
+  m_PacketEventDeque[gl1pid].pop_front();
+  delete gl1evt;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
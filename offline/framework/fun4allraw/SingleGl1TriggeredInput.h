@@ -29,6 +29,7 @@ class SingleGl1TriggeredInput : public SingleTriggeredInput
   const std::array<int, pooldepth>& GetGl1SkipArray() const { return m_Gl1SkipPerIndex; }
   const std::array<uint64_t, pooldepth>& GetPacketNumbers() const { return m_Gl1PacketNumbers; }
   int ReadEvent() override;
+  int SkipEvent() override;
   void SetPacketNumbers(int last, int current)
   {
     m_LastPacketNumber = last;
@@ -167,24 +167,23 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
       else
       {
         int m_nWaveFormInFrame = packet->iValue(0, "NR_WF");
-        static int once = 0;
         for (int wf = 0; wf < m_nWaveFormInFrame; wf++)
         {
           if (m_TpcRawHitMap[gtm_bco].size() > 20000)
           {
-            if (!once)
+            if (!m_TooManyHitsCount)
             {
               std::cout << "too many hits" << std::endl;
             }
-            once++;
+            m_TooManyHitsCount++;
             continue;
           }
           
-                      if (once)
+                      if (m_TooManyHitsCount)
             {
-              std::cout << "many more hits: " << once << std::endl;
+              std::cout << "many more hits: " << m_TooManyHitsCount << std::endl;
             }
-            once = 0;
+            m_TooManyHitsCount = 0;
          
           bool checksumerror = (packet->iValue(wf, "CHECKSUMERROR") > 0);
           if (checksumerror)
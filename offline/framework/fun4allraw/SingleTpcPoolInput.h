@@ -37,6 +37,8 @@ class SingleTpcPoolInput : public SingleStreamingInput
   unsigned int m_BcoRange{0};
   unsigned int m_NegativeBco{0};
   unsigned int m_max_tpc_time_samples{425};
+  //! hits skipped since the last "too many hits" message
+  int m_TooManyHitsCount{0};
   bool m_skipEarlyEvents{true};
   //! map bco to packet
   std::map<unsigned int, uint64_t> m_packet_bco;
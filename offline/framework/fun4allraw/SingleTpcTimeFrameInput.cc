@@ -32,8 +32,13 @@
 #include <Event/Eventiterator.h>
 #include <Event/fileEventiterator.h>
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 SingleTpcTimeFrameInput::SingleTpcTimeFrameInput(const std::string &name)
   : SingleStreamingInput(name)
@@ -118,10 +123,9 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
 {
   m_FillPoolStatus = Fun4AllReturnCodes::EVENT_OK;
   {
-    static bool first = true;
-    if (first)
+    if (m_FirstFillPool)
     {
-      first = false;
+      m_FirstFillPool = false;
 
       if (!m_SelectedPacketIDs.empty())
       {
@@ -270,24 +274,28 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
     getNextEventTimer.stop();
 
     TimeTracker ProcessPacketTimer(m_ProcessPacketTimer, "ProcessPacket", m_hNorm);
+
+    auto cleanup_remaining_packets = [&]()
+    {
+      for (int j = 0; j < npackets; ++j)
+      {
+        if (plist[j])
+        {
+          delete plist[j];
+          plist[j] = nullptr;
+        }
+      }
+    };
+
+    // packets to decode, grouped per time frame builder (i.e. per DAM endpoint)
+    std::vector<std::pair<TpcTimeFrameBuilderBase *, std::vector<Packet *>>> decoding_jobs;
+
     for (int i = 0; i < npackets; i++)
     {
       // keep pointer to local packet
       auto &packet = plist[i];
       assert(packet);
 
-      auto cleanup_remaining_packets = [&](const int first_index)
-      {
-        for (int j = first_index; j < npackets; ++j)
-        {
-          if (plist[j])
-          {
-            delete plist[j];
-            plist[j] = nullptr;
-          }
-        }
-      };
-
       // get packet id
       const auto packet_id = packet->getIdentifier();
 
@@ -312,7 +320,7 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
                   << " to " << hit_format << ". Aborting run." << std::endl;
         packet->identify();
         m_FillPoolStatus = Fun4AllReturnCodes::ABORTRUN;
-        cleanup_remaining_packets(i);
+        cleanup_remaining_packets();
         return;
       }
 
@@ -343,7 +351,7 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
                     << " for packet id " << packet_id << ". Aborting run." << std::endl;
           packet->identify();
           m_FillPoolStatus = Fun4AllReturnCodes::ABORTRUN;
-          cleanup_remaining_packets(i);
+          cleanup_remaining_packets();
           return;
         }
 
@@ -362,21 +370,73 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
         packet->identify();
       }
 
-      assert(m_TpcTimeFrameBuilderMap[packet_id]);
-      const int process_packet_status = m_TpcTimeFrameBuilderMap[packet_id]->ProcessPacket(packet);
-      if (process_packet_status < 0)
+      TpcTimeFrameBuilderBase *builder = m_TpcTimeFrameBuilderMap[packet_id];
+      assert(builder);
+      auto job = std::find_if(decoding_jobs.begin(), decoding_jobs.end(),
+                              [builder](const auto &entry)
+                              { return entry.first == builder; });
+      if (job == decoding_jobs.end())
       {
-        std::cout << __PRETTY_FUNCTION__ << ": Error : TPC packet builder returned " << process_packet_status
-                  << " for packet id " << packet_id << ". Aborting run." << std::endl;
-        m_FillPoolStatus = process_packet_status;
-        cleanup_remaining_packets(i);
-        return;
+        decoding_jobs.emplace_back(builder, std::vector<Packet *>{packet});
+      }
+      else
+      {
+        job->second.push_back(packet);
       }
-      // require_more_data = require_more_data or m_TpcTimeFrameBuilderMap[packet_id]->isMoreDataRequired(targetBCO);
-
-      delete packet;
-      packet = nullptr;
     }  //     for (int i = 0; i < npackets; i++)
+
+    // decode packets. Each builder only accesses its own data,
+    // so that different endpoints can be decoded concurrently.
+    // The exception is the digital current debug TTree: all builders
+    // write to trees in the same output file, so decoding stays serial then
+    auto decode = [](const std::pair<TpcTimeFrameBuilderBase *, std::vector<Packet *>> &job)
+    {
+      for (auto *packet : job.second)
+      {
+        const int status = job.first->ProcessPacket(packet);
+        if (status < 0)
+        {
+          return status;
+        }
+      }
+      return 0;
+    };
+
+    std::vector<int> process_packet_status(decoding_jobs.size(), 0);
+    if (m_ParallelDecoding && m_digitalCurrentDebugTTreeName.empty() && decoding_jobs.size() > 1)
+    {
+      std::vector<std::future<int>> futures;
+      futures.reserve(decoding_jobs.size() - 1);
+      for (size_t j = 1; j < decoding_jobs.size(); ++j)
+      {
+        futures.push_back(std::async(std::launch::async, decode, std::cref(decoding_jobs[j])));
+      }
+      process_packet_status[0] = decode(decoding_jobs[0]);
+      for (size_t j = 1; j < decoding_jobs.size(); ++j)
+      {
+        process_packet_status[j] = futures[j - 1].get();
+      }
+    }
+    else
+    {
+      for (size_t j = 0; j < decoding_jobs.size(); ++j)
+      {
+        process_packet_status[j] = decode(decoding_jobs[j]);
+      }
+    }
+
+    cleanup_remaining_packets();
+
+    for (const auto &status : process_packet_status)
+    {
+      if (status < 0)
+      {
+        std::cout << __PRETTY_FUNCTION__ << ": Error : TPC packet builder returned " << status
+                  << ". Aborting run." << std::endl;
+        m_FillPoolStatus = status;
+        return;
+      }
+    }
     ProcessPacketTimer.stop();
 
   }  // while (require_more_data)
@@ -38,6 +38,10 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
 
   void AddPacketID(const int packetID) { m_SelectedPacketIDs.insert(packetID); }
 
+  //! decode the packets of the different DAM endpoints concurrently, one thread per endpoint.
+  //! Ignored if the digital current debug TTree is saved
+  void SetParallelDecoding(const bool b = true) { m_ParallelDecoding = b; }
+
   void setDigitalCurrentDebugTTreeName(const std::string &name)
   {
     m_digitalCurrentDebugTTreeName = name;
@@ -82,6 +86,8 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
   };
 
   int m_FillPoolStatus{0};
+  bool m_ParallelDecoding{false};
+  bool m_FirstFillPool{true};
   std::string m_digitalCurrentDebugTTreeName;
 };
 
@@ -1339,6 +1339,81 @@ int SingleTriggeredInput::ReadEvent()
     }
   }
 
+  PopEvent(events_to_delete);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+Packet* SingleTriggeredInput::PeekPacket(const int pid)
+{
+  auto iter = m_PacketEventDeque.find(pid);
+  if (iter == m_PacketEventDeque.end() || iter->second.empty())
+  {
+    return nullptr;
+  }
+  auto problem = m_PacketAlignmentProblem.find(pid);
+  if (problem != m_PacketAlignmentProblem.end() && problem->second)
+  {
+    return nullptr;
+  }
+  // ReadEvent() marks these as dropped
+  auto ditch = m_DitchPackets.find(pid);
+  if (ditch != m_DitchPackets.end() && ditch->second.contains(0))
+  {
+    return nullptr;
+  }
+  return iter->second.front()->getPacket(pid);
+}
+
+int SingleTriggeredInput::SkipEvent()
+{
+  for (const auto& [pid, dq] : m_PacketEventDeque)
+  {
+    if (dq.empty())
+    {
+      if (!EventAlignmentProblem())
+      {
+        std::cout << Name() << ": Packet " << pid << " has empty deque — all events done" << std::endl;
+        AllDone(1);
+      }
+      return -1;
+    }
+  }
+
+  bool all_packets_unshifted = std::all_of(
+      m_PacketShiftOffset.begin(), m_PacketShiftOffset.end(),
+      [](const std::pair<int, int>& p)
+      { return p.second == 0; });
+
+  // same bookkeeping as ReadEvent(), without touching the packet data
+  std::set<Event*> events_to_delete;
+  for (auto& [pid, dq] : m_PacketEventDeque)
+  {
+    if (m_PacketAlignmentProblem[pid])
+    {
+      continue;
+    }
+    Event* evt = dq.front();
+    if (m_DitchPackets.contains(pid) && m_DitchPackets[pid].contains(0))
+    {
+      continue;
+    }
+    if (m_packetclk_copy_runs && m_CorrectCopiedClockPackets.contains(pid))
+    {
+      m_PreviousValidBCOMap[pid] = GetClock(evt, pid);
+    }
+    if (all_packets_unshifted || m_PacketShiftOffset[pid] == 1)
+    {
+      events_to_delete.insert(evt);
+    }
+  }
+  PopEvent(events_to_delete);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void SingleTriggeredInput::PopEvent(const std::set<Event*>& events_to_delete)
+{
   for (Event* evtdelete : events_to_delete)
   {
     delete evtdelete;
@@ -1364,6 +1439,4 @@ int SingleTriggeredInput::ReadEvent()
       dq.pop_front();
     }
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -51,6 +51,11 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   virtual int FillEventVector();
   virtual void FillPacketClock(Event *evt, Packet *pkt, size_t event_index);
   virtual int ReadEvent();
+  //! raw packet pid of the event which ReadEvent() reads next, not decoded. The caller owns it,
+  //! nullptr if this input does not have the packet for this event
+  virtual Packet *PeekPacket(const int pid);
+  //! drop the event which ReadEvent() reads next without decoding its packets
+  virtual int SkipEvent();
   virtual SingleTriggeredInput *Gl1Input() { return m_Gl1Input; }
   virtual void Gl1Input(SingleTriggeredInput *input) { m_Gl1Input = input; }
   virtual uint64_t GetClock(Event *evt, int pid);
@@ -87,6 +92,8 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   std::map<int, std::array<uint64_t, pooldepth>> m_bclkdiffarray_map;
   std::set<int> m_PacketSet;
   static uint64_t ComputeClockDiff(uint64_t curr, uint64_t prev) { return (curr - prev) & 0xFFFFFFFF; }
+  //! the part of ReadEvent() which does not depend on the packet content
+  void PopEvent(const std::set<Event *> &events_to_delete);
 
  private:
   Eventiterator *m_EventIterator{nullptr};
@@ -79,6 +79,20 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
   m_hNorm->GetXaxis()->LabelsOption("v");
   hm->registerHisto(m_hNorm);
 
+  m_hHighWaterMarks = new TH1D(TString(m_HistoPrefix.c_str()) + "_HighWaterMarks",  //
+                                TString(m_HistoPrefix.c_str()) + " Maximum memory usage;Items;Maximum",
+                                6, .5, 6.5);
+  i = 1;
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "FEEBufferWords");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "TimeFrames");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitsPerTimeFrame");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitsInTimeFrames");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitPoolSize");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitsAllocated");
+  assert(i <= 7);
+  m_hHighWaterMarks->GetXaxis()->LabelsOption("v");
+  hm->registerHisto(m_hHighWaterMarks);
+
   h_PacketLength = new TH1I(TString(m_HistoPrefix.c_str()) + "_PacketLength",  //
                             TString(m_HistoPrefix.c_str()) + " PacketLength;PacketLength [32bit Words];Count", 1000, .5, 5e6);
   hm->registerHisto(h_PacketLength);
@@ -120,6 +134,7 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
   m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "PacketClockSyncUnavailable");
   m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "PacketClockSyncError");
   m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "PacketClockSyncOK");
+  m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "WordDroppedBufferOverflow");
   assert(i <= 25);
   hm->registerHisto(m_hFEEDataStream);
 
@@ -174,13 +189,17 @@ TpcTimeFrameBuilder::~TpcTimeFrameBuilder()
 {
   for (auto& timeFrameEntry : m_timeFrameMap)
   {
-    while (!timeFrameEntry.second.empty())
+    for (const auto& hit : timeFrameEntry.second)
     {
-      delete timeFrameEntry.second.back();
-      timeFrameEntry.second.pop_back();
+      delete hit;
     }
   }
 
+  for (const auto& hit : m_rawHitPool)
+  {
+    delete hit;
+  }
+
   delete m_packetTimer;
 
   delete m_digitalCurrentDebugTTree;
@@ -267,10 +286,7 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
       m_hNorm->Fill("GTM_TimeFrame_Dropped_Hit_Sum", it->second.size());
       assert(h_GTMClockDiff_Dropped);
       h_GTMClockDiff_Dropped->Fill(int64_t(it->first) - int64_t(bclk_rollover_corrected));
-      for (const auto& hit : it->second)
-      {
-        delete hit;
-      }
+      release_time_frame(it->second);
       it = m_timeFrameMap.erase(it);
     }
     else if (it->first < bclk_rollover_corrected + GL1_BCO_MATCH_WINDOW)
@@ -366,11 +382,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
 
     if (it != m_timeFrameMap.end())
     {
-      while (!it->second.empty())
-      {
-        delete it->second.back();
-        it->second.pop_back();
-      }
+      release_time_frame(it->second);
       m_timeFrameMap.erase(it);
     }
   }
@@ -383,14 +395,12 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
   {
     if (it->first <= bclk_rollover_corrected)
     {
-      int count = 0;
-      while (!it->second.empty())
+      const size_t count = it->second.size();
+      for (const auto& hit : it->second)
       {
-        m_hFEEDataStream->Fill(it->second.back()->get_fee(), "HitUnusedBeforeCleanup", 1);
-        delete it->second.back();
-        it->second.pop_back();
-        ++count;
+        m_hFEEDataStream->Fill(hit->get_fee(), "HitUnusedBeforeCleanup", 1);
       }
+      release_time_frame(it->second);
 
       if (m_verbosity >= 1)
       {
@@ -411,10 +421,81 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
   }  //   for (auto it = m_timeFrameMap.begin(); it != m_timeFrameMap.end();)
 }
 
+TpcRawHitv3* TpcTimeFrameBuilder::allocate_raw_hit()
+{
+  if (m_rawHitPool.empty())
+  {
+    ++m_nRawHitsAllocated;
+    return new TpcRawHitv3();
+  }
+
+  TpcRawHitv3* hit = m_rawHitPool.back();
+  m_rawHitPool.pop_back();
+  return hit;
+}
+
+void TpcTimeFrameBuilder::release_raw_hit(TpcRawHit* hit)
+{
+  // all hits are created by allocate_raw_hit
+  auto* hitv3 = static_cast<TpcRawHitv3*>(hit);  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+  if (m_rawHitPool.size() < kMaxRawHitPoolSize)
+  {
+    hitv3->Clear(nullptr);
+    m_rawHitPool.push_back(hitv3);
+  }
+  else
+  {
+    delete hitv3;
+    --m_nRawHitsAllocated;
+  }
+}
+
+void TpcTimeFrameBuilder::release_time_frame(std::vector<TpcRawHit*>& time_frame)
+{
+  assert(m_nRawHits >= time_frame.size());
+  m_nRawHits -= time_frame.size();
+  for (const auto& hit : time_frame)
+  {
+    release_raw_hit(hit);
+  }
+  time_frame.clear();
+}
+
+void TpcTimeFrameBuilder::update_high_water_marks()
+{
+  assert(m_hHighWaterMarks);
+
+  auto update = [this](const char* label, const size_t value)
+  {
+    const int bin = m_hHighWaterMarks->GetXaxis()->FindBin(label);
+    if (value > m_hHighWaterMarks->GetBinContent(bin))
+    {
+      m_hHighWaterMarks->SetBinContent(bin, value);
+    }
+  };
+
+  size_t fee_buffer_words = 0;
+  for (const auto& data_buffer : m_feeData)
+  {
+    fee_buffer_words = std::max(fee_buffer_words, data_buffer.size());
+  }
+  update("FEEBufferWords", fee_buffer_words);
+
+  size_t hits_per_time_frame = 0;
+  for (const auto& timeframe : m_timeFrameMap)
+  {
+    hits_per_time_frame = std::max(hits_per_time_frame, timeframe.second.size());
+  }
+  update("TimeFrames", m_timeFrameMap.size());
+  update("HitsPerTimeFrame", hits_per_time_frame);
+  update("HitsInTimeFrames", m_nRawHits);
+  update("HitPoolSize", m_rawHitPool.size());
+  update("HitsAllocated", m_nRawHitsAllocated);
+}
+
 int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 {
-  static size_t call_count = 0;
-  ++call_count;
+  ++m_callCount;
 
   if (m_verbosity > 1)
   {
@@ -492,7 +573,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
   }
 
   assert(m_packetTimer);
-  if ((m_verbosity == 1 && (call_count % 1000) == 0) || (m_verbosity > 1))
+  if ((m_verbosity == 1 && (m_callCount % 1000) == 0) || (m_verbosity > 1))
   {
     std::cout << __PRETTY_FUNCTION__ << "\t- : received packet ";
     packet->identify();
@@ -607,9 +688,22 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
       if (fee_id < MAX_FEECOUNT)
       {
+        FeeDataRingBuffer& data_buffer = m_feeData[fee_id];
         for (const uint16_t& i : dma_word_data.data)
         {
-          m_feeData[fee_id].push_back(i);
+          if (!data_buffer.push_back(i))
+          {
+            // should not happen: the buffer holds several maximum length FEE packets.
+            // Drop the content, and resync on the next FEE packet header
+            if (m_verbosity > 1)
+            {
+              std::cout << __PRETTY_FUNCTION__ << "\t- : Error : FEE " << fee_id << " data buffer overflow with "
+                        << data_buffer.size() << " words. Dropping buffer." << std::endl;
+            }
+            m_hFEEDataStream->Fill(fee_id, "WordDroppedBufferOverflow", data_buffer.size());
+            data_buffer.clear();
+            data_buffer.push_back(i);
+          }
         }
         m_hNorm->Fill("DMA_WORD_FEE", 1);
 
@@ -638,28 +732,31 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
     }
   }
 
+  // high water marks are recorded before dropping oversized time frames
+  update_high_water_marks();
+
   // sanity check for the timeframe size
-  for (auto& timeframe : m_timeFrameMap)
+  for (const auto& bco : m_overflowTimeFrameSet)
   {
-    if (timeframe.second.size() > kMaxRawHitLimit)
+    auto timeframe = m_timeFrameMap.find(bco);
+    if (timeframe == m_timeFrameMap.end())
     {
-      std::cout << __PRETTY_FUNCTION__ << "\t- : Warning : impossible amount of hits in the same timeframe at BCO "
-                << timeframe.first << "\t- : " << timeframe.second.size() << ", limit is " << kMaxRawHitLimit
-                << ". Dropping this time frame!"
-                << std::endl;
-      m_hNorm->Fill("TimeFrameSizeLimitError", 1);
-
-      while (!timeframe.second.empty())
-      {
-        delete timeframe.second.back();
-        timeframe.second.pop_back();
-      }
+      continue;
     }
+
+    std::cout << __PRETTY_FUNCTION__ << "\t- : Warning : impossible amount of hits in the same timeframe at BCO "
+              << timeframe->first << "\t- : " << timeframe->second.size() << ", limit is " << kMaxRawHitLimit
+              << ". Dropping this time frame!"
+              << std::endl;
+    m_hNorm->Fill("TimeFrameSizeLimitError", 1);
+
+    release_time_frame(timeframe->second);
   }
+  m_overflowTimeFrameSet.clear();
 
   m_packetTimer->stop();
   assert(h_ProcessPacket_Time);
-  h_ProcessPacket_Time->Fill(call_count, m_packetTimer->elapsed());
+  h_ProcessPacket_Time->Fill(m_callCount, m_packetTimer->elapsed());
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -674,7 +771,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   }
 
   assert(fee < m_feeData.size());
-  std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  FeeDataRingBuffer& data_buffer = m_feeData[fee];
 
   while (HEADER_LENGTH <= data_buffer.size())
   {
@@ -755,7 +852,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
     {
       process_fee_data_waveform(fee, data_buffer);
     }
-    data_buffer.erase(data_buffer.begin(), data_buffer.begin() + pkt_length + 1);
+    data_buffer.pop_front(pkt_length + 1);
     m_hFEEDataStream->Fill(fee, "WordValid", pkt_length + 1);
 
   }  //     while (HEADER_LENGTH < data_buffer.size())
@@ -763,7 +860,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, FeeDataRingBuffer& data_buffer)
 {
   const uint16_t& pkt_length = data_buffer[0];
 
@@ -924,16 +1021,12 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
 
     // Format is (N sample) (start time), (1st sample)... (Nth sample)
     size_t pos = HEADER_LENGTH;
-    std::deque<uint16_t>::const_iterator data_buffer_iterator = data_buffer.cbegin();
-    std::advance(data_buffer_iterator, pos);
     while (pos + 2 < pkt_length)
     {
-      const uint16_t& nsamp = *data_buffer_iterator;
+      const uint16_t& nsamp = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
-      const uint16_t& start_t = *data_buffer_iterator;
+      const uint16_t& start_t = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
       if (m_verbosity > 3)
       {
         std::cout << __PRETTY_FUNCTION__ << ": nsamp: " << nsamp
@@ -964,13 +1057,12 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
       std::vector<uint16_t> adc(nsamp);
       for (int j = 0; j < nsamp; j++)
       {
-        const uint16_t& adc_value = *data_buffer_iterator;
+        const uint16_t& adc_value = data_buffer[pos];
 
         adc[j] = adc_value;
         m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc_value);
 
         ++pos;
-        ++data_buffer_iterator;  // data_buffer[pos++];
       }
       payload.waveforms.emplace_back(start_t, std::move(adc));
 
@@ -992,8 +1084,17 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
     // valid packet in the buffer, create a new hit
     if (payload.type != TpcTimeFrameBuilder::BcoMatchingInformation::HEARTBEAT_T)
     {
-      TpcRawHitv3* hit = new TpcRawHitv3();
-      m_timeFrameMap[payload.gtm_bco].push_back(hit);
+      std::vector<TpcRawHit*>& time_frame = m_timeFrameMap[payload.gtm_bco];
+      if (time_frame.size() >= kMaxRawHitLimit)
+      {
+        // hard limit on the time frame size. The time frame is dropped at the end of the packet
+        m_overflowTimeFrameSet.insert(payload.gtm_bco);
+        return;
+      }
+
+      TpcRawHitv3* hit = allocate_raw_hit();
+      time_frame.push_back(hit);
+      ++m_nRawHits;
 
       hit->set_bco(payload.bx_timestamp);
       hit->set_packetid(m_packet_id);
@@ -1015,7 +1116,7 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
   return;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& fee, FeeDataRingBuffer& data_buffer)
 {
   if (m_verbosity > 2)
   {
@@ -1267,17 +1368,15 @@ uint16_t TpcTimeFrameBuilder::reverseBits(const uint16_t x) const
 
 std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t fee, const uint16_t l) const
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  const FeeDataRingBuffer& data_buffer = m_feeData[fee];
   assert(l < data_buffer.size());
 
-  std::deque<uint16_t>::const_iterator it = data_buffer.begin();
-
   uint16_t crc = 0xffffU;
   uint16_t data_parity = 0U;
 
-  for (int i = 0; i < l; ++i, ++it)
+  for (int i = 0; i < l; ++i)
   {
-    const uint16_t& x = *it;
+    const uint16_t& x = data_buffer[i];
 
     crc ^= reverseBits(x);
     for (uint16_t k = 0; k < 16U; k++)
@@ -1549,7 +1648,7 @@ void TpcTimeFrameBuilder::BcoMatchingInformation::print_gtm_bco_information() co
     // also print predicted fee bco
     if (is_verified())
     {
-      std::list<uint32_t> fee_bco_predicted_list;
+      std::vector<uint32_t> fee_bco_predicted_list;
       std::transform(
           m_gtm_bco_trig_list.begin(),
           m_gtm_bco_trig_list.end(),
@@ -2032,13 +2131,13 @@ std::optional<uint64_t> TpcTimeFrameBuilder::BcoMatchingInformation::find_gtm_bc
 void TpcTimeFrameBuilder::BcoMatchingInformation::cleanup()
 {
   // remove old gtm_bco and matching
-  while (m_gtm_bco_trig_list.size() > m_max_matching_data_size)
+  if (m_gtm_bco_trig_list.size() > m_max_matching_data_size)
   {
-    m_gtm_bco_trig_list.pop_front();
+    m_gtm_bco_trig_list.erase(m_gtm_bco_trig_list.begin(), m_gtm_bco_trig_list.end() - m_max_matching_data_size);
   }
-  while (m_bco_matching_list.size() > m_max_matching_data_size)
+  if (m_bco_matching_list.size() > m_max_matching_data_size)
   {
-    m_bco_matching_list.pop_front();
+    m_bco_matching_list.erase(m_bco_matching_list.begin(), m_bco_matching_list.end() - m_max_matching_data_size);
   }
 
   // clear orphans
@@ -4,8 +4,8 @@
 #include "TpcTimeFrameBuilderBase.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -20,6 +20,7 @@
 
 class Packet;
 class TpcRawHit;
+class TpcRawHitv3;
 class PHTimer;
 class TH1;
 class TH2;
@@ -85,8 +86,20 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
 
   int decode_gtm_data(const dma_word &gtm_word);
   int process_fee_data(unsigned int fee_id);
-  void process_fee_data_waveform(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
-  void process_fee_data_digital_current(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
+  void process_fee_data_waveform(const unsigned int &fee_id, FeeDataRingBuffer &data_buffer);
+  void process_fee_data_digital_current(const unsigned int &fee_id, FeeDataRingBuffer &data_buffer);
+
+  //! get a TpcRawHitv3 from the pool, or allocate a new one if the pool is empty
+  TpcRawHitv3 *allocate_raw_hit();
+
+  //! return a hit to the pool once it has been used, or delete it if the pool is full
+  void release_raw_hit(TpcRawHit *hit);
+
+  //! release all hits of a time frame
+  void release_time_frame(std::vector<TpcRawHit *> &time_frame);
+
+  //! update high water mark histogram
+  void update_high_water_marks();
 
   struct gtm_payload
   {
@@ -315,7 +328,8 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
     bool m_verified_from_data = false;
 
     //! list of available bco, sorted in time with rollover corrected
-    std::list<uint64_t> m_gtm_bco_trig_list;
+    /* the list is bounded to a few entries (m_max_matching_data_size), for which contiguous storage is the fastest */
+    std::vector<uint64_t> m_gtm_bco_trig_list;
 
     //! last digital current readout GTM BCO
     m_gtm_fee_bco_matching_pair_t m_gtm_bco_dc_read = {0, 0};
@@ -335,7 +349,7 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
     //! list of available GTM -> FEE bco mapping for trigger association
     std::map<uint64_t, uint32_t> m_gtm_bco_trigger_map;
 
-    std::list<m_fee_gtm_bco_matching_pair_t> m_bco_matching_list;
+    std::vector<m_fee_gtm_bco_matching_pair_t> m_bco_matching_list;
 
     //! keep track or  fee_bco for which no gtm_bco is found
     std::set<uint32_t> m_orphans;
@@ -373,7 +387,7 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
   };  //   class BcoMatchingInformation
 
  private:
-  std::vector<std::deque<uint16_t>> m_feeData;
+  std::vector<FeeDataRingBuffer> m_feeData;
 
   std::map<int, std::set<int>> m_maskedFEEs;
 
@@ -390,6 +404,23 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
   static const size_t kMaxRawHitLimit = 10000;  // 10k hits per event > 256ch/fee * 26fee
   std::queue<uint64_t> m_UsedTimeFrameSet;
 
+  //! time frames which reached kMaxRawHitLimit while processing the current packet
+  /* no more hits are stored for these, which caps the memory per time frame. They are dropped at the end of the packet */
+  std::set<uint64_t> m_overflowTimeFrameSet;
+
+  //! recycled TpcRawHitv3, to avoid one allocation per waveform
+  std::vector<TpcRawHitv3 *> m_rawHitPool;
+  static const size_t kMaxRawHitPoolSize = 2 * kMaxRawHitLimit;
+
+  //! number of hits currently held in m_timeFrameMap
+  size_t m_nRawHits = 0;
+
+  //! number of hits allocated, in the pool or in m_timeFrameMap
+  size_t m_nRawHitsAllocated = 0;
+
+  //! number of calls to ProcessPacket
+  size_t m_callCount = 0;
+
   //! fast skip mode when searching for particular GL1 BCO over long segment of files
   bool m_fastBCOSkip = false;
 
@@ -401,6 +432,7 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
   PHTimer *m_packetTimer = nullptr;
 
   TH1 *m_hNorm = nullptr;
+  TH1 *m_hHighWaterMarks = nullptr;
   TH2 *m_hFEEDataStream = nullptr;
   TH1 *m_hFEEChannelPacketCount = nullptr;
   TH2 *m_hFEESAMPAADC = nullptr;
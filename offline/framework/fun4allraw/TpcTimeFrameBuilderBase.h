@@ -1,6 +1,8 @@
 #ifndef FUN4ALLRAW_TPCTIMEFRAMEBUILDERBASE_H
 #define FUN4ALLRAW_TPCTIMEFRAMEBUILDERBASE_H
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -21,6 +23,67 @@ class TpcTimeFrameBuilderBase
   virtual void setVerbosity(int i) = 0;
   virtual void fillBadFeeMap() = 0;
   virtual void SaveDigitalCurrentDebugTTree(const std::string &name) = 0;
+
+ protected:
+  //! fixed capacity circular buffer for the 16-bit data stream of one FEE
+  /**
+   * FEE data are decoded as soon as a full FEE packet is available,
+   * so that the buffer only ever holds one partial packet plus one DMA word.
+   * The capacity is a power of two, allocated once, and is a hard limit on the buffered words
+   */
+  class FeeDataRingBuffer
+  {
+   public:
+    //! capacity in 16-bit words. Must be a power of two
+    static const size_t CAPACITY = 4096;
+
+    FeeDataRingBuffer()
+      : m_data(CAPACITY)
+    {
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+    //! access to the i-th word from the front of the buffer
+    const uint16_t &operator[](const size_t i) const
+    {
+      assert(i < m_size);
+      return m_data[(m_head + i) & (CAPACITY - 1)];
+    }
+
+    //! append a word. Returns false, and leaves the buffer unchanged, if the buffer is full
+    bool push_back(const uint16_t value)
+    {
+      if (m_size == CAPACITY)
+      {
+        return false;
+      }
+      m_data[(m_head + m_size) & (CAPACITY - 1)] = value;
+      ++m_size;
+      return true;
+    }
+
+    //! remove n words from the front of the buffer
+    void pop_front(const size_t n = 1)
+    {
+      assert(n <= m_size);
+      m_head = (m_head + n) & (CAPACITY - 1);
+      m_size -= n;
+    }
+
+    void clear()
+    {
+      m_head = 0;
+      m_size = 0;
+    }
+
+   private:
+    std::vector<uint16_t> m_data;
+    size_t m_head = 0;
+    size_t m_size = 0;
+  };
 };
 
 #endif
@@ -90,6 +90,21 @@ TpcTimeFrameBuilderRun3::TpcTimeFrameBuilderRun3(const int packet_id)
   m_hNorm->GetXaxis()->LabelsOption("v");
   hm->registerHisto(m_hNorm);
 
+  m_hHighWaterMarks = new TH1D(TString(m_HistoPrefix.c_str()) + "_HighWaterMarks",  //
+                                TString(m_HistoPrefix.c_str()) + " Maximum memory usage;Items;Maximum",
+                                7, .5, 7.5);
+  i = 1;
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "FEEBufferWords");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "FEEClockBuckets");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitsInFEEClockBuckets");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "TimeFrames");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitsInTimeFrames");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitPoolSize");
+  m_hHighWaterMarks->GetXaxis()->SetBinLabel(i++, "HitsAllocated");
+  assert(i <= 8);
+  m_hHighWaterMarks->GetXaxis()->LabelsOption("v");
+  hm->registerHisto(m_hHighWaterMarks);
+
   h_PacketLength = new TH1I(TString(m_HistoPrefix.c_str()) + "_PacketLength",  //
                             TString(m_HistoPrefix.c_str()) + " PacketLength;PacketLength [32bit Words];Count", 1000, .5, 5e6);
   hm->registerHisto(h_PacketLength);
@@ -131,6 +146,7 @@ TpcTimeFrameBuilderRun3::TpcTimeFrameBuilderRun3(const int packet_id)
   m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "PacketClockSyncUnavailable");
   m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "PacketClockSyncError");
   m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "PacketClockSyncOK");
+  m_hFEEDataStream->GetYaxis()->SetBinLabel(i++, "WordDroppedBufferOverflow");
   assert(i <= 25);
   hm->registerHisto(m_hFEEDataStream);
 
@@ -259,13 +275,16 @@ TpcTimeFrameBuilderRun3::~TpcTimeFrameBuilderRun3()
 
   for (auto& timeFrameEntry : m_timeFrameMap)
   {
-    while (!timeFrameEntry.second.empty())
+    for (TpcRawHit* hit : timeFrameEntry.second)
     {
-      TpcRawHit* hit = timeFrameEntry.second.back();
       delete hit;
-      timeFrameEntry.second.pop_back();
     }
   }
+
+  for (TpcRawHitRun3_typ* hit : m_rawHitPool)
+  {
+    delete hit;
+  }
   delete h_Run3PreviousTimeFrameWaveformADC;
   delete h_Run3PreviousTimeFrameRecoveredWaveformADC;
 
@@ -691,7 +710,7 @@ size_t TpcTimeFrameBuilderRun3::recover_truncated_waveforms(uint32_t predicted_f
       bool created_target = false;
       if (!target_hit)
       {
-        target_hit = new TpcRawHitRun3_typ();
+        target_hit = allocate_raw_hit();
         target_hit->set_bco(predicted_fee_bco);
         target_hit->set_packetid(m_packet_id);
         target_hit->set_fee(fee);
@@ -714,7 +733,7 @@ size_t TpcTimeFrameBuilderRun3::recover_truncated_waveforms(uint32_t predicted_f
           current_hit_diff[channel] = std::numeric_limits<int64_t>::max();
           assert(!timeframe.empty() && timeframe.back() == target_hit);
           timeframe.pop_back();
-          delete target_hit;
+          release_raw_hit(target_hit);
         }
         continue;
       }
@@ -772,12 +791,9 @@ void TpcTimeFrameBuilderRun3::cleanup_time_hit_map(uint64_t bclk_rollover_correc
 
       for (auto map_it = fee_time_hits.begin(); map_it != fee_time_hits.end();)
       {
-        for (TpcRawHit* hit : map_it->second)
-        {
-          m_hFEEDataStream->Fill(fee, "HitUnusedBeforeCleanup", 1);
-          delete hit;
-        }
-        map_it = fee_time_hits.erase(map_it);        
+        m_hFEEDataStream->Fill(fee, "HitUnusedBeforeCleanup", map_it->second.size());
+        release_hits(map_it->second);
+        map_it = fee_time_hits.erase(map_it);
       }
 
       continue;
@@ -788,11 +804,8 @@ void TpcTimeFrameBuilderRun3::cleanup_time_hit_map(uint64_t bclk_rollover_correc
       const int64_t diff = get_signed_fee_bco_diff(map_it->first, *predicted_fee_bco);
       if ((fee_clock_window == 0 && diff <= 0) || (fee_clock_window > 0 && diff < -static_cast<int64_t>(fee_clock_window)))
       {
-        for (TpcRawHit* hit : map_it->second)
-        {
-          m_hFEEDataStream->Fill(fee, "HitUnusedBeforeCleanup", 1);
-          delete hit;
-        }
+        m_hFEEDataStream->Fill(fee, "HitUnusedBeforeCleanup", map_it->second.size());
+        release_hits(map_it->second);
         map_it = fee_time_hits.erase(map_it);
       }
       else
@@ -803,6 +816,88 @@ void TpcTimeFrameBuilderRun3::cleanup_time_hit_map(uint64_t bclk_rollover_correc
   }
 }
 
+TpcRawHitRun3_typ* TpcTimeFrameBuilderRun3::allocate_raw_hit()
+{
+  if (m_rawHitPool.empty())
+  {
+    ++m_nRawHitsAllocated;
+    return new TpcRawHitRun3_typ();
+  }
+
+  TpcRawHitRun3_typ* hit = m_rawHitPool.back();
+  m_rawHitPool.pop_back();
+  return hit;
+}
+
+void TpcTimeFrameBuilderRun3::release_raw_hit(TpcRawHit* hit)
+{
+  // all hits are created by allocate_raw_hit
+  auto* hit_run3 = static_cast<TpcRawHitRun3_typ*>(hit);  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+  if (m_rawHitPool.size() < kMaxRawHitPoolSize)
+  {
+    hit_run3->Clear(nullptr);
+    m_rawHitPool.push_back(hit_run3);
+  }
+  else
+  {
+    delete hit_run3;
+    --m_nRawHitsAllocated;
+  }
+}
+
+void TpcTimeFrameBuilderRun3::release_hits(std::vector<TpcRawHit*>& hits)
+{
+  for (TpcRawHit* hit : hits)
+  {
+    release_raw_hit(hit);
+  }
+  hits.clear();
+}
+
+void TpcTimeFrameBuilderRun3::update_high_water_marks()
+{
+  assert(m_hHighWaterMarks);
+
+  auto update = [this](const char* label, const size_t value)
+  {
+    const int bin = m_hHighWaterMarks->GetXaxis()->FindBin(label);
+    if (value > m_hHighWaterMarks->GetBinContent(bin))
+    {
+      m_hHighWaterMarks->SetBinContent(bin, value);
+    }
+  };
+
+  size_t fee_buffer_words = 0;
+  for (const auto& data_buffer : m_feeData)
+  {
+    fee_buffer_words = std::max(fee_buffer_words, data_buffer.size());
+  }
+  update("FEEBufferWords", fee_buffer_words);
+
+  size_t fee_clock_buckets = 0;
+  size_t fee_clock_hits = 0;
+  for (const auto& fee_time_hits : m_timeHitMap)
+  {
+    fee_clock_buckets += fee_time_hits.size();
+    for (const auto& bucket : fee_time_hits)
+    {
+      fee_clock_hits += bucket.second.size();
+    }
+  }
+  update("FEEClockBuckets", fee_clock_buckets);
+  update("HitsInFEEClockBuckets", fee_clock_hits);
+
+  size_t time_frame_hits = 0;
+  for (const auto& timeframe : m_timeFrameMap)
+  {
+    time_frame_hits += timeframe.second.size();
+  }
+  update("TimeFrames", m_timeFrameMap.size());
+  update("HitsInTimeFrames", time_frame_hits);
+  update("HitPoolSize", m_rawHitPool.size());
+  update("HitsAllocated", m_nRawHitsAllocated);
+}
+
 bool TpcTimeFrameBuilderRun3::isMoreDataRequired(const uint64_t& gtm_bco) const
 {
   for (const BcoMatchingInformation& bcoMatchingInformation : m_bcoMatchingInformation_vec)
@@ -1189,12 +1284,7 @@ void TpcTimeFrameBuilderRun3::CleanupUsedPackets(const uint64_t& bclk)
     auto it = m_timeFrameMap.find(bco_completed);
     if (it != m_timeFrameMap.end())
     {
-      while (!it->second.empty())
-      {
-        TpcRawHit* hit = it->second.back();
-        delete hit;
-        it->second.pop_back();
-      }
+      release_hits(it->second);
       m_timeFrameMap.erase(it);
     }
   }
@@ -1205,8 +1295,7 @@ void TpcTimeFrameBuilderRun3::CleanupUsedPackets(const uint64_t& bclk)
 
 int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
 {
-  static size_t call_count = 0;
-  ++call_count;
+  ++m_callCount;
 
   if (m_verbosity > 1)
   {
@@ -1257,7 +1346,7 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
   }
 
   assert(m_packetTimer);
-  if ((m_verbosity == 1 && (call_count % 1000) == 0) || (m_verbosity > 1))
+  if ((m_verbosity == 1 && (m_callCount % 1000) == 0) || (m_verbosity > 1))
   {
     std::cout << __PRETTY_FUNCTION__ << "\t- : received packet ";
     packet->identify();
@@ -1280,9 +1369,9 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
       }
     }
     size_t total_fee_data = 0;
-    for (const auto& fee_data_deque : m_feeData)
+    for (const auto& fee_data_buffer : m_feeData)
     {
-      total_fee_data += fee_data_deque.size();
+      total_fee_data += fee_data_buffer.size();
     }
     size_t total_gtm_bco_trig = 0;
     size_t total_bco_heartbeat = 0;
@@ -1413,9 +1502,22 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
 
       if (fee_id < MAX_FEECOUNT)
       {
+        FeeDataRingBuffer& data_buffer = m_feeData[fee_id];
         for (const uint16_t& i : dma_word_data.data)
         {
-          m_feeData[fee_id].push_back(i);
+          if (!data_buffer.push_back(i))
+          {
+            // should not happen: the buffer holds several maximum length FEE packets.
+            // Drop the content, and resync on the next FEE packet header
+            if (m_verbosity > 1)
+            {
+              std::cout << __PRETTY_FUNCTION__ << "\t- : Error : FEE " << fee_id << " data buffer overflow with "
+                        << data_buffer.size() << " words. Dropping buffer." << std::endl;
+            }
+            m_hFEEDataStream->Fill(fee_id, "WordDroppedBufferOverflow", data_buffer.size());
+            data_buffer.clear();
+            data_buffer.push_back(i);
+          }
         }
         m_hNorm->Fill("DMA_WORD_FEE", 1);
 
@@ -1458,9 +1560,9 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
       }
     }
     size_t total_fee_data_post = 0;
-    for (const auto& fee_data_deque : m_feeData)
+    for (const auto& fee_data_buffer : m_feeData)
     {
-      total_fee_data_post += fee_data_deque.size();
+      total_fee_data_post += fee_data_buffer.size();
     }
     size_t total_gtm_bco_trig_post = 0;
     size_t total_bco_heartbeat_post = 0;
@@ -1479,37 +1581,34 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
               << std::endl;
   }
 
+  // high water marks are recorded before dropping oversized FEE-clock caches
+  update_high_water_marks();
+
   // sanity check for the cached FEE-clock hit size
-  for (size_t fee = 0; fee < m_timeHitMap.size(); ++fee)
+  for (const auto& [fee, fee_bco] : m_overflowTimeHitSet)
   {
     auto& fee_time_hits = m_timeHitMap[fee];
-    for (auto timehit = fee_time_hits.begin(); timehit != fee_time_hits.end();)
+    auto timehit = fee_time_hits.find(fee_bco);
+    if (timehit == fee_time_hits.end())
     {
-      if (timehit->second.size() > kMaxRawHitLimit)
-      {
-        std::cout << __PRETTY_FUNCTION__ << "\t- : Warning : impossible amount of hits for FEE "
-                  << fee << " at FEE BCO " << timehit->first << "\t- : " << timehit->second.size()
-                  << ", limit is " << kMaxRawHitLimit
-                  << ". Dropping this FEE-clock cache!"
-                  << std::endl;
-        m_hNorm->Fill("TimeFrameSizeLimitError", 1);
-
-        for (TpcRawHit* hit : timehit->second)
-        {
-          delete hit;
-        }
-        timehit = fee_time_hits.erase(timehit);
-      }
-      else
-      {
-        ++timehit;
-      }
+      continue;
     }
+
+    std::cout << __PRETTY_FUNCTION__ << "\t- : Warning : impossible amount of hits for FEE "
+              << fee << " at FEE BCO " << timehit->first << "\t- : " << timehit->second.size()
+              << ", limit is " << kMaxRawHitLimit
+              << ". Dropping this FEE-clock cache!"
+              << std::endl;
+    m_hNorm->Fill("TimeFrameSizeLimitError", 1);
+
+    release_hits(timehit->second);
+    fee_time_hits.erase(timehit);
   }
+  m_overflowTimeHitSet.clear();
 
   m_packetTimer->stop();
   assert(h_ProcessPacket_Time);
-  h_ProcessPacket_Time->Fill(call_count, m_packetTimer->elapsed());
+  h_ProcessPacket_Time->Fill(m_callCount, m_packetTimer->elapsed());
 
   // Track final buffer usage at end of ProcessPacket
   if (m_verbosity >= 1)
@@ -1525,9 +1624,9 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
       }
     }
     size_t total_fee_data_final = 0;
-    for (const auto& fee_data_deque : m_feeData)
+    for (const auto& fee_data_buffer : m_feeData)
     {
-      total_fee_data_final += fee_data_deque.size();
+      total_fee_data_final += fee_data_buffer.size();
     }
     size_t total_gtm_bco_trig_final = 0;
     size_t total_bco_heartbeat_final = 0;
@@ -1565,7 +1664,7 @@ int TpcTimeFrameBuilderRun3::process_fee_data(unsigned int fee)
   }
 
   assert(fee < m_feeData.size());
-  std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  FeeDataRingBuffer& data_buffer = m_feeData[fee];
 
   while (HEADER_LENGTH <= data_buffer.size())
   {
@@ -1646,7 +1745,7 @@ int TpcTimeFrameBuilderRun3::process_fee_data(unsigned int fee)
     {
       process_fee_data_waveform(fee, data_buffer);
     }
-    data_buffer.erase(data_buffer.begin(), data_buffer.begin() + pkt_length + 1);
+    data_buffer.pop_front(pkt_length + 1);
     m_hFEEDataStream->Fill(fee, "WordValid", pkt_length + 1);
 
   }  //     while (HEADER_LENGTH < data_buffer.size())
@@ -1654,7 +1753,7 @@ int TpcTimeFrameBuilderRun3::process_fee_data(unsigned int fee)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void TpcTimeFrameBuilderRun3::process_fee_data_waveform(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilderRun3::process_fee_data_waveform(const unsigned int& fee, FeeDataRingBuffer& data_buffer)
 {
   const uint16_t& pkt_length = data_buffer[0];
 
@@ -1799,16 +1898,12 @@ void TpcTimeFrameBuilderRun3::process_fee_data_waveform(const unsigned int& fee,
 
     // Format is (N sample) (start time), (1st sample)... (Nth sample)
     size_t pos = HEADER_LENGTH;
-    std::deque<uint16_t>::const_iterator data_buffer_iterator = data_buffer.cbegin();
-    std::advance(data_buffer_iterator, pos);
     while (pos + 2 < pkt_length)
     {
-      const uint16_t& nsamp = *data_buffer_iterator;
+      const uint16_t& nsamp = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
-      const uint16_t& start_t = *data_buffer_iterator;
+      const uint16_t& start_t = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
       if (m_verbosity > 3)
       {
         std::cout << __PRETTY_FUNCTION__ << ": nsamp: " << nsamp
@@ -1839,13 +1934,12 @@ void TpcTimeFrameBuilderRun3::process_fee_data_waveform(const unsigned int& fee,
       std::vector<uint16_t> adc(nsamp);
       for (int j = 0; j < nsamp; j++)
       {
-        const uint16_t& adc_value = *data_buffer_iterator;
+        const uint16_t& adc_value = data_buffer[pos];
 
         adc[j] = adc_value;
         m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc_value);
 
         ++pos;
-        ++data_buffer_iterator;  // data_buffer[pos++];
       }
       payload.waveforms.emplace_back(start_t, std::move(adc));
 
@@ -1874,7 +1968,17 @@ void TpcTimeFrameBuilderRun3::process_fee_data_waveform(const unsigned int& fee,
         return;
       }
 
-      TpcRawHitRun3_typ* hit = new TpcRawHitRun3_typ();
+      const uint32_t fee_bco = payload.bx_timestamp & kFEEClockMask;
+      std::vector<TpcRawHit*>& fee_bco_hits = m_timeHitMap[fee][fee_bco];
+      if (fee_bco_hits.size() >= kMaxRawHitLimit)
+      {
+        // hard limit on the FEE-clock cache size. The cache is dropped at the end of the packet
+        m_overflowTimeHitSet.emplace(fee, fee_bco);
+        return;
+      }
+
+      TpcRawHitRun3_typ* hit = allocate_raw_hit();
+      fee_bco_hits.push_back(hit);
 
       hit->set_bco(payload.bx_timestamp);
       hit->set_packetid(m_packet_id);
@@ -1890,15 +1994,13 @@ void TpcTimeFrameBuilderRun3::process_fee_data_waveform(const unsigned int& fee,
       {
         hit->move_adc_waveform(waveform.first, std::move(waveform.second));
       }
-
-      m_timeHitMap[fee][payload.bx_timestamp & kFEEClockMask].push_back(hit);
     }
   }  //     if (not m_fastBCOSkip)
 
   return;
 }
 
-void TpcTimeFrameBuilderRun3::process_fee_data_digital_current(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilderRun3::process_fee_data_digital_current(const unsigned int& fee, FeeDataRingBuffer& data_buffer)
 {
   if (m_verbosity > 2)
   {
@@ -2150,17 +2252,15 @@ uint16_t TpcTimeFrameBuilderRun3::reverseBits(const uint16_t x) const
 
 std::pair<uint16_t, uint16_t> TpcTimeFrameBuilderRun3::crc16_parity(const uint32_t fee, const uint16_t l) const
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  const FeeDataRingBuffer& data_buffer = m_feeData[fee];
   assert(l < data_buffer.size());
 
-  std::deque<uint16_t>::const_iterator it = data_buffer.begin();
-
   uint16_t crc = 0xffffU;
   uint16_t data_parity = 0U;
 
-  for (int i = 0; i < l; ++i, ++it)
+  for (int i = 0; i < l; ++i)
   {
-    const uint16_t& x = *it;
+    const uint16_t& x = data_buffer[i];
 
     crc ^= reverseBits(x);
     for (uint16_t k = 0; k < 16U; k++)
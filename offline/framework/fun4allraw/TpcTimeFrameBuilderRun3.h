@@ -7,7 +7,6 @@
 #include <array>
 #include <bitset>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -95,8 +94,20 @@ class TpcTimeFrameBuilderRun3 : public TpcTimeFrameBuilderBase
 
   int decode_gtm_data(const dma_word &gtm_word);
   int process_fee_data(unsigned int fee_id);
-  void process_fee_data_waveform(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
-  void process_fee_data_digital_current(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
+  void process_fee_data_waveform(const unsigned int &fee_id, FeeDataRingBuffer &data_buffer);
+  void process_fee_data_digital_current(const unsigned int &fee_id, FeeDataRingBuffer &data_buffer);
+
+  //! get a hit from the pool, or allocate a new one if the pool is empty
+  TpcRawHitRun3_typ *allocate_raw_hit();
+
+  //! return a hit to the pool once it has been used, or delete it if the pool is full
+  void release_raw_hit(TpcRawHit *hit);
+
+  //! release all hits of a FEE-clock cache or of a time frame
+  void release_hits(std::vector<TpcRawHit *> &hits);
+
+  //! update high water mark histogram
+  void update_high_water_marks();
 
   struct gtm_payload
   {
@@ -401,13 +412,16 @@ class TpcTimeFrameBuilderRun3 : public TpcTimeFrameBuilderBase
   };  //   class BcoMatchingInformation
 
  private:
-  std::vector<std::deque<uint16_t>> m_feeData;
+  std::vector<FeeDataRingBuffer> m_feeData;
 
   std::map<int, std::set<int>> m_maskedFEEs;
 
   int m_verbosity = 0;
   int m_packet_id = 0;
 
+  //! number of calls to ProcessPacket
+  size_t m_callCount = 0;
+
   //! common prefix for QA histograms
   std::string m_HistoPrefix;
 
@@ -447,6 +461,16 @@ class TpcTimeFrameBuilderRun3 : public TpcTimeFrameBuilderBase
   std::bitset<MAX_FEECOUNT> m_previousTimeFrameRecoveredFees;
   int m_hNormTruncatedWaveformRecoveryFeeFirstBin = 0;
   static const size_t kMaxRawHitLimit = 10000;  // 10k hits per event > 256ch/fee * 26fee
+
+  //! FEE and FEE BCO of the FEE-clock caches that reached kMaxRawHitLimit in the current packet
+  std::set<std::pair<uint16_t, uint32_t>> m_overflowTimeHitSet;
+
+  //! recycled hits
+  std::vector<TpcRawHitRun3_typ *> m_rawHitPool;
+  static const size_t kMaxRawHitPoolSize = 2 * kMaxRawHitLimit;
+
+  //! number of hits owned by this builder, in use or pooled
+  size_t m_nRawHitsAllocated = 0;
   std::queue<uint64_t> m_UsedTimeFrameSet;
 
   //! fast skip mode when searching for particular GL1 BCO over long segment of files
@@ -460,6 +484,7 @@ class TpcTimeFrameBuilderRun3 : public TpcTimeFrameBuilderBase
   PHTimer *m_packetTimer = nullptr;
 
   TH1 *m_hNorm = nullptr;
+  TH1 *m_hHighWaterMarks = nullptr;
   TH2 *m_hFEEDataStream = nullptr;
   TH1 *m_hFEEChannelPacketCount = nullptr;
   TH2 *m_hFEESAMPAADC = nullptr;
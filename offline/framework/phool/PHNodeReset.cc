@@ -25,7 +25,12 @@ void PHNodeReset::perform(PHNode* node)
     if (node->getObjectType() == "PHObject")
     {
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-      (static_cast<PHDataNode<PHObject>*>(node))->getData()->Reset();
+      PHObject* obj = (static_cast<PHDataNode<PHObject>*>(node))->getData();
+      if (recycle)
+      {
+        obj->EnableRecycling(true);
+      }
+      obj->Reset();
     }
   }
 }
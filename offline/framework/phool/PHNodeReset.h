@@ -15,8 +15,12 @@ class PHNodeReset : public PHNodeOperation
   PHNodeReset() = default;
   ~PHNodeReset() override = default;
 
+  //! enable object recycling (PHObject::EnableRecycling) in the containers before resetting them
+  void Recycle(const bool b) { recycle = b; }
+
  protected:
   void perform(PHNode *) override;
+  bool recycle {false};
 };
 
 #endif
@@ -33,6 +33,12 @@ class PHObject : public TObject
   /// Clear Event
   virtual void Reset();
 
+  /** containers which support it keep the objects they own in a PHObjectPool
+      on Reset() and reuse them instead of allocating new ones
+      @param flag enable or disable recycling
+   */
+  virtual void EnableRecycling(const bool /*flag*/) { return; }
+
   /// isValid returns non zero if object contains vailid data
   virtual int isValid() const;
 
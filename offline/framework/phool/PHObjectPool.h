@@ -0,0 +1,132 @@
+#ifndef PHOOL_PHOBJECTPOOL_H
+#define PHOOL_PHOBJECTPOOL_H
+
+//  Declaration of class PHObjectPool
+//  Purpose: free list of objects which a container reuses instead of
+//           deleting and allocating them again every event.
+//           A container creates its pool in EnableRecycling(true), its
+//           Reset() hands the objects to put() and the insert paths ask
+//           get() for an object of the type they need and only allocate if
+//           there is none.  Objects which are refilled with CopyFrom
+//           (get_like()) are put back as they are, since resetting them
+//           first only costs allocations which CopyFrom undoes; objects
+//           handed out by get() have to be reset before put().  The pool keeps one free
+//           list per type and only returns objects of exactly the requested
+//           type.  It holds at most as many objects as were asked for in the
+//           previous event (see new_cycle()).
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+template <class T>
+class PHObjectPool
+{
+ public:
+  explicit PHObjectPool(const std::size_t maxsize = 100000)
+    : m_maxsize(maxsize)
+  {
+  }
+
+  ~PHObjectPool() { clear(); }
+
+  PHObjectPool(const PHObjectPool &) = delete;
+  PHObjectPool &operator=(const PHObjectPool &) = delete;
+
+  //! a recycled object of exactly type U, nullptr (and an allocation is counted) if there is none
+  template <class U = T>
+  U *get()
+  {
+    return static_cast<U *>(take(typeid(U)));
+  }
+
+  //! a recycled object of the same type as proto, to be filled with CopyFrom
+  T *get_like(const T *proto)
+  {
+    return take(typeid(*proto));
+  }
+
+  //! keep an object for reuse, the pool owns it from now on
+  void put(T *obj)
+  {
+    if (!obj)
+    {
+      return;
+    }
+    if (m_nfree >= m_limit)
+    {
+      delete obj;
+      return;
+    }
+    m_free[std::type_index(typeid(*obj))].push_back(obj);
+    ++m_nfree;
+  }
+
+  //! called by the container at the start of Reset(). Until the next call the pool keeps at most
+  //! as many objects as were asked for since the previous call, so a pool nobody draws from stays empty
+  void new_cycle()
+  {
+    m_limit = std::min(m_maxsize, m_requests);
+    m_requests = 0;
+    trim(m_limit);
+  }
+
+  void clear() { trim(0); }
+
+  std::size_t size() const { return m_nfree; }
+  //! number of objects which had to be allocated since the pool was created
+  unsigned long allocated() const { return m_allocated; }
+  //! number of objects which were reused instead
+  unsigned long reused() const { return m_reused; }
+
+  void identify(std::ostream &os = std::cout) const
+  {
+    os << "PHObjectPool: " << m_nfree << " free objects of " << m_free.size() << " types, "
+       << m_reused << " reused, " << m_allocated << " allocated" << std::endl;
+  }
+
+ private:
+  T *take(const std::type_info &type)
+  {
+    ++m_requests;
+    auto iter = m_free.find(std::type_index(type));
+    if (iter == m_free.end() || iter->second.empty())
+    {
+      ++m_allocated;
+      return nullptr;
+    }
+    T *obj = iter->second.back();
+    iter->second.pop_back();
+    --m_nfree;
+    ++m_reused;
+    return obj;
+  }
+
+  void trim(const std::size_t n)
+  {
+    for (auto &[type, objects] : m_free)
+    {
+      while (m_nfree > n && !objects.empty())
+      {
+        delete objects.back();
+        objects.pop_back();
+        --m_nfree;
+      }
+    }
+  }
+
+  //! one free list per dynamic type
+  std::map<std::type_index, std::vector<T *>> m_free;
+  std::size_t m_nfree{0};
+  std::size_t m_maxsize{100000};
+  std::size_t m_limit{0};
+  std::size_t m_requests{0};
+  unsigned long m_allocated{0};
+  unsigned long m_reused{0};
+};
+
+#endif /* PHOOL_PHOBJECTPOOL_H */
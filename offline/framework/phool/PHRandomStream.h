@@ -0,0 +1,220 @@
+#ifndef PHOOL_PHRANDOMSTREAM_H
+#define PHOOL_PHRANDOMSTREAM_H
+
+//  Declaration of class PHRandomStream
+//  Purpose: counter based random numbers (Philox4x32-10, Salmon et al., SC11).
+//           A stream is a pure function of its key and counter, so a module
+//           derives independent streams for (run, event, sub-stream) from its seed
+//           and gets the same numbers no matter in which thread, process or
+//           order the sub-streams are processed.  Streams are cheap value
+//           objects, make one per thread or per work item instead of sharing one.
+//
+//           uint64_t key = PHRandomStream::MakeKey(PHRandomSeed(), Name());
+//           PHRandomStream rng(key, runnumber, eventnumber, hitsetkey);
+//           double x = rng.Gaus(sigma);
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class PHRandomStream
+{
+ public:
+  //! module key from a seed (PHRandomSeed) and the module name
+  static uint64_t MakeKey(const unsigned int seed, const std::string &name)
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a
+    for (const char c : name)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 0x100000001b3ULL;
+    }
+    return Mix(hash ^ Mix(seed));
+  }
+
+  PHRandomStream(const uint64_t key, const uint32_t run, const uint32_t event, const uint64_t substream = 0)
+  {
+    Reset(key, run, event, substream);
+  }
+
+  //! restart as the stream (key, run, event, substream)
+  void Reset(const uint64_t key, const uint32_t run, const uint32_t event, const uint64_t substream = 0)
+  {
+    const uint64_t runkey = Mix(key ^ (static_cast<uint64_t>(run) << 32U));
+    m_key = {static_cast<uint32_t>(runkey), static_cast<uint32_t>(runkey >> 32U)};
+    m_counter = {0, static_cast<uint32_t>(substream), static_cast<uint32_t>(substream >> 32U), event};
+    m_used = 4;
+    m_has_gaus = false;
+  }
+
+  uint32_t Integer()
+  {
+    if (m_used == 4)
+    {
+      m_block = Philox(m_counter, m_key);
+      ++m_counter[0];
+      m_used = 0;
+    }
+    return m_block[m_used++];
+  }
+
+  //! uniform in (0, 1) with 53 random bits
+  double Uniform()
+  {
+    const uint64_t hi = Integer();
+    const uint64_t lo = Integer();
+    return ToDouble((hi << 32U) | lo);
+  }
+
+  double Uniform(const double min, const double max) { return min + (max - min) * Uniform(); }
+
+  //! gaussian with mean 0 (Box-Muller, the second value is kept for the next call)
+  double Gaus(const double sigma = 1)
+  {
+    if (m_has_gaus)
+    {
+      m_has_gaus = false;
+      return sigma * m_gaus;
+    }
+    double g1;
+    double g2;
+    BoxMuller(Uniform(), Uniform(), g1, g2);
+    m_gaus = g2;
+    m_has_gaus = true;
+    return sigma * g1;
+  }
+
+  //! poisson distributed integer, multiplication method below mu = 10, Hoermann's PTRS above
+  unsigned int Poisson(const double mu)
+  {
+    if (!(mu > 0))
+    {
+      return 0;
+    }
+    if (mu < 10)
+    {
+      const double limit = std::exp(-mu);
+      unsigned int n = 0;
+      double prod = Uniform();
+      while (prod > limit)
+      {
+        ++n;
+        prod *= Uniform();
+      }
+      return n;
+    }
+    const double slam = std::sqrt(mu);
+    const double loglam = std::log(mu);
+    const double b = 0.931 + 2.53 * slam;
+    const double a = -0.059 + 0.02483 * b;
+    const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    const double vr = 0.9277 - 3.6224 / (b - 2);
+    while (true)
+    {
+      const double u = Uniform() - 0.5;
+      const double v = Uniform();
+      const double us = 0.5 - std::abs(u);
+      const double k = std::floor((2 * a / us + b) * u + mu + 0.43);
+      if (us >= 0.07 && v <= vr)
+      {
+        return static_cast<unsigned int>(k);
+      }
+      if (k < 0 || (us < 0.013 && v > us))
+      {
+        continue;
+      }
+      if (std::log(v) + std::log(invalpha) - std::log(a / (us * us) + b) <= -mu + k * loglam - std::lgamma(k + 1))
+      {
+        return static_cast<unsigned int>(k);
+      }
+    }
+  }
+
+  //! n uniform numbers in (0, 1), a block of two per Philox call
+  void FillUniform(double *out, const std::size_t n)
+  {
+    std::size_t i = 0;
+    for (; i + 1 < n; i += 2)
+    {
+      const std::array<uint32_t, 4> block = Philox(m_counter, m_key);
+      ++m_counter[0];
+      out[i] = ToDouble((static_cast<uint64_t>(block[0]) << 32U) | block[1]);
+      out[i + 1] = ToDouble((static_cast<uint64_t>(block[2]) << 32U) | block[3]);
+    }
+    if (i < n)
+    {
+      out[i] = Uniform();
+    }
+  }
+
+  //! n gaussian numbers with mean 0 and width sigma
+  void FillGaus(double *out, const std::size_t n, const double sigma = 1)
+  {
+    FillUniform(out, n);
+    std::size_t i = 0;
+    for (; i + 1 < n; i += 2)
+    {
+      double g1;
+      double g2;
+      BoxMuller(out[i], out[i + 1], g1, g2);
+      out[i] = sigma * g1;
+      out[i + 1] = sigma * g2;
+    }
+    if (i < n)
+    {
+      out[i] = Gaus(sigma);
+    }
+  }
+
+  //! one Philox4x32-10 block
+  static std::array<uint32_t, 4> Philox(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key)
+  {
+    for (int round = 0; round < 10; ++round)
+    {
+      if (round > 0)
+      {
+        key[0] += 0x9E3779B9U;
+        key[1] += 0xBB67AE85U;
+      }
+      const uint64_t p0 = static_cast<uint64_t>(0xD2511F53U) * ctr[0];
+      const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57U) * ctr[2];
+      ctr = {static_cast<uint32_t>(p1 >> 32U) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32U) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+    }
+    return ctr;
+  }
+
+ private:
+  //! splitmix64 finalizer
+  static uint64_t Mix(uint64_t x)
+  {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31U);
+  }
+
+  static double ToDouble(const uint64_t x)
+  {
+    return (static_cast<double>(x >> 11U) + 0.5) * 0x1.0p-53;
+  }
+
+  static void BoxMuller(const double u1, const double u2, double &g1, double &g2)
+  {
+    const double r = std::sqrt(-2 * std::log(u1));
+    const double phi = 2 * M_PI * u2;
+    g1 = r * std::cos(phi);
+    g2 = r * std::sin(phi);
+  }
+
+  std::array<uint32_t, 2> m_key{};
+  std::array<uint32_t, 4> m_counter{};
+  std::array<uint32_t, 4> m_block{};
+  unsigned int m_used{4};
+  bool m_has_gaus{false};
+  double m_gaus{0};
+};
+
+#endif /* PHOOL_PHRANDOMSTREAM_H */
@@ -33,6 +33,7 @@ class Fun4AllStreamingLumiCountingInputManager : public Fun4AllInputManager
   int GetSyncObject(SyncObject **mastersync) override;
   int SyncIt(const SyncObject *mastersync) override;
   int HasSyncObject() const override { return 1; }
+  bool IsStreaming() const override { return true; }
   std::string GetString(const std::string &what) const override;
   void registerStreamingInput(SingleStreamingInputv2 *evtin, InputManagerType::enu_subsystem);
   int FillGl1();
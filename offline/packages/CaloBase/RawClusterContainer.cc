@@ -4,6 +4,28 @@
 
 #include <iostream>
 
+// the clusters are shared, not copied, the pool stays with its container
+RawClusterContainer::RawClusterContainer(const RawClusterContainer& other)
+  : PHObject(other)
+  , _clusters(other._clusters)
+{
+}
+
+RawClusterContainer& RawClusterContainer::operator=(const RawClusterContainer& other)
+{
+  if (this != &other)
+  {
+    PHObject::operator=(other);
+    _clusters = other._clusters;
+  }
+  return *this;
+}
+
+RawClusterContainer::~RawClusterContainer()
+{
+  delete m_pool;
+}
+
 RawClusterContainer::ConstRange
 RawClusterContainer::getClusters() const
 {
@@ -61,16 +83,47 @@ int RawClusterContainer::isValid() const
 
 void RawClusterContainer::Reset()
 {
+  if (m_pool)
+  {
+    // only a container filled through NewCluster() keeps its clusters
+    m_pool->new_cycle();
+  }
   while (_clusters.begin() != _clusters.end())
   {
-    delete _clusters.begin()->second;
+    RawCluster* cluster = _clusters.begin()->second;
+    if (m_pool && cluster)
+    {
+      cluster->Reset();
+      m_pool->put(cluster);
+    }
+    else
+    {
+      delete cluster;
+    }
     _clusters.erase(_clusters.begin());
   }
 }
 
+void RawClusterContainer::EnableRecycling(const bool flag)
+{
+  if (flag && !m_pool)
+  {
+    m_pool = new PHObjectPool<RawCluster>();
+  }
+  else if (!flag)
+  {
+    delete m_pool;
+    m_pool = nullptr;
+  }
+}
+
 void RawClusterContainer::identify(std::ostream& os) const
 {
   os << "RawClusterContainer, number of clusters: " << size() << std::endl;
+  if (m_pool)
+  {
+    m_pool->identify(os);
+  }
 }
 
 double
@@ -1,16 +1,16 @@
 #ifndef CALOBASE_RAWCLUSTERCONTAINER_H
 #define CALOBASE_RAWCLUSTERCONTAINER_H
 
+#include "RawCluster.h"
 #include "RawClusterDefs.h"
 
 #include <phool/PHObject.h>
+#include <phool/PHObjectPool.h>
 
 #include <iostream>
 #include <map>
 #include <utility>
 
-class RawCluster;
-
 class RawClusterContainer : public PHObject
 {
  public:
@@ -21,14 +21,25 @@ class RawClusterContainer : public PHObject
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
 
   RawClusterContainer() = default;
-  ~RawClusterContainer() override = default;
+  RawClusterContainer(const RawClusterContainer &other);
+  RawClusterContainer &operator=(const RawClusterContainer &other);
+  ~RawClusterContainer() override;
 
   void Reset() override;
   int isValid() const override;
   void identify(std::ostream &os = std::cout) const override;
+  void EnableRecycling(const bool flag) override;
 
   ConstIterator AddCluster(RawCluster *rawcluster);
 
+  //! a new empty cluster of type T for AddCluster, reused from a previous event if recycling is enabled
+  template <class T>
+  T *NewCluster()
+  {
+    T *cluster = m_pool ? m_pool->get<T>() : nullptr;
+    return cluster ? cluster : new T();
+  }
+
   RawCluster *getCluster(const RawClusterDefs::keytype key);
   const RawCluster *getCluster(const RawClusterDefs::keytype key) const;
 
@@ -44,6 +55,9 @@ class RawClusterContainer : public PHObject
  protected:
   Map _clusters;
 
+  //! reset clusters kept for reuse, only if recycling is enabled
+  PHObjectPool<RawCluster> *m_pool{nullptr};  //!
+
   ClassDefOverride(RawClusterContainer, 1)
 };
 
@@ -15,6 +15,8 @@
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <fun4allraw/PrdfPacketCache.h>
 #include <phool/recoConsts.h>
 
 #include <phool/PHCompositeNode.h>
@@ -263,6 +265,8 @@ int CaloTowerBuilder::process_sim()
 int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::vector<float>> &waveforms)
 {
   std::variant<CaloPacketContainer *, Event *> event;
+  // packets which the read ahead of the prdf input manager already extracted
+  PrdfPacketCache *packetcache = nullptr;
   if (m_UseOfflinePacketFlag)
   {
     CaloPacketContainer *calopacketcontainer = findNode::getClass<CaloPacketContainer>(topNode, nodemap.find(m_dettype)->second);
@@ -288,7 +292,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
   }
   else
   {
-    Event *_event = findNode::getClass<Event>(topNode, "PRDF");
+    Event *_event = findNode::getClass<Event>(topNode, m_prdfNodeName);
     if (_event == nullptr)
     {
       std::cout << PHWHERE << " Event not found" << std::endl;
@@ -299,6 +303,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
       return Fun4AllReturnCodes::ABORTEVENT;
     }
     event = _event;
+    packetcache = findNode::getClass<PrdfPacketCache>(topNode, m_prdfNodeName + "PACKETS");
   }
   // since the function call on Packet and CaloPacket is the same, maybe we can use lambda?
   auto process_packet = [&](auto *packet, int pid)
@@ -449,14 +454,21 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
       }
       else if (auto *_event = std::get_if<Event *>(&event))
       {
-        Packet *packet = (*_event)->getPacket(pid);
+        Packet *cached = packetcache ? packetcache->getPacket(pid) : nullptr;
+        Packet *packet = cached ? cached : (*_event)->getPacket(pid);
         if (process_packet(packet, pid) == Fun4AllReturnCodes::ABORTEVENT)
         {
           // I think it is safe to delete a nullptr...
-          delete packet;
+          if (!cached)
+          {
+            delete packet;
+          }
           return Fun4AllReturnCodes::ABORTEVENT;
         }
-        delete packet;
+        if (!cached)
+        {
+          delete packet;
+        }
       }
     }
     else
@@ -77,6 +77,13 @@ public:
     return;
   }
 
+  //! name of the prdf Event node of the Fun4AllPrdfInputManager, its packet cache is in <name>PACKETS
+  void set_prdfNodeName(const std::string &name)
+  {
+    m_prdfNodeName = name;
+    return;
+  }
+
   void set_offlineflag(const bool f = true)
   {
     m_UseOfflinePacketFlag = f;
@@ -157,6 +164,7 @@ private:
   std::string m_detector{"CEMC"};
   std::string m_inputNodePrefix{"WAVEFORM_"};
   std::string m_outputNodePrefix{"TOWERS_"};
+  std::string m_prdfNodeName{"PRDF"};
   std::string TowerNodeName;
   bool m_setTimeLim{false};
   float m_timeLim_low{-3.0};
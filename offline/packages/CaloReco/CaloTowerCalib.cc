@@ -244,20 +244,33 @@ void CaloTowerCalib::LoadCalib(PHCompositeNode *topNode)
   unsigned int ntowers = _raw_towers->size();
   m_cdbInfo_vec.resize(ntowers);
 
+  // resolve each field once and read it as a column instead of a string lookup per tower
+  CDBTTree::ColumnView<float> calib = cdbttree->GetFloatColumnView(m_fieldname);
+  CDBTTree::ColumnView<float> crosscalib;
+  CDBTTree::ColumnView<float> meantime;
+  if (m_doZScrosscalib)
+  {
+    crosscalib = cdbttree_ZScrosscalib->GetFloatColumnView(m_fieldname_ZScrosscalib);
+  }
+  if (m_dotimecalib)
+  {
+    meantime = cdbttree_time->GetFloatColumnView(m_fieldname_time);
+  }
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
     unsigned int key = _raw_towers->encode_key(channel);
 
-    m_cdbInfo_vec[channel].calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    m_cdbInfo_vec[channel].calibconst = calib(key);
 
     if (m_doZScrosscalib)
     {
-      m_cdbInfo_vec[channel].crosscalibconst = cdbttree_ZScrosscalib->GetFloatValue(key, m_fieldname_ZScrosscalib);
+      m_cdbInfo_vec[channel].crosscalibconst = crosscalib(key);
     }
 
     if(m_dotimecalib)
     {
-      m_cdbInfo_vec[channel].meantime = cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      m_cdbInfo_vec[channel].meantime = meantime(key);
     }
   }
 }
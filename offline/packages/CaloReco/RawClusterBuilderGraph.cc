@@ -180,7 +180,7 @@ int RawClusterBuilderGraph::process_event(PHCompositeNode *topNode)
     if (last_id != clusterid)
     {
       // new cluster
-      cluster = new RawClusterv1();
+      cluster = _clusters->NewCluster<RawClusterv1>();
       _clusters->AddCluster(cluster);
 
       last_id = clusterid;
@@ -0,0 +1,350 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef QAUTILS_HISTACCUMULATOR_H
+#define QAUTILS_HISTACCUMULATOR_H
+
+/*!
+ * \file HistAccumulator.h
+ * \brief contiguous counters for a bank of identically binned histograms
+ *
+ * Hot loops that fill thousands of per tower histograms pay a virtual call and a bin search per TH1::Fill,
+ * and cannot run in threads because ROOT histograms are not thread safe.
+ * A HistAccumulator holds the bin contents of nhist histograms with the same fixed binning in one array,
+ * with the statistics TH1 keeps (entries, sum of weights and moments).  Each thread fills its own copy,
+ * the copies are merged with Add() and the result is added to the ROOT histograms with AddTo(),
+ * which gives the same contents and statistics as filling the histograms directly.
+ *
+ * T is the type of the bin counters; float has the footprint and precision of a TH1F,
+ * double is safer when many threads or events are merged.
+ *
+ * A histogram index out of range is not filled and counted in Rejected(), where the
+ * histogram arrays it replaces would have thrown or written out of bounds.
+ * Compare() checks a histogram filled this way against one filled directly.
+ */
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TH1.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+template <class T = double>
+class HistAccumulator
+{
+ public:
+  struct Axis
+  {
+    int nbins{0};
+    double min{0};
+    double max{1};
+
+    //! same convention as TAxis::FindFixBin: 0 is underflow, nbins + 1 overflow
+    int FindBin(double x) const
+    {
+      if (x < min)
+      {
+        return 0;
+      }
+      if (!(x < max))
+      {
+        return nbins + 1;
+      }
+      return 1 + static_cast<int>(nbins * (x - min) / (max - min));
+    }
+  };
+
+  HistAccumulator() = default;
+
+  //! nhist histograms binned like ref, which can be a TH1, TH2 or TH3 with fixed bins
+  HistAccumulator(unsigned int nhist, const TH1 *ref)
+  {
+    m_dim = ref->GetDimension();
+    const TAxis *axes[3] = {ref->GetXaxis(), ref->GetYaxis(), ref->GetZaxis()};
+    for (int i = 0; i < m_dim; ++i)
+    {
+      if (axes[i]->IsVariableBinSize())
+      {
+        std::cout << "HistAccumulator - " << ref->GetName() << " has variable bins, which are not supported" << std::endl;
+      }
+      m_axis[i] = {axes[i]->GetNbins(), axes[i]->GetXmin(), axes[i]->GetXmax()};
+    }
+    Allocate(nhist, ref->GetSumw2N() > 0);
+  }
+
+  //! nhist one dimensional histograms
+  HistAccumulator(unsigned int nhist, int nbins, double min, double max, bool sumw2 = false)
+    : m_dim(1)
+  {
+    m_axis[0] = {nbins, min, max};
+    Allocate(nhist, sumw2);
+  }
+
+  unsigned int NHist() const { return m_nhist; }
+  int GetDimension() const { return m_dim; }
+  const Axis &GetAxis(int i) const { return m_axis[i]; }
+
+  //! number of cells per histogram, including under- and overflows, as TH1::GetNcells
+  std::size_t NCells() const { return m_ncells; }
+
+  //! contents of histogram ihist, indexed like TH1::GetBin
+  const T *Content(unsigned int ihist) const { return m_content.data() + ihist * m_ncells; }
+  double Entries(unsigned int ihist) const { return m_entries[ihist]; }
+
+  //! number of fills with a histogram index out of range
+  double Rejected() const { return m_rejected; }
+
+  //! returns false, and fills nothing, if ihist is out of range
+  bool Fill(unsigned int ihist, double x, double w = 1)
+  {
+    if (!Accept(ihist))
+    {
+      return false;
+    }
+    const int bin = m_axis[0].FindBin(x);
+    Count(ihist, bin, w);
+    if (bin == 0 || bin > m_axis[0].nbins)
+    {
+      return true;
+    }
+    double *s = Stats(ihist);
+    s[0] += w;
+    s[1] += w * w;
+    s[2] += w * x;
+    s[3] += w * x * x;
+    return true;
+  }
+
+  bool Fill2D(unsigned int ihist, double x, double y, double w = 1)
+  {
+    if (!Accept(ihist))
+    {
+      return false;
+    }
+    const int binx = m_axis[0].FindBin(x);
+    const int biny = m_axis[1].FindBin(y);
+    Count(ihist, binx + (m_axis[0].nbins + 2) * biny, w);
+    if (binx == 0 || binx > m_axis[0].nbins || biny == 0 || biny > m_axis[1].nbins)
+    {
+      return true;
+    }
+    double *s = Stats(ihist);
+    s[0] += w;
+    s[1] += w * w;
+    s[2] += w * x;
+    s[3] += w * x * x;
+    s[4] += w * y;
+    s[5] += w * y * y;
+    s[6] += w * x * y;
+    return true;
+  }
+
+  bool Fill3D(unsigned int ihist, double x, double y, double z, double w = 1)
+  {
+    if (!Accept(ihist))
+    {
+      return false;
+    }
+    const int binx = m_axis[0].FindBin(x);
+    const int biny = m_axis[1].FindBin(y);
+    const int binz = m_axis[2].FindBin(z);
+    Count(ihist, binx + (m_axis[0].nbins + 2) * (biny + (m_axis[1].nbins + 2) * binz), w);
+    if (binx == 0 || binx > m_axis[0].nbins || biny == 0 || biny > m_axis[1].nbins || binz == 0 || binz > m_axis[2].nbins)
+    {
+      return true;
+    }
+    double *s = Stats(ihist);
+    s[0] += w;
+    s[1] += w * w;
+    s[2] += w * x;
+    s[3] += w * x * x;
+    s[4] += w * y;
+    s[5] += w * y * y;
+    s[6] += w * x * y;
+    s[7] += w * z;
+    s[8] += w * z * z;
+    s[9] += w * x * z;
+    s[10] += w * y * z;
+    return true;
+  }
+
+  //! merge another accumulator with the same layout, e.g. the copy of another thread
+  void Add(const HistAccumulator &other)
+  {
+    if (other.m_content.size() != m_content.size() || other.m_sumw2.size() != m_sumw2.size())
+    {
+      std::cout << "HistAccumulator::Add - layouts differ, ignored" << std::endl;
+      return;
+    }
+    for (std::size_t i = 0; i < m_content.size(); ++i)
+    {
+      m_content[i] += other.m_content[i];
+    }
+    for (std::size_t i = 0; i < m_sumw2.size(); ++i)
+    {
+      m_sumw2[i] += other.m_sumw2[i];
+    }
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+      m_entries[i] += other.m_entries[i];
+    }
+    for (std::size_t i = 0; i < m_stats.size(); ++i)
+    {
+      m_stats[i] += other.m_stats[i];
+    }
+    m_rejected += other.m_rejected;
+  }
+
+  //! add histogram ihist to h, which must have the same binning; h may already hold entries
+  bool AddTo(unsigned int ihist, TH1 *h) const
+  {
+    if (!h || h->GetDimension() != m_dim || static_cast<std::size_t>(h->GetNcells()) != m_ncells)
+    {
+      std::cout << "HistAccumulator::AddTo - histogram " << (h ? h->GetName() : "(null)") << " does not match the accumulator binning" << std::endl;
+      return false;
+    }
+    if (m_entries[ihist] == 0)
+    {
+      return true;
+    }
+    // the statistics must be taken before the contents change, an empty histogram computes them from its bins
+    std::array<double, TH1::kNstat> stats{};
+    h->GetStats(stats.data());
+    const double entries = h->GetEntries();
+
+    const T *content = Content(ihist);
+    for (std::size_t cell = 0; cell < m_ncells; ++cell)
+    {
+      if (content[cell] != 0)
+      {
+        h->AddBinContent(static_cast<int>(cell), content[cell]);
+      }
+    }
+    if (h->GetSumw2N() > 0)
+    {
+      TArrayD *sumw2 = h->GetSumw2();
+      for (std::size_t cell = 0; cell < m_ncells; ++cell)
+      {
+        // unweighted fills if the accumulator did not keep the squares
+        sumw2->fArray[cell] += m_sumw2.empty() ? content[cell] : m_sumw2[ihist * m_ncells + cell];
+      }
+    }
+    const double *s = m_stats.data() + ihist * TH1::kNstat;
+    for (int i = 0; i < TH1::kNstat; ++i)
+    {
+      stats[i] += s[i];
+    }
+    h->PutStats(stats.data());
+    h->SetEntries(entries + m_entries[ihist]);
+    return true;
+  }
+
+  void Reset()
+  {
+    std::fill(m_content.begin(), m_content.end(), 0);
+    std::fill(m_sumw2.begin(), m_sumw2.end(), 0);
+    std::fill(m_entries.begin(), m_entries.end(), 0);
+    std::fill(m_stats.begin(), m_stats.end(), 0);
+    m_rejected = 0;
+  }
+
+  //! true if h and ref have the same binning, contents, entries and statistics within the relative tolerance
+  static bool Compare(const TH1 *h, const TH1 *ref, double tolerance = 1e-6)
+  {
+    if (!h || !ref || h->GetDimension() != ref->GetDimension() || h->GetNcells() != ref->GetNcells())
+    {
+      std::cout << "HistAccumulator::Compare - binning differs" << std::endl;
+      return false;
+    }
+    auto same = [tolerance](double a, double b)
+    { return std::abs(a - b) <= tolerance * std::max({1., std::abs(a), std::abs(b)}); };
+
+    for (int cell = 0; cell < h->GetNcells(); ++cell)
+    {
+      if (!same(h->GetBinContent(cell), ref->GetBinContent(cell)))
+      {
+        std::cout << "HistAccumulator::Compare - " << h->GetName() << " cell " << cell << ": "
+                  << h->GetBinContent(cell) << " instead of " << ref->GetBinContent(cell) << std::endl;
+        return false;
+      }
+    }
+    if (!same(h->GetEntries(), ref->GetEntries()))
+    {
+      std::cout << "HistAccumulator::Compare - " << h->GetName() << " entries: "
+                << h->GetEntries() << " instead of " << ref->GetEntries() << std::endl;
+      return false;
+    }
+    std::array<double, TH1::kNstat> stats{};
+    std::array<double, TH1::kNstat> ref_stats{};
+    h->GetStats(stats.data());
+    ref->GetStats(ref_stats.data());
+    for (int i = 0; i < TH1::kNstat; ++i)
+    {
+      if (!same(stats[i], ref_stats[i]))
+      {
+        std::cout << "HistAccumulator::Compare - " << h->GetName() << " statistic " << i << ": "
+                  << stats[i] << " instead of " << ref_stats[i] << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  bool Accept(unsigned int ihist)
+  {
+    if (ihist < m_nhist)
+    {
+      return true;
+    }
+    m_rejected += 1;
+    return false;
+  }
+
+  void Allocate(unsigned int nhist, bool sumw2)
+  {
+    m_nhist = nhist;
+    m_ncells = 1;
+    for (int i = 0; i < m_dim; ++i)
+    {
+      m_ncells *= m_axis[i].nbins + 2;
+    }
+    m_content.assign(m_nhist * m_ncells, 0);
+    if (sumw2)
+    {
+      m_sumw2.assign(m_nhist * m_ncells, 0);
+    }
+    m_entries.assign(m_nhist, 0);
+    m_stats.assign(m_nhist * TH1::kNstat, 0);
+  }
+
+  void Count(unsigned int ihist, std::size_t cell, double w)
+  {
+    const std::size_t index = ihist * m_ncells + cell;
+    m_content[index] += w;
+    if (!m_sumw2.empty())
+    {
+      m_sumw2[index] += w * w;
+    }
+    m_entries[ihist] += 1;
+  }
+
+  double *Stats(unsigned int ihist) { return m_stats.data() + ihist * TH1::kNstat; }
+
+  int m_dim{0};
+  std::array<Axis, 3> m_axis{};
+  unsigned int m_nhist{0};
+  std::size_t m_ncells{0};
+
+  std::vector<T> m_content;
+  std::vector<double> m_sumw2;
+  std::vector<double> m_entries;
+  std::vector<double> m_stats;  // TH1::kNstat per histogram, in the layout of TH1::GetStats
+  double m_rejected{0};
+};
+
+#endif  // QAUTILS_HISTACCUMULATOR_H
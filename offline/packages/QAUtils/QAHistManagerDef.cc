@@ -28,16 +28,22 @@ namespace QAHistManagerDef
   //! Get a pointer to the default hist manager for QA modules
   Fun4AllHistoManager *
   getHistoManager()
+  {
+    return getHistoManager(HistoManagerName);
+  }
+
+  Fun4AllHistoManager *
+  getHistoManager(const std::string &name)
   {
     Fun4AllServer *se = Fun4AllServer::instance();
-    Fun4AllHistoManager *hm = se->getHistoManager(HistoManagerName);
+    Fun4AllHistoManager *hm = se->getHistoManager(name);
 
     if (!hm)
     {
       //        std::cout
       //            << "QAHistManagerDef::get_HistoManager - Making Fun4AllHistoManager EMCalAna_HISTOS"
       //            << std::endl;
-      hm = new Fun4AllHistoManager(HistoManagerName);
+      hm = new Fun4AllHistoManager(name);
       se->registerHistoManager(hm);
     }
 
@@ -45,6 +51,26 @@ namespace QAHistManagerDef
 
     return hm;
   }
+
+  void registerHistoCopy(Fun4AllHistoManager *hm, const TH1 *h)
+  {
+    assert(hm);
+    assert(h);
+
+    TH1 *registered = hm->isHistoRegistered(h->GetName()) ? dynamic_cast<TH1 *>(hm->getHisto(h->GetName())) : nullptr;
+    if (registered)
+    {
+      registered->Reset();
+      registered->Add(h);
+      return;
+    }
+
+    // the copy must not be attached to the current directory, the manager owns it
+    TH1 *copy = static_cast<TH1 *>(h->Clone());  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    copy->SetDirectory(nullptr);
+    hm->registerHisto(copy);
+  }
+
   std::vector<std::string> tokenize(const std::string &str, const char *delimiter)
   {
     std::vector<std::string> tokens;
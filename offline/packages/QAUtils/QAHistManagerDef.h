@@ -16,12 +16,20 @@
 
 class Fun4AllHistoManager;
 class TAxis;
+class TH1;
 
 namespace QAHistManagerDef
 {
   //! Get a pointer to the default hist manager for QA modules
   Fun4AllHistoManager* getHistoManager();
 
+  //! Get a pointer to the hist manager of given name, which is created and registered with the server if needed
+  Fun4AllHistoManager* getHistoManager(const std::string& name);
+
+  //! Register a detached copy of a histogram owned elsewhere, e.g. by a module's own output file.
+  //! If a histogram of the same name is already registered, its content is replaced
+  void registerHistoCopy(Fun4AllHistoManager* hm, const TH1* h);
+
   //! Save hist to root files. It will overwrite the old file if exist
   void saveQARootFile(const std::string& file_name);
 
@@ -502,3 +502,19 @@ void AlignmentDefs::printBuffers(int index, Acts::Vector2 residual, Acts::Vector
   }
   std::cout << " end of meas " << std::endl;
 }
+
+std::string AlignmentDefs::getShardFileName(const std::string& base, int shard, int nshards)
+{
+  if (nshards <= 1)
+  {
+    return base;
+  }
+  const std::string tag = "_shard" + std::to_string(shard);
+  const auto dot = base.find_last_of('.');
+  const auto slash = base.find_last_of('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return base + tag;
+  }
+  return base.substr(0, dot) + tag + base.substr(dot);
+}
@@ -4,6 +4,8 @@
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TrkrDefs.h>
 
+#include <string>
+
 namespace AlignmentDefs
 {
   enum mvtxGrp
@@ -74,5 +76,9 @@ namespace AlignmentDefs
                     Acts::Vector2 clus_sigma, float lcl_derivative[],
                     float glbl_derivative[], int glbl_label[]);
 
+  //! name of the mille data file for one of nshards output shards,
+  //! "base_shardN.ext" for more than one shard, base itself otherwise
+  std::string getShardFileName(const std::string& base, int shard, int nshards);
+
 }  // namespace AlignmentDefs
 #endif
@@ -46,6 +46,7 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <chrono>
 #include <climits>  // for UINT_MAX
 #include <cmath>    // for std::abs, sqrt
 #include <fstream>
@@ -77,12 +78,28 @@ namespace
     }
     return false;
   }
+
+  // result of the helical (or straight line) fit of one tracklet
+  struct TrackletFit
+  {
+    bool accepted{false};
+    std::vector<Acts::Vector3> global_vec;
+    std::vector<TrkrDefs::cluskey> cluskey_vec;
+    std::vector<float> fitpars;
+    std::vector<float> fitpars_mvtx_half;
+    Acts::Vector3 vertex{0, 0, 0};
+    TrackSeed_v2 someseed;
+    SvtxTrack_v4 newTrack;
+    unsigned int nsilicon{0};
+    unsigned int ntpc{0};
+    unsigned int nclus{0};
+    bool h2h_flag{false};
+  };
 };  // namespace
 //____________________________________________________________________________..
 HelicalFitter::HelicalFitter(const std::string& name)
   : SubsysReco(name)
   , PHParameterInterface(name)
-  , _mille(nullptr)
 {
   InitializeParameters();
 
@@ -110,19 +127,26 @@ int HelicalFitter::InitRun(PHCompositeNode* topNode)
     return ret;
   }
 
-  // Instantiate Mille and open output data file
-  if (test_output)
+  // Instantiate Mille and open output data file(s)
+  for (int ishard = 0; ishard < m_nshards; ++ishard)
   {
-    _mille = new Mille(data_outfilename.c_str(), false);  // write text in data files, rather than binary, for debugging only
-  }
-  else
-  {
-    _mille = new Mille(data_outfilename.c_str());
+    const std::string filename = AlignmentDefs::getShardFileName(data_outfilename, ishard, m_nshards);
+    if (test_output)
+    {
+      _mille.push_back(new Mille(filename.c_str(), false));  // write text in data files, rather than binary, for debugging only
+    }
+    else
+    {
+      _mille.push_back(new Mille(filename.c_str()));
+    }
   }
 
-  // Write the steering file here, and add the data file path to it
+  // Write the steering file here, and add the data file paths to it
   std::ofstream steering_file(steering_outfilename);
-  steering_file << data_outfilename << std::endl;
+  for (int ishard = 0; ishard < m_nshards; ++ishard)
+  {
+    steering_file << AlignmentDefs::getShardFileName(data_outfilename, ishard, m_nshards) << std::endl;
+  }
   steering_file.close();
 
   if (make_ntuple)
@@ -220,10 +244,6 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 
   // Decide whether we want to make a helical fit for silicon or TPC
   unsigned int maxtracks = 0;
-  unsigned int nsilicon = 0;
-  unsigned int ntpc = 0;
-  unsigned int nclus = 0;
-  bool h2h_flag = false;
   bool mvtx_east_only = false;
   bool mvtx_west_only = false;
   if (do_mvtx_half == 0)
@@ -234,14 +254,6 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
   {
     mvtx_west_only = true;
   }
-  std::vector<std::vector<Acts::Vector3>> cumulative_global_vec;
-  std::vector<std::vector<TrkrDefs::cluskey>> cumulative_cluskey_vec;
-  std::vector<std::vector<float>> cumulative_fitpars_vec;
-  std::vector<std::vector<float>> cumulative_fitpars_mvtx_half_vec;
-  std::vector<Acts::Vector3> cumulative_vertex;
-  std::vector<TrackSeed> cumulative_someseed;
-  std::vector<SvtxTrack_v4> cumulative_newTrack;
-
   if (fittpc && _track_map_tpc != nullptr)
   {
     maxtracks = _track_map_tpc->size();
@@ -250,8 +262,18 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
   {
     maxtracks = _track_map_silicon->size();
   }
+
+  // the tracklet fits only read the event, they run in parallel and fill one slot per tracklet.
+  // Derivatives and mille records are made serially below, in tracklet order
+  const auto fit_start = std::chrono::steady_clock::now();
+  std::vector<TrackletFit> fits(maxtracks);
+#pragma omp parallel for schedule(dynamic) num_threads(m_nthreads)
   for (unsigned int trackid = 0; trackid < maxtracks; ++trackid)
   {
+    unsigned int nsilicon = 0;
+    unsigned int ntpc = 0;
+    unsigned int nclus = 0;
+    bool h2h_flag = false;
     TrackSeed* tracklet = nullptr;
     if (fitsilicon && _track_map_silicon != nullptr)
     {
@@ -523,14 +545,31 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
     {
       continue;
     }
-    cumulative_global_vec.push_back(global_vec);
-    cumulative_cluskey_vec.push_back(cluskey_vec);
-    cumulative_vertex.push_back(track_vtx);
-    cumulative_fitpars_vec.push_back(fitpars);
-    cumulative_fitpars_mvtx_half_vec.push_back(fitpars_mvtx_half);
-    cumulative_someseed.push_back(someseed);
-    cumulative_newTrack.push_back(newTrack);
+    auto& fit = fits[trackid];
+    fit.accepted = true;
+    fit.global_vec = std::move(global_vec);
+    fit.cluskey_vec = std::move(cluskey_vec);
+    fit.fitpars = std::move(fitpars);
+    fit.fitpars_mvtx_half = std::move(fitpars_mvtx_half);
+    fit.vertex = track_vtx;
+    fit.someseed = someseed;
+    fit.newTrack = newTrack;
+    fit.nsilicon = nsilicon;
+    fit.ntpc = ntpc;
+    fit.nclus = nclus;
+    fit.h2h_flag = h2h_flag;
+  }
+
+  std::vector<TrackletFit> accepted_fits;
+  for (auto& fit : fits)
+  {
+    if (fit.accepted)
+    {
+      accepted_fits.push_back(std::move(fit));
+    }
   }
+  m_fit_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - fit_start).count();
+  m_ntracklets += maxtracks;
 
   // terminate loop over tracks
   // Collect fitpars for each track by intializing array of size maxtracks and populaating thorughout the loop
@@ -539,24 +578,32 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
   float xsum = 0;
   float ysum = 0;
   float zsum = 0;
-  unsigned int const accepted_tracks = cumulative_fitpars_vec.size();
+  unsigned int const accepted_tracks = accepted_fits.size();
+  m_naccepted += accepted_tracks;
 
   for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
   {
-    xsum += cumulative_vertex[trackid][0];
-    ysum += cumulative_vertex[trackid][1];
-    zsum += cumulative_vertex[trackid][2];
+    xsum += accepted_fits[trackid].vertex[0];
+    ysum += accepted_fits[trackid].vertex[1];
+    zsum += accepted_fits[trackid].vertex[2];
   }
   Acts::Vector3 averageVertex(xsum / accepted_tracks, ysum / accepted_tracks, zsum / accepted_tracks);
 
   for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
   {
-    const auto& global_vec = cumulative_global_vec[trackid];
-    const auto& cluskey_vec = cumulative_cluskey_vec[trackid];
-    auto fitpars = cumulative_fitpars_vec[trackid];
-    auto fitpars_mvtx_half = cumulative_fitpars_mvtx_half_vec[trackid];
-    const auto& someseed = cumulative_someseed[trackid];
-    auto newTrack = cumulative_newTrack[trackid];
+    const auto& fit = accepted_fits[trackid];
+    const auto& global_vec = fit.global_vec;
+    const auto& cluskey_vec = fit.cluskey_vec;
+    auto fitpars = fit.fitpars;
+    auto fitpars_mvtx_half = fit.fitpars_mvtx_half;
+    const auto& someseed = fit.someseed;
+    auto newTrack = fit.newTrack;
+    unsigned int const nsilicon = fit.nsilicon;
+    unsigned int const ntpc = fit.ntpc;
+    unsigned int const nclus = fit.nclus;
+    bool const h2h_flag = fit.h2h_flag;
+    // accepted tracks are dealt out to the output shards round robin
+    Mille* mille = _mille[trackid % _mille.size()];
     SvtxAlignmentStateMap::StateVec statevec;
 
     // get the residuals and derivatives for all clusters
@@ -872,7 +919,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
           std::cerr << "glbl_derivativeX is NaN" << std::endl;
           continue;
         }
-        _mille->mille(AlignmentDefs::NLC, lcl_derivativeX, AlignmentDefs::NGL, glbl_derivativeX, glbl_label, residual(0), errinf * clus_sigma(0));
+        mille->mille(AlignmentDefs::NLC, lcl_derivativeX, AlignmentDefs::NGL, glbl_derivativeX, glbl_label, residual(0), errinf * clus_sigma(0));
       }
 
       if (!isnan(residual(1)) && clus_sigma(1) < 1.0)
@@ -887,7 +934,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
           std::cerr << "glbl_derivativeY is NaN" << std::endl;
           continue;
         }
-        _mille->mille(AlignmentDefs::NLC, lcl_derivativeY, AlignmentDefs::NGL, glbl_derivativeY, glbl_label, residual(1), errinf * clus_sigma(1));
+        mille->mille(AlignmentDefs::NLC, lcl_derivativeY, AlignmentDefs::NGL, glbl_derivativeY, glbl_label, residual(1), errinf * clus_sigma(1));
       }
     }
 
@@ -898,7 +945,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
     //   skip the common vertex requirement for this track unless there are 3 tracks in the event
     if (accepted_tracks < 3)
     {
-      _mille->end();
+      mille->end();
       continue;
     }
     // calculate vertex residual with perigee surface
@@ -1017,7 +1064,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
           std::cerr << "glblvtx_derivativeX is NaN" << std::endl;
           continue;
         }
-        _mille->mille(AlignmentDefs::NLC, lclvtx_derivativeX, AlignmentDefs::NGLVTX, glblvtx_derivativeX, AlignmentDefs::glbl_vtx_label, vtx_residual(0), vtx_sigma(0));
+        mille->mille(AlignmentDefs::NLC, lclvtx_derivativeX, AlignmentDefs::NGLVTX, glblvtx_derivativeX, AlignmentDefs::glbl_vtx_label, vtx_residual(0), vtx_sigma(0));
       }
       if (!isnan(vtx_residual(1)))
       {
@@ -1031,7 +1078,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
           std::cerr << "glblvtx_derivativeY is NaN" << std::endl;
           continue;
         }
-        _mille->mille(AlignmentDefs::NLC, lclvtx_derivativeY, AlignmentDefs::NGLVTX, glblvtx_derivativeY, AlignmentDefs::glbl_vtx_label, vtx_residual(1), vtx_sigma(1));
+        mille->mille(AlignmentDefs::NLC, lclvtx_derivativeY, AlignmentDefs::NGLVTX, glblvtx_derivativeY, AlignmentDefs::glbl_vtx_label, vtx_residual(1), vtx_sigma(1));
       }
     }
 
@@ -1075,7 +1122,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
       std::cout << "track_x " << newTrack.get_x() << "track_y " << newTrack.get_y() << "track_z " << newTrack.get_z() << std::endl;
     }
     // close out this track
-    _mille->end();
+    mille->end();
 
   }  // end loop over tracks
 
@@ -1327,8 +1374,32 @@ std::pair<Acts::Vector3, Acts::Vector3> HelicalFitter::get_helix_tangent(const s
 
 int HelicalFitter::End(PHCompositeNode* /*unused*/)
 {
-  // closes output file in destructor
-  delete _mille;
+  long nrecords = 0;
+  long nbytes = 0;
+  unsigned long long checksum = 0;
+  for (unsigned int ishard = 0; ishard < _mille.size(); ++ishard)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "HelicalFitter::End - shard " << ishard << ": " << _mille[ishard]->numRecords()
+                << " records, " << _mille[ishard]->numBytes() << " bytes" << std::endl;
+    }
+    nrecords += _mille[ishard]->numRecords();
+    nbytes += _mille[ishard]->numBytes();
+    checksum += _mille[ishard]->recordChecksum();
+    // closes output file in destructor
+    delete _mille[ishard];
+  }
+  _mille.clear();
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "HelicalFitter::End - " << m_ntracklets << " tracklets fitted in " << m_fit_time
+              << " s with " << m_nthreads << " threads, " << m_naccepted << " accepted, "
+              << nrecords << " records, " << nbytes << " bytes in " << m_nshards << " files" << std::endl;
+    // the checksum does not depend on the number of threads or shards
+    std::cout << "HelicalFitter::End - record checksum " << std::hex << checksum << std::dec << std::endl;
+  }
 
   if (make_ntuple)
   {
@@ -16,8 +16,10 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
 
 class TpcClusterZCrossingCorrection;
 class PHCompositeNode;
@@ -68,6 +70,10 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
   void set_tpc_grouping(int group) { tpc_grp = (AlignmentDefs::tpcGrp) group; }
   void set_mms_grouping(int group) { mms_grp = (AlignmentDefs::mmsGrp) group; }
   void set_test_output(bool test) { test_output = test; }
+  //! number of threads used for the tracklet fits
+  void set_num_threads(int nthreads) { m_nthreads = std::max(1, nthreads); }
+  //! split the mille data into nshards files, accepted tracks are written round robin
+  void set_num_shards(int nshards) { m_nshards = std::max(1, nshards); }
   void set_intt_layer_fixed(unsigned int layer);
   void set_mvtx_layer_fixed(unsigned int layer, unsigned int clamshell);
   void set_tpc_sector_fixed(unsigned int region, unsigned int sector, unsigned int side);
@@ -113,7 +119,7 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
   void set_dca_cut(float dca) { dca_cut = dca; }
 
  private:
-  Mille* _mille;
+  std::vector<Mille*> _mille;
 
   int GetNodes(PHCompositeNode* topNode);
   int CreateNodes(PHCompositeNode* topNode);
@@ -228,6 +234,14 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
 
   int event{0};
 
+  int m_nthreads{1};
+  int m_nshards{1};
+
+  //! throughput counters
+  long m_ntracklets{0};
+  long m_naccepted{0};
+  double m_fit_time{0};  // seconds
+
   Acts::Vector3 vertexPosition;
   Acts::Vector3 vertexPosUncertainty;
   Acts::Vector2 vtx_sigma;
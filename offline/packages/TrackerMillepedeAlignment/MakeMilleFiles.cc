@@ -35,12 +35,16 @@
 #include <TNtuple.h>
 #include <TF1.h>
 
+#include <omp.h>
+
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace
 {
@@ -55,7 +59,6 @@ namespace
 //____________________________________________________________________________..
 MakeMilleFiles::MakeMilleFiles(const std::string& name)
   : SubsysReco(name)
-  , _mille(nullptr)
 {
 }
 
@@ -68,13 +71,20 @@ int MakeMilleFiles::InitRun(PHCompositeNode* topNode)
     return ret;
   }
 
-  // Instantiate Mille and open output data file
+  // Instantiate Mille and open output data file(s), one per thread
   //  _mille = new Mille(data_outfilename.c_str(), false);   // write text in data files, rather than binary, for debugging only
-  _mille = new Mille(data_outfilename.c_str(), _binary);
+  for (int ishard = 0; ishard < m_nthreads; ++ishard)
+  {
+    const std::string filename = AlignmentDefs::getShardFileName(data_outfilename, ishard, m_nthreads);
+    _mille.push_back(new Mille(filename.c_str(), _binary));
+  }
 
-  // Write the steering file here, and add the data file path to it
+  // Write the steering file here, and add the data file paths to it
   std::ofstream steering_file(steering_outfilename);
-  steering_file << data_outfilename << std::endl;
+  for (int ishard = 0; ishard < m_nthreads; ++ishard)
+  {
+    steering_file << AlignmentDefs::getShardFileName(data_outfilename, ishard, m_nthreads) << std::endl;
+  }
   steering_file << m_constraintFileName << std::endl;
   steering_file.close();
 
@@ -143,9 +153,10 @@ int MakeMilleFiles::process_event(PHCompositeNode* /*topNode*/)
     eventVertex = getEventVertex();
   }
 
-  ActsPropagator propagator(_tGeometry);
-
-  for (auto [key, statevec] : *_state_map)
+  // collect the tracks first, the state map cannot be indexed
+  std::vector<std::pair<SvtxTrack*, SvtxAlignmentStateMap::StateVec*>> tracks;
+  tracks.reserve(_state_map->size());
+  for (auto& [key, statevec] : *_state_map)
   {
     // Check if track was removed from cleaner
     auto iter = _track_map->find(key);
@@ -153,79 +164,33 @@ int MakeMilleFiles::process_event(PHCompositeNode* /*topNode*/)
     {
       continue;
     }
+    tracks.emplace_back(iter->second, &statevec);
+  }
 
-    SvtxTrack* track = iter->second;
+  const auto start = std::chrono::steady_clock::now();
+  const int nshards = _mille.size();
+  const int ntracks = tracks.size();
 
-    if (Verbosity() > 0)
-    {
-      std::cout << std::endl
-                << __LINE__ << ": Processing track itrack: " << key << ": nhits: " << track->size_cluster_keys()
-                << ": Total tracks: " << _track_map->size() << ": phi: " << track->get_phi() << std::endl;
-    }
-
-    //! Make any desired track cuts here
-    //! Maybe set a lower pT limit - low pT tracks are not very sensitive to alignment
-    addTrackToMilleFile(statevec);
+#pragma omp parallel num_threads(nshards)
+  {
+    // Acts propagation keeps its state in the propagator, one per thread
+    ActsPropagator propagator(_tGeometry);
 
-    //! Only take tracks that have 2 mm within event vertex
-    if (m_useEventVertex &&
-        std::abs(track->get_z() - eventVertex.z()) < 0.2 &&
-        std::abs(track->get_x()) < 0.2 &&
-        std::abs(track->get_y()) < 0.2)
+    // shards are dealt out to the threads we actually got, and tracks to shards
+    // round robin, so the contents of each file do not depend on thread timing
+    const int nthr = omp_get_num_threads();
+    for (int ishard = omp_get_thread_num(); ishard < nshards; ishard += nthr)
     {
-      //! set x and y to 0 since we are constraining to the x-y origin
-      //! and add constraints to pede later
-      eventVertex(0) = 0;
-      eventVertex(1) = 0;
-
-      auto dcapair = TrackAnalysisUtils::get_dca(track, eventVertex);
-      Acts::Vector2 vtx_residual(-dcapair.first.first, -dcapair.second.first);
-      vtx_residual *= Acts::UnitConstants::cm;
-
-      float lclvtx_derivative[SvtxAlignmentState::NRES][SvtxAlignmentState::NLOC];
-      bool success = getLocalVtxDerivativesXY(track, propagator,
-                                              eventVertex, lclvtx_derivative);
-
-      // The global derivs dimensions are [alpha/beta/gamma](x/y/z)
-      float glblvtx_derivative[SvtxAlignmentState::NRES][3];
-      getGlobalVtxDerivativesXY(track, eventVertex, glblvtx_derivative);
-
-      if (Verbosity() > 2)
+      for (int itrack = ishard; itrack < ntracks; itrack += nshards)
       {
-        std::cout << "vertex info for trakc " << track->get_id() << " with charge " << track->get_charge() << std::endl;
-        std::cout << "vertex is " << eventVertex.transpose() << std::endl;
-        std::cout << "vertex residuals " << vtx_residual.transpose()
-                  << std::endl;
-        std::cout << "global vtx derivatives " << std::endl;
-        for (auto& i : glblvtx_derivative)
-        {
-          for (float j : i)
-          {
-            std::cout << j << ", ";
-          }
-          std::cout << std::endl;
-        }
-      }
-      if (success)
-      {
-        for (int i = 0; i < 2; i++)
-        {
-          if (!std::isnan(vtx_residual(i)))
-          {
-            _mille->mille(SvtxAlignmentState::NLOC, lclvtx_derivative[i],
-                          AlignmentDefs::NGLVTX, glblvtx_derivative[i],
-                          AlignmentDefs::glbl_vtx_label, vtx_residual(i),
-                          m_vtxSigma(i));
-
-          }
-        }
+        processTrack(tracks[itrack].first, *tracks[itrack].second, propagator, eventVertex, _mille[ishard]);
       }
     }
-
-    //! Finish this track
-    _mille->end();
   }
 
+  m_ntracks += ntracks;
+  m_process_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
   if (Verbosity() > 0)
   {
     std::cout << "Finished processing mille file " << std::endl;
@@ -236,7 +201,35 @@ int MakeMilleFiles::process_event(PHCompositeNode* /*topNode*/)
 
 int MakeMilleFiles::End(PHCompositeNode* /*unused*/)
 {
-  delete _mille;
+  long nrecords = 0;
+  long nbytes = 0;
+  unsigned long long checksum = 0;
+  for (unsigned int ishard = 0; ishard < _mille.size(); ++ishard)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "MakeMilleFiles::End - shard " << ishard << ": " << _mille[ishard]->numRecords()
+                << " records, " << _mille[ishard]->numBytes() << " bytes" << std::endl;
+    }
+    nrecords += _mille[ishard]->numRecords();
+    nbytes += _mille[ishard]->numBytes();
+    checksum += _mille[ishard]->recordChecksum();
+    delete _mille[ishard];
+  }
+  _mille.clear();
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "MakeMilleFiles::End - " << m_ntracks << " tracks, " << nrecords << " records, "
+              << nbytes << " bytes in " << m_process_time << " s with " << m_nthreads << " threads";
+    if (m_process_time > 0)
+    {
+      std::cout << " (" << m_ntracks / m_process_time << " tracks/s)";
+    }
+    std::cout << std::endl;
+    // the checksum does not depend on the number of threads, compare it to validate a multi threaded production
+    std::cout << "MakeMilleFiles::End - record checksum " << std::hex << checksum << std::dec << std::endl;
+  }
   m_constraintFile.close();
 
   if (m_file && m_ntuple)
@@ -462,7 +455,80 @@ Acts::Vector3 MakeMilleFiles::getEventVertex()
                        zsum / nacceptedtracks);
 }
 
-void MakeMilleFiles::addTrackToMilleFile(SvtxAlignmentStateMap::StateVec& statevec)
+void MakeMilleFiles::processTrack(SvtxTrack* track, SvtxAlignmentStateMap::StateVec& statevec,
+                                  ActsPropagator& propagator, Acts::Vector3 eventVertex, Mille* mille)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << std::endl
+              << __LINE__ << ": Processing track itrack: " << track->get_id() << ": nhits: " << track->size_cluster_keys()
+              << ": Total tracks: " << _track_map->size() << ": phi: " << track->get_phi() << std::endl;
+  }
+
+  //! Make any desired track cuts here
+  //! Maybe set a lower pT limit - low pT tracks are not very sensitive to alignment
+  addTrackToMilleFile(statevec, mille);
+
+  //! Only take tracks that have 2 mm within event vertex
+  if (m_useEventVertex &&
+      std::abs(track->get_z() - eventVertex.z()) < 0.2 &&
+      std::abs(track->get_x()) < 0.2 &&
+      std::abs(track->get_y()) < 0.2)
+  {
+    //! set x and y to 0 since we are constraining to the x-y origin
+    //! and add constraints to pede later
+    eventVertex(0) = 0;
+    eventVertex(1) = 0;
+
+    auto dcapair = TrackAnalysisUtils::get_dca(track, eventVertex);
+    Acts::Vector2 vtx_residual(-dcapair.first.first, -dcapair.second.first);
+    vtx_residual *= Acts::UnitConstants::cm;
+
+    float lclvtx_derivative[SvtxAlignmentState::NRES][SvtxAlignmentState::NLOC];
+    bool success = getLocalVtxDerivativesXY(track, propagator,
+                                            eventVertex, lclvtx_derivative);
+
+    // The global derivs dimensions are [alpha/beta/gamma](x/y/z)
+    float glblvtx_derivative[SvtxAlignmentState::NRES][3];
+    getGlobalVtxDerivativesXY(track, eventVertex, glblvtx_derivative);
+
+    if (Verbosity() > 2)
+    {
+      std::cout << "vertex info for trakc " << track->get_id() << " with charge " << track->get_charge() << std::endl;
+      std::cout << "vertex is " << eventVertex.transpose() << std::endl;
+      std::cout << "vertex residuals " << vtx_residual.transpose()
+                << std::endl;
+      std::cout << "global vtx derivatives " << std::endl;
+      for (auto& i : glblvtx_derivative)
+      {
+        for (float j : i)
+        {
+          std::cout << j << ", ";
+        }
+        std::cout << std::endl;
+      }
+    }
+    if (success)
+    {
+      for (int i = 0; i < 2; i++)
+      {
+        if (!std::isnan(vtx_residual(i)))
+        {
+          mille->mille(SvtxAlignmentState::NLOC, lclvtx_derivative[i],
+                       AlignmentDefs::NGLVTX, glblvtx_derivative[i],
+                       AlignmentDefs::glbl_vtx_label, vtx_residual(i),
+                       m_vtxSigma(i));
+
+        }
+      }
+    }
+  }
+
+  //! Finish this track
+  mille->end();
+}
+
+void MakeMilleFiles::addTrackToMilleFile(SvtxAlignmentStateMap::StateVec& statevec, Mille* mille)
 {
   for (auto state : statevec)
   {
@@ -616,7 +682,7 @@ void MakeMilleFiles::addTrackToMilleFile(SvtxAlignmentStateMap::StateVec& statev
           errinf = m_layerMisalignment.find(layer)->second;
         }
 
-        _mille->mille(SvtxAlignmentState::NLOC, lcl_derivative[i], SvtxAlignmentState::NGL, glbl_derivative[i], glbl_label, residual(i), errinf * clus_sigma(i));
+        mille->mille(SvtxAlignmentState::NLOC, lcl_derivative[i], SvtxAlignmentState::NGL, glbl_derivative[i], glbl_label, residual(i), errinf * clus_sigma(i));
       }
     }
 
@@ -627,7 +693,11 @@ void MakeMilleFiles::addTrackToMilleFile(SvtxAlignmentStateMap::StateVec& statev
       glbl_derivative[1][0], glbl_derivative[1][1], glbl_derivative[1][2], glbl_derivative[1][3], glbl_derivative[1][4], glbl_derivative[1][5],
     };
 
-    if (m_ntuple) m_ntuple->Fill(ntp_data);
+    if (m_ntuple)
+    {
+#pragma omp critical(MakeMilleFiles_ntuple)
+      m_ntuple->Fill(ntp_data);
+    }
   }
 
   return;
@@ -23,6 +23,7 @@
 
 #include <ActsExamples/EventData/Trajectories.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -52,6 +53,12 @@ class MakeMilleFiles : public SubsysReco
 
   void set_binary(bool bin) { _binary = bin; }
 
+  //! process the tracks of an event with nthreads threads.  Every thread writes
+  //! its own mille data file (see AlignmentDefs::getShardFileName), all of them
+  //! are listed in the steering file.  Track i always goes to shard i % nthreads,
+  //! so the files are reproducible for a given number of threads
+  void set_num_threads(int nthreads) { m_nthreads = std::max(1, nthreads); }
+
   void set_track_map_name(const std::string& name) {m_track_map_name = name;}
   void set_state_map_name(const std::string& name) {m_state_map_name = name;}
   void set_constraintfile_name(const std::string& file) { m_constraintFileName = file; }
@@ -88,7 +95,7 @@ class MakeMilleFiles : public SubsysReco
   }
 
  private:
-  Mille* _mille;
+  std::vector<Mille*> _mille;
 
   int GetNodes(PHCompositeNode* topNode);
   Acts::Vector3 getEventVertex();
@@ -99,7 +106,9 @@ class MakeMilleFiles : public SubsysReco
 
   bool is_tpc_sector_fixed(unsigned int layer, unsigned int sector, unsigned int side);
   bool is_mvtx_layer_fixed(unsigned int layer, unsigned int clamshell);
-  void addTrackToMilleFile(SvtxAlignmentStateMap::StateVec& statevec);
+  void processTrack(SvtxTrack* track, SvtxAlignmentStateMap::StateVec& statevec,
+                    ActsPropagator& propagator, Acts::Vector3 eventVertex, Mille* mille);
+  void addTrackToMilleFile(SvtxAlignmentStateMap::StateVec& statevec, Mille* mille);
   void getGlobalVtxDerivativesXY(SvtxTrack* track,
                                  const Acts::Vector3& vertex,
                                  float glblvtx_derivative[SvtxAlignmentState::NRES][3]);
@@ -118,6 +127,11 @@ class MakeMilleFiles : public SubsysReco
 
   bool m_useEventVertex = false;
   bool _binary = true;
+  int m_nthreads = 1;
+
+  //! throughput counters
+  long m_ntracks = 0;
+  double m_process_time = 0;  // seconds
 
   Acts::Vector2 m_vtxSigma = {0.1, 0.1};
 
@@ -31,6 +31,7 @@
 
 #include "Mille.h"
 
+#include <cstddef>
 #include <fstream>
 #include <iostream>
 
@@ -229,6 +230,22 @@ void Mille::end()
       }
       myOutFile << "\n";
     }
+
+    // bookkeeping: FNV-1a hash of the record contents, summed over records
+    unsigned long long hash = 14695981039346656037ULL;
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(myBufferFloat);
+    for (std::size_t i = 0; i < (myBufferPos + 1) * sizeof(myBufferFloat[0]); ++i)
+    {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    bytes = reinterpret_cast<const unsigned char *>(myBufferInt);
+    for (std::size_t i = 0; i < (myBufferPos + 1) * sizeof(myBufferInt[0]); ++i)
+    {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    myRecordChecksum += hash;
+    ++myNumRecords;
+    myNumBytes += sizeof(numWordsToWrite) + numWordsToWrite * sizeof(myBufferInt[0]);
   }
   myBufferPos = -1;  // reset buffer for next set of derivatives
 
@@ -60,6 +60,14 @@ class Mille
   void kill();
   void end();
 
+  /// number of records (tracks) written so far
+  long numRecords() const { return myNumRecords; }
+  /// number of bytes written so far
+  long numBytes() const { return myNumBytes; }
+  /// order independent checksum of the records written so far,
+  /// the sum over several files does not depend on how records were split between them
+  unsigned long long recordChecksum() const { return myRecordChecksum; }
+
  private:
   void newSet();
   bool checkBufferSize(int nLocal, int nGlobal);
@@ -76,6 +84,9 @@ class Mille
   float myBufferFloat[myBufferSize]{};  ///< to collect derivatives etc.
   int myBufferPos;                      ///< position in buffer
   bool myHasSpecial;                    ///< if true, special(..) already called for this record
+  long myNumRecords{0};                 ///< records written
+  long myNumBytes{0};                   ///< bytes written
+  unsigned long long myRecordChecksum{0};  ///< sum of the FNV-1a hashes of the records
   /// largest label allowed
   enum
   {
@@ -60,18 +60,30 @@ int InttBadChannelMap::v_LoadFromCDBTTree(CDBTTree& cdbttree)
     return 0;
   }
 
+  // Resolve each field once; the loop below then reads columns instead of looking up every field by name
+  CDBTTree::ColumnView<int> layer = cdbttree.GetIntColumnView("layer");
+  CDBTTree::ColumnView<int> ladder_phi = cdbttree.GetIntColumnView("ladder_phi");
+  CDBTTree::ColumnView<int> ladder_z = cdbttree.GetIntColumnView("ladder_z");
+  CDBTTree::ColumnView<int> strip_z = cdbttree.GetIntColumnView("strip_z");
+  CDBTTree::ColumnView<int> strip_phi = cdbttree.GetIntColumnView("strip_phi");
+
+  CDBTTree::ColumnView<int> felix_server = cdbttree.GetIntColumnView("felix_server");
+  CDBTTree::ColumnView<int> felix_channel = cdbttree.GetIntColumnView("felix_channel");
+  CDBTTree::ColumnView<int> chip = cdbttree.GetIntColumnView("chip");
+  CDBTTree::ColumnView<int> channel = cdbttree.GetIntColumnView("channel");
+
   // Check if the CDBTTree has branches corresponding to the offline convention
-  m_offline_loaded = m_offline_loaded && (cdbttree.GetIntValue(0, "layer") != std::numeric_limits<int>::min());
-  m_offline_loaded = m_offline_loaded && (cdbttree.GetIntValue(0, "ladder_phi") != std::numeric_limits<int>::min());
-  m_offline_loaded = m_offline_loaded && (cdbttree.GetIntValue(0, "ladder_z") != std::numeric_limits<int>::min());
-  m_offline_loaded = m_offline_loaded && (cdbttree.GetIntValue(0, "strip_z") != std::numeric_limits<int>::min());
-  m_offline_loaded = m_offline_loaded && (cdbttree.GetIntValue(0, "strip_phi") != std::numeric_limits<int>::min());
+  m_offline_loaded = m_offline_loaded && (layer(0) != std::numeric_limits<int>::min());
+  m_offline_loaded = m_offline_loaded && (ladder_phi(0) != std::numeric_limits<int>::min());
+  m_offline_loaded = m_offline_loaded && (ladder_z(0) != std::numeric_limits<int>::min());
+  m_offline_loaded = m_offline_loaded && (strip_z(0) != std::numeric_limits<int>::min());
+  m_offline_loaded = m_offline_loaded && (strip_phi(0) != std::numeric_limits<int>::min());
 
   // Check if the CDBTTree has branches corresponding to the rawdata convention
-  m_rawdata_loaded = m_rawdata_loaded && (cdbttree.GetIntValue(0, "felix_server") != std::numeric_limits<int>::min());
-  m_rawdata_loaded = m_rawdata_loaded && (cdbttree.GetIntValue(0, "felix_channel") != std::numeric_limits<int>::min());
-  m_rawdata_loaded = m_rawdata_loaded && (cdbttree.GetIntValue(0, "chip") != std::numeric_limits<int>::min());
-  m_rawdata_loaded = m_rawdata_loaded && (cdbttree.GetIntValue(0, "channel") != std::numeric_limits<int>::min());
+  m_rawdata_loaded = m_rawdata_loaded && (felix_server(0) != std::numeric_limits<int>::min());
+  m_rawdata_loaded = m_rawdata_loaded && (felix_channel(0) != std::numeric_limits<int>::min());
+  m_rawdata_loaded = m_rawdata_loaded && (chip(0) != std::numeric_limits<int>::min());
+  m_rawdata_loaded = m_rawdata_loaded && (channel(0) != std::numeric_limits<int>::min());
 
   if (!m_offline_loaded && !m_rawdata_loaded)
   {
@@ -90,21 +102,21 @@ int InttBadChannelMap::v_LoadFromCDBTTree(CDBTTree& cdbttree)
     if (m_offline_loaded)
     {
       m_offline_set.insert((struct InttNameSpace::Offline_s){
-        .layer = cdbttree.GetIntValue(n, "layer"),
-        .ladder_phi = cdbttree.GetIntValue(n, "ladder_phi"),
-        .ladder_z = cdbttree.GetIntValue(n, "ladder_z"),
-        .strip_x = cdbttree.GetIntValue(n, "strip_phi"),
-        .strip_y = cdbttree.GetIntValue(n, "strip_z"),
+        .layer = layer(n),
+        .ladder_phi = ladder_phi(n),
+        .ladder_z = ladder_z(n),
+        .strip_x = strip_phi(n),
+        .strip_y = strip_z(n),
       });
     }
 
     if (m_rawdata_loaded)
     {
       m_rawdata_set.insert((struct InttNameSpace::RawData_s){
-        .felix_server = cdbttree.GetIntValue(n, "felix_server"),
-        .felix_channel = cdbttree.GetIntValue(n, "felix_channel"),
-        .chip = cdbttree.GetIntValue(n, "chip"),
-        .channel = cdbttree.GetIntValue(n, "channel"),
+        .felix_server = felix_server(n),
+        .felix_channel = felix_channel(n),
+        .chip = chip(n),
+        .channel = channel(n),
       });
     }
   }
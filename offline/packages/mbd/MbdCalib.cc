@@ -267,16 +267,23 @@ int MbdCalib::Download_Gains(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<float> qfit_integ_col = cdbttree->GetFloatColumnView("qfit_integ");
+    CDBTTree::ColumnView<float> qfit_mpv_col = cdbttree->GetFloatColumnView("qfit_mpv");
+    CDBTTree::ColumnView<float> qfit_sigma_col = cdbttree->GetFloatColumnView("qfit_sigma");
+    CDBTTree::ColumnView<float> qfit_integerr_col = cdbttree->GetFloatColumnView("qfit_integerr");
+    CDBTTree::ColumnView<float> qfit_mpverr_col = cdbttree->GetFloatColumnView("qfit_mpverr");
+    CDBTTree::ColumnView<float> qfit_sigmaerr_col = cdbttree->GetFloatColumnView("qfit_sigmaerr");
+    CDBTTree::ColumnView<float> qfit_chi2ndf_col = cdbttree->GetFloatColumnView("qfit_chi2ndf");
 
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _qfit_integ[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_integ");
-      _qfit_mpv[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_mpv");
-      _qfit_sigma[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_sigma");
-      _qfit_integerr[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_integerr");
-      _qfit_mpverr[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_mpverr");
-      _qfit_sigmaerr[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_sigmaerr");
-      _qfit_chi2ndf[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_chi2ndf");
+      _qfit_integ[ipmt] = qfit_integ_col(ipmt);
+      _qfit_mpv[ipmt] = qfit_mpv_col(ipmt);
+      _qfit_sigma[ipmt] = qfit_sigma_col(ipmt);
+      _qfit_integerr[ipmt] = qfit_integerr_col(ipmt);
+      _qfit_mpverr[ipmt] = qfit_mpverr_col(ipmt);
+      _qfit_sigmaerr[ipmt] = qfit_sigmaerr_col(ipmt);
+      _qfit_chi2ndf[ipmt] = qfit_chi2ndf_col(ipmt);
       if (Verbosity() > 0)
       {
         if (ipmt < 5)
@@ -344,13 +351,17 @@ int MbdCalib::Download_TQT0(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<float> tqfit_t0mean_col = cdbttree->GetFloatColumnView("tqfit_t0mean");
+    CDBTTree::ColumnView<float> tqfit_t0meanerr_col = cdbttree->GetFloatColumnView("tqfit_t0meanerr");
+    CDBTTree::ColumnView<float> tqfit_t0sigma_col = cdbttree->GetFloatColumnView("tqfit_t0sigma");
+    CDBTTree::ColumnView<float> tqfit_t0sigmaerr_col = cdbttree->GetFloatColumnView("tqfit_t0sigmaerr");
 
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _tqfit_t0mean[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0mean");
-      _tqfit_t0meanerr[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0meanerr");
-      _tqfit_t0sigma[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0sigma");
-      _tqfit_t0sigmaerr[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0sigmaerr");
+      _tqfit_t0mean[ipmt] = tqfit_t0mean_col(ipmt);
+      _tqfit_t0meanerr[ipmt] = tqfit_t0meanerr_col(ipmt);
+      _tqfit_t0sigma[ipmt] = tqfit_t0sigma_col(ipmt);
+      _tqfit_t0sigmaerr[ipmt] = tqfit_t0sigmaerr_col(ipmt);
       if (Verbosity() > 0)
       {
         if (ipmt < 5 || ipmt >= MbdDefs::MBD_N_PMT - 5)
@@ -419,13 +430,17 @@ int MbdCalib::Download_TTT0(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<float> ttfit_t0mean_col = cdbttree->GetFloatColumnView("ttfit_t0mean");
+    CDBTTree::ColumnView<float> ttfit_t0meanerr_col = cdbttree->GetFloatColumnView("ttfit_t0meanerr");
+    CDBTTree::ColumnView<float> ttfit_t0sigma_col = cdbttree->GetFloatColumnView("ttfit_t0sigma");
+    CDBTTree::ColumnView<float> ttfit_t0sigmaerr_col = cdbttree->GetFloatColumnView("ttfit_t0sigmaerr");
 
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _ttfit_t0mean[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0mean");
-      _ttfit_t0meanerr[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0meanerr");
-      _ttfit_t0sigma[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0sigma");
-      _ttfit_t0sigmaerr[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0sigmaerr");
+      _ttfit_t0mean[ipmt] = ttfit_t0mean_col(ipmt);
+      _ttfit_t0meanerr[ipmt] = ttfit_t0meanerr_col(ipmt);
+      _ttfit_t0sigma[ipmt] = ttfit_t0sigma_col(ipmt);
+      _ttfit_t0sigmaerr[ipmt] = ttfit_t0sigmaerr_col(ipmt);
 
       if (Verbosity() > 0)
       {
@@ -593,13 +608,17 @@ int MbdCalib::Download_Ped(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<float> pedmean_col = cdbttree->GetFloatColumnView("pedmean");
+    CDBTTree::ColumnView<float> pedmeanerr_col = cdbttree->GetFloatColumnView("pedmeanerr");
+    CDBTTree::ColumnView<float> pedsigma_col = cdbttree->GetFloatColumnView("pedsigma");
+    CDBTTree::ColumnView<float> pedsigmaerr_col = cdbttree->GetFloatColumnView("pedsigmaerr");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
-      _pedmean[ifeech] = cdbttree->GetFloatValue(ifeech, "pedmean");
-      _pedmeanerr[ifeech] = cdbttree->GetFloatValue(ifeech, "pedmeanerr");
-      _pedsigma[ifeech] = cdbttree->GetFloatValue(ifeech, "pedsigma");
-      _pedsigmaerr[ifeech] = cdbttree->GetFloatValue(ifeech, "pedsigmaerr");
+      _pedmean[ifeech] = pedmean_col(ifeech);
+      _pedmeanerr[ifeech] = pedmeanerr_col(ifeech);
+      _pedsigma[ifeech] = pedsigma_col(ifeech);
+      _pedsigmaerr[ifeech] = pedsigmaerr_col(ifeech);
 
       if (Verbosity() > 0)
       {
@@ -660,10 +679,11 @@ int MbdCalib::Download_SampMax(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<int> sampmax_col = cdbttree->GetIntColumnView("sampmax");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
-      _sampmax[ifeech] = cdbttree->GetIntValue(ifeech, "sampmax");
+      _sampmax[ifeech] = sampmax_col(ifeech);
       if (Verbosity() > 0)
       {
         if (ifeech < 5 || ifeech >= MbdDefs::MBD_N_FEECH - 5)
@@ -722,10 +742,11 @@ int MbdCalib::Download_Status(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<int> status_col = cdbttree->GetIntColumnView("status");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
-      _mbdstatus[ifeech] = cdbttree->GetIntValue(ifeech, "status");
+      _mbdstatus[ifeech] = status_col(ifeech);
       if (Verbosity() > 0)
       {
         if (ifeech < 5 || ifeech >= MbdDefs::MBD_N_FEECH - 5)
@@ -808,6 +829,14 @@ int MbdCalib::Download_Shapes(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<int> shape_npts_col = cdbttree->GetIntColumnView("shape_npts");
+    CDBTTree::ColumnView<float> shape_min_col = cdbttree->GetFloatColumnView("shape_min");
+    CDBTTree::ColumnView<float> shape_max_col = cdbttree->GetFloatColumnView("shape_max");
+    CDBTTree::ColumnView<int> sherr_npts_col = cdbttree->GetIntColumnView("sherr_npts");
+    CDBTTree::ColumnView<float> sherr_min_col = cdbttree->GetFloatColumnView("sherr_min");
+    CDBTTree::ColumnView<float> sherr_max_col = cdbttree->GetFloatColumnView("sherr_max");
+    CDBTTree::ColumnView<float> shape_val_col = cdbttree->GetFloatColumnView("shape_val");
+    CDBTTree::ColumnView<float> sherr_val_col = cdbttree->GetFloatColumnView("sherr_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -816,22 +845,22 @@ int MbdCalib::Download_Shapes(const std::string& dbase_location)
         continue;  // skip t-channels
       }
 
-      _shape_npts[ifeech] = cdbttree->GetIntValue(ifeech, "shape_npts");
-      _shape_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "shape_min");
-      _shape_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "shape_max");
+      _shape_npts[ifeech] = shape_npts_col(ifeech);
+      _shape_minrange[ifeech] = shape_min_col(ifeech);
+      _shape_maxrange[ifeech] = shape_max_col(ifeech);
 
-      _sherr_npts[ifeech] = cdbttree->GetIntValue(ifeech, "sherr_npts");
-      _sherr_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "sherr_min");
-      _sherr_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "sherr_max");
+      _sherr_npts[ifeech] = sherr_npts_col(ifeech);
+      _sherr_minrange[ifeech] = sherr_min_col(ifeech);
+      _sherr_maxrange[ifeech] = sherr_max_col(ifeech);
 
       for (int ipt = 0; ipt < _shape_npts[ifeech]; ipt++)
       {
         int chtemp = (1000 * ipt) + ifeech;
 
-        float val = cdbttree->GetFloatValue(chtemp, "shape_val");
+        float val = shape_val_col(chtemp);
         _shape_y[ifeech].push_back(val);
 
-        val = cdbttree->GetFloatValue(chtemp, "sherr_val");
+        val = sherr_val_col(chtemp);
         _sherr_yerr[ifeech].push_back(val);
       }
 
@@ -997,6 +1026,10 @@ int MbdCalib::Download_TimeCorr(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<int> tcorr_npts_col = cdbttree->GetIntColumnView("tcorr_npts");
+    CDBTTree::ColumnView<float> tcorr_min_col = cdbttree->GetFloatColumnView("tcorr_min");
+    CDBTTree::ColumnView<float> tcorr_max_col = cdbttree->GetFloatColumnView("tcorr_max");
+    CDBTTree::ColumnView<float> tcorr_val_col = cdbttree->GetFloatColumnView("tcorr_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -1005,15 +1038,15 @@ int MbdCalib::Download_TimeCorr(const std::string& dbase_location)
         continue;  // skip q-channels
       }
 
-      _tcorr_npts[ifeech] = cdbttree->GetIntValue(ifeech, "tcorr_npts");
-      _tcorr_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "tcorr_min");
-      _tcorr_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "tcorr_max");
+      _tcorr_npts[ifeech] = tcorr_npts_col(ifeech);
+      _tcorr_minrange[ifeech] = tcorr_min_col(ifeech);
+      _tcorr_maxrange[ifeech] = tcorr_max_col(ifeech);
 
       for (int ipt=0; ipt<_tcorr_npts[ifeech]; ipt++)
       {
         int chtemp = (1000*ipt) + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "tcorr_val");
+        float val = tcorr_val_col(chtemp);
         _tcorr_y[ifeech].push_back( val );
       }
 
@@ -1156,6 +1189,10 @@ int MbdCalib::Download_SlewCorr(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<int> scorr_npts_col = cdbttree->GetIntColumnView("scorr_npts");
+    CDBTTree::ColumnView<float> scorr_min_col = cdbttree->GetFloatColumnView("scorr_min");
+    CDBTTree::ColumnView<float> scorr_max_col = cdbttree->GetFloatColumnView("scorr_max");
+    CDBTTree::ColumnView<float> scorr_val_col = cdbttree->GetFloatColumnView("scorr_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -1164,15 +1201,15 @@ int MbdCalib::Download_SlewCorr(const std::string& dbase_location)
         continue;  // skip q-channels
       }
 
-      _scorr_npts[ifeech] = cdbttree->GetIntValue(ifeech, "scorr_npts");
-      _scorr_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "scorr_min");
-      _scorr_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "scorr_max");
+      _scorr_npts[ifeech] = scorr_npts_col(ifeech);
+      _scorr_minrange[ifeech] = scorr_min_col(ifeech);
+      _scorr_maxrange[ifeech] = scorr_max_col(ifeech);
 
       for (int ipt=0; ipt<_scorr_npts[ifeech]; ipt++)
       {
         int chtemp = (1000*ipt) + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "scorr_val");
+        float val = scorr_val_col(chtemp);
         _scorr_y[ifeech].push_back( val );
       }
 
@@ -1328,6 +1365,10 @@ int MbdCalib::Download_TimeRMS(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<int> trms_npts_col = cdbttree->GetIntColumnView("trms_npts");
+    CDBTTree::ColumnView<float> trms_min_col = cdbttree->GetFloatColumnView("trms_min");
+    CDBTTree::ColumnView<float> trms_max_col = cdbttree->GetFloatColumnView("trms_max");
+    CDBTTree::ColumnView<float> trms_val_col = cdbttree->GetFloatColumnView("trms_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -1336,15 +1377,15 @@ int MbdCalib::Download_TimeRMS(const std::string& dbase_location)
         continue;  // skip q-channels
       }
 
-      _trms_npts[ifeech] = cdbttree->GetIntValue(ifeech, "trms_npts");
-      _trms_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "trms_min");
-      _trms_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "trms_max");
+      _trms_npts[ifeech] = trms_npts_col(ifeech);
+      _trms_minrange[ifeech] = trms_min_col(ifeech);
+      _trms_maxrange[ifeech] = trms_max_col(ifeech);
 
       for (int ipt=0; ipt<_trms_npts[ifeech]; ipt++)
       {
         int chtemp = (1000*ipt) + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "trms_val");
+        float val = trms_val_col(chtemp);
         _trms_y[ifeech].push_back( val );
       }
 
@@ -1500,16 +1541,23 @@ int MbdCalib::Download_Pileup(const std::string& dbase_location)
       return _status;
     }
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<float> pileup_p0_col = cdbttree->GetFloatColumnView("pileup_p0");
+    CDBTTree::ColumnView<float> pileup_p0err_col = cdbttree->GetFloatColumnView("pileup_p0err");
+    CDBTTree::ColumnView<float> pileup_p1_col = cdbttree->GetFloatColumnView("pileup_p1");
+    CDBTTree::ColumnView<float> pileup_p1err_col = cdbttree->GetFloatColumnView("pileup_p1err");
+    CDBTTree::ColumnView<float> pileup_p2_col = cdbttree->GetFloatColumnView("pileup_p2");
+    CDBTTree::ColumnView<float> pileup_p2err_col = cdbttree->GetFloatColumnView("pileup_p2err");
+    CDBTTree::ColumnView<float> pileup_chi2ndf_col = cdbttree->GetFloatColumnView("pileup_chi2ndf");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
-      _pileup_p0[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_p0");
-      _pileup_p0err[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_p0err");
-      _pileup_p1[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_p1");
-      _pileup_p1err[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_p1err");
-      _pileup_p2[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_p2");
-      _pileup_p2err[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_p2err");
-      _pileup_chi2ndf[ifeech] = cdbttree->GetFloatValue(ifeech, "pileup_chi2ndf");
+      _pileup_p0[ifeech] = pileup_p0_col(ifeech);
+      _pileup_p0err[ifeech] = pileup_p0err_col(ifeech);
+      _pileup_p1[ifeech] = pileup_p1_col(ifeech);
+      _pileup_p1err[ifeech] = pileup_p1err_col(ifeech);
+      _pileup_p2[ifeech] = pileup_p2_col(ifeech);
+      _pileup_p2err[ifeech] = pileup_p2err_col(ifeech);
+      _pileup_chi2ndf[ifeech] = pileup_chi2ndf_col(ifeech);
       if (Verbosity() > 0)
       {
         if (ifeech < 2 || ifeech >= (MbdDefs::MBD_N_FEECH-2) )
@@ -1579,16 +1627,23 @@ int MbdCalib::Download_Thresholds(const std::string& dbase_location)
   {
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    CDBTTree::ColumnView<float> thresh_mean_col = cdbttree->GetFloatColumnView("thresh_mean");
+    CDBTTree::ColumnView<float> thresh_meanerr_col = cdbttree->GetFloatColumnView("thresh_meanerr");
+    CDBTTree::ColumnView<float> thresh_width_col = cdbttree->GetFloatColumnView("thresh_width");
+    CDBTTree::ColumnView<float> thresh_widtherr_col = cdbttree->GetFloatColumnView("thresh_widtherr");
+    CDBTTree::ColumnView<float> thresh_eff_col = cdbttree->GetFloatColumnView("thresh_eff");
+    CDBTTree::ColumnView<float> thresh_efferr_col = cdbttree->GetFloatColumnView("thresh_efferr");
+    CDBTTree::ColumnView<float> thresh_chi2ndf_col = cdbttree->GetFloatColumnView("thresh_chi2ndf");
 
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _thresh_mean[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_mean");
-      _thresh_meanerr[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_meanerr");
-      _thresh_width[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_width");
-      _thresh_widtherr[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_widtherr");
-      _thresh_eff[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_eff");
-      _thresh_efferr[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_efferr");
-      _thresh_chi2ndf[ipmt] = cdbttree->GetFloatValue(ipmt, "thresh_chi2ndf");
+      _thresh_mean[ipmt] = thresh_mean_col(ipmt);
+      _thresh_meanerr[ipmt] = thresh_meanerr_col(ipmt);
+      _thresh_width[ipmt] = thresh_width_col(ipmt);
+      _thresh_widtherr[ipmt] = thresh_widtherr_col(ipmt);
+      _thresh_eff[ipmt] = thresh_eff_col(ipmt);
+      _thresh_efferr[ipmt] = thresh_efferr_col(ipmt);
+      _thresh_chi2ndf[ipmt] = thresh_chi2ndf_col(ipmt);
       if (Verbosity() > 0)
       {
         if (ipmt < 5)
@@ -0,0 +1,104 @@
+#ifndef PARTICLEFLOWCALOGRID_H
+#define PARTICLEFLOWCALOGRID_H
+
+//===========================================================
+/// \file ParticleFlowCaloGrid.h
+/// \brief eta-phi lookup grid of calorimeter clusters
+///
+/// Every cluster is entered into all cells which one of its
+/// towers reaches within the match window, so the candidates
+/// for a track projection are the entries of the single cell it
+/// falls into.  A cell lists each cluster once and in the order
+/// in which the clusters were filled.  The grid only preselects,
+/// the caller still applies the exact match criteria.
+//===========================================================
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class ParticleFlowCaloGrid
+{
+ public:
+  ParticleFlowCaloGrid(const float cellsize, const float etamax)
+    : m_cellsize(cellsize)
+    , m_etamax(etamax)
+    , m_neta(std::max(1, static_cast<int>(std::ceil(2 * etamax / cellsize))))
+    , m_nphi(std::max(1, static_cast<int>(std::ceil(2 * M_PI / cellsize))))
+    , m_cells(m_neta * m_nphi)
+    , m_last(m_neta * m_nphi, -1)
+  {
+  }
+
+  //! empties the cells but keeps their memory
+  void clear()
+  {
+    for (auto &cell : m_cells)
+    {
+      cell.clear();
+    }
+    std::fill(m_last.begin(), m_last.end(), -1);
+  }
+
+  //! enters cluster index (indices must be filled in increasing order)
+  void fill(const int index, const std::vector<float> &tower_eta, const std::vector<float> &tower_phi, const float window)
+  {
+    for (unsigned int tow = 0; tow < tower_eta.size(); tow++)
+    {
+      // one cell of margin on every side against rounding at the cell edges
+      const int etalo = eta_bin(tower_eta[tow] - window) - 1;
+      const int etahi = eta_bin(tower_eta[tow] + window) + 1;
+      const int philo = static_cast<int>(std::floor(wrap(tower_phi[tow] - window) / m_cellsize)) - 1;
+      int nphibins = static_cast<int>(std::ceil(2 * window / m_cellsize)) + 3;
+      nphibins = std::min(nphibins, m_nphi);
+      for (int ieta = std::max(etalo, 0); ieta <= std::min(etahi, m_neta - 1); ieta++)
+      {
+        for (int i = 0; i < nphibins; i++)
+        {
+          const int iphi = ((philo + i) % m_nphi + m_nphi) % m_nphi;
+          const int cell = ieta * m_nphi + iphi;
+          if (m_last[cell] != index)
+          {
+            m_last[cell] = index;
+            m_cells[cell].push_back(index);
+          }
+        }
+      }
+    }
+  }
+
+  //! clusters which may have a tower within the window around (eta, phi)
+  const std::vector<int> &candidates(const float eta, const float phi) const
+  {
+    const int iphi = std::min(static_cast<int>(wrap(phi) / m_cellsize), m_nphi - 1);
+    return m_cells[eta_bin(eta) * m_nphi + iphi];
+  }
+
+ private:
+  //! eta bin, under- and overflow go into the first and last bin
+  int eta_bin(const float eta) const
+  {
+    const int bin = static_cast<int>(std::floor((eta + m_etamax) / m_cellsize));
+    return std::clamp(bin, 0, m_neta - 1);
+  }
+
+  //! phi in [0, 2pi)
+  static float wrap(float phi)
+  {
+    phi = std::fmod(phi, static_cast<float>(2 * M_PI));
+    if (phi < 0)
+    {
+      phi += 2 * M_PI;
+    }
+    return phi;
+  }
+
+  float m_cellsize;
+  float m_etamax;
+  int m_neta;
+  int m_nphi;
+  std::vector<std::vector<int> > m_cells;
+  std::vector<int> m_last;
+};
+
+#endif  // PARTICLEFLOWCALOGRID_H
@@ -27,8 +27,10 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_uniform_pos
 
+#include <chrono>
 #include <cmath>
 #include <iostream>
+#include <numeric>
 
 // examine second value of std::pair, sort by smallest
 bool sort_by_pair_second_lowest(const std::pair<int, float> &a, const std::pair<int, float> &b)
@@ -73,6 +75,191 @@ int ParticleFlowReco::InitRun(PHCompositeNode *topNode)
   return CreateNode(topNode);
 }
 
+//____________________________________________________________________________..
+// TRK -> EM and TRK -> HAD links of one track, only writes the entries of this track
+void ParticleFlowReco::link_track(unsigned int trk)
+{
+  if (Verbosity() > 10)
+  {
+    std::cout << " TRK " << trk << " with p / eta / phi = " << _pflow_TRK_p[trk] << " / " << _pflow_TRK_eta[trk] << " / " << _pflow_TRK_phi[trk] << std::endl;
+  }
+
+  // TRK -> EM link
+  float min_em_dR = 0.2;
+  int min_em_index = -1;
+
+  const std::vector<int> &em_candidates = _use_grid ? _grid_EM.candidates(_pflow_TRK_EMproj_eta[trk], _pflow_TRK_EMproj_phi[trk]) : _all_EM;
+  for (const int em : em_candidates)
+  {
+    float dR = calculate_dR(_pflow_TRK_EMproj_eta[trk], _pflow_EM_eta[em], _pflow_TRK_EMproj_phi[trk], _pflow_EM_phi[em]);
+
+    if (dR > 0.2)
+    {
+      continue;
+    }
+
+    bool has_overlap = false;
+
+    for (unsigned int tow = 0; tow < _pflow_EM_tower_eta.at(em).size(); tow++)
+    {
+      float tower_eta = _pflow_EM_tower_eta.at(em).at(tow);
+      float tower_phi = _pflow_EM_tower_phi.at(em).at(tow);
+
+      float deta = tower_eta - _pflow_TRK_EMproj_eta[trk];
+      float dphi = tower_phi - _pflow_TRK_EMproj_phi[trk];
+      if (dphi > M_PI)
+      {
+        dphi -= 2 * M_PI;
+      }
+      if (dphi < -M_PI)
+      {
+        dphi += 2 * M_PI;
+      }
+
+      if (std::fabs(deta) < 0.025 * 2.5 && std::fabs(dphi) < 0.025 * 2.5)
+      {
+        has_overlap = true;
+        break;
+      }
+    }
+
+    if (has_overlap)
+    {
+      if (Verbosity() > 5)
+      {
+        std::cout << " -> possible match to EM " << em << " with dR = " << dR << std::endl;
+      }
+
+      _pflow_TRK_addtl_match_EM.at(trk).emplace_back(em, dR);
+    }
+    else
+    {
+      if (Verbosity() > 5)
+      {
+        std::cout << " -> no match to EM " << em << " (even though dR = " << dR << " )" << std::endl;
+      }
+    }
+  }
+
+  // sort possible matches
+
+  std::stable_sort(_pflow_TRK_addtl_match_EM.at(trk).begin(), _pflow_TRK_addtl_match_EM.at(trk).end(), sort_by_pair_second_lowest);
+  if (Verbosity() > 10)
+  {
+    for (auto &n : _pflow_TRK_addtl_match_EM.at(trk))
+    {
+      std::cout << " -> sorted list of matches, EM / dR = " << n.first << " / " << n.second << std::endl;
+    }
+  }
+
+  if (!_pflow_TRK_addtl_match_EM.at(trk).empty())
+  {
+    min_em_index = _pflow_TRK_addtl_match_EM.at(trk).at(0).first;
+    min_em_dR = _pflow_TRK_addtl_match_EM.at(trk).at(0).second;
+    // delete best matched element
+    _pflow_TRK_addtl_match_EM.at(trk).erase(_pflow_TRK_addtl_match_EM.at(trk).begin());
+  }
+
+  if (min_em_index > -1)
+  {
+    _pflow_TRK_match_EM.at(trk).push_back(min_em_index);
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " -> matched EM " << min_em_index << " with pt / eta / phi = " << _pflow_EM_E.at(min_em_index) << " / " << _pflow_EM_eta.at(min_em_index) << " / " << _pflow_EM_phi.at(min_em_index) << ", dR = " << min_em_dR;
+      std::cout << " ( " << _pflow_TRK_addtl_match_EM.at(trk).size() << " other possible matches ) " << std::endl;
+    }
+  }
+  else
+  {
+    if (Verbosity() > 5)
+    {
+      std::cout << " -> no EM match! ( best dR = " << min_em_dR << " ) " << std::endl;
+    }
+  }
+
+  // TRK -> HAD link
+  float min_had_dR = 0.2;
+  int min_had_index = -1;
+  float max_had_pt = 0;
+
+  // TODO: sequential linking should better happen here -- i.e. allow EM-matched HAD's into the possible pool
+  const std::vector<int> &had_candidates = _use_grid ? _grid_HAD.candidates(_pflow_TRK_HADproj_eta[trk], _pflow_TRK_HADproj_phi[trk]) : _all_HAD;
+  for (const int had : had_candidates)
+  {
+    float dR = calculate_dR(_pflow_TRK_HADproj_eta[trk], _pflow_HAD_eta[had], _pflow_TRK_HADproj_phi[trk], _pflow_HAD_phi[had]);
+
+    if (dR > 0.5)
+    {
+      continue;
+    }
+
+    bool has_overlap = false;
+
+    for (unsigned int tow = 0; tow < _pflow_HAD_tower_eta.at(had).size(); tow++)
+    {
+      float tower_eta = _pflow_HAD_tower_eta.at(had).at(tow);
+      float tower_phi = _pflow_HAD_tower_phi.at(had).at(tow);
+
+      float deta = tower_eta - _pflow_TRK_HADproj_eta[trk];
+      float dphi = tower_phi - _pflow_TRK_HADproj_phi[trk];
+      if (dphi > M_PI)
+      {
+        dphi -= 2 * M_PI;
+      }
+      if (dphi < -M_PI)
+      {
+        dphi += 2 * M_PI;
+      }
+
+      if (std::fabs(deta) < 0.1 * 1.5 && std::fabs(dphi) < 0.1 * 1.5)
+      {
+        has_overlap = true;
+        break;
+      }
+    }
+
+    if (has_overlap)
+    {
+      if (Verbosity() > 5)
+      {
+        std::cout << " -> possible match to HAD " << had << " with dR = " << dR << std::endl;
+      }
+
+      if (_pflow_HAD_E.at(had) > max_had_pt)
+      {
+        max_had_pt = _pflow_HAD_E.at(had);
+        min_had_index = had;
+        min_had_dR = dR;
+      }
+    }
+    else
+    {
+      if (Verbosity() > 5)
+      {
+        std::cout << " -> no match to HAD " << had << " (even though dR = " << dR << " )" << std::endl;
+      }
+    }
+  }
+
+  if (min_had_index > -1)
+  {
+    _pflow_TRK_match_HAD.at(trk).push_back(min_had_index);
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " -> matched HAD " << min_had_index << " with pt / eta / phi = " << _pflow_HAD_E.at(min_had_index) << " / " << _pflow_HAD_eta.at(min_had_index) << " / " << _pflow_HAD_phi.at(min_had_index) << ", dR = " << min_had_dR << std::endl;
+    }
+  }
+  else
+  {
+    if (Verbosity() > 5)
+    {
+      std::cout << " -> no HAD match! ( best dR = " << min_had_dR << " ) " << std::endl;
+    }
+  }
+}
+
 //____________________________________________________________________________..
 int ParticleFlowReco::process_event(PHCompositeNode *topNode)
 {
@@ -372,188 +559,61 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     std::cout << "ParticleFlowReco::process_event : TRK -> EM and TRK -> HAD linking " << std::endl;
   }
 
-  for (unsigned int trk = 0; trk < _pflow_TRK_p.size(); trk++)
-  {
-    if (Verbosity() > 10)
-    {
-      std::cout << " TRK " << trk << " with p / eta / phi = " << _pflow_TRK_p[trk] << " / " << _pflow_TRK_eta[trk] << " / " << _pflow_TRK_phi[trk] << std::endl;
-    }
-
-    // TRK -> EM link
-    float min_em_dR = 0.2;
-    int min_em_index = -1;
+  const auto link_start = std::chrono::steady_clock::now();
 
+  if (_use_grid)
+  {
+    _grid_EM.clear();
     for (unsigned int em = 0; em < _pflow_EM_E.size(); em++)
     {
-      float dR = calculate_dR(_pflow_TRK_EMproj_eta[trk], _pflow_EM_eta[em], _pflow_TRK_EMproj_phi[trk], _pflow_EM_phi[em]);
-
-      if (dR > 0.2)
-      {
-        continue;
-      }
-
-      bool has_overlap = false;
-
-      for (unsigned int tow = 0; tow < _pflow_EM_tower_eta.at(em).size(); tow++)
-      {
-        float tower_eta = _pflow_EM_tower_eta.at(em).at(tow);
-        float tower_phi = _pflow_EM_tower_phi.at(em).at(tow);
-
-        float deta = tower_eta - _pflow_TRK_EMproj_eta[trk];
-        float dphi = tower_phi - _pflow_TRK_EMproj_phi[trk];
-        if (dphi > M_PI)
-        {
-          dphi -= 2 * M_PI;
-        }
-        if (dphi < -M_PI)
-        {
-          dphi += 2 * M_PI;
-        }
-
-        if (std::fabs(deta) < 0.025 * 2.5 && std::fabs(dphi) < 0.025 * 2.5)
-        {
-          has_overlap = true;
-          break;
-        }
-      }
-
-      if (has_overlap)
-      {
-        if (Verbosity() > 5)
-        {
-          std::cout << " -> possible match to EM " << em << " with dR = " << dR << std::endl;
-        }
-
-        _pflow_TRK_addtl_match_EM.at(trk).emplace_back(em, dR);
-      }
-      else
-      {
-        if (Verbosity() > 5)
-        {
-          std::cout << " -> no match to EM " << em << " (even though dR = " << dR << " )" << std::endl;
-        }
-      }
+      _grid_EM.fill(em, _pflow_EM_tower_eta[em], _pflow_EM_tower_phi[em], 0.025 * 2.5);
     }
-
-    // sort possible matches
-
-    std::sort(_pflow_TRK_addtl_match_EM.at(trk).begin(), _pflow_TRK_addtl_match_EM.at(trk).end(), sort_by_pair_second_lowest);
-    if (Verbosity() > 10)
+    _grid_HAD.clear();
+    for (unsigned int had = 0; had < _pflow_HAD_E.size(); had++)
     {
-      for (auto &n : _pflow_TRK_addtl_match_EM.at(trk))
-      {
-        std::cout << " -> sorted list of matches, EM / dR = " << n.first << " / " << n.second << std::endl;
-      }
+      _grid_HAD.fill(had, _pflow_HAD_tower_eta[had], _pflow_HAD_tower_phi[had], 0.1 * 1.5);
     }
+  }
+  else
+  {
+    _all_EM.resize(_pflow_EM_E.size());
+    std::iota(_all_EM.begin(), _all_EM.end(), 0);
+    _all_HAD.resize(_pflow_HAD_E.size());
+    std::iota(_all_HAD.begin(), _all_HAD.end(), 0);
+  }
 
-    if (!_pflow_TRK_addtl_match_EM.at(trk).empty())
-    {
-      min_em_index = _pflow_TRK_addtl_match_EM.at(trk).at(0).first;
-      min_em_dR = _pflow_TRK_addtl_match_EM.at(trk).at(0).second;
-      // delete best matched element
-      _pflow_TRK_addtl_match_EM.at(trk).erase(_pflow_TRK_addtl_match_EM.at(trk).begin());
-    }
+  // tracks are independent, the printout is only readable in sequence
+  const int ntracks = _pflow_TRK_p.size();
+  const int nthreads = (Verbosity() > 5) ? 1 : _nthreads;
+#pragma omp parallel for schedule(dynamic, 8) num_threads(nthreads)
+  for (int trk = 0; trk < ntracks; trk++)
+  {
+    link_track(trk);
+  }
 
-    if (min_em_index > -1)
+  // back links in track order, as in the sequential loop
+  for (unsigned int trk = 0; trk < _pflow_TRK_p.size(); trk++)
+  {
+    for (int em : _pflow_TRK_match_EM.at(trk))
     {
-      _pflow_EM_match_TRK.at(min_em_index).push_back(trk);
-      _pflow_TRK_match_EM.at(trk).push_back(min_em_index);
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " -> matched EM " << min_em_index << " with pt / eta / phi = " << _pflow_EM_E.at(min_em_index) << " / " << _pflow_EM_eta.at(min_em_index) << " / " << _pflow_EM_phi.at(min_em_index) << ", dR = " << min_em_dR;
-        std::cout << " ( " << _pflow_TRK_addtl_match_EM.at(trk).size() << " other possible matches ) " << std::endl;
-      }
+      _pflow_EM_match_TRK.at(em).push_back(trk);
     }
-    else
+    for (int had : _pflow_TRK_match_HAD.at(trk))
     {
-      if (Verbosity() > 5)
-      {
-        std::cout << " -> no EM match! ( best dR = " << min_em_dR << " ) " << std::endl;
-      }
+      _pflow_HAD_match_TRK.at(had).push_back(trk);
     }
+  }
 
-    // TRK -> HAD link
-    float min_had_dR = 0.2;
-    int min_had_index = -1;
-    float max_had_pt = 0;
-
-    // TODO: sequential linking should better happen here -- i.e. allow EM-matched HAD's into the possible pool
-    for (unsigned int had = 0; had < _pflow_HAD_E.size(); had++)
-    {
-      float dR = calculate_dR(_pflow_TRK_HADproj_eta[trk], _pflow_HAD_eta[had], _pflow_TRK_HADproj_phi[trk], _pflow_HAD_phi[had]);
-
-      if (dR > 0.5)
-      {
-        continue;
-      }
-
-      bool has_overlap = false;
-
-      for (unsigned int tow = 0; tow < _pflow_HAD_tower_eta.at(had).size(); tow++)
-      {
-        float tower_eta = _pflow_HAD_tower_eta.at(had).at(tow);
-        float tower_phi = _pflow_HAD_tower_phi.at(had).at(tow);
-
-        float deta = tower_eta - _pflow_TRK_HADproj_eta[trk];
-        float dphi = tower_phi - _pflow_TRK_HADproj_phi[trk];
-        if (dphi > M_PI)
-        {
-          dphi -= 2 * M_PI;
-        }
-        if (dphi < -M_PI)
-        {
-          dphi += 2 * M_PI;
-        }
-
-        if (std::fabs(deta) < 0.1 * 1.5 && std::fabs(dphi) < 0.1 * 1.5)
-        {
-          has_overlap = true;
-          break;
-        }
-      }
-
-      if (has_overlap)
-      {
-        if (Verbosity() > 5)
-        {
-          std::cout << " -> possible match to HAD " << had << " with dR = " << dR << std::endl;
-        }
-
-        if (_pflow_HAD_E.at(had) > max_had_pt)
-        {
-          max_had_pt = _pflow_HAD_E.at(had);
-          min_had_index = had;
-          min_had_dR = dR;
-        }
-      }
-      else
-      {
-        if (Verbosity() > 5)
-        {
-          std::cout << " -> no match to HAD " << had << " (even though dR = " << dR << " )" << std::endl;
-        }
-      }
-    }
-
-    if (min_had_index > -1)
-    {
-      _pflow_HAD_match_TRK.at(min_had_index).push_back(trk);
-      _pflow_TRK_match_HAD.at(trk).push_back(min_had_index);
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " -> matched HAD " << min_had_index << " with pt / eta / phi = " << _pflow_HAD_E.at(min_had_index) << " / " << _pflow_HAD_eta.at(min_had_index) << " / " << _pflow_HAD_phi.at(min_had_index) << ", dR = " << min_had_dR << std::endl;
-      }
-    }
-    else
-    {
-      if (Verbosity() > 5)
-      {
-        std::cout << " -> no HAD match! ( best dR = " << min_had_dR << " ) " << std::endl;
-      }
-    }
+  const std::chrono::duration<double> link_time = std::chrono::steady_clock::now() - link_start;
+  unsigned int timing_class = 0;
+  while (timing_class + 1 < _timing_class_edges.size() && _pflow_TRK_p.size() >= _timing_class_edges[timing_class + 1])
+  {
+    timing_class++;
   }
+  _timing_class_events.resize(_timing_class_edges.size(), 0);
+  _timing_class_seconds.resize(_timing_class_edges.size(), 0);
+  _timing_class_events[timing_class]++;
+  _timing_class_seconds[timing_class] += link_time.count();
 
   // EM->HAD linking
   if (Verbosity() > 2)
@@ -848,7 +908,7 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         additional_EMs_vec.emplace_back(x.first, x.second);
       }
 
-      std::sort(additional_EMs_vec.begin(), additional_EMs_vec.end(), sort_by_pair_second_lowest);
+      std::stable_sort(additional_EMs_vec.begin(), additional_EMs_vec.end(), sort_by_pair_second_lowest);
 
       if (Verbosity() > 5)
       {
@@ -1198,6 +1258,31 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+//____________________________________________________________________________..
+int ParticleFlowReco::End(PHCompositeNode * /*topNode*/)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "ParticleFlowReco::End - TRK -> EM/HAD linking time (" << (_use_grid ? "grid" : "all pairs")
+              << ", " << _nthreads << " threads)" << std::endl;
+    for (unsigned int i = 0; i < _timing_class_events.size(); i++)
+    {
+      if (_timing_class_events[i] == 0)
+      {
+        continue;
+      }
+      std::cout << "  tracks >= " << _timing_class_edges[i];
+      if (i + 1 < _timing_class_edges.size())
+      {
+        std::cout << " and < " << _timing_class_edges[i + 1];
+      }
+      std::cout << ": " << _timing_class_events[i] << " events, "
+                << 1e3 * _timing_class_seconds[i] / _timing_class_events[i] << " ms/event" << std::endl;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int ParticleFlowReco::CreateNode(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -7,11 +7,15 @@
 /// \author Dennis V. Perepelitsa
 //===========================================================
 
+#include "ParticleFlowCaloGrid.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <gsl/gsl_rng.h>
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 class PHCompositeNode;
@@ -29,6 +33,8 @@ class ParticleFlowReco : public SubsysReco
 
   int process_event(PHCompositeNode *topNode) override;
 
+  int End(PHCompositeNode *topNode) override;
+
   void set_energy_match_Nsigma(float Nsigma)
   {
     _energy_match_Nsigma = Nsigma;
@@ -37,13 +43,25 @@ class ParticleFlowReco : public SubsysReco
 
   void set_only_crossing_zero(bool b) { _only_crossing_zero = b; }
 
+  /// look up TRK -> EM/HAD candidates in an eta-phi grid instead of
+  /// testing every cluster (the links are the same either way)
+  void set_use_grid(bool b) { _use_grid = b; }
+  /// threads for the TRK -> EM/HAD linking, output does not depend on it
+  void set_num_threads(int nthreads) { _nthreads = std::max(1, nthreads); }
+  /// lower edges in number of accepted tracks of the event classes
+  /// for which End() reports the linking time
+  void set_timing_classes(const std::vector<unsigned int> &edges) { _timing_class_edges = edges; }
+
  private:
   static int CreateNode(PHCompositeNode *topNode);
 
   static float calculate_dR(float, float, float, float);
   std::pair<float, float> get_expected_signature(int);
+  void link_track(unsigned int trk);
 
   bool _only_crossing_zero {true};
+  bool _use_grid {true};
+  int _nthreads {1};
 
   float _energy_match_Nsigma {1.5};
 
@@ -80,6 +98,16 @@ class ParticleFlowReco : public SubsysReco
   std::vector<std::vector<int> > _pflow_HAD_match_TRK;
 
   std::string _track_map_name {"SvtxTrackMap"};
+
+  // cells of one tower width, covering the tracking acceptance
+  ParticleFlowCaloGrid _grid_EM {0.025, 1.2};
+  ParticleFlowCaloGrid _grid_HAD {0.1, 1.2};
+  std::vector<int> _all_EM;
+  std::vector<int> _all_HAD;
+
+  std::vector<unsigned int> _timing_class_edges {0, 10, 50, 200, 500};
+  std::vector<unsigned long> _timing_class_events;
+  std::vector<double> _timing_class_seconds;
 };
 
 #endif  // PARTICLEFLOWRECO_H
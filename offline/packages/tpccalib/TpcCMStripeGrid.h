@@ -0,0 +1,95 @@
+#ifndef TPCCALIB_TPCCMSTRIPEGRID_H
+#define TPCCALIB_TPCCMSTRIPEGRID_H
+
+/*!
+ * \file TpcCMStripeGrid.h
+ * \brief r-phi lookup grid of the central membrane stripes
+ *
+ * The stripe pattern is fixed, so the grid is filled once per run. Cells
+ * are at least as large as the match window, hence every stripe within
+ * the window around a position sits in the cell of that position or in
+ * one of its eight neighbours. The grid only preselects, the caller
+ * still applies the exact match criteria.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class TpcCMStripeGrid
+{
+ public:
+  //! r, phi and z of the stripes, side 0 takes z <= 0 and side 1 z >= 0
+  void build(const std::vector<double> &r, const std::vector<double> &phi, const std::vector<double> &z, const double rwindow, const double phiwindow)
+  {
+    // a bit of margin against rounding at the cell edges
+    m_rwidth = rwindow * 1.001;
+    m_nphi = std::max(3, static_cast<int>(2 * M_PI / (phiwindow * 1.001)));
+    m_phiwidth = 2 * M_PI / m_nphi;
+    const double rmax = r.empty() ? 0 : *std::max_element(r.begin(), r.end());
+    m_nr = static_cast<int>(rmax / m_rwidth) + 2;
+    for (auto &cells : m_cells)
+    {
+      cells.assign(m_nr * m_nphi, {});
+    }
+    for (unsigned int i = 0; i < r.size(); i++)
+    {
+      const int cell = rbin(r[i]) * m_nphi + phibin(phi[i]);
+      if (z[i] <= 0)
+      {
+        m_cells[0][cell].push_back(i);
+      }
+      if (z[i] >= 0)
+      {
+        m_cells[1][cell].push_back(i);
+      }
+    }
+  }
+
+  bool empty() const { return m_nr == 0; }
+
+  //! calls f(index) for the stripes of one side in the 3x3 cells around (r, phi)
+  template <class F>
+  void for_each(const bool side, const double r, const double phi, F &&f) const
+  {
+    const auto &cells = m_cells[side ? 1 : 0];
+    const int ir = rbin(r);
+    const int iphi = phibin(phi);
+    for (int jr = std::max(ir - 1, 0); jr <= std::min(ir + 1, m_nr - 1); jr++)
+    {
+      for (int dphi = -1; dphi <= 1; dphi++)
+      {
+        const int jphi = (iphi + dphi + m_nphi) % m_nphi;
+        for (const int index : cells[jr * m_nphi + jphi])
+        {
+          f(index);
+        }
+      }
+    }
+  }
+
+ private:
+  int rbin(const double r) const
+  {
+    return std::clamp(static_cast<int>(std::floor(r / m_rwidth)), 0, m_nr - 1);
+  }
+
+  //! phi is taken into [0, 2pi)
+  int phibin(double phi) const
+  {
+    phi = std::fmod(phi, 2 * M_PI);
+    if (phi < 0)
+    {
+      phi += 2 * M_PI;
+    }
+    return std::min(static_cast<int>(phi / m_phiwidth), m_nphi - 1);
+  }
+
+  double m_rwidth{1};
+  double m_phiwidth{1};
+  int m_nr{0};
+  int m_nphi{0};
+  std::vector<std::vector<int>> m_cells[2];
+};
+
+#endif  // TPCCALIB_TPCCMSTRIPEGRID_H
@@ -35,6 +35,7 @@
 #include <TVector3.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <format>
 #include <iomanip>
@@ -978,6 +979,56 @@ int TpcCentralMembraneMatching::getClusterRMatch(double clusterR, int side)
   return -1;
 }
 
+//____________________________________________________________________________..
+int TpcCentralMembraneMatching::findNearestTruth(const TVector3& reco, bool side) const
+{
+  const double rR = get_r(reco.X(), reco.Y());
+  const double rPhi = reco.Phi();
+
+  double minNNDist = 100000.0;
+  int match_localTruth = -1;
+  auto check = [&](int truth_index)
+  {
+    const auto& truth = m_truth_pos[truth_index];
+    const double tZ = truth.Z();
+    if ((!side && tZ > 0) || (side && tZ < 0))
+    {
+      return;
+    }
+
+    if (fabs(m_truth_R[truth_index] - rR) > m_nnMaxDR)
+    {
+      return;
+    }
+
+    if (fabs(delta_phi(m_truth_Phi[truth_index] - rPhi)) > m_nnMaxDPhi)
+    {
+      return;
+    }
+
+    // the grid visits the stripes out of order, ties go to the lowest index as in the plain loop
+    double dist = sqrt(pow(truth.X() - reco.X(), 2) + pow(truth.Y() - reco.Y(), 2));
+    if (dist < minNNDist || (dist == minNNDist && truth_index < match_localTruth))
+    {
+      minNNDist = dist;
+      match_localTruth = truth_index;
+    }
+  };
+
+  if (m_useStripeGrid && !m_truth_grid.empty())
+  {
+    m_truth_grid.for_each(side, rR, rPhi, check);
+  }
+  else
+  {
+    for (int truth_index = 0; truth_index < (int) m_truth_pos.size(); truth_index++)
+    {
+      check(truth_index);
+    }
+  }
+  return match_localTruth;
+}
+
 //____________________________________________________________________________..
 int TpcCentralMembraneMatching::InitRun(PHCompositeNode* topNode)
 {
@@ -1371,6 +1422,18 @@ int TpcCentralMembraneMatching::InitRun(PHCompositeNode* topNode)
     gr_points[s]->SetMarkerColor(kBlack);
   }
 
+  // the stripe pattern does not change, bin it once for the nearest neighbor search
+  m_truth_R.clear();
+  m_truth_Phi.clear();
+  std::vector<double> truth_Z;
+  for (const auto& truth : m_truth_pos)
+  {
+    m_truth_R.push_back(get_r(truth.X(), truth.Y()));
+    m_truth_Phi.push_back(truth.Phi());
+    truth_Z.push_back(truth.Z());
+  }
+  m_truth_grid.build(m_truth_R, m_truth_Phi, truth_Z, m_nnMaxDR, m_nnMaxDPhi);
+
   int ret = GetNodes(topNode);
   return ret;
 }
@@ -1466,8 +1529,12 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     }
   }
 
-  reco_r_phi[0]->Reset();
-  reco_r_phi[1]->Reset();
+  // only the fancy matching uses the reco r-phi histograms
+  if (m_doFancy)
+  {
+    reco_r_phi[0]->Reset();
+    reco_r_phi[1]->Reset();
+  }
 
   int nClus_gtMin = 0;
   int clusterIndex = 0;
@@ -1568,13 +1635,9 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     reco_SDWeightedIPhi.push_back(cmclus->getSDWeightedIPhi());
     reco_SDWeightedIT.push_back(cmclus->getSDWeightedIT());
 
-    if (side == 0)
+    if (m_doFancy)
     {
-      reco_r_phi[0]->Fill(tmp_pos.Phi(), tmp_pos.Perp());
-    }
-    else
-    {
-      reco_r_phi[1]->Fill(tmp_pos.Phi(), tmp_pos.Perp());
+      reco_r_phi[side == 0 ? 0 : 1]->Fill(tmp_pos.Phi(), tmp_pos.Perp());
     }
 
     if (Verbosity() > 2)
@@ -1604,6 +1667,8 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
+  const auto matchStart = std::chrono::steady_clock::now();
+
   int truth_index = 0;
   int nMatched = 0;
   std::vector<bool> truth_matched(m_truth_pos.size(), false);
@@ -1893,55 +1958,21 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
   }  // end fancy
   else
   {
-    int reco_index = 0;
-    for (const auto& reco : reco_pos)
+    // nearest truth stripe of each cluster, the clusters of both sides are independent
+    const int nreco = reco_pos.size();
+    std::vector<int> reco_localTruth(nreco, -1);
+#pragma omp parallel for schedule(dynamic, 16) num_threads(m_nthreads)
+    for (int i = 0; i < nreco; i++)
     {
-      double rR = get_r(reco.X(), reco.Y());
-      double rPhi = reco.Phi();
-      bool side = reco_side[reco_index];
-
-      truth_index = 0;
-      double minNNDist = 100000.0;
-      int match_localTruth = -1;
-      for (const auto& truth : m_truth_pos)
-      {
-        // std::cout << "reco_index " << reco_index << "   truth_index " << truth_index << std::endl;
-        double tR = get_r(truth.X(), truth.Y());
-        double tPhi = truth.Phi();
-        double tZ = truth.Z();
-
-        if ((!side && tZ > 0) || (side && tZ < 0))
-        {
-          truth_index++;
-          continue;
-        }
-
-        auto dR = fabs(tR - rR);
-        if (dR > 5.0)
-        {
-          truth_index++;
-          continue;
-        }
-
-        auto dphi = delta_phi(tPhi - rPhi);
-        if (fabs(dphi) > 0.05)
-        {
-          truth_index++;
-          continue;
-        }
-
-        double dist = sqrt(pow(truth.X() - reco.X(), 2) + pow(truth.Y() - reco.Y(), 2));
-        if (dist < minNNDist)
-        {
-          minNNDist = dist;
-          match_localTruth = truth_index;
-        }
-        truth_index++;
-      }  // end truth loop
+      reco_localTruth[i] = findNearestTruth(reco_pos[i], reco_side[i]);
+    }
 
+    for (int reco_index = 0; reco_index < nreco; reco_index++)
+    {
+      const auto& reco = reco_pos[reco_index];
+      const int match_localTruth = reco_localTruth[reco_index];
       if (match_localTruth == -1)
       {
-        reco_index++;
         continue;
       }
 
@@ -1950,8 +1981,6 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
       NNR[reco_index] = get_r(m_truth_pos[match_localTruth].X(), m_truth_pos[match_localTruth].Y());
       NNPhi[reco_index] = m_truth_pos[match_localTruth].Phi();
       NNIndex[reco_index] = m_truth_index[match_localTruth];
-
-      reco_index++;
     }  // end reco loop
 
     truth_index = 0;
@@ -2027,6 +2056,11 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     }
   }  // end else for fancy
 
+  const double matchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - matchStart).count();
+  m_matchTime += matchTime;
+  m_matchTimeMax = std::max(m_matchTimeMax, matchTime);
+  ++m_nMatchEvents;
+
   // print some statistics:
   if (Verbosity() > 1)
   {
@@ -2408,6 +2442,13 @@ int TpcCentralMembraneMatching::End(PHCompositeNode* /*topNode*/)
 {
   std::cout << PHWHERE << "starting TpcCentralMembraneMatching::End()" << std::endl;
 
+  if (m_nMatchEvents > 0)
+  {
+    std::cout << PHWHERE << "matching latency over " << m_nMatchEvents << " events: mean " << m_matchTime / m_nMatchEvents
+              << " ms, max " << m_matchTimeMax << " ms (" << (m_useStripeGrid ? "stripe grid" : "all pairs")
+              << ", " << m_nthreads << " threads)" << std::endl;
+  }
+
   // write distortion corrections
   if (m_dcc_out_aggregated)
   {
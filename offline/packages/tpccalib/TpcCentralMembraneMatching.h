@@ -9,6 +9,8 @@
  * \author Tony Frawley <frawley@fsunuc.physics.fsu.edu>, Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "TpcCMStripeGrid.h"
+
 #include <tpc/TpcDistortionCorrection.h>
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
@@ -20,6 +22,7 @@
 #include <TGraph.h>
 #include <TGraph2D.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -126,6 +129,18 @@ class TpcCentralMembraneMatching : public SubsysReco
 
   void set_phiHistInRad(bool rad){ m_phiHist_in_rad = rad; }
 
+  /// look up the truth stripes near each cluster in an r-phi grid rather than looping over all of them (default)
+  void set_useStripeGrid(bool value)
+  {
+    m_useStripeGrid = value;
+  }
+
+  /// number of threads used for the nearest neighbor search
+  void set_num_threads(int n)
+  {
+    m_nthreads = std::max(1, n);
+  }
+
 
   // void set_laminationFile(const std::string& filename)
   //{
@@ -156,6 +171,9 @@ class TpcCentralMembraneMatching : public SubsysReco
 
   int getClusterRMatch(double clusterR, int side);
 
+  /// index of the closest truth stripe within the nearest neighbor window on the cluster side, -1 if none
+  int findNearestTruth(const TVector3 &reco, bool side) const;
+
   //! tpc distortion correction utility class
   TpcDistortionCorrection m_distortionCorrection;
 
@@ -415,6 +433,23 @@ class TpcCentralMembraneMatching : public SubsysReco
   bool m_skipOutliers{false};
   bool m_manualInterp{false};
 
+  bool m_useStripeGrid{true};
+  int m_nthreads{1};
+
+  /// nearest neighbor window between cluster and truth stripe
+  static constexpr double m_nnMaxDR{5.0};
+  static constexpr double m_nnMaxDPhi{0.05};
+
+  /// truth stripes binned in r and phi, filled at InitRun
+  TpcCMStripeGrid m_truth_grid;
+  std::vector<double> m_truth_R;
+  std::vector<double> m_truth_Phi;
+
+  /// matching latency
+  double m_matchTime{0};
+  double m_matchTimeMax{0};
+  int m_nMatchEvents{0};
+
   std::vector<double> m_reco_RPeaks[2];
   double m_m[2]{};
   double m_b[2]{};
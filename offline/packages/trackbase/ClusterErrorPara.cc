@@ -6,6 +6,7 @@
 #include <TF1.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -20,6 +21,41 @@ namespace
     return x * x;
   }
 
+  //! pol2 in the layer number
+  constexpr double pol2(double x, double p0, double p1, double p2)
+  {
+    return p0 + p1 * x + p2 * x * x;
+  }
+
+  //! tpc layer dependence of the data parametrization in get_clusterv5_modified_error
+  struct TpcLayerFactors
+  {
+    std::array<double, 57> phi{};
+    std::array<double, 57> z{};
+
+    TpcLayerFactors()
+    {
+      phi.fill(1);
+      z.fill(1);
+      for (int layer = 7; layer < 7 + 16; ++layer)
+      {
+        phi[layer] = pol2(layer, 3.206, -0.252, 0.007);
+      }
+      for (int layer = 7 + 16; layer < 7 + 32; ++layer)
+      {
+        phi[layer] = pol2(layer, 4.48, -0.226, 0.00362);
+        z[layer] = pol2(layer, 5.593, -0.2458, 0.00333455);
+      }
+      for (int layer = 7 + 32; layer < 7 + 48; ++layer)
+      {
+        phi[layer] = pol2(layer, 14.8112, -0.577, 0.00605);
+        z[layer] = pol2(layer, 5.6964, -0.21338, 0.002502);
+      }
+    }
+  };
+
+  const TpcLayerFactors tpc_layer_factors;
+
 }  // namespace
 
 ClusterErrorPara::ClusterErrorPara():
@@ -510,6 +546,111 @@ ClusterErrorPara::ClusterErrorPara():
   pull_fine_z[4] *= 1.127752;
   pull_fine_z[5] *= 0.804010;
   pull_fine_z[6] *= 0.567351;
+
+  build_tables();
+}
+
+//_________________________________________________________________________________
+void ClusterErrorPara::build_tables()
+{
+  m_pol_functions = {f0, f1, f2, f0fine, f1fine, f2fine, fz0, fz1, fz2, fz0fine, fz1fine, fz2fine, fmm_55_2, fmm_56_2, fmm_3};
+  m_adc_functions = {fadcphi0, fadcphi0fine, fadcphi1, fadcphi1fine, fadcphi2, fadcphi2fine1, fadcz0, fadcz1, fadcz2, fadcz0fine, fadcz1fine, fadcz2fine};
+
+  for (int f = 0; f < nPolFunctions; ++f)
+  {
+    auto& coefficients = m_pol_coefficients[f];
+    coefficients.fill(0);
+    const int npar = std::min<int>(m_pol_functions[f]->GetNpar(), coefficients.size());
+    for (int i = 0; i < npar; ++i)
+    {
+      coefficients[i] = m_pol_functions[f]->GetParameter(i);
+    }
+  }
+
+  // the max adc is an integer, so the table holds exactly what the TF1 would return
+  m_adc_table.resize(nAdcFunctions * m_nAdcTable);
+  for (int f = 0; f < nAdcFunctions; ++f)
+  {
+    for (unsigned int adc = 0; adc < m_nAdcTable; ++adc)
+    {
+      m_adc_table[f * m_nAdcTable + adc] = m_adc_functions[f]->Eval(adc);
+    }
+  }
+}
+
+//_________________________________________________________________________________
+double ClusterErrorPara::pol(PolFunction f, double x) const
+{
+  if (!m_use_tables)
+  {
+    return m_pol_functions[f]->Eval(x);
+  }
+  return pol_from_coefficients(f, x);
+}
+
+//_________________________________________________________________________________
+double ClusterErrorPara::pol_from_coefficients(PolFunction f, double x) const
+{
+  const auto& c = m_pol_coefficients[f];
+  return c[0] + x * (c[1] + x * (c[2] + x * (c[3] + x * (c[4] + x * c[5]))));
+}
+
+//_________________________________________________________________________________
+bool ClusterErrorPara::compare_tables(double tolerance) const
+{
+  auto deviation = [](double value, double reference)
+  { return std::abs(value - reference) / std::max(1e-12, std::abs(reference)); };
+
+  bool ok = true;
+  // alpha and beta stay within [-2, 2] for all callers of get_cluster_error
+  for (int f = 0; f < nPolFunctions; ++f)
+  {
+    double max_deviation = 0;
+    double worst_x = 0;
+    for (int i = 0; i <= 4000; ++i)
+    {
+      const double x = -2 + i * 0.001;
+      const double d = deviation(pol_from_coefficients(static_cast<PolFunction>(f), x), m_pol_functions[f]->Eval(x));
+      if (d > max_deviation)
+      {
+        max_deviation = d;
+        worst_x = x;
+      }
+    }
+    std::cout << "ClusterErrorPara::compare_tables - " << m_pol_functions[f]->GetName()
+              << " max deviation " << max_deviation << " at angle " << worst_x << std::endl;
+    ok &= (max_deviation <= tolerance);
+  }
+
+  // the table covers the integer max adc values below m_nAdcTable, above it both paths use the TF1
+  for (int f = 0; f < nAdcFunctions; ++f)
+  {
+    double max_deviation = 0;
+    unsigned int worst_adc = 0;
+    for (unsigned int adc = 0; adc < m_nAdcTable; ++adc)
+    {
+      const double d = deviation(m_adc_table[f * m_nAdcTable + adc], m_adc_functions[f]->Eval(adc));
+      if (d > max_deviation)
+      {
+        max_deviation = d;
+        worst_adc = adc;
+      }
+    }
+    std::cout << "ClusterErrorPara::compare_tables - " << m_adc_functions[f]->GetName()
+              << " max deviation " << max_deviation << " at max adc " << worst_adc << std::endl;
+    ok &= (max_deviation <= tolerance);
+  }
+  return ok;
+}
+
+//_________________________________________________________________________________
+double ClusterErrorPara::adc_factor(AdcFunction f, unsigned int adc) const
+{
+  if (!m_use_tables || adc >= m_nAdcTable)
+  {
+    return m_adc_functions[f]->Eval(adc);
+  }
+  return m_adc_table[f * m_nAdcTable + adc];
 }
 
 //_________________________________________________________________________________
@@ -693,27 +834,9 @@ ClusterErrorPara::error_t ClusterErrorPara::get_clusterv5_modified_error(TrkrClu
 	    }
 	  */
 	  
-	  // Inline pol2 evaluation: p0 + p1*x + p2*x^2
-	  auto pol2 = [](double x, double p0, double p1, double p2) {
-	    return p0 + p1 * x + p2 * x * x;
-	  };
-	  
-	  if(layer>=7&&layer<(7+16)){
-	    phierror *= pol2(layer, 3.206, -0.252, 0.007);
-	  }
-	  if(layer>=(7+16)&&layer<(7+32)){
-	    phierror *= pol2(layer, 4.48, -0.226, 0.00362);
-	  }
-	  if(layer>=(7+32)&&layer<(7+48)){
-	    phierror *= pol2(layer, 14.8112, -0.577, 0.00605);
-	  }
-	  
-	  if(layer>=(7+16)&&layer<(7+32)){
-	    zerror *= pol2(layer, 5.593, -0.2458, 0.00333455);
-	  }
-	  if(layer>=(7+32)&&layer<(7+48)){
-	    zerror *= pol2(layer, 5.6964, -0.21338, 0.002502);
-	  }
+	  // pol2 in the layer number, tabulated per layer (1 where there is no correction)
+	  phierror *= tpc_layer_factors.phi[layer];
+	  zerror *= tpc_layer_factors.z[layer];
 	}
 	if (cluster->getPhiSize() >= 5)
 	  {
@@ -807,7 +930,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
   if (sector == 0)
   {
     // phierror = 0.019886;
-    phierror = f0->Eval(alpha);
+    phierror = pol(pol_f0, alpha);
     if (cluster->getMaxAdc() != 0)
     {
       if (cluster->getMaxAdc() > 150)
@@ -816,8 +939,8 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi0->Eval(cluster->getMaxAdc());
-        phierror *= fadcphi0fine->Eval(cluster->getMaxAdc());
+        phierror *= adc_factor(adc_fadcphi0, cluster->getMaxAdc());
+        phierror *= adc_factor(adc_fadcphi0fine, cluster->getMaxAdc());
       }
     }
     if (cluster->getEdge() >= 5)
@@ -838,13 +961,13 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       phierror *= 2.5;
     }
 
-    phierror *= f0fine->Eval(alpha);
+    phierror *= pol(pol_f0fine, alpha);
   }
 
   if (sector == 1)
   {
     // phierror = 0.018604;
-    phierror = f1->Eval(alpha);
+    phierror = pol(pol_f1, alpha);
     if (cluster->getMaxAdc() != 0)
     {
       if (cluster->getMaxAdc() > 160)
@@ -853,7 +976,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi1->Eval(cluster->getMaxAdc());
+        phierror *= adc_factor(adc_fadcphi1, cluster->getMaxAdc());
       }
       if (cluster->getEdge() >= 5)
       {
@@ -865,7 +988,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi1fine->Eval(cluster->getMaxAdc());
+        phierror *= adc_factor(adc_fadcphi1fine, cluster->getMaxAdc());
       }
     }
     phierror *= 0.975;
@@ -882,14 +1005,14 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       phierror *= 2;
     }
 
-    phierror *= f1fine->Eval(alpha);
+    phierror *= pol(pol_f1fine, alpha);
   }
 
   if (sector == 2)
   {
     // phierror = 0.02043;
 
-    phierror = f2->Eval(alpha);
+    phierror = pol(pol_f2, alpha);
     if (cluster->getMaxAdc())
     {
       if (cluster->getMaxAdc() > 170)
@@ -898,10 +1021,10 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi2->Eval(cluster->getMaxAdc());
+        phierror *= adc_factor(adc_fadcphi2, cluster->getMaxAdc());
         if (cluster->getMaxAdc() < 100)
         {
-          phierror *= fadcphi2fine1->Eval(cluster->getMaxAdc());
+          phierror *= adc_factor(adc_fadcphi2fine1, cluster->getMaxAdc());
         }
       }
     }
@@ -919,7 +1042,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       phierror *= 10;
     }
 
-    phierror *= f2fine->Eval(alpha);
+    phierror *= pol(pol_f2fine, alpha);
   }
   if (layer == 7)
   {
@@ -970,48 +1093,48 @@ double ClusterErrorPara::tpc_z_error(int layer, double beta, TrkrCluster* cluste
 
   if (sector == 0)
   {
-    zerror = fz0->Eval(beta);
+    zerror = pol(pol_fz0, beta);
     if (cluster->getMaxAdc() > 180)
     {
       zerror *= 0.5;
     }
     else
     {
-      zerror *= fadcz0->Eval(cluster->getMaxAdc());
+      zerror *= adc_factor(adc_fadcz0, cluster->getMaxAdc());
     }
-    zerror *= fz0fine->Eval(beta);
-    zerror *= fadcz0fine->Eval(cluster->getMaxAdc());
+    zerror *= pol(pol_fz0fine, beta);
+    zerror *= adc_factor(adc_fadcz0fine, cluster->getMaxAdc());
   }
 
   if (sector == 1)
   {
-    zerror = fz1->Eval(beta);
+    zerror = pol(pol_fz1, beta);
     if (cluster->getMaxAdc() > 180)
     {
       zerror *= 0.6;
     }
     else
     {
-      zerror *= fadcz1->Eval(cluster->getMaxAdc());
+      zerror *= adc_factor(adc_fadcz1, cluster->getMaxAdc());
     }
-    zerror *= fz1fine->Eval(beta);
-    zerror *= fadcz1fine->Eval(cluster->getMaxAdc());
+    zerror *= pol(pol_fz1fine, beta);
+    zerror *= adc_factor(adc_fadcz1fine, cluster->getMaxAdc());
     zerror *= 0.98;
     //    zerror *= 1.05913
   }
   if (sector == 2)
   {
-    zerror = fz2->Eval(beta);
+    zerror = pol(pol_fz2, beta);
     if (cluster->getMaxAdc() > 170)
     {
       zerror *= 0.6;
     }
     else
     {
-      zerror *= fadcz2->Eval(cluster->getMaxAdc());
+      zerror *= adc_factor(adc_fadcz2, cluster->getMaxAdc());
     }
-    zerror *= fz2fine->Eval(beta);
-    zerror *= fadcz2fine->Eval(cluster->getMaxAdc());
+    zerror *= pol(pol_fz2fine, beta);
+    zerror *= adc_factor(adc_fadcz2fine, cluster->getMaxAdc());
     // zerrror *= 1.15575;
   }
   if (layer == 7)
@@ -1051,11 +1174,11 @@ double ClusterErrorPara::mm_phi_error(int layer, double alpha, TrkrCluster* clus
     }
     else if (cluster->getPhiSize() == 2)
     {
-      phierror = fmm_55_2->Eval(alpha);
+      phierror = pol(pol_fmm_55_2, alpha);
     }
     else if (cluster->getPhiSize() >= 3)
     {
-      phierror = fmm_3->Eval(alpha);
+      phierror = pol(pol_fmm_3, alpha);
     }
     phierror *= scale_mm_0;
   }
@@ -1081,11 +1204,11 @@ double ClusterErrorPara::mm_z_error(int layer, double beta, TrkrCluster* cluster
     }
     else if (cluster->getZSize() == 2)
     {
-      zerror = fmm_56_2->Eval(beta);
+      zerror = pol(pol_fmm_56_2, beta);
     }
     else if (cluster->getZSize() >= 3)
     {
-      zerror = fmm_3->Eval(beta);
+      zerror = pol(pol_fmm_3, beta);
     }
     zerror *= scale_mm_1;
   }
@@ -1387,6 +1510,27 @@ ClusterErrorPara::error_t ClusterErrorPara::get_cluster_error(TrkrCluster* clust
   return std::make_pair(square(phierror), square(zerror));
   //  return std::make_pair(phierror,zerror);
 }
+
+//_________________________________________________________________________________
+void ClusterErrorPara::get_clusterv5_modified_errors(const std::vector<TrkrCluster*>& clusters, const std::vector<TrkrDefs::cluskey>& keys, std::vector<error_t>& errors)
+{
+  errors.resize(clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i)
+  {
+    errors[i] = get_clusterv5_modified_error(clusters[i], 0, keys[i]);
+  }
+}
+
+//_________________________________________________________________________________
+void ClusterErrorPara::get_cluster_errors(const std::vector<TrkrCluster*>& clusters, const std::vector<TrkrDefs::cluskey>& keys,
+                                          const std::vector<double>& alphas, const std::vector<double>& betas, std::vector<error_t>& errors)
+{
+  errors.resize(clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i)
+  {
+    errors[i] = get_cluster_error(clusters[i], keys[i], alphas[i], betas[i]);
+  }
+}
 //_________________________________________________________________________________
 
 ClusterErrorPara::error_t ClusterErrorPara::get_simple_cluster_error(TrkrCluster* cluster, double cluster_r, TrkrDefs::cluskey key)
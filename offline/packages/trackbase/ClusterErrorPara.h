@@ -5,6 +5,9 @@
 
 #include <TF1.h>
 
+#include <array>
+#include <vector>
+
 class TrkrCluster;
 
 class ClusterErrorPara
@@ -55,6 +58,18 @@ class ClusterErrorPara
   error_t get_cluster_error(TrkrCluster *cluster, double cluster_r, TrkrDefs::cluskey key, float qOverR, float slope);
   error_t get_cluster_error(TrkrCluster *cluster, TrkrDefs::cluskey key, double alpha, double beta);
 
+  //! errors of all clusters of a seed, errors[i] belongs to clusters[i] and keys[i]
+  static void get_clusterv5_modified_errors(const std::vector<TrkrCluster *> &clusters, const std::vector<TrkrDefs::cluskey> &keys, std::vector<error_t> &errors);
+  void get_cluster_errors(const std::vector<TrkrCluster *> &clusters, const std::vector<TrkrDefs::cluskey> &keys,
+                          const std::vector<double> &alphas, const std::vector<double> &betas, std::vector<error_t> &errors);
+
+  //! evaluate the parametrizations from the precomputed tables (default) or from the TF1s
+  void set_use_tables(bool value) { m_use_tables = value; }
+
+  //! compare the table path with the TF1 path over the max adc and track angle ranges
+  /** prints the largest relative deviation of each parametrization, false if one exceeds the tolerance */
+  bool compare_tables(double tolerance = 1e-9) const;
+
   error_t get_simple_cluster_error(TrkrCluster *cluster, double cluster_r, TrkrDefs::cluskey key);
   error_t get_fix_tpc_cluster_error(TrkrCluster *cluster, TrkrDefs::cluskey key);
   error_t get_si_cluster_error(const TrkrCluster *cluster, TrkrDefs::cluskey key);
@@ -72,6 +87,53 @@ class ClusterErrorPara
   double tpc_z_error(int layer, double beta, TrkrCluster *cluster);
 
  private:
+  //! polynomials in the track angles
+  enum PolFunction
+  {
+    pol_f0,
+    pol_f1,
+    pol_f2,
+    pol_f0fine,
+    pol_f1fine,
+    pol_f2fine,
+    pol_fz0,
+    pol_fz1,
+    pol_fz2,
+    pol_fz0fine,
+    pol_fz1fine,
+    pol_fz2fine,
+    pol_fmm_55_2,
+    pol_fmm_56_2,
+    pol_fmm_3,
+    nPolFunctions
+  };
+
+  //! correction factors in the cluster max adc
+  enum AdcFunction
+  {
+    adc_fadcphi0,
+    adc_fadcphi0fine,
+    adc_fadcphi1,
+    adc_fadcphi1fine,
+    adc_fadcphi2,
+    adc_fadcphi2fine1,
+    adc_fadcz0,
+    adc_fadcz1,
+    adc_fadcz2,
+    adc_fadcz0fine,
+    adc_fadcz1fine,
+    adc_fadcz2fine,
+    nAdcFunctions
+  };
+
+  //! max adc values below this are tabulated
+  static constexpr unsigned int m_nAdcTable{1024};
+
+  void build_tables();
+  double pol(PolFunction f, double x) const;
+  double pol_from_coefficients(PolFunction f, double x) const;
+  double adc_factor(AdcFunction f, unsigned int adc) const;
+
   //  TF1 *ftpcR1 {nullptr};
   TF1 *f0 {nullptr};
   TF1 *f1 {nullptr};
@@ -131,6 +193,14 @@ class ClusterErrorPara
   double pull_fine_phi[60]{};
   double pull_fine_z[60]{};
 
+  bool m_use_tables{true};
+  std::array<TF1 *, nPolFunctions> m_pol_functions{};
+  std::array<TF1 *, nAdcFunctions> m_adc_functions{};
+  //! coefficients of the angle polynomials, up to 5th order
+  std::array<std::array<double, 6>, nPolFunctions> m_pol_coefficients{};
+  //! adc factors of the integer max adc values, one row of m_nAdcTable per function
+  std::vector<double> m_adc_table;
+
 };
 
 #endif
@@ -13,18 +13,50 @@
 
 void TrkrHitSetContainerv1::Reset()
 {
+  if (m_pool)
+  {
+    m_pool->new_cycle();
+  }
   for (auto&& [key, hitset] : m_hitmap)
   {
-    delete hitset;
+    release_hitset(hitset);
   }
 
   m_hitmap.clear();
 }
 
+void TrkrHitSetContainerv1::EnableRecycling(const bool flag)
+{
+  if (flag && !m_pool)
+  {
+    m_pool = new PHObjectPool<TrkrHitSet>();
+  }
+  else if (!flag)
+  {
+    delete m_pool;
+    m_pool = nullptr;
+  }
+}
+
+void TrkrHitSetContainerv1::release_hitset(TrkrHitSet* hitset)
+{
+  if (m_pool && hitset)
+  {
+    hitset->Reset();
+    m_pool->put(hitset);
+    return;
+  }
+  delete hitset;
+}
+
 void TrkrHitSetContainerv1::identify(std::ostream& os) const
 {
   ConstIterator iter;
   os << "Number of hits: " << size() << std::endl;
+  if (m_pool)
+  {
+    m_pool->identify(os);
+  }
   for (const auto& pair : m_hitmap)
   {
     int layer = TrkrDefs::getLayer(pair.first);
@@ -60,8 +92,7 @@ void TrkrHitSetContainerv1::removeHitSet(TrkrDefs::hitsetkey key)
   auto iter = m_hitmap.find(key);
   if (iter != m_hitmap.end())
   {
-    TrkrHitSet* hitset = iter->second;
-    delete hitset;
+    release_hitset(iter->second);
     m_hitmap.erase(iter);
   }
 }
@@ -99,7 +130,12 @@ TrkrHitSetContainerv1::findOrAddHitSet(TrkrDefs::hitsetkey key)
   auto it = m_hitmap.lower_bound(key);
   if (it == m_hitmap.end() || (key < it->first))
   {
-    it = m_hitmap.insert(it, std::make_pair(key, new TrkrHitSetv1));
+    TrkrHitSet* hitset = m_pool ? m_pool->get<TrkrHitSetv1>() : nullptr;
+    if (!hitset)
+    {
+      hitset = new TrkrHitSetv1;
+    }
+    it = m_hitmap.insert(it, std::make_pair(key, hitset));
     it->second->setHitSetKey(key);
   }
   return it;
@@ -7,14 +7,15 @@
  */
 
 #include "TrkrDefs.h"
+#include "TrkrHitSet.h"
 #include "TrkrHitSetContainer.h"
 
+#include <phool/PHObjectPool.h>
+
 #include <iostream>  // for cout, ostream
 #include <map>
 #include <utility>  // for pair
 
-class TrkrHitSet;
-
 /**
  * Container for TrkrHitSet objects
  */
@@ -26,10 +27,13 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
   ~TrkrHitSetContainerv1() override
   {
     TrkrHitSetContainerv1::Reset();
+    delete m_pool;
   }
 
   void Reset() override;
 
+  void EnableRecycling(const bool flag) override;
+
   void identify(std::ostream& = std::cout) const override;
 
   ConstIterator addHitSet(TrkrHitSet*) override;
@@ -56,8 +60,13 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
   }
 
  private:
+  void release_hitset(TrkrHitSet* hitset);
+
   Map m_hitmap;
 
+  //! reset hitsets kept for reuse by findOrAddHitSet, only if recycling is enabled
+  PHObjectPool<TrkrHitSet>* m_pool{nullptr};  //!
+
   ClassDefOverride(TrkrHitSetContainerv1, 1)
 };
 
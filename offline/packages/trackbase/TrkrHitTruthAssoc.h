@@ -73,6 +73,9 @@ class TrkrHitTruthAssoc : public PHObject
   {
   }
 
+  //! all associations at once, for bulk lookups. nullptr if not supported
+  virtual const MMap *getMap() const { return nullptr; }
+
  protected:
   //! ctor
   TrkrHitTruthAssoc() = default;
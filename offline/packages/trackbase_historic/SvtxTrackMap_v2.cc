@@ -44,24 +44,82 @@ SvtxTrackMap_v2& SvtxTrackMap_v2::operator=(const SvtxTrackMap_v2& trackmap)
 SvtxTrackMap_v2::~SvtxTrackMap_v2()
 {
   Reset();
+  delete m_pool;
 }
 
 void SvtxTrackMap_v2::Reset()
 {
+  if (m_pool)
+  {
+    m_pool->new_cycle();
+  }
   for (auto& iter : _map)
   {
-    SvtxTrack* track = iter.second;
-    delete track;
+    release_track(iter.second);
   }
   _map.clear();
 }
 
+void SvtxTrackMap_v2::EnableRecycling(const bool flag)
+{
+  if (flag && !m_pool)
+  {
+    m_pool = new PHObjectPool<SvtxTrack>();
+  }
+  else if (!flag)
+  {
+    delete m_pool;
+    m_pool = nullptr;
+  }
+}
+
 void SvtxTrackMap_v2::identify(std::ostream& os) const
 {
   os << "SvtxTrackMap_v2: size = " << _map.size() << std::endl;
+  if (m_pool)
+  {
+    m_pool->identify(os);
+  }
   return;
 }
 
+size_t SvtxTrackMap_v2::erase(unsigned int idkey)
+{
+  auto iter = _map.find(idkey);
+  if (iter == _map.end())
+  {
+    return 0;
+  }
+  release_track(iter->second);
+  _map.erase(iter);
+  return 1;
+}
+
+SvtxTrack* SvtxTrackMap_v2::copy_track(const SvtxTrack* track)
+{
+  if (m_pool)
+  {
+    SvtxTrack* copy = m_pool->get_like(track);
+    if (copy)
+    {
+      copy->CopyFrom(*track);
+      return copy;
+    }
+  }
+  return static_cast<SvtxTrack*>(track->CloneMe());
+}
+
+void SvtxTrackMap_v2::release_track(SvtxTrack* track)
+{
+  // no Reset() here, copy_track() overwrites a recycled track with CopyFrom
+  if (m_pool && track)
+  {
+    m_pool->put(track);
+    return;
+  }
+  delete track;
+}
+
 const SvtxTrack* SvtxTrackMap_v2::get(unsigned int id) const
 {
   ConstIter iter = _map.find(id);
@@ -89,14 +147,14 @@ SvtxTrack* SvtxTrackMap_v2::insert(const SvtxTrack* track)
   {
     index = _map.rbegin()->first + 1;
   }
-  auto copy = static_cast<SvtxTrack*>(track->CloneMe());
+  auto copy = copy_track(track);
   copy->set_id(index);
 
   const auto result = _map.insert(std::make_pair(index, copy));
   if (!result.second)
   {
     std::cout << "SvtxTrackMap_v2::insert - duplicated key. track not inserted" << std::endl;
-    delete copy;
+    release_track(copy);
     return nullptr;
   }
   else
@@ -107,13 +165,13 @@ SvtxTrack* SvtxTrackMap_v2::insert(const SvtxTrack* track)
 
 SvtxTrack* SvtxTrackMap_v2::insertWithKey(const SvtxTrack* track, unsigned int index)
 {
-  auto copy = static_cast<SvtxTrack*>(track->CloneMe());
+  auto copy = copy_track(track);
   copy->set_id(index);
   const auto result = _map.insert(std::make_pair(index, copy));
   if (!result.second)
   {
     std::cout << "SvtxTrackMap_v2::insertWithKey - duplicated key. track not inserted" << std::endl;
-    delete copy;
+    release_track(copy);
     return nullptr;
   }
   else
@@ -4,6 +4,8 @@
 #include "SvtxTrack.h"
 #include "SvtxTrackMap.h"
 
+#include <phool/PHObjectPool.h>
+
 #include <cstddef>   // for size_t
 #include <iostream>  // for cout, ostream
 
@@ -22,6 +24,7 @@ class SvtxTrackMap_v2 : public SvtxTrackMap
   void Reset() override;
   int isValid() const override { return 1; }
   PHObject* CloneMe() const override { return new SvtxTrackMap_v2(*this); }
+  void EnableRecycling(const bool flag) override;
 
   bool empty() const override { return _map.empty(); }
   size_t size() const override { return _map.size(); }
@@ -32,11 +35,7 @@ class SvtxTrackMap_v2 : public SvtxTrackMap
   SvtxTrack* get(unsigned int idkey) override;
   SvtxTrack* insert(const SvtxTrack* track) override;
   SvtxTrack* insertWithKey(const SvtxTrack* track, unsigned int index) override;
-  size_t erase(unsigned int idkey) override
-  {
-    delete _map[idkey];
-    return _map.erase(idkey);
-  }
+  size_t erase(unsigned int idkey) override;
 
   ConstIter begin() const override { return _map.begin(); }
   ConstIter find(unsigned int idkey) const override { return _map.find(idkey); }
@@ -47,8 +46,14 @@ class SvtxTrackMap_v2 : public SvtxTrackMap
   Iter end() override { return _map.end(); }
 
  private:
+  SvtxTrack* copy_track(const SvtxTrack* track);
+  void release_track(SvtxTrack* track);
+
   TrackMap _map;
 
+  //! reset tracks kept for reuse, only if recycling is enabled
+  PHObjectPool<SvtxTrack>* m_pool{nullptr};  //!
+
   ClassDefOverride(SvtxTrackMap_v2, 2);
 };
 
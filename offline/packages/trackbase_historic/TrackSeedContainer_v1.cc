@@ -36,9 +36,21 @@ TrackSeedContainer_v1& TrackSeedContainer_v1::operator=(const TrackSeedContainer
 
 void TrackSeedContainer_v1::Reset()
 {
-  for (const TrackSeed* seed : m_seeds)
+  if (m_pool)
   {
-    delete seed;
+    m_pool->new_cycle();
+  }
+  for (TrackSeed* seed : m_seeds)
+  {
+    // no Reset() here, insert() overwrites a recycled seed with CopyFrom
+    if (m_pool && seed)
+    {
+      m_pool->put(seed);
+    }
+    else
+    {
+      delete seed;
+    }
   }
 
   m_seeds.clear();
@@ -48,12 +60,30 @@ void TrackSeedContainer_v1::Reset()
 TrackSeedContainer_v1::~TrackSeedContainer_v1()
 {
   Reset();
+  delete m_pool;
+}
+
+void TrackSeedContainer_v1::EnableRecycling(const bool flag)
+{
+  if (flag && !m_pool)
+  {
+    m_pool = new PHObjectPool<TrackSeed>();
+  }
+  else if (!flag)
+  {
+    delete m_pool;
+    m_pool = nullptr;
+  }
 }
 
 void TrackSeedContainer_v1::identify(std::ostream& os) const
 {
   os << "TrackSeedContainer_v1 size is " << m_seeds.size()
      << std::endl;
+  if (m_pool)
+  {
+    m_pool->identify(os);
+  }
 }
 
 const TrackSeed* TrackSeedContainer_v1::get(const std::size_t key) const
@@ -76,7 +106,16 @@ TrackSeed* TrackSeedContainer_v1::get(const std::size_t key)
 
 TrackSeed* TrackSeedContainer_v1::insert(const TrackSeed* seed)
 {
-  m_seeds.push_back(static_cast<TrackSeed*>(seed->CloneMe()));
+  TrackSeed* copy = m_pool ? m_pool->get_like(seed) : nullptr;
+  if (copy)
+  {
+    copy->CopyFrom(*seed);
+  }
+  else
+  {
+    copy = static_cast<TrackSeed*>(seed->CloneMe());
+  }
+  m_seeds.push_back(copy);
   Iter iter = m_seeds.end() - 1;
   return *iter;
 }
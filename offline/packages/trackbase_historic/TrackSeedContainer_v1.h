@@ -4,6 +4,8 @@
 #include "TrackSeed.h"
 #include "TrackSeedContainer.h"
 
+#include <phool/PHObjectPool.h>
+
 #include <iostream>
 #include <vector>
 
@@ -20,6 +22,7 @@ class TrackSeedContainer_v1 : public TrackSeedContainer
   void Reset() override;
   int isValid() const override { return 1; }
   PHObject* CloneMe() const override { return new TrackSeedContainer_v1(*this); }
+  void EnableRecycling(const bool flag) override;
 
   bool empty() const override { return m_seeds.empty(); }
   std::size_t size() const override { return m_seeds.size(); }
@@ -49,6 +52,9 @@ class TrackSeedContainer_v1 : public TrackSeedContainer
  private:
   Container m_seeds;
 
+  //! reset seeds kept for reuse, only if recycling is enabled
+  PHObjectPool<TrackSeed>* m_pool{nullptr};  //!
+
   ClassDefOverride(TrackSeedContainer_v1, 1);
 };
 
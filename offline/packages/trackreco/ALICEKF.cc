@@ -92,53 +92,65 @@ double ALICEKF::get_Bz(double x, double y, double z) const
 
 double ALICEKF::getClusterError(TrkrCluster* c, TrkrDefs::cluskey key, Acts::Vector3 global, int i, int j) const
 {
+  return getClusterCovariance(c, key, global)(i, j);
+}
+
+Eigen::Matrix3d ALICEKF::getClusterCovariance(TrkrCluster* c, TrkrDefs::cluskey key, const Acts::Vector3& global) const
+{
+  Eigen::Matrix3d err = Eigen::Matrix3d::Zero();
   if (_use_fixed_clus_error)
   {
-    if (i == j)
+    for (int i = 0; i < 3; ++i)
     {
-      return _fixed_clus_error.at(i) * _fixed_clus_error.at(i);
-    }
-    else
-    {
-      return 0.;
+      err(i, i) = _fixed_clus_error.at(i) * _fixed_clus_error.at(i);
     }
+    return err;
   }
-  else
+
+  double clusRadius = sqrt(global[0] * global[0] + global[1] * global[1]);
+  return getClusterCovariance(_ClusErrPara->get_clusterv5_modified_error(c, clusRadius, key), global);
+}
+
+Eigen::Matrix3d ALICEKF::getClusterCovariance(const ClusterErrorPara::error_t& para_errors, const Acts::Vector3& global) const
+{
+  // the rotation stays in float (TMatrixF), the seeds depend on its rounding
+  TMatrixF localErr(3, 3);
+  localErr[0][0] = 0.;
+  localErr[0][1] = 0.;
+  localErr[0][2] = 0.;
+  localErr[1][0] = 0.;
+  localErr[1][1] = para_errors.first;
+  localErr[1][2] = 0.;
+  localErr[2][0] = 0.;
+  localErr[2][1] = 0.;
+  localErr[2][2] = para_errors.second;
+
+  float clusphi = atan2(global(1), global(0));
+  TMatrixF ROT(3, 3);
+  ROT[0][0] = std::cos(clusphi);
+  ROT[0][1] = -std::sin(clusphi);
+  ROT[0][2] = 0.0;
+  ROT[1][0] = std::sin(clusphi);
+  ROT[1][1] = std::cos(clusphi);
+  ROT[1][2] = 0.0;
+  ROT[2][0] = 0.0;
+  ROT[2][1] = 0.0;
+  ROT[2][2] = 1.0;
+  TMatrixF ROT_T(3, 3);
+  ROT_T.Transpose(ROT);
+
+  TMatrixF err(3, 3);
+  err = ROT * localErr * ROT_T;
+
+  Eigen::Matrix3d cov;
+  for (int i = 0; i < 3; ++i)
   {
-    TMatrixF localErr(3, 3);
-
-    double clusRadius = sqrt(global[0] * global[0] + global[1] * global[1]);
-    auto para_errors = _ClusErrPara->get_clusterv5_modified_error(c, clusRadius, key);
-
-    localErr[0][0] = 0.;
-    localErr[0][1] = 0.;
-    localErr[0][2] = 0.;
-    localErr[1][0] = 0.;
-    localErr[1][1] = para_errors.first;
-    localErr[1][2] = 0.;
-    localErr[2][0] = 0.;
-    localErr[2][1] = 0.;
-    localErr[2][2] = para_errors.second;
-
-    float clusphi = atan2(global(1), global(0));
-    TMatrixF ROT(3, 3);
-    ROT[0][0] = std::cos(clusphi);
-    ROT[0][1] = -std::sin(clusphi);
-    ROT[0][2] = 0.0;
-    ROT[1][0] = std::sin(clusphi);
-    ROT[1][1] = std::cos(clusphi);
-    ROT[1][2] = 0.0;
-    ROT[2][0] = 0.0;
-    ROT[2][1] = 0.0;
-    ROT[2][2] = 1.0;
-    TMatrixF ROT_T(3, 3);
-    ROT_T.Transpose(ROT);
-
-    TMatrixF err(3, 3);
-    err = ROT * localErr * ROT_T;
-
-    return err[i][j];
+    for (int j = 0; j < 3; ++j)
+    {
+      cov(i, j) = err[i][j];
+    }
   }
+  return cov;
 }
 
 bool ALICEKF::TransportAndRotate(double old_radius, double new_radius, double& phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp) const
@@ -243,7 +255,7 @@ bool ALICEKF::TransportAndRotate(double old_radius, double new_radius, double& p
   return true;
 }
 
-bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const
+bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions, const ClusterErrorPara::error_t* para_errors) const
 {
   // give up if position vector has NaN for any component
   if (std::isnan(kftrack.GetX()) ||
@@ -432,10 +444,10 @@ bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_
     std::cout << "track position error: (" << txerr << ", " << tyerr << ", " << tzerr << ")" << std::endl;
   }
 
-  TrkrCluster* cluster = _cluster_map->findCluster(ckey);
-  const double cxerr = sqrt(getClusterError(cluster, ckey, cluster_pos, 0, 0));
-  const double cyerr = sqrt(getClusterError(cluster, ckey, cluster_pos, 1, 1));
-  const double czerr = sqrt(getClusterError(cluster, ckey, cluster_pos, 2, 2));
+  const Eigen::Matrix3d ccov = para_errors ? getClusterCovariance(*para_errors, cluster_pos) : getClusterCovariance(_cluster_map->findCluster(ckey), ckey, cluster_pos);
+  const double cxerr = sqrt(ccov(0, 0));
+  const double cyerr = sqrt(ccov(1, 1));
+  const double czerr = sqrt(ccov(2, 2));
 
   if (Verbosity() > 1)
   {
@@ -443,7 +455,7 @@ bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_
   }
 
   const double cY = -cx * sin(current_phi) + cy * cos(current_phi);
-  const double cxycov2 = getClusterError(cluster, ckey, cluster_pos, 0, 1);
+  const double cxycov2 = ccov(0, 1);
   const double cYerr2 = cxerr * cxerr * sin(current_phi) * sin(current_phi) + cxycov2 * sin(current_phi) * cos(current_phi) + cyerr * cyerr * cos(current_phi) * cos(current_phi);
   const double czerr2 = czerr * czerr;
 
@@ -477,6 +489,8 @@ TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter(const std::vector<keylist>& tra
   //  TNtuple* ntp = new TNtuple("pull","pull","cx:cy:cz:xerr:yerr:zerr:tx:ty:tz:layer:xsize:ysize:phisize:phierr:zsize");
   std::vector<TrackSeed_v2> seeds_vector;
   std::vector<GPUTPCTrackParam> alice_seeds_vector;
+  std::vector<TrkrCluster*> seed_clusters;
+  std::vector<ClusterErrorPara::error_t> seed_errors;
   int nseeds = 0;
   int ncandidates = -1;
   if (Verbosity() > 0)
@@ -634,9 +648,23 @@ TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter(const std::vector<keylist>& tra
     double current_phi = phi_first;
     bool filter_failed = false;
     keylist outputKeyChain = trackKeyChain;
+
+    // parametrized errors of all clusters of the seed in one call
+    seed_errors.clear();
+    if (!_use_fixed_clus_error)
+    {
+      seed_clusters.clear();
+      for (const auto& key : trackKeyChain)
+      {
+        seed_clusters.push_back(_cluster_map->findCluster(key));
+      }
+      ClusterErrorPara::get_clusterv5_modified_errors(seed_clusters, trackKeyChain, seed_errors);
+    }
+
     for (auto clusterkey = std::next(trackKeyChain.begin()); clusterkey != trackKeyChain.end(); ++clusterkey)
     {
-      if (!FilterStep(*clusterkey, outputKeyChain, current_phi, trackSeed, fp, globalPositions))
+      const ClusterErrorPara::error_t* para_errors = seed_errors.empty() ? nullptr : &seed_errors[std::distance(trackKeyChain.begin(), clusterkey)];
+      if (!FilterStep(*clusterkey, outputKeyChain, current_phi, trackSeed, fp, globalPositions, para_errors))
       {
         if (Verbosity() > 0)
         {
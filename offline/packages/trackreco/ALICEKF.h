@@ -40,7 +40,8 @@ class ALICEKF
   void setIsobutaneFraction(double frac) { isobutane_frac = frac; };
 
   bool TransportAndRotate(double old_radius, double new_radius, double& phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp) const;
-  bool FilterStep(TrkrDefs::cluskey ckey, std::vector<TrkrDefs::cluskey>& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const;
+  //! para_errors are the parametrized errors of the cluster if they were already evaluated, they are looked up otherwise
+  bool FilterStep(TrkrDefs::cluskey ckey, std::vector<TrkrDefs::cluskey>& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions, const ClusterErrorPara::error_t* para_errors = nullptr) const;
 
   TrackSeedAliceSeedMap ALICEKalmanFilter(const std::vector<std::vector<TrkrDefs::cluskey>>& chains, bool use_nhits_limit, const PositionMap& globalPositions, std::vector<float>& trackChi2) const;
   bool covIsPosDef(Eigen::Matrix<double, 6, 6>& cov) const;
@@ -58,6 +59,10 @@ class ALICEKF
   void useFixedClusterError(bool opt) { _use_fixed_clus_error = opt; }
   void setFixedClusterError(int i, double val) { _fixed_clus_error.at(i) = val; }
   double getClusterError(TrkrCluster* c, TrkrDefs::cluskey key, Acts::Vector3 global, int i, int j) const;
+  //! global x, y, z covariance of a cluster, the parametrization is evaluated once for all elements
+  Eigen::Matrix3d getClusterCovariance(TrkrCluster* c, TrkrDefs::cluskey key, const Acts::Vector3& global) const;
+  //! same, from the already evaluated parametrized (rphi, z) errors
+  Eigen::Matrix3d getClusterCovariance(const ClusterErrorPara::error_t& para_errors, const Acts::Vector3& global) const;
   std::vector<double> GetCircleClusterResiduals(const std::vector<std::pair<double, double>>& pts, double R, double X0, double Y0) const;
   std::vector<double> GetLineClusterResiduals(const std::vector<std::pair<double, double>>& pts, double A, double B) const;
   double get_Bzconst() const { return _Bzconst; }
@@ -51,6 +51,7 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -81,6 +82,8 @@
 #include <Acts/Material/IMaterialDecorator.hpp>
 #include <trackbase/MaterialWiper.h>
 
+#include <nlohmann/json.hpp>
+
 #include <TGeoManager.h>
 #include <TMatrixT.h>
 #include <TObject.h>
@@ -91,9 +94,14 @@
 #include <cstddef>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <map>
 #include <memory>
+#include <sstream>
+#include <unistd.h>
 #include <utility>
 #include <vector>
 
@@ -126,6 +134,9 @@ namespace
     return nullptr;
   }
 
+  // bump when the content written to the material cache changes
+  constexpr int material_cache_version = 1;
+
   template <class T>
   inline constexpr T square(const T &x)
   {
@@ -210,10 +221,18 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
   alignment_transformation.setUseModuleTiltAlways(m_use_module_tilt_always);
   
   
+  PHTimer buildTimer("MakeActsGeometryBuild");
+  buildTimer.restart();
   if (buildAllGeometry(topNode) != Fun4AllReturnCodes::EVENT_OK)
   {
     return Fun4AllReturnCodes::ABORTEVENT;
   }
+  buildTimer.stop();
+  if (Verbosity() > 0)
+  {
+    std::cout << "MakeActsGeometry::InitRun - geometry built in " << buildTimer.elapsed()
+              << " ms, material cache: " << m_materialCacheStatus << std::endl;
+  }
 
   // load relevant magnetic field map on the node tree
   double fieldstrength = std::numeric_limits<double>::quiet_NaN();
@@ -701,6 +720,11 @@ void MakeActsGeometry::setMaterialResponseFile(std::string &responseFile,
     materialFile = CDBInterface::instance()->getUrl("ACTSMATERIALMAP");
   }
 
+  if (!m_materialCacheDir.empty() && materialFile.find(".json") != std::string::npos)
+  {
+    materialFile = getCachedMaterialFile(materialFile);
+  }
+
     std::cout << "using Acts material file : " << materialFile
               << std::endl;
     std::cout << "Using Acts TGeoResponse file : " << responseFile
@@ -708,6 +732,78 @@ void MakeActsGeometry::setMaterialResponseFile(std::string &responseFile,
 
   return;
 }
+
+std::string MakeActsGeometry::getCachedMaterialFile(const std::string &materialFile)
+{
+  // the key changes whenever the source file is replaced or modified
+  std::error_code ec;
+  const auto source = std::filesystem::canonical(materialFile, ec);
+  if (ec)
+  {
+    m_materialCacheStatus = "failed";
+    return materialFile;
+  }
+  const auto size = std::filesystem::file_size(source, ec);
+  const auto mtime = std::filesystem::last_write_time(source, ec).time_since_epoch().count();
+  if (ec)
+  {
+    m_materialCacheStatus = "failed";
+    return materialFile;
+  }
+  std::ostringstream key;
+  key << material_cache_version << ":" << source.string() << ":" << size << ":" << mtime;
+  std::ostringstream name;
+  name << source.stem().string() << "-v" << material_cache_version
+       << "-" << std::hex << std::hash<std::string>{}(key.str()) << ".cbor";
+  const auto cached = std::filesystem::path(m_materialCacheDir) / name.str();
+
+  if (std::filesystem::exists(cached))
+  {
+    m_materialCacheStatus = "warm";
+    if (Verbosity() > 0)
+    {
+      std::cout << "MakeActsGeometry::getCachedMaterialFile - using " << cached << std::endl;
+    }
+    return cached.string();
+  }
+
+  // convert once, write to a job specific file and rename it so that
+  // concurrent jobs never read a partially written cache
+  try
+  {
+    std::ifstream in(source);
+    const auto json = nlohmann::json::parse(in);
+    const auto cbor = nlohmann::json::to_cbor(json);
+
+    std::filesystem::create_directories(m_materialCacheDir);
+    const auto tmpfile = cached.string() + ".tmp" + std::to_string(getpid());
+    {
+      std::ofstream out(tmpfile, std::ios::binary);
+      out.write(reinterpret_cast<const char *>(cbor.data()), static_cast<std::streamsize>(cbor.size()));
+      if (!out)
+      {
+        throw std::runtime_error("cannot write " + tmpfile);
+      }
+    }
+    std::filesystem::rename(tmpfile, cached);
+  }
+  catch (const std::exception &e)
+  {
+    std::cout << "MakeActsGeometry::getCachedMaterialFile - cannot cache " << materialFile
+              << ": " << e.what() << std::endl;
+    m_materialCacheStatus = "failed";
+    return materialFile;
+  }
+
+  m_materialCacheStatus = "cold";
+  if (Verbosity() > 0)
+  {
+    std::cout << "MakeActsGeometry::getCachedMaterialFile - cached " << materialFile
+              << " as " << cached << std::endl;
+  }
+  return cached.string();
+}
+
 void MakeActsGeometry::makeGeometry(int argc, char *argv[], const std::string& responseFile, const std::string& materialFile)
 {
 
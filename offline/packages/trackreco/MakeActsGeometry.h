@@ -154,6 +154,11 @@ class MakeActsGeometry : public SubsysReco
   void setUseModuleTiltAlways(bool flag) { m_use_module_tilt_always = flag; }
   void setUseNewSiliconRotationOrder(bool flag) { m_use_new_silicon_rotation_order = flag; }
 
+  /// Directory in which the json material map is cached as binary (cbor).
+  /// The cache file is keyed by the source file and a format version; an
+  /// empty directory (default) disables the cache
+  void setMaterialCacheDir(const std::string &dir) { m_materialCacheDir = dir; }
+
 private:
   /// Main function to build all acts geometry for use in the fitting modules
   int buildAllGeometry(PHCompositeNode *topNode);
@@ -179,6 +184,10 @@ private:
   void setMaterialResponseFile(std::string &responseFile,
                                std::string &materialFile);
 
+  /// Returns the binary cache of a json material map, creating it if
+  /// needed. Falls back to the json file if the cache cannot be written
+  std::string getCachedMaterialFile(const std::string &materialFile);
+
   /// Get hitsetkey from TGeoNode for each detector geometry
   void getInttKeyFromNode(TGeoNode *gnode);
   void getMvtxKeyFromNode(TGeoNode *gnode);
@@ -303,6 +312,10 @@ private:
 
   bool m_use_module_tilt_always = false;
   bool m_use_new_silicon_rotation_order = false;
+
+  /// binary material map cache
+  std::string m_materialCacheDir;
+  std::string m_materialCacheStatus = "off";
 };
 
 #endif
@@ -210,9 +210,20 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(
 
   Acts::GeometryContext transient_geocontext{transformMapTransient};
 
+  // parametrized errors of all clusters of the track in one call
+  std::vector<TrkrCluster*> clusters;
+  clusters.reserve(cluster_vec.size());
+  for (const auto& cluskey : cluster_vec)
+  {
+    clusters.push_back(clusterContainer->findCluster(cluskey));
+  }
+  std::vector<ClusterErrorPara::error_t> cluster_errors;
+  ClusterErrorPara::get_clusterv5_modified_errors(clusters, cluster_vec, cluster_errors);
+
   // loop over cluster_vec and make source links
-  for (auto& cluskey : cluster_vec)
+  for (size_t i = 0; i < cluster_vec.size(); ++i)
   {
+    const auto& cluskey = cluster_vec[i];
     if (m_ignoreLayer.contains(TrkrDefs::getLayer(cluskey)))
     {
       if (m_verbosity > 3)
@@ -224,7 +235,7 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(
     }
 
     // get local coordinates (TPC time needs conversion to cm)
-    auto* cluster = clusterContainer->findCluster(cluskey);
+    auto* cluster = clusters[i];
     if (TrkrDefs::getTrkrId(cluskey) == TrkrDefs::TrkrId::tpcId)
     {
       if (cluster->getEdge() > m_cluster_edge_rejection)
@@ -245,9 +256,7 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(
     Acts::ActsSquareMatrix<2> cov = Acts::ActsSquareMatrix<2>::Zero();
 
     // get errors
-    Acts::Vector3 global = tGeometry->getGlobalPosition(cluskey, cluster);
-    double clusRadius = sqrt(global[0] * global[0] + global[1] * global[1]);
-    auto para_errors = ClusterErrorPara::get_clusterv5_modified_error(cluster, clusRadius, cluskey);
+    const auto& para_errors = cluster_errors[i];
     cov(Acts::eBoundLoc0, Acts::eBoundLoc0) = para_errors.first * Acts::UnitConstants::cm2;
     cov(Acts::eBoundLoc0, Acts::eBoundLoc1) = 0;
     cov(Acts::eBoundLoc1, Acts::eBoundLoc0) = 0;
@@ -432,9 +441,23 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
     std::cout << "Cluster global positions after mover puts them on readout surface:" << std::endl;
   }
 
+  // parametrized errors of all clusters of the track in one call
+  std::vector<TrkrDefs::cluskey> cluster_keys;
+  std::vector<TrkrCluster*> clusters;
+  cluster_keys.reserve(global_moved.size());
+  clusters.reserve(global_moved.size());
+  for (const auto& moved : global_moved)
+  {
+    cluster_keys.push_back(moved.first);
+    clusters.push_back(clusterContainer->findCluster(moved.first));
+  }
+  std::vector<ClusterErrorPara::error_t> cluster_errors;
+  ClusterErrorPara::get_clusterv5_modified_errors(clusters, cluster_keys, cluster_errors);
+
   // loop over global positions returned by cluster mover
-  for (auto&& [cluskey, global] : global_moved)
+  for (size_t i = 0; i < global_moved.size(); ++i)
   {
+    auto& [cluskey, global] = global_moved[i];
     // std::cout << "Global moved: " << global.x() << "  " <<  global.y() << "  " << global.z() << std::endl;
 
     if (m_ignoreLayer.contains(TrkrDefs::getLayer(cluskey)))
@@ -447,7 +470,7 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
       continue;
     }
 
-    auto* cluster = clusterContainer->findCluster(cluskey);
+    auto* cluster = clusters[i];
     Surface surf = tGeometry->maps().getSurface(cluskey, cluster);
     if (std::isnan(global.x()) || std::isnan(global.y()))
     {
@@ -532,8 +555,7 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
 
     Acts::ActsSquareMatrix<2> cov = Acts::ActsSquareMatrix<2>::Zero();
 
-    double clusRadius = sqrt(global[0] * global[0] + global[1] * global[1]);
-    auto para_errors = ClusterErrorPara::get_clusterv5_modified_error(cluster, clusRadius, cluskey);
+    const auto& para_errors = cluster_errors[i];
     cov(Acts::eBoundLoc0, Acts::eBoundLoc0) = para_errors.first * Acts::UnitConstants::cm2;
     cov(Acts::eBoundLoc0, Acts::eBoundLoc1) = 0;
     cov(Acts::eBoundLoc1, Acts::eBoundLoc0) = 0;
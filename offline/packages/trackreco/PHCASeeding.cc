@@ -47,6 +47,8 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
@@ -114,6 +116,13 @@ namespace std
 // anonymous namespace for local functions
 namespace
 {
+#if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_) || defined(_PHCASEEDING_CHAIN_FORKS_)
+  // diagnostic ntuples are not thread safe. Run single threaded when they are filled
+  constexpr bool allow_parallel = false;
+#else
+  constexpr bool allow_parallel = true;
+#endif
+
   // square
   template <class T>
   inline constexpr T square(const T& x)
@@ -288,8 +297,11 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
 {
   // Fill _rtree with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
   // Note that layer is only used for a cout statement
+  // This is called concurrently for different layers, and must not modify shared state
   int n_dupli = 0;
   std::vector<coordKey> coords;
+  coords.reserve(ckeys.size());
+  std::vector<pointKey> testduplicate;
   _rtree.clear();
   /* _rtree.reserve(ckeys.size()); */
   for (const auto& ckey : ckeys)
@@ -302,7 +314,7 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
       /* int layer = TrkrDefs::getLayer(ckey); */
       std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
     }
-    std::vector<pointKey> testduplicate;
+    testduplicate.clear();
     QueryTree(_rtree, clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, testduplicate);
     if (!testduplicate.empty())
     {
@@ -310,19 +322,13 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
       continue;
     }
     coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
-    t_fill->restart();
     _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
-    t_fill->stop();
   }
   if (Verbosity() > 5)
   {
     std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
   }
   if (Verbosity() > 3)
-  {
-    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
-  }
-  if (Verbosity() > 3)
   {
     std::cout << "number of duplicates : " << n_dupli << std::endl;
   }
@@ -404,46 +410,40 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   keyLinks startLinks;        // bilinks at start of chains
   keyLinkPerLayer bodyLinks;  //  bilinks to build chains
                               //
-  double cluster_find_time = 0;
-  double rtree_query_time = 0;
-  double transform_time = 0;
-  double compute_best_angle_time = 0;
-  double set_insert_time = 0;
-
-  // there are three coord_array (only the current layer is used at a time,
-  // but it is filled the same time as the _rtrees, which are used two at
-  // a time -- the prior padplane row and the next padplain row
-  std::array<std::vector<coordKey>, 3> coord_arr;
-  std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
-  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
+  double fill_time = 0;
+  double link_search_time = 0;
+  double bilink_time = 0;
 
   // iterate from outer to inner layers
   const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
   const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
 
-  // fill the current and prior row coord and ttrees for the first iteration
-  int _index_above = (outer_index + 1) % 3;
-  int _index_current = (outer_index) % 3;
-  coord_arr[_index_above] = FillTree(_rtrees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1);
-  coord_arr[_index_current] = FillTree(_rtrees[_index_current], ckeys[outer_index], globalPositions, outer_index);
+  // fill one rtree (and coord array) per pad row, in parallel.
+  // Each tree is filled with the same cluster sequence as in the serial algorithm,
+  // so that queries return the same clusters in the same order, independently of the number of threads
+  std::array<std::vector<coordKey>, _NLAYERS_TPC> coord_arr;
+  t_seed->restart();
+#pragma omp parallel for schedule(dynamic) if (allow_parallel)
+  for (int layer_index = inner_index - 1; layer_index <= outer_index + 1; ++layer_index)
+  {
+    coord_arr[layer_index] = FillTree(_rtrees[layer_index], ckeys[layer_index], globalPositions, layer_index);
+  }
+  t_seed->stop();
+  fill_time += t_seed->elapsed();
+
+  std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
+  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
+
+  // links found for each cluster of the current row
+  std::vector<LinkCandidates> candidates;
 
   for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
   {
-    // these lines of code will rotates through all three _rtree's in the array,
-    // where the old lower becomes the new middle, the old middle the new upper,
-    // and the old upper drops out and that _rtree is filled with the new lower
     const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
-    int index_above = (layer_index + 1) % 3;
-    int index_current = (layer_index) % 3;
-    int index_below = (layer_index - 1) % 3;
-
-    coord_arr[index_below] = FillTree(_rtrees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1);
 
-    // NO DUPLICATES FOUND IN COORD_ARR
-
-    auto& _rtree_above = _rtrees[index_above];
-    const std::vector<coordKey>& coord = coord_arr[index_current];
-    auto& _rtree_below = _rtrees[index_below];
+    auto& _rtree_above = _rtrees[layer_index + 1];
+    const std::vector<coordKey>& coord = coord_arr[layer_index];
+    auto& _rtree_below = _rtrees[layer_index - 1];
 
     auto& curr_downlinks = previous_downlinks_arr[layer_index % 2];
     auto& last_downlinks = previous_downlinks_arr[(layer_index + 1) % 2];
@@ -455,121 +455,136 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
     curr_bottom_of_bilink.clear();
 
     // For all the clusters in coord, find nearest neighbors in the
-    // above and below layers and make links
-    // Any link to an above node which matches the same clusters
-    // on the previous iteration (to a "below node") becomes a "bilink"
-    // Check if this bilink links to a prior bilink or not
+    // above and below layers and make links.
+    // Clusters are ordered by hitset, so that contiguous chunks of coord
+    // correspond to TPC sectors, which are distributed among threads
+    t_seed->restart();
+    candidates.clear();
+    candidates.resize(coord.size());
 
-    std::vector<keyLink> aboveLinks;
-    for (const auto& StartCluster : coord)
+#pragma omp parallel if (allow_parallel)
     {
-      double StartPhi = StartCluster.first[0];
-      const auto& globalpos = globalPositions.at(StartCluster.second);
-      double StartX = globalpos(0);
-      double StartY = globalpos(1);
-      double StartZ = globalpos(2);
-      t_seed->stop();
-      cluster_find_time += t_seed->elapsed();
-      t_seed->restart();
-      LogDebug(" starting cluster:" << std::endl);
-      LogDebug(" z: " << StartZ << std::endl);
-      LogDebug(" phi: " << StartPhi << std::endl);
-
+      // scratch buffers, reused from one starting cluster to the next
       std::vector<pointKey> ClustersAbove;
       std::vector<pointKey> ClustersBelow;
-
-      QueryTree(_rtree_below,
-                StartPhi - dphi_per_layer[LAYER],
-                StartZ - dZ_per_layer[LAYER],
-                StartPhi + dphi_per_layer[LAYER],
-                StartZ + dZ_per_layer[LAYER],
-                ClustersBelow);
-
-      FillTupWinLink(_rtree_below, StartCluster, globalPositions);
-
-      QueryTree(_rtree_above,
-                StartPhi - dphi_per_layer[LAYER + 1],
-                StartZ - dZ_per_layer[LAYER + 1],
-                StartPhi + dphi_per_layer[LAYER + 1],
-                StartZ + dZ_per_layer[LAYER + 1],
-                ClustersAbove);
-
-      t_seed->stop();
-      rtree_query_time += t_seed->elapsed();
-      t_seed->restart();
-      LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
-      LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
       std::vector<std::array<double, 3>> delta_below;
       std::vector<std::array<double, 3>> delta_above;
-      delta_below.clear();
-      delta_above.clear();
-      delta_below.resize(ClustersBelow.size());
-      delta_above.resize(ClustersAbove.size());
-      // calculate (delta_z_, delta_phi) vector for each neighboring cluster
-
-      std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
-                     [&](pointKey BelowCandidate)
-                     {
-          const auto& belowpos = globalPositions.at(BelowCandidate.second);
-          return std::array<double,3>{belowpos(0)-StartX,
-          belowpos(1)-StartY,
-          belowpos(2)-StartZ}; });
-
-      std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
-                     [&](pointKey AboveCandidate)
-                     {
-          const auto& abovepos = globalPositions.at(AboveCandidate.second);
-          return std::array<double,3>{abovepos(0)-StartX,
-          abovepos(1)-StartY,
-          abovepos(2)-StartZ}; });
-      t_seed->stop();
-      transform_time += t_seed->elapsed();
-      t_seed->restart();
-
-      // find the three clusters closest to a straight line
-      // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
-      // double minSumLengths = 1e9;
-      std::unordered_set<TrkrDefs::cluskey> bestAboveClusters;
-      for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
+
+#pragma omp for schedule(dynamic, 32)
+      for (size_t icluster = 0; icluster < coord.size(); ++icluster)
       {
-        for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
+        const auto& StartCluster = coord[icluster];
+        auto& candidate = candidates[icluster];
+
+        double StartPhi = StartCluster.first[0];
+        const auto& globalpos = globalPositions.at(StartCluster.second);
+        double StartX = globalpos(0);
+        double StartY = globalpos(1);
+        double StartZ = globalpos(2);
+        LogDebug(" starting cluster:" << std::endl);
+        LogDebug(" z: " << StartZ << std::endl);
+        LogDebug(" phi: " << StartPhi << std::endl);
+
+        ClustersAbove.clear();
+        ClustersBelow.clear();
+
+        QueryTree(_rtree_below,
+                  StartPhi - dphi_per_layer[LAYER],
+                  StartZ - dZ_per_layer[LAYER],
+                  StartPhi + dphi_per_layer[LAYER],
+                  StartZ + dZ_per_layer[LAYER],
+                  ClustersBelow);
+
+        FillTupWinLink(_rtree_below, StartCluster, globalPositions);
+
+        QueryTree(_rtree_above,
+                  StartPhi - dphi_per_layer[LAYER + 1],
+                  StartZ - dZ_per_layer[LAYER + 1],
+                  StartPhi + dphi_per_layer[LAYER + 1],
+                  StartZ + dZ_per_layer[LAYER + 1],
+                  ClustersAbove);
+
+        LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
+        LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
+        delta_below.resize(ClustersBelow.size());
+        delta_above.resize(ClustersAbove.size());
+        // calculate (delta_z_, delta_phi) vector for each neighboring cluster
+
+        std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
+                       [&](const pointKey& BelowCandidate)
+                       {
+            const auto& belowpos = globalPositions.at(BelowCandidate.second);
+            return std::array<double,3>{belowpos(0)-StartX,
+            belowpos(1)-StartY,
+            belowpos(2)-StartZ}; });
+
+        std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
+                       [&](const pointKey& AboveCandidate)
+                       {
+            const auto& abovepos = globalPositions.at(AboveCandidate.second);
+            return std::array<double,3>{abovepos(0)-StartX,
+            abovepos(1)-StartY,
+            abovepos(2)-StartZ}; });
+
+        // find the three clusters closest to a straight line
+        // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
+        // note: the set is re-created for each cluster, so that its iteration order
+        // (which defines the order of the output links) matches the serial algorithm
+        std::unordered_set<TrkrDefs::cluskey> bestAboveClusters;
+        for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
         {
-          // test for straightness of line just by taking the cos(angle) between the two vectors
-          // use the sq as it is much faster than sqrt
-          const auto& A = delta_below[iBelow];
-          const auto& B = delta_above[iAbove];
-          // calculate normalized dot product between two vectors
-          const double A_len_sq = (A[0] * A[0] + A[1] * A[1] + A[2] * A[2]);
-          const double B_len_sq = (B[0] * B[0] + B[1] * B[1] + B[2] * B[2]);
-          const double dot_prod = (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
-          const double cos_angle_sq = dot_prod * dot_prod / A_len_sq / B_len_sq;  // also same as cos(angle), where angle is between two vectors
-          FillTupWinCosAngle(ClustersAbove[iAbove].second, StartCluster.second, ClustersBelow[iBelow].second, globalPositions, cos_angle_sq, (dot_prod < 0.));
-
-          constexpr double maxCosPlaneAngle = -0.95;
-          constexpr double maxCosPlaneAngle_sq = maxCosPlaneAngle * maxCosPlaneAngle;
-          if ((dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
+          for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
           {
-            // maxCosPlaneAngle = cos(angle);
-            // minSumLengths = belowLength+aboveLength;
-            curr_downlinks.insert({StartCluster.second, ClustersBelow[iBelow].second});
-            bestAboveClusters.insert(ClustersAbove[iAbove].second);
-
-            // fill the tuples for plotting
-            fill_tuple(_tupclus_links, 0, StartCluster.second, globalPositions.at(StartCluster.second));
-            fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
-            fill_tuple(_tupclus_links, 1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
+            // test for straightness of line just by taking the cos(angle) between the two vectors
+            // use the sq as it is much faster than sqrt
+            const auto& A = delta_below[iBelow];
+            const auto& B = delta_above[iAbove];
+            // calculate normalized dot product between two vectors
+            const double A_len_sq = (A[0] * A[0] + A[1] * A[1] + A[2] * A[2]);
+            const double B_len_sq = (B[0] * B[0] + B[1] * B[1] + B[2] * B[2]);
+            const double dot_prod = (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
+            const double cos_angle_sq = dot_prod * dot_prod / A_len_sq / B_len_sq;  // also same as cos(angle), where angle is between two vectors
+            FillTupWinCosAngle(ClustersAbove[iAbove].second, StartCluster.second, ClustersBelow[iBelow].second, globalPositions, cos_angle_sq, (dot_prod < 0.));
+
+            constexpr double maxCosPlaneAngle = -0.95;
+            constexpr double maxCosPlaneAngle_sq = maxCosPlaneAngle * maxCosPlaneAngle;
+            if ((dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
+            {
+              candidate.downlinks.emplace_back(StartCluster.second, ClustersBelow[iBelow].second);
+              bestAboveClusters.insert(ClustersAbove[iAbove].second);
+
+              // fill the tuples for plotting
+              fill_tuple(_tupclus_links, 0, StartCluster.second, globalPositions.at(StartCluster.second));
+              fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
+              fill_tuple(_tupclus_links, 1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
+            }
           }
         }
-      }
-      // NOTE:
-      // There was some old commented-out code here for allowing layers to be skipped. This
-      // may be useful in the future. This chunk of code has been moved towards the
-      // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
-      t_seed->stop();
-      compute_best_angle_time += t_seed->elapsed();
-      t_seed->restart();
-
-      for (auto cluster : bestAboveClusters)
+        // NOTE:
+        // There was some old commented-out code here for allowing layers to be skipped. This
+        // may be useful in the future. This chunk of code has been moved towards the
+        // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
+        candidate.above.assign(bestAboveClusters.begin(), bestAboveClusters.end());
+      }  // end loop over start clusters
+    }    // end parallel section
+
+    t_seed->stop();
+    link_search_time += t_seed->elapsed();
+    t_seed->restart();
+
+    // Any link to an above node which matches the same clusters
+    // on the previous iteration (to a "below node") becomes a "bilink"
+    // Check if this bilink links to a prior bilink or not.
+    // This is done serially, in cluster order, so that the links are identical to the single thread case
+    for (const auto& candidate : candidates)
+    {
+      curr_downlinks.insert(candidate.downlinks.begin(), candidate.downlinks.end());
+    }
+
+    for (size_t icluster = 0; icluster < coord.size(); ++icluster)
+    {
+      const auto& StartCluster = coord[icluster];
+      for (auto cluster : candidates[icluster].above)
       {
         keyLink uplink = std::make_pair(cluster, StartCluster.second);
 
@@ -595,20 +610,16 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
     }    // end loop over start clusters
 
     t_seed->stop();
-    set_insert_time += t_seed->elapsed();
-    t_seed->restart();
-    LogDebug(" max collinearity: " << maxCosPlaneAngle << std::endl);
+    bilink_time += t_seed->elapsed();
   }  // end loop over layers (to make links)
 
-  t_seed->stop();
   if (Verbosity() > 0)
   {
-    std::cout << "triplet forming time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
-    std::cout << "starting cluster setup: " << cluster_find_time / 1000 << " s" << std::endl;
-    std::cout << "RTree query: " << rtree_query_time / 1000 << " s" << std::endl;
-    std::cout << "Transform: " << transform_time / 1000 << " s" << std::endl;
-    std::cout << "Compute best triplet: " << compute_best_angle_time / 1000 << " s" << std::endl;
-    std::cout << "Set insert: " << set_insert_time / 1000 << " s" << std::endl;
+    std::cout << "triplet forming time: " << (fill_time + link_search_time + bilink_time) / 1000 << " s"
+              << " (threads: " << omp_get_max_threads() << ")" << std::endl;
+    std::cout << "RTree fill: " << fill_time / 1000 << " s" << std::endl;
+    std::cout << "Link search: " << link_search_time / 1000 << " s" << std::endl;
+    std::cout << "Bilink assembly: " << bilink_time / 1000 << " s" << std::endl;
   }
   t_seed->restart();
 
@@ -694,15 +705,24 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
 
   int nsplit_chains = -1;
 
-  // positions of the seed being following
-  std::array<float, 4> phi{}, R{}, Z{};
   keyLists grown_seeds;
 
   while (seeds.size() > 0)
   {
-    keyLists split_seeds{};  // to collect when using split tracks
-    for (auto& seed : seeds)
+    // seeds are grown in parallel. The split seeds and the grown seeds are stored per input seed
+    // and merged afterwards in seed order, so that the output does not depend on the number of threads
+    std::vector<keyLists> split_seeds_per_seed(seeds.size());  // to collect when using split tracks
+    std::vector<unsigned char> is_grown(seeds.size(), 0);
+
+#pragma omp parallel for schedule(dynamic, 16) if (allow_parallel)
+    for (size_t iseed = 0; iseed < seeds.size(); ++iseed)
     {
+      auto& seed = seeds[iseed];
+      auto& split_seeds = split_seeds_per_seed[iseed];
+
+      // positions of the seed being following
+      std::array<float, 4> phi{}, R{}, Z{};
+
       // grow the seed to the maximum length allowed
       bool first_link = true;
       bool done_growing = (seed.size() >= _max_clusters_per_seed);
@@ -857,16 +877,24 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
       }    // end of seed growing loop: if (!done_growing)
       if (seed.size() >= _min_clusters_per_seed)
       {
-        grown_seeds.push_back(seed);
+        is_grown[iseed] = 1;
         fill_tuple_with_seed(_tupclus_grown_seeds, seed, globalPositions);
       }
     }  // end of loop over seeds
-    seeds.clear();
-    for (const auto& seed : split_seeds)
+
+    keyLists split_seeds{};
+    for (size_t iseed = 0; iseed < seeds.size(); ++iseed)
     {
-      seeds.push_back(seed);
+      if (is_grown[iseed])
+      {
+        grown_seeds.push_back(std::move(seeds[iseed]));
+      }
+      for (auto& split_seed : split_seeds_per_seed[iseed])
+      {
+        split_seeds.push_back(std::move(split_seed));
+      }
     }
-    /* seeds = split_seeds; */
+    seeds = std::move(split_seeds);
   }  // end of looping over all seeds
 
   // old code block move to end of code under the title: "---OLD CODE 1: SKIP_LAYERS---"
@@ -966,9 +994,6 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
   }
 
   // timing
-  t_fill = std::make_unique<PHTimer>("t_fill");
-  t_fill->stop();
-
   t_seed = std::make_unique<PHTimer>("t_seed");
   t_seed->stop();
 
@@ -978,6 +1003,13 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
   t_makeseeds = std::make_unique<PHTimer>("t_makeseeds");
   t_makeseeds->stop();
 
+  // assign number of threads
+  std::cout << "PHCASeeding::Setup - m_num_threads: " << m_num_threads << std::endl;
+  if (m_num_threads >= 1)
+  {
+    omp_set_num_threads(m_num_threads);
+  }
+
   auto geom_container =
       findNode::getClass<PHG4TpcGeomContainer>(topNode, "TPCGEOMCONTAINER");
   if (!geom_container)
@@ -155,6 +155,7 @@ class PHCASeeding : public PHTrackSeeding
   void setCF4Fraction(double frac) { CF4_frac = frac; };
   void setNitrogenFraction(double frac) { N2_frac = frac; };
   void setIsobutaneFraction(double frac) { isobutane_frac = frac; };
+  void set_num_threads(int value) { m_num_threads = value; }
 
  protected:
   int Setup(PHCompositeNode* topNode) override;
@@ -212,6 +213,13 @@ class PHCASeeding : public PHTrackSeeding
   };
   std::pair<std::vector<keyLink>::iterator, std::vector<keyLink>::iterator> FindBilinks(const TrkrDefs::cluskey& key);
 
+  // links found around a given starting cluster, filled concurrently for all clusters of a layer
+  struct LinkCandidates
+  {
+    keyLinks downlinks;  // (start, below) links passing the collinearity cut, in search order
+    keyList above;       // matching clusters in the layer above
+  };
+
   /// tpc distortion correction utility class
   TpcDistortionCorrection m_distortionCorrection;
 
@@ -269,17 +277,23 @@ class PHCASeeding : public PHTrackSeeding
   TpcGlobalPositionWrapper m_globalPositionWrapper;
 
   std::unique_ptr<PHTimer> t_seed;
-  std::unique_ptr<PHTimer> t_fill;
   std::unique_ptr<PHTimer> t_makebilinks;
   std::unique_ptr<PHTimer> t_makeseeds;
-  /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
-  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, 3> _rtrees;  // need three layers at a time
+  // one tree per layer, so that all layers can be filled concurrently
+  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees;
 
   double Ne_frac = 0.00;
   double Ar_frac = 0.75;
   double CF4_frac = 0.20;
   double N2_frac = 0.00;
   double isobutane_frac = 0.05;
+
+  //! number of threads
+  /**
+   * default is 0. This corresponds to allocating as many threads as available on the host
+   * The output seeds do not depend on the number of threads
+   */
+  int m_num_threads = 0;
 };
 
 #endif
@@ -23,6 +23,7 @@
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 #include <trackbase/ActsGeometry.h>
+#include <trackbase/ClusterErrorPara.h>
 #include <trackbase/TrackFitUtils.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
@@ -98,6 +99,15 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   fitter->setFixedClusterError(1, _fixed_clus_err.at(1));
   fitter->setFixedClusterError(2, _fixed_clus_err.at(2));
 
+  if (Verbosity() > 0)
+  {
+    // check the tabulated cluster error parametrizations against their TF1s
+    ClusterErrorPara para;
+    std::cout << "PHSimpleKFProp::InitRun - cluster error tables "
+              << (para.compare_tables() ? "agree" : "DO NOT agree")
+              << " with the TF1 parametrizations" << std::endl;
+  }
+
   // properly set constField in ALICEKF, based on PHFieldConfig
   auto *const field_config = PHFieldUtility::GetFieldConfigNode(nullptr, topNode);
   if( field_config->get_field_config() == PHFieldConfig::kFieldUniform )
@@ -930,9 +940,10 @@ bool PHSimpleKFProp::PropagateStep(
     std::cout << "track state position errors: (" << txerr << ", " << tyerr << ", " << tzerr << ")" << std::endl;
   }
 
-  const double cand_xerr = sqrt(fitter->getClusterError(clusterCandidate, closest_ckey, candidate_globalpos, 0, 0));
-  const double cand_yerr = sqrt(fitter->getClusterError(clusterCandidate, closest_ckey, candidate_globalpos, 1, 1));
-  const double cand_zerr = sqrt(fitter->getClusterError(clusterCandidate, closest_ckey, candidate_globalpos, 2, 2));
+  const Eigen::Matrix3d cand_cov = fitter->getClusterCovariance(clusterCandidate, closest_ckey, candidate_globalpos);
+  const double cand_xerr = sqrt(cand_cov(0, 0));
+  const double cand_yerr = sqrt(cand_cov(1, 1));
+  const double cand_zerr = sqrt(cand_cov(2, 2));
 
   if (Verbosity() > 1)
   {
@@ -954,7 +965,7 @@ bool PHSimpleKFProp::PropagateStep(
     if (std::find(ckeys.begin(), ckeys.end(), closest_ckey) == ckeys.end())
     {
       const double cand_Y = -cand_x * std::sin(current_phi) + cand_y * std::cos(current_phi);
-      const double cand_xycov2 = fitter->getClusterError(clusterCandidate, closest_ckey, candidate_globalpos, 0, 1);
+      const double cand_xycov2 = cand_cov(0, 1);
       const double cand_Yerr2 = cand_xerr * cand_xerr * sin(current_phi) * sin(current_phi) + cand_xycov2 * sin(current_phi) * cos(current_phi) + cand_yerr * cand_yerr * cos(current_phi) * cos(current_phi);
       const double cand_zerr2 = cand_zerr * cand_zerr;
 
@@ -35,6 +35,7 @@
 #include <TNtuple.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -74,22 +75,9 @@ CaloTriggerEmulator::CaloTriggerEmulator(const std::string &name)
     m_l1_slewing_table[i] = (i) & 0x3ffU;
   }
 
-  for (int i = 0; i < 24576; i++)
-  {
-    unsigned int key = TowerInfoDefs::encode_emcal(i);
-    h_emcal_lut[key] = nullptr;
-  }
-
-  for (int i = 0; i < 1536; i++)
-  {
-    unsigned int key = TowerInfoDefs::encode_hcal(i);
-    h_hcalin_lut[key] = nullptr;
-  }
-  for (int i = 0; i < 1536; i++)
-  {
-    unsigned int key = TowerInfoDefs::encode_hcal(i);
-    h_hcalout_lut[key] = nullptr;
-  }
+  m_peak_sub_ped_emcal.resize(24576);
+  m_peak_sub_ped_hcalin.resize(1536);
+  m_peak_sub_ped_hcalout.resize(1536);
 
   // Set HCAL LL1 lookup table for the cosmic coincidence trigger.
   if (m_triggerid == TriggerDefs::TriggerId::cosmic_coinTId)
@@ -454,12 +442,7 @@ int CaloTriggerEmulator::Download_Calibrations()
     {
       cdbttree_emcal->LoadCalibrations();
 
-      for (int i = 0; i < 24576; i++)
-      {
-        std::string histoname = "h_emcal_lut_" + std::to_string(i);
-        unsigned int key = TowerInfoDefs::encode_emcal(i);
-        h_emcal_lut[key] = cdbttree_emcal->getHisto(histoname);
-      }
+      flatten_lut(cdbttree_emcal, "h_emcal_lut_", 24576, m_lut_emcal);
     }
   }
   if (m_do_hcalin && !m_default_lut_hcalin)
@@ -485,12 +468,7 @@ int CaloTriggerEmulator::Download_Calibrations()
     {
       cdbttree_hcalin->LoadCalibrations();
 
-      for (int i = 0; i < 1536; i++)
-      {
-        std::string histoname = "h_hcalin_lut_" + std::to_string(i);
-        unsigned int key = TowerInfoDefs::encode_hcal(i);
-        h_hcalin_lut[key] = cdbttree_hcalin->getHisto(histoname);
-      }
+      flatten_lut(cdbttree_hcalin, "h_hcalin_lut_", 1536, m_lut_hcalin);
     }
   }
   if (m_do_hcalout && !m_default_lut_hcalout)
@@ -516,12 +494,7 @@ int CaloTriggerEmulator::Download_Calibrations()
     {
       cdbttree_hcalout->LoadCalibrations();
 
-      for (int i = 0; i < 1536; i++)
-      {
-        std::string histoname = "h_hcalout_lut_" + std::to_string(i);
-        unsigned int key = TowerInfoDefs::encode_hcal(i);
-        h_hcalout_lut[key] = cdbttree_hcalout->getHisto(histoname);
-      }
+      flatten_lut(cdbttree_hcalout, "h_hcalout_lut_", 1536, m_lut_hcalout);
     }
   }
   return 0;
@@ -534,6 +507,7 @@ int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
     std::cout << __FUNCTION__ << ": event " << m_nevent << std::endl;
   }
 
+  const auto start = std::chrono::steady_clock::now();
   // Get all nodes needed fo
   GetNodes(topNode);
 
@@ -564,6 +538,8 @@ int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
   }
 
   m_nevent++;
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  m_process_time += elapsed.count();
 
   if (Verbosity() >= 2)
   {
@@ -576,10 +552,14 @@ int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
 // RESET event procedure that takes all variables to 0 and clears the primitives.
 int CaloTriggerEmulator::ResetEvent(PHCompositeNode * /*topNode*/)
 {
-  // here, the peak minus pedestal map is cleanly disposed of
-  m_peak_sub_ped_emcal.clear();
-  m_peak_sub_ped_hcalin.clear();
-  m_peak_sub_ped_hcalout.clear();
+  // here, the peak minus pedestal samples are cleanly disposed of
+  for (auto *table : {&m_peak_sub_ped_emcal, &m_peak_sub_ped_hcalin, &m_peak_sub_ped_hcalout})
+  {
+    for (auto &samples : *table)
+    {
+      samples.clear();
+    }
+  }
 
   return 0;
 }
@@ -642,8 +622,7 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
                 {
                   v_peak_sub_ped.push_back(0);
                 }
-                unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-                m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+                set_peak_sub_ped(m_peak_sub_ped_emcal, iwave, v_peak_sub_ped);
                 iwave++;
               }
             }
@@ -680,8 +659,7 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
               v_peak_sub_ped.push_back(sub);
             }
           }
-          unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-          m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+          set_peak_sub_ped(m_peak_sub_ped_emcal, iwave, v_peak_sub_ped);
           iwave++;
         }
         if (nchannels < 192 && !(adc_skip_mask < 4))
@@ -693,8 +671,7 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
             {
               v_peak_sub_ped.push_back(0);
             }
-            unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-            m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+            set_peak_sub_ped(m_peak_sub_ped_emcal, iwave, v_peak_sub_ped);
             iwave++;
           }
         }
@@ -759,8 +736,7 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
               v_peak_sub_ped.push_back(sub);
             }
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
+          set_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, v_peak_sub_ped);
           iwave++;
         }
       }
@@ -824,8 +800,7 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
               v_peak_sub_ped.push_back(sub);
             }
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
+          set_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, v_peak_sub_ped);
           iwave++;
         }
       }
@@ -901,8 +876,7 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
                 {
                   v_peak_sub_ped.push_back(0);
                 }
-                unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-                m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+                set_peak_sub_ped(m_peak_sub_ped_emcal, iwave, v_peak_sub_ped);
                 iwave++;
               }
               continue;
@@ -940,8 +914,7 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
               v_peak_sub_ped.push_back(sub);
             }
           }
-          unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-          m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+          set_peak_sub_ped(m_peak_sub_ped_emcal, iwave, v_peak_sub_ped);
           iwave++;
         }
       }
@@ -997,8 +970,7 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
               v_peak_sub_ped.push_back(sub);
             }
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
+          set_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, v_peak_sub_ped);
           iwave++;
         }
       }
@@ -1054,8 +1026,7 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
               v_peak_sub_ped.push_back(sub);
             }
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
+          set_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, v_peak_sub_ped);
           iwave++;
         }
       }
@@ -1097,7 +1068,6 @@ int CaloTriggerEmulator::process_sim()
     {
       std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_emcal->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_emcal(iwave);
       if (tower->get_isZS())
       {
         for (int i = sample_start; i < sample_end; i++)
@@ -1130,7 +1100,7 @@ int CaloTriggerEmulator::process_sim()
         }
       }
       // save in global.
-      m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+      set_peak_sub_ped(m_peak_sub_ped_emcal, iwave, v_peak_sub_ped);
     }
   }
   if (m_do_hcalout)
@@ -1151,7 +1121,6 @@ int CaloTriggerEmulator::process_sim()
     {
       std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_hcalout->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_hcal(iwave);
       if (tower->get_isZS())
       {
         for (int i = sample_start; i < sample_end; i++)
@@ -1184,7 +1153,7 @@ int CaloTriggerEmulator::process_sim()
         }
       }
       // save in global.
-      m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
+      set_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, v_peak_sub_ped);
     }
   }
   if (m_do_hcalin)
@@ -1209,7 +1178,6 @@ int CaloTriggerEmulator::process_sim()
     {
       std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_hcalin->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_hcal(iwave);
       if (tower->get_isZS())
       {
         for (int i = sample_start; i < sample_end; i++)
@@ -1242,7 +1210,7 @@ int CaloTriggerEmulator::process_sim()
         }
       }
       // save in global.
-      m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
+      set_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, v_peak_sub_ped);
     }
   }
 
@@ -1277,6 +1245,11 @@ int CaloTriggerEmulator::process_primitives()
 
     // get the number of primitives needed to process
     m_n_primitives = m_prim_map[TriggerDefs::DetectorId::emcalDId];
+    if (m_sum_channels_emcal.size() != static_cast<size_t>(m_n_primitives * m_n_sums * 4))
+    {
+      fill_sum_channels(TriggerDefs::GetDetectorId("EMCAL"), m_n_primitives, m_sum_channels_emcal);
+    }
+    const bool default_lut = m_default_lut_emcal || m_lut_emcal.empty();
     for (i = 0; i < m_n_primitives; i++, ip++)
     {
       if (Verbosity())
@@ -1304,6 +1277,7 @@ int CaloTriggerEmulator::process_primitives()
 
         // check to mask channel (if fiber masked, automatically mask the channel)
         bool mask_channel = mask || CheckChannelMasks(sumkey);
+        const unsigned int *channels = &m_sum_channels_emcal[((ip * m_n_sums) + isum) * 4];
         for (int is = 0; is < nsample; is++)
         {
           sum = 0;
@@ -1315,18 +1289,17 @@ int CaloTriggerEmulator::process_primitives()
             for (int j = 0; j < 4; j++)
             {
               // unsigned int iwave = 64*ip + isum*4 + j;
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("EMCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_emcal[key].at(is) >> 4U) & 0x3ffU;
+              unsigned int channel = channels[j];
+              unsigned int lut_input = (m_peak_sub_ped_emcal[channel].at(is) >> 4U) & 0x3ffU;
 
               // shift before the sum
-              if (m_default_lut_emcal)
+              if (default_lut)
               {
                 tmp = (m_l1_adc_table[lut_input] >> 2U);
               }
               else
               {
-                unsigned int lut_output = ((unsigned int) h_emcal_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
+                tmp = m_lut_emcal[(channel * 1024) + lut_input];
               }
               temp_sum += (tmp & 0xffU);
             }
@@ -1359,6 +1332,11 @@ int CaloTriggerEmulator::process_primitives()
     ip = 0;
 
     m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcaloutDId];
+    if (m_sum_channels_hcal.size() != static_cast<size_t>(m_n_primitives * m_n_sums * 4))
+    {
+      fill_sum_channels(TriggerDefs::GetDetectorId("HCAL"), m_n_primitives, m_sum_channels_hcal);
+    }
+    const bool default_lut = m_default_lut_hcalout || m_lut_hcalout.empty();
 
     for (i = 0; i < m_n_primitives; i++, ip++)
     {
@@ -1371,6 +1349,7 @@ int CaloTriggerEmulator::process_primitives()
         TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip, isum);
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
         mask |= CheckChannelMasks(sumkey);
+        const unsigned int *channels = &m_sum_channels_hcal[((ip * m_n_sums) + isum) * 4];
         for (int is = 0; is < nsample; is++)
         {
           sum = 0;
@@ -1379,17 +1358,16 @@ int CaloTriggerEmulator::process_primitives()
           {
             for (int j = 0; j < 4; j++)
             {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalout[key].at(is) >> 4U) & 0x3ffU;
+              unsigned int channel = channels[j];
+              unsigned int lut_input = (m_peak_sub_ped_hcalout[channel].at(is) >> 4U) & 0x3ffU;
               unsigned int tmp = 0;
-              if (m_default_lut_hcalout)
+              if (default_lut)
               {
                 tmp = (m_l1_adc_table[lut_input] >> 2U);
               }
               else
               {
-                unsigned int lut_output = ((unsigned int) h_hcalout_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
+                tmp = m_lut_hcalout[(channel * 1024) + lut_input];
               }
               temp_sum += (tmp & 0xffU);
             }
@@ -1415,6 +1393,11 @@ int CaloTriggerEmulator::process_primitives()
     }
 
     m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcalinDId];
+    if (m_sum_channels_hcal.size() != static_cast<size_t>(m_n_primitives * m_n_sums * 4))
+    {
+      fill_sum_channels(TriggerDefs::GetDetectorId("HCAL"), m_n_primitives, m_sum_channels_hcal);
+    }
+    const bool default_lut = m_default_lut_hcalin || m_lut_hcalin.empty();
 
     for (i = 0; i < m_n_primitives; i++, ip++)
     {
@@ -1427,6 +1410,7 @@ int CaloTriggerEmulator::process_primitives()
         TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip, isum);
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
         mask |= CheckChannelMasks(sumkey);
+        const unsigned int *channels = &m_sum_channels_hcal[((ip * m_n_sums) + isum) * 4];
         for (int is = 0; is < nsample; is++)
         {
           sum = 0;
@@ -1435,17 +1419,16 @@ int CaloTriggerEmulator::process_primitives()
           {
             for (int j = 0; j < 4; j++)
             {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalin[key].at(is) >> 4U) & 0x3ffU;
+              unsigned int channel = channels[j];
+              unsigned int lut_input = (m_peak_sub_ped_hcalin[channel].at(is) >> 4U) & 0x3ffU;
               unsigned int tmp = 0;
-              if (m_default_lut_hcalin)
+              if (default_lut)
               {
                 tmp = (m_l1_adc_table[lut_input] >> 2U);
               }
               else
               {
-                unsigned int lut_output = ((unsigned int) h_hcalin_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
+                tmp = m_lut_hcalin[(channel * 1024) + lut_input];
               }
               temp_sum += (tmp & 0x3ffU);
             }
@@ -1891,17 +1874,14 @@ int CaloTriggerEmulator::process_trigger()
     // Make the jet primitives
     m_triggerid = TriggerDefs::TriggerId::jetTId;
     std::vector<unsigned int> *trig_bits = m_ll1out_jet->GetTriggerBits();
-    std::vector<unsigned int> jet_map[32][9]{};
-    for (auto &ie : jet_map)
-    {
-      for (auto &ip : ie)
-      {
-        for (int is = 0; is < nsample; is++)
-        {
-          ip.push_back(0);
-        }
-      }
-    }
+
+    // the 8x8 sums go on a dense (phi, eta, sample) grid, a jet patch is the
+    // 4x4 window of sums starting at its (phi, eta), wrapping around in phi
+    const int njetphi = 32;
+    const int nsumeta = 12;
+    const int njeteta = nsumeta - 3;
+    m_jet_grid.assign(njetphi * nsumeta * nsample, 0);
+    m_jet_eta_window.assign(njetphi * njeteta * nsample, 0);
 
     if (!m_primitives_jet)
     {
@@ -1923,7 +1903,6 @@ int CaloTriggerEmulator::process_trigger()
       {
         TriggerDefs::TriggerSumKey sumkey = (*iter_sum).first;
 
-        int i = 0;
         int sum_phi = static_cast<int>((TriggerDefs::getPrimitivePhiId_from_TriggerSumKey(sumkey) * 2) + TriggerDefs::getSumPhiId(sumkey));
         int sum_eta = static_cast<int>(TriggerDefs::getSumEtaId(sumkey));
         if (Verbosity() >= 2)
@@ -1931,29 +1910,48 @@ int CaloTriggerEmulator::process_trigger()
           std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << sum_phi << " " << sum_eta << std::endl;
         }
 
-        for (unsigned int &it_s : *(iter_sum->second))
+        // sums beyond the last patch do not contribute to any
+        if (sum_phi >= njetphi || sum_eta >= nsumeta)
+        {
+          continue;
+        }
+        unsigned int *cell = &m_jet_grid[((sum_phi * nsumeta) + sum_eta) * nsample];
+        const std::vector<unsigned int> &samples = *(iter_sum->second);
+        const int nfilled = std::min(nsample, static_cast<int>(samples.size()));
+        for (int is = 0; is < nfilled; is++)
+        {
+          cell[is] += samples[is];
+        }
+      }
+    }
+
+    // sliding window sums, first over eta then over phi. The loops over
+    // the samples are contiguous and independent so they vectorize
+    for (int iphi = 0; iphi < njetphi; iphi++)
+    {
+      for (int ijeta = 0; ijeta < njeteta; ijeta++)
+      {
+        unsigned int *window = &m_jet_eta_window[((iphi * njeteta) + ijeta) * nsample];
+        for (int deta = 0; deta < 4; deta++)
         {
-          for (int ijeta = (sum_eta <= 3 ? 0 : sum_eta - 3); ijeta <= (sum_eta > 8 ? 8 : sum_eta); ijeta++)
+          const unsigned int *cell = &m_jet_grid[((iphi * nsumeta) + ijeta + deta) * nsample];
+          for (int is = 0; is < nsample; is++)
           {
-            for (int ijphi = sum_phi - 3; ijphi <= sum_phi; ijphi++)
-            {
-              int iphi = (ijphi < 0 ? 32 + ijphi : ijphi);
-              jet_map[iphi][ijeta].at(i) += it_s;
-            }
+            window[is] += cell[is];
           }
-          i++;
         }
       }
     }
+    std::vector<unsigned int> jet_patch(nsample);
     if (Verbosity() >= 2)
     {
       std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger" << std::endl;
     }
 
     int pass = 0;
-    for (int ijphi = 0; ijphi < 32; ijphi++)
+    for (int ijphi = 0; ijphi < njetphi; ijphi++)
     {
-      for (int ijeta = 0; ijeta < 9; ijeta++)
+      for (int ijeta = 0; ijeta < njeteta; ijeta++)
       {
         if (Verbosity() >= 2)
         {
@@ -1962,6 +1960,15 @@ int CaloTriggerEmulator::process_trigger()
 
         unsigned int sk = ((unsigned int) ijphi & 0xffffU) + (((unsigned int) ijeta & 0xffffU) << 16U);
         std::vector<unsigned int> *sum = m_ll1out_jet->get_word(sk);
+        std::fill(jet_patch.begin(), jet_patch.end(), 0);
+        for (int dphi = 0; dphi < 4; dphi++)
+        {
+          const unsigned int *window = &m_jet_eta_window[((((ijphi + dphi) % njetphi) * njeteta) + ijeta) * nsample];
+          for (int is = 0; is < nsample; is++)
+          {
+            jet_patch[is] += window[is];
+          }
+        }
         if (Verbosity() >= 2)
         {
           std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << ijphi << " " << ijeta << std::endl;
@@ -1974,12 +1981,12 @@ int CaloTriggerEmulator::process_trigger()
             std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << ijphi << " " << ijeta << std::endl;
           }
 
-          sum->push_back(jet_map[ijphi][ijeta].at(is));
-          unsigned short bit = getBits(jet_map[ijphi][ijeta].at(is), TriggerDefs::TriggerId::jetTId);
+          sum->push_back(jet_patch[is]);
+          unsigned short bit = getBits(jet_patch[is], TriggerDefs::TriggerId::jetTId);
 
           if (bit)
           {
-            m_ll1out_jet->addTriggeredSum(sk, jet_map[ijphi][ijeta].at(is));
+            m_ll1out_jet->addTriggeredSum(sk, jet_patch[is]);
             m_ll1out_jet->addTriggeredPrimitive(sk);
             pass = 1;
           }
@@ -2505,6 +2512,10 @@ int CaloTriggerEmulator::End(PHCompositeNode * /*topNode*/)
   std::cout << "Total Jet passed: " << m_jet_npassed << "/" << m_nevent << std::endl;
   std::cout << "Total Photon passed: " << m_photon_npassed << "/" << m_nevent << std::endl;
   std::cout << "Total Pair passed: " << m_pair_npassed << "/" << m_nevent << std::endl;
+  if (m_process_time > 0)
+  {
+    std::cout << "Emulation: " << m_nevent / m_process_time << " events/s" << std::endl;
+  }
   std::cout << "------------------------" << std::endl;
 
   return 0;
@@ -2627,3 +2638,44 @@ unsigned int CaloTriggerEmulator::getBits(unsigned int sum, TriggerDefs::Trigger
   }
   return 0;
 }
+
+void CaloTriggerEmulator::flatten_lut(CDBHistos *cdbhistos, const std::string &prefix, const unsigned int nchannels, std::vector<uint8_t> &lut)
+{
+  lut.assign(nchannels * 1024, 0);
+  for (unsigned int i = 0; i < nchannels; i++)
+  {
+    uint8_t *row = &lut[i * 1024];
+    TH1 *h_lut = cdbhistos->getHisto(prefix + std::to_string(i));
+    if (!h_lut)
+    {
+      // getHisto complains already
+      for (unsigned int input = 0; input < 1024; input++)
+      {
+        row[input] = m_l1_adc_table[input] >> 2U;
+      }
+      continue;
+    }
+    for (unsigned int input = 0; input < 1024; input++)
+    {
+      unsigned int lut_output = ((unsigned int) h_lut->GetBinContent(input + 1)) & 0x3ffU;
+      row[input] = lut_output >> 2U;
+    }
+  }
+}
+
+void CaloTriggerEmulator::fill_sum_channels(TriggerDefs::DetectorId detId, const int nprimitives, std::vector<unsigned int> &channels) const
+{
+  channels.clear();
+  channels.reserve(nprimitives * m_n_sums * 4);
+  for (int ip = 0; ip < nprimitives; ip++)
+  {
+    for (int isum = 0; isum < m_n_sums; isum++)
+    {
+      for (int j = 0; j < 4; j++)
+      {
+        unsigned int key = TriggerDefs::GetTowerInfoKey(detId, ip, isum, j);
+        channels.push_back(detId == TriggerDefs::DetectorId::emcalDId ? TowerInfoDefs::decode_emcal(key) : TowerInfoDefs::decode_hcal(key));
+      }
+    }
+  }
+}
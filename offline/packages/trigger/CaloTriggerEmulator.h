@@ -5,6 +5,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -18,7 +19,6 @@ class Event;
 class TowerInfoContainer;
 class CaloPacketContainer;
 class PHCompositeNode;
-class TH1;
 
 class CaloTriggerEmulator : public SubsysReco
 {
@@ -125,6 +125,19 @@ class CaloTriggerEmulator : public SubsysReco
   void identify();
 
  private:
+  //! LUT histograms of all channels into one table, (lut output >> 2) for every 10 bit input
+  void flatten_lut(CDBHistos *cdbhistos, const std::string &prefix, const unsigned int nchannels, std::vector<uint8_t> &lut);
+  //! tower channels of the 2x2 sums of a detector, 4 per sum, sums in the order of the primitives
+  void fill_sum_channels(TriggerDefs::DetectorId detId, const int nprimitives, std::vector<unsigned int> &channels) const;
+
+  static void set_peak_sub_ped(std::vector<std::vector<unsigned int>> &table, const unsigned int channel, const std::vector<unsigned int> &samples)
+  {
+    if (channel < table.size())
+    {
+      table[channel] = samples;
+    }
+  }
+
   std::string m_ll1_nodename;
   std::string m_prim_nodename;
   std::string m_waveform_nodename;
@@ -195,18 +208,29 @@ class CaloTriggerEmulator : public SubsysReco
   unsigned int m_l1_8x8_table[1024]{};
   unsigned int m_l1_slewing_table[4096]{};
 
-  std::map<unsigned int, TH1 *> h_emcal_lut{};
-  std::map<unsigned int, TH1 *> h_hcalin_lut{};
-  std::map<unsigned int, TH1 *> h_hcalout_lut{};
+  //! flattened LUTs, 1024 entries per tower channel (empty when the default table is used)
+  std::vector<uint8_t> m_lut_emcal{};
+  std::vector<uint8_t> m_lut_hcalin{};
+  std::vector<uint8_t> m_lut_hcalout{};
 
   CDBTTree *cdbttree_adcmask{nullptr};
   CDBHistos *cdbttree_emcal{nullptr};
   CDBHistos *cdbttree_hcalin{nullptr};
   CDBHistos *cdbttree_hcalout{nullptr};
 
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_emcal{};
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_hcalin{};
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_hcalout{};
+  //! peak - pedestal samples, indexed by tower channel. Emptied rows keep their memory between events
+  std::vector<std::vector<unsigned int>> m_peak_sub_ped_emcal{};
+  std::vector<std::vector<unsigned int>> m_peak_sub_ped_hcalin{};
+  std::vector<std::vector<unsigned int>> m_peak_sub_ped_hcalout{};
+
+  std::vector<unsigned int> m_sum_channels_emcal{};
+  std::vector<unsigned int> m_sum_channels_hcal{};
+
+  //! 8x8 sums on a dense (phi, eta, sample) grid and their 4 wide eta windows, for the jet patches
+  std::vector<unsigned int> m_jet_grid{};
+  std::vector<unsigned int> m_jet_eta_window{};
+
+  double m_process_time{0};
 
   //! Verbosity.
   int m_nevent{0};
@@ -65,11 +65,37 @@ void SvtxClusterEval::next_event(PHCompositeNode* topNode)
   _cache_best_cluster_from_gtrackid_layer.clear();
   _clusters_per_layer.clear();
   //  _g4hits_per_layer.clear();
+  _assoc_table.clear();
   _hiteval.next_event(topNode);
 
   get_node_pointers(topNode);
 }
 
+void SvtxClusterEval::set_use_assoc_table(bool use_table)
+{
+  _use_assoc_table = use_table;
+  get_truth_eval()->set_use_assoc_table(use_table);
+}
+
+const SvtxTruthAssocTable& SvtxClusterEval::get_assoc_table()
+{
+  if (!_assoc_table.has_clusters())
+  {
+    _assoc_table.build_clusters(_clustermap, _cluster_hit_map, _hit_truth_map,
+                                {_g4hits_tpc, _g4hits_intt, _g4hits_mvtx, _g4hits_mms}, _truthinfo);
+    if (_strict)
+    {
+      assert(_assoc_table.missing_particles() == 0);
+    }
+    _errors += _assoc_table.missing_particles();
+    if (_verbosity > 0)
+    {
+      std::cout << "SvtxClusterEval::get_assoc_table - " << _assoc_table.size() << " cluster/g4hit associations" << std::endl;
+    }
+  }
+  return _assoc_table;
+}
+
 std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>> SvtxClusterEval::all_truth_clusters(TrkrDefs::cluskey cluster_key)
 {
   if (_do_cache)
@@ -344,6 +370,17 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     return std::set<PHG4Hit*>();
   }
 
+  if (_use_assoc_table)
+  {
+    std::set<PHG4Hit*> truth_hits;
+    const auto range = get_assoc_table().cluster_truth(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      truth_hits.insert(truth_hits.end(), iter->g4hit);
+    }
+    return truth_hits;
+  }
+
   if (_do_cache)
   {
     std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>>::iterator iter =
@@ -786,6 +823,21 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     return std::set<PHG4Particle*>();
   }
 
+  if (_use_assoc_table)
+  {
+    // missing particles were counted as errors when the table was built
+    std::set<PHG4Particle*> truth_particles;
+    const auto range = get_assoc_table().cluster_truth(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->particle)
+      {
+        truth_particles.insert(iter->particle);
+      }
+    }
+    return truth_particles;
+  }
+
   if (_do_cache)
   {
     std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>>::iterator iter =
@@ -937,6 +989,18 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Particle* tru
     ++_errors;
     return std::set<TrkrDefs::cluskey>();
   }
+
+  if (_use_assoc_table)
+  {
+    std::set<TrkrDefs::cluskey> clusters;
+    const auto range = get_assoc_table().clusters_from(truthparticle);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      clusters.insert(clusters.end(), iter->second);
+    }
+    return clusters;
+  }
+
   // check if cache is filled, if not fill it.
   //   if(_cache_all_clusters_from_particle.count(truthparticle)==0){
   if (_cache_all_clusters_from_particle.empty())
@@ -1019,6 +1083,17 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
+  if (_use_assoc_table)
+  {
+    std::set<TrkrDefs::cluskey> clusters;
+    const auto range = get_assoc_table().clusters_from(truthhit);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      clusters.insert(clusters.end(), iter->second);
+    }
+    return clusters;
+  }
+
   // one time, fill cache of g4hit/cluster pairs
   if (_cache_all_clusters_from_g4hit.empty())
   {
@@ -1288,6 +1363,20 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     }
   }
 
+  if (_use_assoc_table)
+  {
+    float energy = 0.0;
+    const auto range = get_assoc_table().cluster_truth(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->g4hit->get_trkid() == particle->get_track_id())
+      {
+        energy += iter->g4hit->get_edep();
+      }
+    }
+    return energy;
+  }
+
   float energy = 0.0;
   std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
   for (auto* hit : hits)
@@ -1325,6 +1414,20 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return std::numeric_limits<float>::quiet_NaN();
   }
 
+  if (_use_assoc_table)
+  {
+    float energy = 0.0;
+    const auto range = get_assoc_table().cluster_truth(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->g4hit->get_hit_id() == g4hit->get_hit_id())
+      {
+        energy += iter->g4hit->get_edep();
+      }
+    }
+    return energy;
+  }
+
   if ((_do_cache) &&
       (_cache_get_energy_contribution_g4hit.contains(std::make_pair(cluster_key, g4hit))))
   {
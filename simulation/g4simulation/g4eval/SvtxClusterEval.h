@@ -2,6 +2,7 @@
 #define G4EVAL_SVTXCLUSTEREVAL_H
 
 #include "SvtxHitEval.h"
+#include "SvtxTruthAssocTable.h"
 
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TrkrDefs.h>
@@ -48,6 +49,8 @@ class SvtxClusterEval
     _verbosity = verbosity;
     _hiteval.set_verbosity(verbosity);
   }
+  //! answer the cluster <-> truth queries from tables built once per event
+  void set_use_assoc_table(bool use_table);
 
   // access the clustereval (and its cached values)
   SvtxHitEval* get_hit_eval() { return &_hiteval; }
@@ -89,6 +92,7 @@ class SvtxClusterEval
   void fill_cluster_layer_map();
   //  void fill_g4hit_layer_map();
   bool has_node_pointers();
+  const SvtxTruthAssocTable& get_assoc_table();
 
   //! Fast approximation of atan2() for cluster searching
   //! From https://www.dsprelated.com/showarticle/1052.php
@@ -113,6 +117,8 @@ class SvtxClusterEval
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey cluster_key, TrkrCluster* cluster);
 
   bool _do_cache = true;
+  bool _use_assoc_table = false;
+  SvtxTruthAssocTable _assoc_table;
   std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>> _cache_all_truth_hits;
   std::map<TrkrDefs::cluskey, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters;
   std::map<TrkrDefs::cluskey, PHG4Hit*> _cache_max_truth_hit_by_energy;
@@ -1,5 +1,7 @@
 #include "SvtxEvalStack.h"
 
+#include "SvtxClusterEval.h"
+
 SvtxEvalStack::SvtxEvalStack(PHCompositeNode* topNode)
   : _vertexeval(topNode)
 {
@@ -9,3 +11,9 @@ void SvtxEvalStack::next_event(PHCompositeNode* topNode)
 {
   _vertexeval.next_event(topNode);
 }
+
+void SvtxEvalStack::set_use_assoc_tables(bool use_tables)
+{
+  // also switches the truth eval underneath
+  get_cluster_eval()->set_use_assoc_table(use_tables);
+}
@@ -30,6 +30,8 @@ class SvtxEvalStack
   void set_use_initial_vertex(bool use_init_vtx) { _vertexeval.set_use_initial_vertex(use_init_vtx); }
   void set_use_genfit_vertex(bool use_genfit_vtx) { _vertexeval.set_use_genfit_vertex(use_genfit_vtx); }
   void set_verbosity(int verbosity) { _vertexeval.set_verbosity(verbosity); }
+  //! build the truth <-> reco association tables once per event and query those
+  void set_use_assoc_tables(bool use_tables);
 
   SvtxVertexEval* get_vertex_eval() { return &_vertexeval; }
   SvtxTrackEval* get_track_eval() { return _vertexeval.get_track_eval(); }
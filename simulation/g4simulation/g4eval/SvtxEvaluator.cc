@@ -79,6 +79,7 @@ SvtxEvaluator::SvtxEvaluator(const std::string& /*name*/, const std::string& fil
 SvtxEvaluator::~SvtxEvaluator()
 {
   delete _timer;
+  delete _event_timer;
 }
 
 int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
@@ -212,6 +213,8 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
 
   _timer = new PHTimer("_eval_timer");
   _timer->stop();
+  _event_timer = new PHTimer("_eval_event_timer");
+  _event_timer->stop();
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -245,6 +248,8 @@ int SvtxEvaluator::process_event(PHCompositeNode* topNode)
     std::cout << "SvtxEvaluator::process_event - Seed = " << _iseed << std::endl;
   }
 
+  _event_timer->restart();
+
   if (!_svtxevalstack)
   {
     _svtxevalstack = new SvtxEvalStack(topNode);
@@ -252,6 +257,7 @@ int SvtxEvaluator::process_event(PHCompositeNode* topNode)
     _svtxevalstack->set_verbosity(Verbosity());
     _svtxevalstack->set_use_initial_vertex(_use_initial_vertex);
     _svtxevalstack->set_use_genfit_vertex(_use_genfit_vertex);
+    _svtxevalstack->set_use_assoc_tables(_use_assoc_tables);
     _svtxevalstack->next_event(topNode);
   }
   else
@@ -277,6 +283,7 @@ int SvtxEvaluator::process_event(PHCompositeNode* topNode)
 
   // printOutputInfo(topNode);
 
+  _event_timer->stop();
   ++_ievent;
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -334,6 +341,8 @@ int SvtxEvaluator::End(PHCompositeNode* /*topNode*/)
   {
     std::cout << "========================= SvtxEvaluator::End() ============================" << std::endl;
     std::cout << " " << _ievent << " events of output written to: " << _filename << std::endl;
+    std::cout << " " << _event_timer->get_accumulated_time() / 1000. << " sec in process_event"
+              << (_use_assoc_tables ? " (association tables)" : "") << std::endl;
     std::cout << "===========================================================================" << std::endl;
   }
 
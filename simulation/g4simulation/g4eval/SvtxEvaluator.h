@@ -73,6 +73,8 @@ class SvtxEvaluator : public SubsysReco
   void do_vtx_eval_light(bool b) { _do_vtx_eval_light = b; }
   void scan_for_embedded(bool b) { _scan_for_embedded = b; }
   void scan_for_primaries(bool b) { _scan_for_primaries = b; }
+  //! truth <-> reco queries from association tables built once per event
+  void set_use_assoc_tables(bool b) { _use_assoc_tables = b; }
   
  private:
   unsigned int _ievent {0};
@@ -111,6 +113,7 @@ class SvtxEvaluator : public SubsysReco
   bool _do_vtx_eval_light {true};
   bool _scan_for_embedded {false};
   bool _scan_for_primaries {false};
+  bool _use_assoc_tables {false};
 
   unsigned int _nlayers_maps {3};
   unsigned int _nlayers_intt {4};
@@ -131,6 +134,7 @@ class SvtxEvaluator : public SubsysReco
   TFile *_tfile {nullptr};
 
   PHTimer *_timer {nullptr};
+  PHTimer *_event_timer {nullptr};
 
   // evaluator output file
   std::string _filename;
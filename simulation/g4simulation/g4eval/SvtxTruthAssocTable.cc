@@ -0,0 +1,220 @@
+#include "SvtxTruthAssocTable.h"
+
+#include <trackbase/MvtxDefs.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterHitAssoc.h>
+#include <trackbase/TrkrHitTruthAssoc.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <tuple>
+
+void SvtxTruthAssocTable::clear()
+{
+  m_has_clusters = false;
+  m_has_truth = false;
+  m_missing_particles = 0;
+  m_hit_truth.clear();
+  m_cluster_truth.clear();
+  m_hit_clusters.clear();
+  m_particle_clusters.clear();
+  m_track_hits.clear();
+}
+
+void SvtxTruthAssocTable::fill_hit_truth(TrkrHitTruthAssoc* hit_truth_map)
+{
+  m_hit_truth.clear();
+  const TrkrHitTruthAssoc::MMap* map = hit_truth_map->getMap();
+  if (!map)
+  {
+    return;
+  }
+  m_hit_truth.reserve(map->size());
+  for (const auto& [hitsetkey, hit_g4hit] : *map)
+  {
+    m_hit_truth.push_back({hitsetkey, hit_g4hit.first, hit_g4hit.second});
+  }
+  // the map is sorted by hitset already, the hit keys within a hitset are not
+  std::stable_sort(m_hit_truth.begin(), m_hit_truth.end(),
+                   [](const HitTruth& lhs, const HitTruth& rhs)
+                   { return std::tie(lhs.hitsetkey, lhs.hitkey) < std::tie(rhs.hitsetkey, rhs.hitkey); });
+}
+
+void SvtxTruthAssocTable::add_g4hits(TrkrHitTruthAssoc* hit_truth_map, TrkrDefs::hitsetkey hitsetkey, TrkrDefs::hitkey hitkey, std::vector<PHG4HitDefs::keytype>& g4hitkeys) const
+{
+  if (!hit_truth_map->getMap())
+  {
+    // no bulk access, one lookup per hit
+    std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>> temp_map;
+    hit_truth_map->getG4Hits(hitsetkey, hitkey, temp_map);
+    for (const auto& htiter : temp_map)
+    {
+      g4hitkeys.push_back(htiter.second.second);
+    }
+    return;
+  }
+
+  const auto lookup = [this, hitkey](TrkrDefs::hitsetkey key)
+  {
+    return std::equal_range(m_hit_truth.begin(), m_hit_truth.end(), HitTruth{key, hitkey, 0},
+                            [](const HitTruth& lhs, const HitTruth& rhs)
+                            { return std::tie(lhs.hitsetkey, lhs.hitkey) < std::tie(rhs.hitsetkey, rhs.hitkey); });
+  };
+
+  auto range = lookup(hitsetkey);
+  // same mvtx special case as TrkrHitTruthAssocv1::getG4Hits: fall back to the bare hitsetkey
+  const auto layer = TrkrDefs::getLayer(hitsetkey);
+  if (range.first == range.second && layer < 3)
+  {
+    range = lookup(MvtxDefs::genHitSetKey(layer, MvtxDefs::getStaveId(hitsetkey), MvtxDefs::getChipId(hitsetkey), 0));
+  }
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    g4hitkeys.push_back(iter->g4hitkey);
+  }
+}
+
+void SvtxTruthAssocTable::build_clusters(TrkrClusterContainer* clustermap, TrkrClusterHitAssoc* cluster_hit_map,
+                                         TrkrHitTruthAssoc* hit_truth_map, const std::vector<PHG4HitContainer*>& g4hits,
+                                         PHG4TruthInfoContainer* truthinfo)
+{
+  m_cluster_truth.clear();
+  m_hit_clusters.clear();
+  m_particle_clusters.clear();
+  m_missing_particles = 0;
+  m_has_clusters = true;
+  if (!clustermap || !cluster_hit_map || !hit_truth_map)
+  {
+    return;
+  }
+
+  fill_hit_truth(hit_truth_map);
+
+  std::vector<PHG4HitDefs::keytype> g4hitkeys;
+  for (const auto& hitsetkey : clustermap->getHitSetKeys())
+  {
+    PHG4HitContainer* container = nullptr;
+    switch (TrkrDefs::getTrkrId(hitsetkey))
+    {
+    case TrkrDefs::tpcId:
+      container = g4hits[0];
+      break;
+    case TrkrDefs::inttId:
+      container = g4hits[1];
+      break;
+    case TrkrDefs::mvtxId:
+      container = g4hits[2];
+      break;
+    case TrkrDefs::micromegasId:
+      container = g4hits[3];
+      break;
+    default:
+      break;
+    }
+
+    auto range = clustermap->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const TrkrDefs::cluskey cluskey = iter->first;
+      const size_t first = m_cluster_truth.size();
+
+      const auto hitrange = cluster_hit_map->getHits(cluskey);
+      for (auto clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
+      {
+        g4hitkeys.clear();
+        add_g4hits(hit_truth_map, hitsetkey, clushititer->second, g4hitkeys);
+        for (const auto g4hitkey : g4hitkeys)
+        {
+          PHG4Hit* g4hit = container ? container->findHit(g4hitkey) : nullptr;
+          if (g4hit)
+          {
+            m_cluster_truth.push_back({cluskey, g4hit, nullptr});
+          }
+        }
+      }
+
+      // one entry per distinct g4hit of this cluster
+      std::sort(m_cluster_truth.begin() + first, m_cluster_truth.end(),
+                [](const ClusterTruth& lhs, const ClusterTruth& rhs)
+                { return std::less<PHG4Hit*>()(lhs.g4hit, rhs.g4hit); });
+      m_cluster_truth.erase(std::unique(m_cluster_truth.begin() + first, m_cluster_truth.end(),
+                                        [](const ClusterTruth& lhs, const ClusterTruth& rhs)
+                                        { return lhs.g4hit == rhs.g4hit; }),
+                            m_cluster_truth.end());
+
+      for (auto entry = m_cluster_truth.begin() + first; entry != m_cluster_truth.end(); ++entry)
+      {
+        m_hit_clusters.emplace_back(entry->g4hit, cluskey);
+        entry->particle = truthinfo ? truthinfo->GetParticle(entry->g4hit->get_trkid()) : nullptr;
+        if (!entry->particle)
+        {
+          ++m_missing_particles;
+          continue;
+        }
+        m_particle_clusters.emplace_back(entry->particle, cluskey);
+      }
+    }
+  }
+
+  // the container iterates hitsets in key order, make sure the clusters are too
+  std::stable_sort(m_cluster_truth.begin(), m_cluster_truth.end(),
+                   [](const ClusterTruth& lhs, const ClusterTruth& rhs)
+                   { return lhs.cluskey < rhs.cluskey; });
+  std::sort(m_hit_clusters.begin(), m_hit_clusters.end(), std::less<>());
+  m_hit_clusters.erase(std::unique(m_hit_clusters.begin(), m_hit_clusters.end()), m_hit_clusters.end());
+  std::sort(m_particle_clusters.begin(), m_particle_clusters.end(), std::less<>());
+  m_particle_clusters.erase(std::unique(m_particle_clusters.begin(), m_particle_clusters.end()), m_particle_clusters.end());
+}
+
+void SvtxTruthAssocTable::build_truth(const std::vector<PHG4HitContainer*>& g4hits)
+{
+  m_track_hits.clear();
+  m_has_truth = true;
+  for (PHG4HitContainer* container : g4hits)
+  {
+    if (!container)
+    {
+      continue;
+    }
+    const auto range = container->getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      m_track_hits.emplace_back(iter->second->get_trkid(), iter->second);
+    }
+  }
+  std::sort(m_track_hits.begin(), m_track_hits.end(), std::less<>());
+  m_track_hits.erase(std::unique(m_track_hits.begin(), m_track_hits.end()), m_track_hits.end());
+}
+
+SvtxTruthAssocTable::ClusterTruthRange SvtxTruthAssocTable::cluster_truth(TrkrDefs::cluskey cluskey) const
+{
+  return std::equal_range(m_cluster_truth.begin(), m_cluster_truth.end(), ClusterTruth{cluskey, nullptr, nullptr},
+                          [](const ClusterTruth& lhs, const ClusterTruth& rhs)
+                          { return lhs.cluskey < rhs.cluskey; });
+}
+
+SvtxTruthAssocTable::HitClusterRange SvtxTruthAssocTable::clusters_from(PHG4Hit* g4hit) const
+{
+  return std::equal_range(m_hit_clusters.begin(), m_hit_clusters.end(), std::make_pair(g4hit, TrkrDefs::cluskey(0)),
+                          [](const auto& lhs, const auto& rhs)
+                          { return std::less<PHG4Hit*>()(lhs.first, rhs.first); });
+}
+
+SvtxTruthAssocTable::ParticleClusterRange SvtxTruthAssocTable::clusters_from(PHG4Particle* particle) const
+{
+  return std::equal_range(m_particle_clusters.begin(), m_particle_clusters.end(), std::make_pair(particle, TrkrDefs::cluskey(0)),
+                          [](const auto& lhs, const auto& rhs)
+                          { return std::less<PHG4Particle*>()(lhs.first, rhs.first); });
+}
+
+SvtxTruthAssocTable::TrackHitRange SvtxTruthAssocTable::truth_hits(int trackid) const
+{
+  return std::equal_range(m_track_hits.begin(), m_track_hits.end(), std::make_pair(trackid, static_cast<PHG4Hit*>(nullptr)),
+                          [](const auto& lhs, const auto& rhs)
+                          { return lhs.first < rhs.first; });
+}
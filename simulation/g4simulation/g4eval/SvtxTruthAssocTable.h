@@ -0,0 +1,88 @@
+#ifndef G4EVAL_SVTXTRUTHASSOCTABLE_H
+#define G4EVAL_SVTXTRUTHASSOCTABLE_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <g4main/PHG4HitDefs.h>
+
+#include <utility>
+#include <vector>
+
+class PHG4Hit;
+class PHG4HitContainer;
+class PHG4Particle;
+class PHG4TruthInfoContainer;
+class TrkrClusterContainer;
+class TrkrClusterHitAssoc;
+class TrkrHitTruthAssoc;
+
+// cluster <-> g4hit <-> particle associations of one event, built in
+// one pass over the clusters and kept in sorted vectors so that every
+// query is a binary search instead of a walk through the association
+// containers. The cluster and truth evals fill it once per event when
+// their association tables are enabled and answer their queries from it.
+class SvtxTruthAssocTable
+{
+ public:
+  struct ClusterTruth
+  {
+    TrkrDefs::cluskey cluskey;
+    PHG4Hit* g4hit;
+    PHG4Particle* particle;  //!< nullptr if the g4hit track is not in the truth container
+  };
+
+  using ClusterTruthRange = std::pair<std::vector<ClusterTruth>::const_iterator, std::vector<ClusterTruth>::const_iterator>;
+  using HitClusterRange = std::pair<std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>>::const_iterator, std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>>::const_iterator>;
+  using ParticleClusterRange = std::pair<std::vector<std::pair<PHG4Particle*, TrkrDefs::cluskey>>::const_iterator, std::vector<std::pair<PHG4Particle*, TrkrDefs::cluskey>>::const_iterator>;
+  using TrackHitRange = std::pair<std::vector<std::pair<int, PHG4Hit*>>::const_iterator, std::vector<std::pair<int, PHG4Hit*>>::const_iterator>;
+
+  void clear();
+
+  //! reco side, g4hit containers in the order tpc, intt, mvtx, micromegas (may be nullptr)
+  void build_clusters(TrkrClusterContainer* clustermap, TrkrClusterHitAssoc* cluster_hit_map,
+                      TrkrHitTruthAssoc* hit_truth_map, const std::vector<PHG4HitContainer*>& g4hits,
+                      PHG4TruthInfoContainer* truthinfo);
+  //! truth side, g4hits of the given containers by track id
+  void build_truth(const std::vector<PHG4HitContainer*>& g4hits);
+
+  bool has_clusters() const { return m_has_clusters; }
+  bool has_truth() const { return m_has_truth; }
+
+  //! distinct g4hits of a cluster, sorted by pointer
+  ClusterTruthRange cluster_truth(TrkrDefs::cluskey cluskey) const;
+  //! distinct clusters containing a g4hit, sorted by key
+  HitClusterRange clusters_from(PHG4Hit* g4hit) const;
+  //! distinct clusters containing a g4hit of a particle, sorted by key
+  ParticleClusterRange clusters_from(PHG4Particle* particle) const;
+  //! g4hits of a track id, sorted by pointer
+  TrackHitRange truth_hits(int trackid) const;
+
+  //! g4hits whose track is not in the truth container, counted once per cluster
+  unsigned int missing_particles() const { return m_missing_particles; }
+
+  unsigned int size() const { return m_cluster_truth.size(); }
+
+ private:
+  struct HitTruth
+  {
+    TrkrDefs::hitsetkey hitsetkey;
+    TrkrDefs::hitkey hitkey;
+    PHG4HitDefs::keytype g4hitkey;
+  };
+
+  void fill_hit_truth(TrkrHitTruthAssoc* hit_truth_map);
+  void add_g4hits(TrkrHitTruthAssoc* hit_truth_map, TrkrDefs::hitsetkey hitsetkey, TrkrDefs::hitkey hitkey, std::vector<PHG4HitDefs::keytype>& g4hitkeys) const;
+
+  bool m_has_clusters{false};
+  bool m_has_truth{false};
+  unsigned int m_missing_particles{0};
+
+  //! flattened TrkrHitTruthAssoc, sorted by hitset and hit key
+  std::vector<HitTruth> m_hit_truth;
+  std::vector<ClusterTruth> m_cluster_truth;
+  std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>> m_hit_clusters;
+  std::vector<std::pair<PHG4Particle*, TrkrDefs::cluskey>> m_particle_clusters;
+  std::vector<std::pair<int, PHG4Hit*>> m_track_hits;
+};
+
+#endif  // G4EVAL_SVTXTRUTHASSOCTABLE_H
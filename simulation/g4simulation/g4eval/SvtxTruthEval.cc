@@ -72,6 +72,7 @@ void SvtxTruthEval::next_event(PHCompositeNode* topNode)
   _cache_get_innermost_truth_hit.clear();
   _cache_get_outermost_truth_hit.clear();
   _cache_get_primary_particle_g4hit.clear();
+  _assoc_table.clear();
 
   _basetrutheval.next_event(topNode);
 
@@ -173,6 +174,27 @@ std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits(PHG4Particle* particle)
     ++_errors;
     return std::set<PHG4Hit*>();
   }
+
+  if (_use_assoc_table)
+  {
+    if (!_assoc_table.has_truth())
+    {
+      _assoc_table.build_truth({_g4hits_svtx, _g4hits_tracker, _g4hits_maps, _g4hits_mms});
+    }
+    // like the cache below, only particles of the truth container have hits
+    std::set<PHG4Hit*> truth_hits;
+    if (_truthinfo->GetParticle(particle->get_track_id()) != particle)
+    {
+      return truth_hits;
+    }
+    const auto range = _assoc_table.truth_hits(particle->get_track_id());
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      truth_hits.insert(truth_hits.end(), iter->second);
+    }
+    return truth_hits;
+  }
+
   //  if( _cache_all_truth_hits_g4particle.count(particle)==0){
   if (_cache_all_truth_hits_g4particle.empty())
   {
@@ -2,6 +2,7 @@
 #define G4EVAL_SVTXTRUTHEVAL_H
 
 #include "BaseTruthEval.h"
+#include "SvtxTruthAssocTable.h"
 
 #include <trackbase/TrkrDefs.h>
 
@@ -31,6 +32,8 @@ class SvtxTruthEval
 
   void next_event(PHCompositeNode* topNode);
   void do_caching(bool do_cache) { _do_cache = do_cache; }
+  //! answer the particle -> g4hit queries from a table built once per event
+  void set_use_assoc_table(bool use_table) { _use_assoc_table = use_table; }
   void set_strict(bool strict)
   {
     _strict = strict;
@@ -108,6 +111,8 @@ class SvtxTruthEval
   std::multimap<TrkrDefs::cluskey, PHG4Hit*> _truth_cluster_truth_hit_map;
 
   bool _do_cache = true;
+  bool _use_assoc_table = false;
+  SvtxTruthAssocTable _assoc_table;
   std::set<PHG4Hit*> _cache_all_truth_hits;
   std::map<PHG4Particle*, std::set<PHG4Hit*>> _cache_all_truth_hits_g4particle;
   std::map<PHG4Particle*, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters_g4particle;
@@ -12,6 +12,7 @@
 #include <g4detectors/PHG4TpcGeomContainer.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 #include <fun4all/SubsysReco.h>  // for SubsysReco
 #
 #include <phool/PHCompositeNode.h>
@@ -21,8 +22,6 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
-#include <gsl/gsl_randist.h>
-#include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
 #include <algorithm>
 #include <cstddef>
@@ -33,12 +32,11 @@
 
 PHG4TpcDigitizer::PHG4TpcDigitizer(const std::string &name)
   : SubsysReco(name)
-  , RandomGenerator(gsl_rng_alloc(gsl_rng_mt19937))  // will be assigned in PHG4TpcDigitizer::InitRun
 {
   unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
   std::cout << Name() << " random seed: " << seed << std::endl;
 
-  gsl_rng_set(RandomGenerator, seed);
+  m_rng_key = PHRandomStream::MakeKey(seed, Name());
 
   if (Verbosity() > 0)
   {
@@ -46,10 +44,7 @@ PHG4TpcDigitizer::PHG4TpcDigitizer(const std::string &name)
   }
 }
 
-PHG4TpcDigitizer::~PHG4TpcDigitizer()
-{
-  gsl_rng_free(RandomGenerator);
-}
+PHG4TpcDigitizer::~PHG4TpcDigitizer() = default;
 
 int PHG4TpcDigitizer::InitRun(PHCompositeNode *topNode)
 {
@@ -264,6 +259,8 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
       {
         std::cout << "TPC layer " << layer << " side " << side << std::endl;
       }
+      // the noise of a layer and side does not depend on the other layers
+      m_rng.Reset(m_rng_key, Fun4AllServer::instance()->RunNumber(), Fun4AllServer::instance()->EventCounter(), 2 * layer + side);
 
       // for this layer and side, use a vector of a vector of cells for each phibin
       if (phi_sorted_hits.size() != static_cast<std::size_t>(nphibins))
@@ -676,7 +673,7 @@ float PHG4TpcDigitizer::add_noise_to_bin(float signal)
 
 float PHG4TpcDigitizer::added_noise()
 {
-  float noise = gsl_ran_gaussian(RandomGenerator, TpcEnc);
+  float noise = m_rng.Gaus(TpcEnc);
 
   return noise;
 }
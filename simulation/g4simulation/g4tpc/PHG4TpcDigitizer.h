@@ -8,8 +8,9 @@
 #include <trackbase/TrkrDefs.h>
 #include <trackbase/TrkrHitSet.h>
 
-#include <gsl/gsl_rng.h>
+#include <phool/PHRandomStream.h>
 
+#include <cstdint>
 #include <map>
 #include <string>   // for string
 #include <utility>  // for pair, make_pair
@@ -67,8 +68,9 @@ class PHG4TpcDigitizer : public SubsysReco
   std::map<int, unsigned int> _max_adc;
   std::map<int, float> _energy_scale;
 
-  //! random generator that conform with sPHENIX standard
-  gsl_rng *RandomGenerator {nullptr};
+  //! random numbers, one stream per layer and side in each event
+  uint64_t m_rng_key{0};
+  PHRandomStream m_rng{0, 0, 0};
 };
 
 #endif
@@ -47,6 +47,7 @@
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
 #include <phool/PHRandomSeed.h>
+#include <phool/PHRandomStream.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -56,9 +57,6 @@
 #include <TNtuple.h>
 #include <TSystem.h>
 
-#include <gsl/gsl_randist.h>
-#include <gsl/gsl_rng.h>  // for gsl_rng_alloc
-
 #include <array>
 #include <cassert>
 #include <cmath>    // for sqrt, abs, NAN
@@ -84,7 +82,6 @@ PHG4TpcElectronDrift::PHG4TpcElectronDrift(const std::string &name)
   , single_hitsetcontainer(new TrkrHitSetContainerv1)
 {
   InitializeParameters();
-  RandomGenerator.reset(gsl_rng_alloc(gsl_rng_mt19937));
   set_seed(PHRandomSeed());
 }
 
@@ -442,6 +439,10 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
   int trkid = -1;
 
+  // every g4hit gets its own random stream, so the result does not depend on the order the hits are drifted in
+  Fun4AllServer *se = Fun4AllServer::instance();
+  PHRandomStream rng(m_rng_key, se->RunNumber(), se->EventCounter());
+
   PHG4Hit *prior_g4hit = nullptr;  // used to check for jumps in g4hits;
   // if there is a big jump (such as crossing into the INTT area or out of the TPC)
   // then cluster the truth clusters before adding a new hit. This prevents
@@ -514,8 +515,9 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
     // Instead, use a temporary map to accumulate the charge from all
     // drifted electrons, then copy to the node tree later
 
+    rng.Reset(m_rng_key, se->RunNumber(), se->EventCounter(), hiter->first);
     double eion = hiter->second->get_eion();
-    unsigned int n_electrons = gsl_ran_poisson(RandomGenerator.get(), eion * electrons_per_gev);
+    unsigned int n_electrons = rng.Poisson(eion * electrons_per_gev);
     //    count_electrons += n_electrons;
 
     if (Verbosity() > 100)
@@ -554,7 +556,7 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
       // distribution along the path length the parameter t is the fraction of
       // the distance along the path betwen entry and exit points, it has
       // values between 0 and 1
-      const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+      const double f = rng.Uniform();
 
       const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
       const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
@@ -569,14 +571,14 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
       const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
       const double rantrans =
-          gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
+          rng.Gaus(r_sigma) +
+          rng.Gaus(added_smear_sigma_trans);
 
       const double t_path = (tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
       const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
       const double rantime =
-          gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
-	gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / layergeom->get_drift_velocity_sim();
+          rng.Gaus(t_sigma) +
+          rng.Gaus(added_smear_sigma_long) / layergeom->get_drift_velocity_sim();
       double t_final = t_start + t_path + rantime;
 
       if (t_final < min_time || t_final > max_time)
@@ -596,7 +598,7 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
       const double radstart = std::sqrt(square(x_start) + square(y_start));
       const double phistart = std::atan2(y_start, x_start);
-      const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
+      const double ranphi = rng.Uniform(-M_PI, M_PI);
 
       double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
       double y_final = y_start + rantrans * std::sin(ranphi);
@@ -694,11 +696,30 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         assert(nt);
         nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
       }
+      if (m_batched_readout)
+      {
+        m_drifted_electrons.push_back({x_final, y_final, t_final, side});
+        continue;
+      }
+      m_readout_timer.restart();
       padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
                               temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
                               side, hiter, ntpad, nthit);
+      m_readout_timer.stop();
+      ++m_readout_electrons;
     }  // end loop over electrons for this g4hit
 
+    if (!m_drifted_electrons.empty())
+    {
+      m_readout_timer.restart();
+      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                              temp_hitsetcontainer.get(), hittruthassoc, m_drifted_electrons,
+                              hiter, ntpad, nthit);
+      m_readout_timer.stop();
+      m_readout_electrons += m_drifted_electrons.size();
+      m_drifted_electrons.clear();
+    }
+
     if (do_ElectronDriftQAHistos)
     {
       ratioElectronsRR->Fill((double) (n_electrons - notReachingReadout) / n_electrons);
@@ -886,6 +907,14 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
 int PHG4TpcElectronDrift::End(PHCompositeNode * /*topNode*/)
 {
+  if (m_readout_electrons > 0)
+  {
+    std::cout << "PHG4TpcElectronDrift::End - " << (m_batched_readout ? "batched" : "electron by electron")
+              << " pad plane readout of " << m_readout_electrons << " electrons: "
+              << m_readout_timer.get_accumulated_time() << " ms, "
+              << 1e6 * m_readout_timer.get_accumulated_time() / m_readout_electrons << " ns per electron" << std::endl;
+  }
+
   if (Verbosity() > 0)
   {
     assert(m_outf);
@@ -927,7 +956,7 @@ int PHG4TpcElectronDrift::End(PHCompositeNode * /*topNode*/)
 
 void PHG4TpcElectronDrift::set_seed(const unsigned int seed)
 {
-  gsl_rng_set(RandomGenerator.get(), seed);
+  m_rng_key = PHRandomStream::MakeKey(seed, Name());
 }
 
 void PHG4TpcElectronDrift::SetDefaultParameters()
@@ -3,6 +3,7 @@
 #ifndef G4TPC_PHG4TPCELECTRONDRIFT_H
 #define G4TPC_PHG4TPCELECTRONDRIFT_H
 
+#include "PHG4TpcPadPlane.h"
 #include "TpcClusterBuilder.h"
 
 #include <trackbase/ActsGeometry.h>
@@ -13,16 +14,17 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <gsl/gsl_rng.h>
+#include <phool/PHTimer.h>
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
-class PHG4TpcPadPlane;
 class PHG4TpcDistortion;
 class PHCompositeNode;
 class TH1;
@@ -83,6 +85,8 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   void set_zero_bfield_flag(bool flag) { zero_bfield = flag; };
   void set_zero_bfield_diffusion_factor(double f) { zero_bfield_diffusion_factor = f; };
   void use_PDG_gas_params() { m_use_PDG_gas_params = true; }
+  //! hand all electrons of a g4hit to the pad plane at once instead of one by one
+  void set_batched_readout(bool flag) { m_batched_readout = flag; }
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
@@ -142,6 +146,14 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   bool do_getReachReadout{false};
   bool zero_bfield{false};
   bool m_use_PDG_gas_params{false};
+  bool m_batched_readout{false};
+
+  //! electrons of the current g4hit for the batched readout
+  std::vector<PHG4TpcPadPlane::DriftedElectron> m_drifted_electrons;
+
+  //! time spent in the pad plane readout, reported in End
+  PHTimer m_readout_timer{"pad plane readout"};
+  unsigned long m_readout_electrons{0};
 
   std::unique_ptr<TrkrHitSetContainer> temp_hitsetcontainer;
   std::unique_ptr<TrkrHitSetContainer> single_hitsetcontainer;
@@ -154,14 +166,8 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   std::string hitnodename;
   std::string seggeonodename;
 
-  //! rng de-allocator
-  class Deleter
-  {
-   public:
-    //! deletion operator
-    void operator()(gsl_rng *rng) const { gsl_rng_free(rng); }
-  };
-  std::unique_ptr<gsl_rng, Deleter> RandomGenerator;
+  //! key of the random streams (PHRandomStream), one stream per g4hit and event
+  uint64_t m_rng_key{0};
 };
 
 #endif  // G4TPC_PHG4TPCELECTRONDRIFT_H
@@ -10,6 +10,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <string>  // for string
+#include <vector>
 
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
@@ -20,6 +21,15 @@ class TNtuple;
 class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
 {
  public:
+  //! electron at the GEM stack, after drift and diffusion
+  struct DriftedElectron
+  {
+    double x{0};
+    double y{0};
+    double t{0};
+    unsigned int side{0};
+  };
+
   PHG4TpcPadPlane(const std::string &name = "PHG4TpcPadPlane");
 
   int process_event(PHCompositeNode *) final
@@ -33,6 +43,14 @@ class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
   virtual void UpdateInternalParameters() { return; }
   //  virtual void MapToPadPlane(PHG4CellContainer * /*g4cells*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) {}
   virtual void MapToPadPlane(TpcClusterBuilder & /*builder*/, TrkrHitSetContainer * /*single_hitsetcontainer*/, TrkrHitSetContainer * /*hitsetcontainer*/, TrkrHitTruthAssoc * /*hittruthassoc*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) = 0;  // { return {}; }
+  //! all electrons of one g4hit at once, the default maps them one by one
+  virtual void MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const std::vector<DriftedElectron> &electrons, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+  {
+    for (const auto &electron : electrons)
+    {
+      MapToPadPlane(builder, single_hitsetcontainer, hitsetcontainer, hittruthassoc, electron.x, electron.y, electron.t, electron.side, hiter, ntpad, nthit);
+    }
+  }
   void Detector(const std::string &name) { detector = name; }
 
  protected:
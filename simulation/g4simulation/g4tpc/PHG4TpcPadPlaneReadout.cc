@@ -37,12 +37,15 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
+#include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstdlib>  // for getenv
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <map>      // for _Rb_tree_cons...
+#include <numeric>
 #include <utility>  // for pair
 
 class PHCompositeNode;
@@ -70,8 +73,25 @@ namespace
     return std::exp(-square(x / sigma) / 2) / (sigma * std::sqrt(2 * M_PI));
   }
 
+  //! overlap of a gaussian charge cloud of width sigma, at distance x_loc from the pad center, with a zigzag pad
+  /*!
+  this corresponds to integrating the charge distribution Gaussian function (centered on rphi and of width cloud_sig_rp),
+  convoluted with a strip response function, which is triangular from -pitch to +pitch, with a maximum of 1. at stript center
+  */
+  double pad_overlap(const double x_loc, const double pitch, const double sigma)
+  {
+    return (pitch - x_loc) * (std::erf(x_loc / (M_SQRT2 * sigma)) - std::erf((x_loc - pitch) / (M_SQRT2 * sigma))) / (pitch * 2) + (pitch + x_loc) * (std::erf((x_loc + pitch) / (M_SQRT2 * sigma)) - std::erf(x_loc / (M_SQRT2 * sigma))) / (pitch * 2) + (gaus(x_loc - pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch + (gaus(x_loc + pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch;
+  }
+
   constexpr unsigned int print_layer = 18;
 
+  //! samples of the SAMPA response per time bin
+  constexpr int sampa_samples = 6;
+
+  //! number of intervals of the pad and SAMPA response tables
+  constexpr int pad_response_bins = 2048;
+  constexpr int sampa_response_bins = 512;
+
 }  // namespace
 
 PHG4TpcPadPlaneReadout::PHG4TpcPadPlaneReadout(const std::string &name)
@@ -219,6 +239,8 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
     makeChannelMask(m_hotChannelMap, m_hotChannelMapName, "TotalHotChannels");
   }
 
+  makeResponseTables();
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -296,30 +318,9 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(TF1 *f)
   return nelec;
 }
 
-void PHG4TpcPadPlaneReadout::MapToPadPlane(
-    TpcClusterBuilder &tpc_truth_clusterer,
-    TrkrHitSetContainer *single_hitsetcontainer,
-    TrkrHitSetContainer *hitsetcontainer,
-    TrkrHitTruthAssoc * /*hittruthassoc*/,
-    const double x_gem, const double y_gem, const double t_gem, const unsigned int side,
-    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)
+//_________________________________________________________
+unsigned int PHG4TpcPadPlaneReadout::findLayer(double &rad_gem)
 {
-  // One electron per call of this method
-  // The x_gem and y_gem values have already been randomized within the transverse drift diffusion width
-  // The t_gem value already reflects the drift time of the primary electron from the production point, and is randomized within the longitudinal diffusion witdth
-
-  double phi = atan2(y_gem, x_gem);
-  if (phi > +M_PI)
-  {
-    phi -= 2 * M_PI;
-  }
-  if (phi < -M_PI)
-  {
-    phi += 2 * M_PI;
-  }
-
-  double rad_gem = get_r(x_gem, y_gem);
-
   // Moving electrons from dead area to a closest pad
   for (int iregion = 0; iregion < 3; ++iregion)
   {
@@ -345,63 +346,30 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
     }
   }
 
-  unsigned int layernum = 0;
-  /* TpcClusterBuilder pass_data {}; */
-
-  // Find which readout layer this electron ends up in
 
-  PHG4TpcGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
-  for (PHG4TpcGeomContainer::ConstIterator layeriter = layerrange.first;
-       layeriter != layerrange.second;
-       ++layeriter)
+  // layers are ordered in radius and do not overlap, the first one whose upper edge is above rad_gem is the candidate
+  const auto iter = std::upper_bound(m_layer_bounds.begin(), m_layer_bounds.end(), rad_gem,
+                                     [](const double rad, const LayerBounds &bounds)
+                                     { return rad < bounds.rad_high; });
+  if (iter == m_layer_bounds.end() || !(rad_gem > iter->rad_low))
   {
-    double rad_low = layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0;
-    double rad_high = layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0;
-
-    if (rad_gem > rad_low && rad_gem < rad_high)
-    {
-      // capture the layer where this electron hits the gem stack
-      LayerGeom = layeriter->second;
-
-      layernum = LayerGeom->get_layer();
-      /* pass_data.layerGeom = LayerGeom; */
-      /* pass_data.layer = layernum; */
-      if (Verbosity() > 1000)
-      {
-        std::cout << " g4hit id " << hiter->first << " rad_gem " << rad_gem << " rad_low " << rad_low << " rad_high " << rad_high
-                  << " layer  " << hiter->second->get_layer() << " want to change to " << layernum << std::endl;
-      }
-      hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
-    }
+    return 0;
   }
 
-  if (layernum == 0)
+  // capture the layer where this electron hits the gem stack
+  if (iter->geom != LayerGeom)
   {
-    return;
+    LayerGeom = iter->geom;
+    sector_min_Phi = LayerGeom->get_sector_min_phi();
+    sector_max_Phi = LayerGeom->get_sector_max_phi();
+    phi_bin_width = LayerGeom->get_phistep();
   }
+  return LayerGeom->get_layer();
+}
 
-  // store phi bins and tbins upfront to avoid repetitive checks on the phi methods
-  const auto phibins = LayerGeom->get_phibins();
-  /* pass_data.nphibins = phibins; */
-
-  const auto tbins = LayerGeom->get_zbins();
-
-  sector_min_Phi = LayerGeom->get_sector_min_phi();
-  sector_max_Phi = LayerGeom->get_sector_max_phi();
-  phi_bin_width = LayerGeom->get_phistep();
-
-  phi = check_phi(side, phi, rad_gem);
-
-  // Create the distribution function of charge on the pad plane around the electron position
-
-  // The resolution due to pad readout includes the charge spread during GEM multiplication.
-  // this now defaults to 400 microns during construction from Tom (see 8/11 email).
-  // Use the setSigmaT(const double) method to update...
-  // We use a double gaussian to represent the smearing due to the SAMPA chip shaping time - default values of fShapingLead and fShapingTail are for 80 ns SAMPA
-
-  // amplify the single electron in the gem stack
-  //===============================
-
+//_________________________________________________________
+double PHG4TpcPadPlaneReadout::getGEMAmplification(const unsigned int side, const double phi, const double rad_gem)
+{
   double nelec = getSingleEGEMAmplification();
   // Applying weight with respect to the rad_gem and phi after electrons are redistributed
   double phi_gain = phi;
@@ -482,7 +450,89 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
     }
   }
 
-  // std::cout<<"PHG4TpcPadPlaneReadout::MapToPadPlane gain_weight = "<<gain_weight<<std::endl;
+  return nelec;
+}
+
+//_________________________________________________________
+bool PHG4TpcPadPlaneReadout::isMasked(const TrkrDefs::hitsetkey hitsetkey, const unsigned int pad)
+{
+  const TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(pad, 0);
+  if (m_maskDeadChannels)
+  {
+    if (m_deadChannelMap.contains(hitsetkey) &&
+        std::find(m_deadChannelMap[hitsetkey].begin(), m_deadChannelMap[hitsetkey].end(), hitkey) != m_deadChannelMap[hitsetkey].end())
+    {
+      return true;
+    }
+  }
+  if (m_maskHotChannels)
+  {
+    if (m_hotChannelMap.contains(hitsetkey) &&
+        std::find(m_hotChannelMap[hitsetkey].begin(), m_hotChannelMap[hitsetkey].end(), hitkey) != m_hotChannelMap[hitsetkey].end())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PHG4TpcPadPlaneReadout::MapToPadPlane(
+    TpcClusterBuilder &tpc_truth_clusterer,
+    TrkrHitSetContainer *single_hitsetcontainer,
+    TrkrHitSetContainer *hitsetcontainer,
+    TrkrHitTruthAssoc * /*hittruthassoc*/,
+    const double x_gem, const double y_gem, const double t_gem, const unsigned int side,
+    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)
+{
+  // One electron per call of this method
+  // The x_gem and y_gem values have already been randomized within the transverse drift diffusion width
+  // The t_gem value already reflects the drift time of the primary electron from the production point, and is randomized within the longitudinal diffusion witdth
+
+  double phi = atan2(y_gem, x_gem);
+  if (phi > +M_PI)
+  {
+    phi -= 2 * M_PI;
+  }
+  if (phi < -M_PI)
+  {
+    phi += 2 * M_PI;
+  }
+
+  double rad_gem = get_r(x_gem, y_gem);
+
+  // Find which readout layer this electron ends up in
+  const unsigned int layernum = findLayer(rad_gem);
+  if (layernum == 0)
+  {
+    return;
+  }
+  if (Verbosity() > 1000)
+  {
+    std::cout << " g4hit id " << hiter->first << " rad_gem " << rad_gem
+              << " layer  " << hiter->second->get_layer() << " want to change to " << layernum << std::endl;
+  }
+  hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
+
+  // store phi bins and tbins upfront to avoid repetitive checks on the phi methods
+  const auto phibins = LayerGeom->get_phibins();
+  /* pass_data.nphibins = phibins; */
+
+  const auto tbins = LayerGeom->get_zbins();
+
+  phi = check_phi(side, phi, rad_gem);
+
+  // Create the distribution function of charge on the pad plane around the electron position
+
+  // The resolution due to pad readout includes the charge spread during GEM multiplication.
+  // this now defaults to 400 microns during construction from Tom (see 8/11 email).
+  // Use the setSigmaT(const double) method to update...
+  // We use a double gaussian to represent the smearing due to the SAMPA chip shaping time - default values of fShapingLead and fShapingTail are for 80 ns SAMPA
+
+  // amplify the single electron in the gem stack
+  //===============================
+
+  const double nelec = getGEMAmplification(side, phi, rad_gem);
+
   /* pass_data.neff_electrons = nelec; */
 
   // Distribute the charge between the pads in phi
@@ -623,28 +673,12 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       // Use existing hitset or add new one if needed
       TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
       TrkrHitSetContainer::Iterator single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
-      TrkrDefs::hitkey hitkey;
-
-      if (m_maskDeadChannels)
+      if (isMasked(hitsetkey, pad_num))
       {
-        hitkey = TpcDefs::genHitKey((unsigned int) pad_num, 0);
-        if (m_deadChannelMap.contains(hitsetkey) &&
-            std::find(m_deadChannelMap[hitsetkey].begin(), m_deadChannelMap[hitsetkey].end(), hitkey) != m_deadChannelMap[hitsetkey].end())
-        {
-          continue;
-        }
-      }
-      if (m_maskHotChannels)
-      {
-        hitkey = TpcDefs::genHitKey((unsigned int) pad_num, 0);
-        if (m_hotChannelMap.contains(hitsetkey) &&
-            std::find(m_hotChannelMap[hitsetkey].begin(), m_hotChannelMap[hitsetkey].end(), hitkey) != m_hotChannelMap[hitsetkey].end())
-        {
-          continue;
-        }
+        continue;
       }
       // generate the key for this hit, requires tbin and phibin
-      hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
+      const TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
 
       // See if this hit already exists
       TrkrHit *hit = nullptr;
@@ -716,6 +750,218 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   m_NHits++;
   /* return pass_data; */
 }
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::MapToPadPlane(
+    TpcClusterBuilder &tpc_truth_clusterer,
+    TrkrHitSetContainer *single_hitsetcontainer,
+    TrkrHitSetContainer *hitsetcontainer,
+    TrkrHitTruthAssoc * /*hittruthassoc*/,
+    const std::vector<DriftedElectron> &electrons,
+    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)
+{
+  // Same as the electron by electron readout above, except that the pad and SAMPA responses are interpolated
+  // from tables and the TrkrHits are looked up once per pad and time bin instead of once per electron
+
+  // first pass: gain and charge sharing of each electron, in the order of the electrons
+  // so the gain is sampled exactly as in the electron by electron readout
+  m_stamps.clear();
+  std::vector<int> pad_phibin;
+  std::vector<double> pad_phibin_share;
+  std::vector<int> adc_tbin;
+  std::vector<double> adc_tbin_share;
+  for (const auto &electron : electrons)
+  {
+    double phi = atan2(electron.y, electron.x);
+    double rad_gem = get_r(electron.x, electron.y);
+    const unsigned int layernum = findLayer(rad_gem);
+    if (layernum == 0)
+    {
+      continue;
+    }
+    hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
+    phi = check_phi(electron.side, phi, rad_gem);
+
+    ChargeStamp stamp;
+    stamp.layer = layernum;
+    stamp.side = electron.side;
+    stamp.nelec = getGEMAmplification(electron.side, phi, rad_gem);
+
+    pad_phibin.clear();
+    pad_phibin_share.clear();
+    populate_zigzag_phibins(electron.side, layernum, phi, sigmaT, pad_phibin, pad_phibin_share, true);
+    const double norm1 = std::accumulate(pad_phibin_share.begin(), pad_phibin_share.end(), 0.0);
+    stamp.npads = pad_phibin.size();
+    for (unsigned int ipad = 0; ipad < stamp.npads; ++ipad)
+    {
+      stamp.pad[ipad] = pad_phibin[ipad];
+      stamp.pad_share[ipad] = pad_phibin_share[ipad] / norm1;
+    }
+
+    adc_tbin.clear();
+    adc_tbin_share.clear();
+    sampaTimeDistribution(electron.t, adc_tbin, adc_tbin_share, true);
+    const double tnorm = std::accumulate(adc_tbin_share.begin(), adc_tbin_share.end(), 0.0);
+    stamp.ntbins = adc_tbin.size();
+    for (unsigned int it = 0; it < stamp.ntbins; ++it)
+    {
+      stamp.tbin[it] = adc_tbin[it];
+      stamp.tbin_share[it] = adc_tbin_share[it] / tnorm;
+    }
+
+    m_stamps.push_back(stamp);
+    m_NHits++;
+  }
+
+  // second pass: sum the charge of each layer and side in a dense (pad x time bin) window
+  m_stamp_order.resize(m_stamps.size());
+  std::iota(m_stamp_order.begin(), m_stamp_order.end(), 0);
+  std::stable_sort(m_stamp_order.begin(), m_stamp_order.end(), [this](const unsigned int a, const unsigned int b)
+                   { return std::make_pair(m_stamps[a].layer, m_stamps[a].side) < std::make_pair(m_stamps[b].layer, m_stamps[b].side); });
+
+  std::size_t end = 0;
+  for (std::size_t begin = 0; begin < m_stamp_order.size(); begin = end)
+  {
+    const ChargeStamp &first = m_stamps[m_stamp_order[begin]];
+    const unsigned int layernum = first.layer;
+    const unsigned int side = first.side;
+    for (end = begin + 1; end < m_stamp_order.size(); ++end)
+    {
+      const ChargeStamp &stamp = m_stamps[m_stamp_order[end]];
+      if (stamp.layer != layernum || stamp.side != side)
+      {
+        break;
+      }
+    }
+
+    const PHG4TpcGeom *layergeom = GeomContainer->GetLayerCellGeom(layernum);
+    const int phibins = layergeom->get_phibins();
+    const int tbins = layergeom->get_zbins();
+
+    // pads which wrapped around at 2 pi are moved next to the pads of the first electron, so the window stays small
+    const int ref_pad = first.pad[0];
+    auto unwrap = [phibins, ref_pad](const int pad)
+    {
+      if (pad - ref_pad > phibins / 2)
+      {
+        return pad - phibins;
+      }
+      if (ref_pad - pad > phibins / 2)
+      {
+        return pad + phibins;
+      }
+      return pad;
+    };
+
+    int pad_min = INT_MAX;
+    int pad_max = INT_MIN;
+    int tbin_min = INT_MAX;
+    int tbin_max = INT_MIN;
+    for (std::size_t istamp = begin; istamp < end; ++istamp)
+    {
+      const ChargeStamp &stamp = m_stamps[m_stamp_order[istamp]];
+      for (unsigned int ipad = 0; ipad < stamp.npads; ++ipad)
+      {
+        pad_min = std::min(pad_min, unwrap(stamp.pad[ipad]));
+        pad_max = std::max(pad_max, unwrap(stamp.pad[ipad]));
+      }
+      for (unsigned int it = 0; it < stamp.ntbins; ++it)
+      {
+        tbin_min = std::min(tbin_min, stamp.tbin[it]);
+        tbin_max = std::max(tbin_max, stamp.tbin[it]);
+      }
+    }
+    const std::size_t nt_window = tbin_max - tbin_min + 1;
+    const std::size_t ncells = (pad_max - pad_min + 1) * nt_window;
+    m_grid.assign(ncells, 0);
+    m_grid_touched.assign(ncells, 0);
+    m_grid_cells.clear();
+
+    for (std::size_t istamp = begin; istamp < end; ++istamp)
+    {
+      const ChargeStamp &stamp = m_stamps[m_stamp_order[istamp]];
+      for (unsigned int ipad = 0; ipad < stamp.npads; ++ipad)
+      {
+        const std::size_t row = (unwrap(stamp.pad[ipad]) - pad_min) * nt_window;
+        for (unsigned int it = 0; it < stamp.ntbins; ++it)
+        {
+          // Divide electrons from avalanche between bins
+          const float neffelectrons = stamp.nelec * stamp.pad_share[ipad] * stamp.tbin_share[it];
+          if (neffelectrons < neffelectrons_threshold)
+          {
+            continue;  // skip signals that will be below the noise suppression threshold
+          }
+          const std::size_t cell = row + (stamp.tbin[it] - tbin_min);
+          if (!m_grid_touched[cell])
+          {
+            m_grid_touched[cell] = 1;
+            m_grid_cells.push_back(cell);
+          }
+          // TrkrHitv2 keeps the energy as ADC counts and truncates every addition,
+          // sum the truncated counts so the hits are the same as when the electrons are added one by one
+          m_grid[cell] += static_cast<unsigned int>(std::min(neffelectrons * TrkrDefs::EdepScaleFactor, (double) USHRT_MAX));
+        }
+      }
+    }
+
+    // write the window to the hitsets
+    const unsigned int pads_per_sector = phibins / 12;
+    TrkrDefs::hitsetkey last_hitsetkey = 0;
+    TrkrHitSetContainer::Iterator hitsetit;
+    TrkrHitSetContainer::Iterator single_hitsetit;
+    for (const auto cell : m_grid_cells)
+    {
+      int pad_num = pad_min + static_cast<int>(cell / nt_window);
+      if (pad_num < 0)
+      {
+        pad_num += phibins;
+      }
+      else if (pad_num >= phibins)
+      {
+        pad_num -= phibins;
+      }
+      const int tbin_num = tbin_min + static_cast<int>(cell % nt_window);
+      if (tbin_num >= tbins)
+      {
+        std::cout << " Error making key: adc_tbin " << tbin_num << " ntbins " << tbins << std::endl;
+      }
+
+      const unsigned int sector = pad_num / pads_per_sector;
+      const TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layernum, sector, side);
+      if (hitsetkey != last_hitsetkey)
+      {
+        hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
+        single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
+        last_hitsetkey = hitsetkey;
+      }
+      if (isMasked(hitsetkey, pad_num))
+      {
+        continue;
+      }
+
+      const TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
+      const double energy = m_grid[cell] / TrkrDefs::EdepScaleFactor;
+
+      TrkrHit *hit = hitsetit->second->getHit(hitkey);
+      if (!hit)
+      {
+        hit = new TrkrHitv2();
+        hitsetit->second->addHitSpecificKey(hitkey, hit);
+      }
+      hit->addEnergy(energy);
+
+      tpc_truth_clusterer.addhitset(hitsetkey, hitkey, energy);
+
+      TrkrHit *single_hit = single_hitsetit->second->getHit(hitkey);
+      if (!single_hit)
+      {
+        single_hit = new TrkrHitv2();
+        single_hitsetit->second->addHitSpecificKey(hitkey, single_hit);
+      }
+      single_hit->addEnergy(energy);
+    }
+  }
+}
+
 double PHG4TpcPadPlaneReadout::check_phi(const unsigned int side, const double phi, const double radius)
 {
   double new_phi = phi;
@@ -764,7 +1010,7 @@ double PHG4TpcPadPlaneReadout::check_phi(const unsigned int side, const double p
   return new_phi;
 }
 
-void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int side, const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &phibin_pad, std::vector<double> &phibin_pad_share)
+void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int side, const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &phibin_pad, std::vector<double> &phibin_pad_share, const bool tabulated)
 {
   const double radius = LayerGeom->get_radius();
   const double phistepsize = LayerGeom->get_phistep();
@@ -892,12 +1138,7 @@ void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int side, co
 
     const double x_loc = x_loc_tmp;
     // calculate fraction of the total charge on this strip
-    /*
-    this corresponds to integrating the charge distribution Gaussian function (centered on rphi and of width cloud_sig_rp),
-    convoluted with a strip response function, which is triangular from -pitch to +pitch, with a maximum of 1. at stript center
-    */
-    overlap[ipad] =
-        (pitch - x_loc) * (std::erf(x_loc / (M_SQRT2 * sigma)) - std::erf((x_loc - pitch) / (M_SQRT2 * sigma))) / (pitch * 2) + (pitch + x_loc) * (std::erf((x_loc + pitch) / (M_SQRT2 * sigma)) - std::erf(x_loc / (M_SQRT2 * sigma))) / (pitch * 2) + (gaus(x_loc - pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch + (gaus(x_loc + pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch;
+    overlap[ipad] = tabulated ? tabulatedPadOverlap(layernum, x_loc) : pad_overlap(x_loc, pitch, sigma);
   }
 
   // now we have the overlap for each pad
@@ -1030,18 +1271,40 @@ void PHG4TpcPadPlaneReadout::makeChannelMask(hitMaskTpc &aMask, const std::strin
   delete cdbttree;
 }
 
-void PHG4TpcPadPlaneReadout::sampaTimeDistribution(double tzero,  std::vector<int> &adc_tbin, std::vector<double> &adc_tbin_share)
+void PHG4TpcPadPlaneReadout::sampaTimeDistribution(double tzero,  std::vector<int> &adc_tbin, std::vector<double> &adc_tbin_share, const bool tabulated)
 {
   // tzero is the arrival time of the electron at the GEM
   // Ts is the sampa peaking time
   // Assume the response is over after 8 clock cycles (400 ns)
-  int nclocks = 8;
+  int nclocks = NClocks;
 
   double tstepsize = LayerGeom->get_zstep();
   int tbinzero = LayerGeom->get_zbin(tzero);
 
   // the first clock bin is a special case
   double tfirst_end = LayerGeom->get_zcenter(tbinzero) + tstepsize/2.0;
+
+  if (tabulated)
+  {
+    // the shares only depend on the time between the arrival and the end of the first bin
+    const double u = std::clamp((tfirst_end - tzero) * m_sampa_response_inv_step, 0., (double) sampa_response_bins);
+    const int i = std::min(static_cast<int>(u), sampa_response_bins - 1);
+    const double f = u - i;
+    const auto &low = m_sampa_response[i];
+    const auto &high = m_sampa_response[i + 1];
+    for (int iclock = 0; iclock < nclocks; ++iclock)
+    {
+      int tbin = tbinzero + iclock;
+      if (iclock > 0 && (tbin < 0 || tbin > LayerGeom->get_zbins()))
+      {
+        continue;
+      }
+      adc_tbin.push_back(tbin);
+      adc_tbin_share.push_back(low[iclock] + f * (high[iclock] - low[iclock]));
+    }
+    return;
+  }
+
   double vfirst_end =  sampaShapingResponseFunction(tzero, tfirst_end); 
   double first_integral = (vfirst_end / 2.0) * (tfirst_end - tzero);
     
@@ -1073,7 +1336,7 @@ void PHG4TpcPadPlaneReadout::sampaTimeDistribution(double tzero,  std::vector<in
       double tlow = tcenter - tstepsize/2.0;
 
       // sample the voltage in this bin at nsamples-1 locations
-      int nsamples = 6;
+      int nsamples = sampa_samples;
       double sample_step = tstepsize / (double) nsamples;
       double sintegral = 0;
       for(int isample = 0; isample < nsamples; ++isample)
@@ -1103,3 +1366,75 @@ double PHG4TpcPadPlaneReadout::sampaShapingResponseFunction(double tzero, double
 
     return v;
   }
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::makeResponseTables()
+{
+  m_layer_bounds.clear();
+  m_pad_response.clear();
+  LayerGeom = nullptr;
+
+  PHG4TpcGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
+  for (PHG4TpcGeomContainer::ConstIterator layeriter = layerrange.first;
+       layeriter != layerrange.second;
+       ++layeriter)
+  {
+    PHG4TpcGeom *geom = layeriter->second;
+    const double radius = geom->get_radius();
+    m_layer_bounds.push_back({radius - geom->get_thickness() / 2.0, radius + geom->get_thickness() / 2.0, geom});
+
+    // pads are assumed to touch the center of the next phi bin on both sides, see populate_zigzag_phibins
+    const double pitch = geom->get_phistep() * radius;
+    const unsigned int layer = geom->get_layer();
+    if (layer >= m_pad_response.size())
+    {
+      m_pad_response.resize(layer + 1);
+    }
+    PadResponse &response = m_pad_response[layer];
+    response.xmax = pitch + _nsigmas * sigmaT;
+    const double step = 2 * response.xmax / pad_response_bins;
+    response.inv_step = 1. / step;
+    response.overlap.resize(pad_response_bins + 1);
+    for (int i = 0; i <= pad_response_bins; ++i)
+    {
+      response.overlap[i] = pad_overlap(-response.xmax + i * step, pitch, sigmaT);
+    }
+  }
+  std::sort(m_layer_bounds.begin(), m_layer_bounds.end(), [](const LayerBounds &a, const LayerBounds &b)
+            { return a.rad_high < b.rad_high; });
+
+  // the time binning is the same for all layers
+  const double tstepsize = GeomContainer->GetLayerCellGeom(20)->get_zstep();
+  const double sample_step = tstepsize / sampa_samples;
+  m_sampa_response.assign(sampa_response_bins + 1, {});
+  m_sampa_response_inv_step = sampa_response_bins / tstepsize;
+  for (int i = 0; i <= sampa_response_bins; ++i)
+  {
+    // time from the arrival to the end of the first bin
+    const double dt = i * tstepsize / sampa_response_bins;
+    auto &shares = m_sampa_response[i];
+    shares[0] = (sampaShapingResponseFunction(0, dt) / 2.0) * dt;
+    for (int iclock = 1; iclock < NClocks; ++iclock)
+    {
+      const double tlow = dt + (iclock - 1) * tstepsize;
+      for (int isample = 0; isample < sampa_samples; ++isample)
+      {
+        shares[iclock] += sampaShapingResponseFunction(0, tlow + isample * sample_step + sample_step / 2.0) * sample_step;
+      }
+    }
+  }
+}
+
+//_________________________________________________________
+double PHG4TpcPadPlaneReadout::tabulatedPadOverlap(const unsigned int layernum, const double x_loc) const
+{
+  const PadResponse &response = m_pad_response[layernum];
+  const double u = (x_loc + response.xmax) * response.inv_step;
+  if (!(u >= 0) || u >= pad_response_bins)
+  {
+    return 0;
+  }
+  const int i = static_cast<int>(u);
+  const double f = u - i;
+  return response.overlap[i] + f * (response.overlap[i + 1] - response.overlap[i]);
+}
@@ -48,6 +48,10 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   void MapToPadPlane(TpcClusterBuilder &tpc_truth_clusterer, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
 
+  //! batched readout: the charge of all electrons is shared with the tabulated pad and SAMPA responses,
+  //! summed in a dense (pad x time bin) grid per layer and side and written to the TrkrHits once
+  void MapToPadPlane(TpcClusterBuilder &tpc_truth_clusterer, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const std::vector<DriftedElectron> &electrons, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
+
   void SetDefaultParameters() override;
   void UpdateInternalParameters() override;
  
@@ -68,18 +72,39 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
  private:
   //  void populate_rectangular_phibins(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share);
-  void populate_zigzag_phibins(const unsigned int side, const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &phibin_pad, std::vector<double> &phibin_pad_share);
+  void populate_zigzag_phibins(const unsigned int side, const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &phibin_pad, std::vector<double> &phibin_pad_share, const bool tabulated = false);
 
-  void sampaTimeDistribution(double tzero,  std::vector<int> &adc_tbin, std::vector<double> &adc_tbin_share);
+  void sampaTimeDistribution(double tzero,  std::vector<int> &adc_tbin, std::vector<double> &adc_tbin_share, const bool tabulated = false);
   double sampaShapingResponseFunction(double tzero, double t) const;
   
   double check_phi(const unsigned int side, const double phi, const double radius);
 
   void makeChannelMask(hitMaskTpc& aMask, const std::string& dbName, const std::string& totalChannelsToMask);
 
+  //! readout layer of an electron at rad_gem, which is moved out of the dead areas between the modules first. Sets LayerGeom, 0 if there is none
+  unsigned int findLayer(double &rad_gem);
+
+  //! number of electrons after the GEM amplification of one electron
+  double getGEMAmplification(const unsigned int side, const double phi, const double rad_gem);
+
+  bool isMasked(const TrkrDefs::hitsetkey hitsetkey, const unsigned int pad);
+
+  //! pad and SAMPA response tables of the batched readout
+  void makeResponseTables();
+  double tabulatedPadOverlap(const unsigned int layernum, const double x_loc) const;
+
   PHG4TpcGeomContainer *GeomContainer = nullptr;
   PHG4TpcGeom *LayerGeom = nullptr;
 
+  //! radial extent of the readout layers, ordered in radius
+  struct LayerBounds
+  {
+    double rad_low{0};
+    double rad_high{0};
+    PHG4TpcGeom *geom{nullptr};
+  };
+  std::vector<LayerBounds> m_layer_bounds;
+
   double neffelectrons_threshold {std::numeric_limits<double>::quiet_NaN()};
 
   std::array<double, 3> MinRadius{};
@@ -137,6 +162,39 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   TF1 *flangau[2][3][12] {{{nullptr}}};
 
+  //! overlap of the charge cloud with a zigzag pad, tabulated in the distance to the pad center, per layer
+  struct PadResponse
+  {
+    double xmax{0};
+    double inv_step{0};
+    std::vector<double> overlap;
+  };
+  std::vector<PadResponse> m_pad_response;
+
+  //! SAMPA shares of the time bins after the arrival, tabulated in the time to the end of the first bin
+  static constexpr int NClocks{8};
+  std::vector<std::array<double, NClocks>> m_sampa_response;
+  double m_sampa_response_inv_step{0};
+
+  //! per electron input of the batched readout
+  struct ChargeStamp
+  {
+    unsigned int layer{0};
+    unsigned int side{0};
+    double nelec{0};
+    std::array<int, 10> pad{};
+    std::array<double, 10> pad_share{};
+    unsigned int npads{0};
+    std::array<int, NClocks> tbin{};
+    std::array<double, NClocks> tbin_share{};
+    unsigned int ntbins{0};
+  };
+  std::vector<ChargeStamp> m_stamps;
+  std::vector<unsigned int> m_stamp_order;
+  std::vector<unsigned int> m_grid;
+  std::vector<unsigned char> m_grid_touched;
+  std::vector<unsigned int> m_grid_cells;
+
   hitMaskTpc m_deadChannelMap;
   hitMaskTpc m_hotChannelMap; 
 